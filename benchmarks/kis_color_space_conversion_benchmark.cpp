@@ -0,0 +1,125 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_color_space_conversion_benchmark.h"
+
+#include <simpletest.h>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+
+#include <kis_image.h>
+#include <kis_group_layer.h>
+#include <kis_paint_layer.h>
+#include "kis_paint_device.h"
+
+/**
+ * The document is 8k x 8k, every layer covers a 2k x 2k area
+ * at a different position, so the memory footprint stays sane
+ * even for the floating point color spaces
+ */
+const int IMAGE_SIZE = 8192;
+const int LAYER_RECT_SIZE = 2048;
+const int NUM_LAYERS = 30;
+
+KisImageSP KisColorSpaceConversionBenchmark::createImage(const KoColorSpace *colorSpace)
+{
+    KisImageSP image = new KisImage(0, IMAGE_SIZE, IMAGE_SIZE, colorSpace, "color space conversion benchmark");
+
+    const int step = (IMAGE_SIZE - LAYER_RECT_SIZE) / NUM_LAYERS;
+
+    for (int i = 0; i < NUM_LAYERS; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("layer %1").arg(i), OPACITY_OPAQUE_U8, colorSpace);
+
+        KoColor color(QColor::fromHsv(i * 360 / NUM_LAYERS, 200, 200, 192), colorSpace);
+        layer->paintDevice()->fill(QRect(i * step, (NUM_LAYERS - i - 1) * step,
+                                         LAYER_RECT_SIZE, LAYER_RECT_SIZE),
+                                   color);
+
+        image->addNode(layer, image->root());
+    }
+
+    image->initialRefreshGraph();
+
+    return image;
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkImageConversion(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace)
+{
+    QVERIFY(srcColorSpace);
+    QVERIFY(dstColorSpace);
+
+    KisImageSP image = createImage(srcColorSpace);
+
+    QBENCHMARK_ONCE {
+        image->convertImageColorSpace(dstColorSpace,
+                                      KoColorConversionTransformation::internalRenderingIntent(),
+                                      KoColorConversionTransformation::internalConversionFlags());
+        image->waitForDone();
+    }
+
+    QCOMPARE(*image->root()->firstChild()->colorSpace(), *dstColorSpace);
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkSequentialConversion(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace)
+{
+    QVERIFY(srcColorSpace);
+    QVERIFY(dstColorSpace);
+
+    KisImageSP image = createImage(srcColorSpace);
+
+    QBENCHMARK_ONCE {
+        KisNodeSP node = image->root()->firstChild();
+        while (node) {
+            node->paintDevice()->convertTo(dstColorSpace);
+            node = node->nextSibling();
+        }
+    }
+}
+
+namespace {
+const KoColorSpace* rgbF32() {
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), QString());
+}
+
+const KoColorSpace* cmyk8() {
+    return KoColorSpaceRegistry::instance()->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), QString());
+}
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgb8ToRgbF32()
+{
+    benchmarkImageConversion(KoColorSpaceRegistry::instance()->rgb8(), rgbF32());
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgbF32ToRgb8()
+{
+    benchmarkImageConversion(rgbF32(), KoColorSpaceRegistry::instance()->rgb8());
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgb8ToCmyk8()
+{
+    benchmarkImageConversion(KoColorSpaceRegistry::instance()->rgb8(), cmyk8());
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgbF32ToCmyk8()
+{
+    benchmarkImageConversion(rgbF32(), cmyk8());
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgb8ToRgbF32Sequential()
+{
+    benchmarkSequentialConversion(KoColorSpaceRegistry::instance()->rgb8(), rgbF32());
+}
+
+void KisColorSpaceConversionBenchmark::benchmarkRgb8ToCmyk8Sequential()
+{
+    benchmarkSequentialConversion(KoColorSpaceRegistry::instance()->rgb8(), cmyk8());
+}
+
+SIMPLE_TEST_MAIN(KisColorSpaceConversionBenchmark)
@@ -0,0 +1,35 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_COLOR_SPACE_CONVERSION_BENCHMARK_H
+#define __KIS_COLOR_SPACE_CONVERSION_BENCHMARK_H
+
+#include <simpletest.h>
+
+#include "kis_types.h"
+
+class KoColorSpace;
+
+class KisColorSpaceConversionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    KisImageSP createImage(const KoColorSpace *colorSpace);
+    void benchmarkImageConversion(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace);
+    void benchmarkSequentialConversion(const KoColorSpace *srcColorSpace, const KoColorSpace *dstColorSpace);
+
+private Q_SLOTS:
+    void benchmarkRgb8ToRgbF32();
+    void benchmarkRgbF32ToRgb8();
+    void benchmarkRgb8ToCmyk8();
+    void benchmarkRgbF32ToCmyk8();
+
+    void benchmarkRgb8ToRgbF32Sequential();
+    void benchmarkRgb8ToCmyk8Sequential();
+};
+
+#endif /* __KIS_COLOR_SPACE_CONVERSION_BENCHMARK_H */
@@ -39,6 +39,8 @@
 #include <KoCompositeOpAlphaDarken.h>
 #include <KoCompositeOpOver.h>
 #include <KoCompositeOpCopy2.h>
+#include <KoCompositeOpGeneric.h>
+#include <KoCompositeOpRegistry.h>
 #include <KoOptimizedCompositeOpFactory.h>
 #include <KoAlphaDarkenParamsWrapper.h>
 
@@ -58,7 +60,13 @@
 enum AlphaRange {
     ALPHA_ZERO,
     ALPHA_UNIT,
-    ALPHA_RANDOM
+    ALPHA_RANDOM,
+    /**
+     * Looks like a brush dab: an opaque disc in the middle of the
+     * tile surrounded by transparent pixels. If used for the source,
+     * the mask is zero outside of the disc as well.
+     */
+    ALPHA_SPARSE
 };
 
 
@@ -75,6 +83,9 @@ inline channel_type generateAlphaValue(AlphaRange range, RandomGenerator &rnd) {
     case ALPHA_RANDOM:
         value = rnd();
         break;
+    case ALPHA_SPARSE:
+        // handled in generateDataLine()
+        break;
     }
 
     return value;
@@ -170,6 +181,18 @@ struct RandomGenerator<double> : RandomGenerator<float>
 };
 
 
+const int rowStride = 64;
+const int totalRows = 64;
+
+inline bool isInsideSparseDab(int pixelIndex)
+{
+    const int x = pixelIndex % rowStride - rowStride / 2;
+    const int y = pixelIndex / rowStride - totalRows / 2;
+    const int radius = rowStride / 4;
+
+    return x * x + y * y <= radius * radius;
+}
+
 template <typename channel_type>
 void generateDataLine(uint seed, int numPixels, quint8 *srcPixels, quint8 *dstPixels, quint8 *mask, AlphaRange srcAlphaRange, AlphaRange dstAlphaRange)
 {
@@ -191,10 +214,25 @@ void generateDataLine(uint seed, int numPixels, quint8 *srcPixels, quint8 *dstPi
 
         channel_type sa = generateAlphaValue<channel_type>(srcAlphaRange, rnd);
         channel_type da = generateAlphaValue<channel_type>(dstAlphaRange, rnd);
+        quint8 m = maskRnd();
+
+        if (srcAlphaRange == ALPHA_SPARSE || dstAlphaRange == ALPHA_SPARSE) {
+            const bool isInsideDab = isInsideSparseDab(i);
+
+            if (srcAlphaRange == ALPHA_SPARSE) {
+                sa = isInsideDab ? rnd.unit() : channel_type(0);
+                m = isInsideDab ? m : 0;
+            }
+
+            if (dstAlphaRange == ALPHA_SPARSE) {
+                da = isInsideDab ? rnd.unit() : channel_type(0);
+            }
+        }
+
         *(srcArray++) = sa;
         *(dstArray++) = da;
 
-        *(mask++) = maskRnd();
+        *(mask++) = m;
     }
 }
 
@@ -216,8 +254,6 @@ void printData(int numPixels, quint8 *srcPixels, quint8 *dstPixels, quint8 *mask
     }
 }
 
-const int rowStride = 64;
-const int totalRows = 64;
 const QRect processRect(0,0,64,64);
 const int numPixels = rowStride * totalRows;
 const int numTiles = 1024;
@@ -336,12 +372,13 @@ bool compareTwoOpsPixels(QVector<Tile> &tiles, channel_type prec) {
     return true;
 }
 
-bool compareTwoOps(bool haveMask, const KoCompositeOp *op1, const KoCompositeOp *op2)
+bool compareTwoOps(bool haveMask, const KoCompositeOp *op1, const KoCompositeOp *op2,
+                   AlphaRange srcAlphaRange = ALPHA_RANDOM, AlphaRange dstAlphaRange = ALPHA_RANDOM)
 {
     Q_ASSERT(op1->colorSpace()->pixelSize() == op2->colorSpace()->pixelSize());
     const quint32 pixelSize = op1->colorSpace()->pixelSize();
     const int alignment = 16;
-    QVector<Tile> tiles = generateTiles(2, alignment, alignment, ALPHA_RANDOM, ALPHA_RANDOM, op1->colorSpace()->pixelSize());
+    QVector<Tile> tiles = generateTiles(2, alignment, alignment, srcAlphaRange, dstAlphaRange, op1->colorSpace()->pixelSize());
 
     KoCompositeOp::ParameterInfo params;
     params.dstRowStride  = 4 * rowStride;
@@ -402,12 +439,14 @@ QString getTestName(bool haveMask,
     testName +=
         srcAlphaRange == ALPHA_RANDOM ? "SrcRand " :
         srcAlphaRange == ALPHA_ZERO   ? "SrcZero " :
-        srcAlphaRange == ALPHA_UNIT   ? "SrcUnit " : "###";
+        srcAlphaRange == ALPHA_UNIT   ? "SrcUnit " :
+        srcAlphaRange == ALPHA_SPARSE ? "SrcSprs " : "###";
 
     testName +=
         dstAlphaRange == ALPHA_RANDOM ? "DstRand" :
         dstAlphaRange == ALPHA_ZERO   ? "DstZero" :
-        dstAlphaRange == ALPHA_UNIT   ? "DstUnit" : "###";
+        dstAlphaRange == ALPHA_UNIT   ? "DstUnit" :
+        dstAlphaRange == ALPHA_SPARSE ? "DstSprs" : "###";
 
     return testName;
 }
@@ -479,6 +518,13 @@ void benchmarkCompositeOp(const KoCompositeOp *op, const QString &postfix)
     benchmarkCompositeOp(op, false, 1.0, 1.0, 0, 0, ALPHA_RANDOM, ALPHA_UNIT);
     benchmarkCompositeOp(op, false, 1.0, 1.0, 0, 0, ALPHA_ZERO, ALPHA_UNIT);
     benchmarkCompositeOp(op, false, 1.0, 1.0, 0, 0, ALPHA_UNIT, ALPHA_UNIT);
+
+/// --- Sparse data: a small dab in the middle of the tile
+
+    benchmarkCompositeOp(op, true, 0.5, 0.3, 0, 0, ALPHA_SPARSE, ALPHA_RANDOM);
+    benchmarkCompositeOp(op, true, 1.0, 1.0, 0, 0, ALPHA_SPARSE, ALPHA_RANDOM);
+    benchmarkCompositeOp(op, false, 1.0, 1.0, 0, 0, ALPHA_SPARSE, ALPHA_RANDOM);
+    benchmarkCompositeOp(op, false, 1.0, 1.0, 0, 0, ALPHA_SPARSE, ALPHA_SPARSE);
 }
 
 #ifdef HAVE_VC
@@ -757,6 +803,19 @@ void KisCompositionBenchmark::compareOverOps()
     delete opAct;
 }
 
+void KisCompositionBenchmark::compareOverOpsSparse()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KoCompositeOp *opAct = KoOptimizedCompositeOpFactory::createOverOp32(cs);
+    KoCompositeOp *opExp = new KoCompositeOpOver<KoBgrU8Traits>(cs);
+
+    QVERIFY(compareTwoOps(true, opAct, opExp, ALPHA_SPARSE, ALPHA_RANDOM));
+    QVERIFY(compareTwoOps(false, opAct, opExp, ALPHA_SPARSE, ALPHA_SPARSE));
+
+    delete opExp;
+    delete opAct;
+}
+
 void KisCompositionBenchmark::compareOverOpsNoMask()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -805,6 +864,18 @@ void KisCompositionBenchmark::compareRgbU8CopyOps()
     delete opAct;
 }
 
+void KisCompositionBenchmark::compareRgbU8CopyOpsSparse()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KoCompositeOp *opAct = KoOptimizedCompositeOpFactory::createCopyOp32(cs);
+    KoCompositeOp *opExp = new KoCompositeOpCopy2<KoRgbU8Traits>(cs);
+
+    QVERIFY(compareTwoOps(true, opAct, opExp, ALPHA_SPARSE, ALPHA_RANDOM));
+
+    delete opExp;
+    delete opAct;
+}
+
 void KisCompositionBenchmark::compareRgbU16CopyOps()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
@@ -829,6 +900,88 @@ void KisCompositionBenchmark::compareRgbF32CopyOps()
     delete opAct;
 }
 
+KoCompositeOp* createLegacyBlendOp32(const KoColorSpace *cs, const QString &id)
+{
+    KoCompositeOp *op = 0;
+
+    if (id == COMPOSITE_MULT) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfMultiply<quint8> >(cs, id, KoCompositeOp::categoryArithmetic());
+    } else if (id == COMPOSITE_SCREEN) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfScreen<quint8> >(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_OVERLAY) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfOverlay<quint8> >(cs, id, KoCompositeOp::categoryMix());
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfSoftLight<quint8> >(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_DODGE) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfColorDodge<quint8> >(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_BURN) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfColorBurn<quint8> >(cs, id, KoCompositeOp::categoryDark());
+    } else if (id == COMPOSITE_ADD) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfAddition<quint8> >(cs, id, KoCompositeOp::categoryArithmetic());
+    } else if (id == COMPOSITE_SUBTRACT) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfSubtract<quint8> >(cs, id, KoCompositeOp::categoryArithmetic());
+    } else if (id == COMPOSITE_DARKEN) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfDarkenOnly<quint8> >(cs, id, KoCompositeOp::categoryDark());
+    } else if (id == COMPOSITE_LIGHTEN) {
+        op = new KoCompositeOpGenericSC<KoBgrU8Traits, &cfLightenOnly<quint8> >(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_COLOR) {
+        op = new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfColor<HSYType, float> >(cs, id, KoCompositeOp::categoryHSY());
+    } else if (id == COMPOSITE_HUE) {
+        op = new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfHue<HSYType, float> >(cs, id, KoCompositeOp::categoryHSY());
+    } else if (id == COMPOSITE_SATURATION) {
+        op = new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfSaturation<HSYType, float> >(cs, id, KoCompositeOp::categoryHSY());
+    } else if (id == COMPOSITE_LUMINIZE) {
+        op = new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfLightness<HSYType, float> >(cs, id, KoCompositeOp::categoryHSY());
+    }
+
+    return op;
+}
+
+void addBlendOpsTestData()
+{
+    QTest::addColumn<QString>("id");
+
+    QTest::newRow("multiply") << COMPOSITE_MULT;
+    QTest::newRow("screen") << COMPOSITE_SCREEN;
+    QTest::newRow("overlay") << COMPOSITE_OVERLAY;
+    QTest::newRow("soft-light") << COMPOSITE_SOFT_LIGHT_PHOTOSHOP;
+    QTest::newRow("color-dodge") << COMPOSITE_DODGE;
+    QTest::newRow("color-burn") << COMPOSITE_BURN;
+    QTest::newRow("add") << COMPOSITE_ADD;
+    QTest::newRow("subtract") << COMPOSITE_SUBTRACT;
+    QTest::newRow("darken") << COMPOSITE_DARKEN;
+    QTest::newRow("lighten") << COMPOSITE_LIGHTEN;
+    QTest::newRow("color") << COMPOSITE_COLOR;
+    QTest::newRow("hue") << COMPOSITE_HUE;
+    QTest::newRow("saturation") << COMPOSITE_SATURATION;
+    QTest::newRow("luminize") << COMPOSITE_LUMINIZE;
+}
+
+void KisCompositionBenchmark::compareRgbU8BlendOps_data()
+{
+    addBlendOpsTestData();
+}
+
+void KisCompositionBenchmark::compareRgbU8BlendOps()
+{
+    QFETCH(QString, id);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QScopedPointer<KoCompositeOp> opAct(KoOptimizedCompositeOpFactory::createBlendOp32(cs, id));
+    QScopedPointer<KoCompositeOp> opExp(createLegacyBlendOp32(cs, id));
+
+    QVERIFY(opAct);
+    QVERIFY(opExp);
+
+    /**
+     * The generic ops do the division by the resulting alpha in
+     * integers, which loses too much precision on almost transparent
+     * pixels, so compare them on an opaque canvas only
+     */
+    QVERIFY(compareTwoOps(true, opAct.data(), opExp.data(), ALPHA_RANDOM, ALPHA_UNIT));
+    QVERIFY(compareTwoOps(false, opAct.data(), opExp.data(), ALPHA_RANDOM, ALPHA_UNIT));
+}
+
 void KisCompositionBenchmark::testRgb8CompositeAlphaDarkenLegacy()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -957,6 +1110,78 @@ void KisCompositionBenchmark::testRgbF32CompositeCopyOptimized()
     delete op;
 }
 
+void KisCompositionBenchmark::testRgbF16CompositeAlphaDarkenLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeAlphaDarkenOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeOverLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpOver<KoRgbF16Traits>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeOverOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeCopyLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpCopy2<KoRgbF16Traits>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeCopyOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
+
 void KisCompositionBenchmark::testRgb8CompositeAlphaDarkenReal_Aligned()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -987,6 +1212,34 @@ void KisCompositionBenchmark::testRgb8CompositeCopyOptimized()
     delete op;
 }
 
+void KisCompositionBenchmark::testRgb8CompositeBlendLegacy_data()
+{
+    addBlendOpsTestData();
+}
+
+void KisCompositionBenchmark::testRgb8CompositeBlendLegacy()
+{
+    QFETCH(QString, id);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QScopedPointer<KoCompositeOp> op(createLegacyBlendOp32(cs, id));
+    benchmarkCompositeOp(op.data(), "Legacy");
+}
+
+void KisCompositionBenchmark::testRgb8CompositeBlendOptimized_data()
+{
+    addBlendOpsTestData();
+}
+
+void KisCompositionBenchmark::testRgb8CompositeBlendOptimized()
+{
+    QFETCH(QString, id);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QScopedPointer<KoCompositeOp> op(KoOptimizedCompositeOpFactory::createBlendOp32(cs, id));
+    benchmarkCompositeOp(op.data(), "Optimized");
+}
+
 void KisCompositionBenchmark::benchmarkMemcpy()
 {
     QVector<Tile> tiles =
@@ -37,14 +37,19 @@ private Q_SLOTS:
     void compareRgbF32AlphaDarkenOps();
 
     void compareOverOps();
+    void compareOverOpsSparse();
     void compareOverOpsNoMask();
     void compareRgbU16OverOps();
     void compareRgbF32OverOps();
 
     void compareRgbU8CopyOps();
+    void compareRgbU8CopyOpsSparse();
     void compareRgbU16CopyOps();
     void compareRgbF32CopyOps();
 
+    void compareRgbU8BlendOps_data();
+    void compareRgbU8BlendOps();
+
     void testRgb8CompositeAlphaDarkenLegacy();
     void testRgb8CompositeAlphaDarkenOptimized();
 
@@ -69,12 +74,26 @@ private Q_SLOTS:
     void testRgbF32CompositeCopyLegacy();
     void testRgbF32CompositeCopyOptimized();
 
+    void testRgbF16CompositeAlphaDarkenLegacy();
+    void testRgbF16CompositeAlphaDarkenOptimized();
+
+    void testRgbF16CompositeOverLegacy();
+    void testRgbF16CompositeOverOptimized();
+
+    void testRgbF16CompositeCopyLegacy();
+    void testRgbF16CompositeCopyOptimized();
+
     void testRgb8CompositeAlphaDarkenReal_Aligned();
     void testRgb8CompositeOverReal_Aligned();
 
     void testRgb8CompositeCopyLegacy();
     void testRgb8CompositeCopyOptimized();
 
+    void testRgb8CompositeBlendLegacy_data();
+    void testRgb8CompositeBlendLegacy();
+    void testRgb8CompositeBlendOptimized_data();
+    void testRgb8CompositeBlendOptimized();
+
     void benchmarkMemcpy();
 
     void benchmarkUintFloat();
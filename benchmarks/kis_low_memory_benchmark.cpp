@@ -27,6 +27,10 @@
 #include "KisGlobalResourcesInterface.h"
 
 #include "tiles3/kis_tile_data_store.h"
+#include "tiles3/swap/kis_tile_compressor_factory.h"
+#include "tiles3/swap/kis_chunk_allocator.h"
+#include "tiles3/swap/kis_memory_window.h"
+#include "tiles3/swap/kis_mapped_swap_file.h"
 #include "kis_surrogate_undo_adapter.h"
 #include "kis_image_config.h"
 #define LOAD_PRESET_OR_RETURN(preset, fileName)                         \
@@ -218,4 +222,194 @@ void KisLowMemoryBenchmark::memory2000History100Pool500HugeBrush()
                       2000, 600, 500, 0);
 }
 
+/**
+ * Compresses and decompresses all the tiles of a painted device with
+ * the swap compressor and reports the throughput and the ratio of the
+ * chosen algorithm.
+ */
+void KisLowMemoryBenchmark::benchmarkSwapCompression(KisCompressionFactory::Type type)
+{
+    if (!KisCompressionFactory::isSupported(type)) {
+        QSKIP("The compression algorithm is not supported by this build");
+    }
+
+    const QString presetFileName = "autobrush_300px.kpp";
+    KisPaintOpPresetSP preset(new KisPaintOpPreset(QString(FILES_DATA_DIR) + '/' + presetFileName));
+    LOAD_PRESET_OR_RETURN(preset, presetFileName);
+
+    const KoColorSpace *colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, 4096, 4096, colorSpace, "compression sample image");
+    KisLayerSP layer = new KisPaintLayer(image, "compression sample", OPACITY_OPAQUE_U8, colorSpace);
+    image->addNode(layer, image->root());
+
+    KisPainter painter(layer->paintDevice());
+    painter.setPaintColor(KoColor(Qt::black, colorSpace));
+    painter.setPaintOpPreset(preset, layer, image);
+
+    KisDistanceInformation currentDistance;
+    for (qreal y = 150; y < 4000; y += 250) {
+        KisPaintInformation pi1(QPointF(150, y), 0.0);
+        KisPaintInformation pi2(QPointF(4000, y + 125), 1.0);
+        painter.paintLine(pi1, pi2, &currentDistance);
+    }
+
+    KisDataManagerSP dm = layer->paintDevice()->dataManager();
+    const QRect extent = dm->extent();
+
+    QVector<KisTileSP> tiles;
+    for (int row = extent.top() / KisTileData::HEIGHT; row <= extent.bottom() / KisTileData::HEIGHT; row++) {
+        for (int col = extent.left() / KisTileData::WIDTH; col <= extent.right() / KisTileData::WIDTH; col++) {
+            tiles << dm->getTile(col, row, false);
+        }
+    }
+    QVERIFY(!tiles.isEmpty());
+
+    KisAbstractTileCompressorSP compressor = KisTileCompressorFactory::createForSwap(type);
+    const qint32 tileDataSize = colorSpace->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+    QByteArray buffer(compressor->tileDataBufferSize(tiles.first()->tileData()), 0);
+
+    QVector<QByteArray> compressedTiles;
+    compressedTiles.reserve(tiles.size());
+    qint64 compressedSize = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        qint32 bytesWritten = 0;
+
+        tile->lockForRead();
+        compressor->compressTileData(tile->tileData(), (quint8*)buffer.data(),
+                                     buffer.size(), bytesWritten);
+        tile->unlockForRead();
+
+        compressedTiles << QByteArray(buffer.constData(), bytesWritten);
+        compressedSize += bytesWritten;
+    }
+
+    const qint64 compressionTime = timer.nsecsElapsed();
+
+    KisPaintDeviceSP scratchDevice = new KisPaintDevice(colorSpace);
+    KisTileSP scratchTile = scratchDevice->dataManager()->getTile(0, 0, true);
+
+    timer.restart();
+
+    scratchTile->lockForWrite();
+    Q_FOREACH (const QByteArray &data, compressedTiles) {
+        QVERIFY(compressor->decompressTileData((quint8*)data.data(), data.size(),
+                                               scratchTile->tileData()));
+    }
+    scratchTile->unlockForWrite();
+
+    const qint64 decompressionTime = timer.nsecsElapsed();
+
+    const qreal uncompressedMiB = qreal(tiles.size()) * tileDataSize / MiB;
+
+    dbgKrita << KisCompressionFactory::name(type)
+             << "tiles:" << tiles.size()
+             << "ratio:" << qreal(tiles.size()) * tileDataSize / compressedSize
+             << "compression (MiB/s):" << uncompressedMiB / (compressionTime * 1e-9)
+             << "decompression (MiB/s):" << uncompressedMiB / (decompressionTime * 1e-9);
+}
+
+void KisLowMemoryBenchmark::benchmarkSwapCompressionLzf()
+{
+    benchmarkSwapCompression(KisCompressionFactory::LZF);
+}
+
+void KisLowMemoryBenchmark::benchmarkSwapCompressionLz4()
+{
+    benchmarkSwapCompression(KisCompressionFactory::LZ4);
+}
+
+void KisLowMemoryBenchmark::benchmarkSwapCompressionZstd()
+{
+    benchmarkSwapCompression(KisCompressionFactory::ZSTD);
+}
+
+#define SWAP_SPACE_BENCHMARK_SIZE (10ULL * 1024 * MiB)
+#define SWAP_SPACE_CHUNK_AV_SIZE (12 * 1024)
+#define SWAP_SPACE_CHUNK_DEV_SIZE (4 * 1024)
+#define SWAP_SPACE_NUM_RANDOM_READS 200000
+
+/**
+ * Fills a swap file of SWAP_SPACE_BENCHMARK_SIZE with chunks of
+ * the size of a usual compressed tile and then reads them back in
+ * random order, the way the swapper does when the user jumps
+ * around a huge image. The file is placed into the configured swap
+ * directory and is expected to be bigger than the available RAM.
+ */
+void KisLowMemoryBenchmark::benchmarkSwapSpace(bool useMappedFile)
+{
+    KisImageConfig config(true);
+
+    QScopedPointer<KisChunkAllocator> allocator;
+    QScopedPointer<KisAbstractSwapSpace> swapSpace;
+
+    if (useMappedFile) {
+        allocator.reset(new KisChunkAllocator(DEFAULT_SLAB_SIZE, 2 * SWAP_SPACE_BENCHMARK_SIZE, DEFAULT_SEGMENT_SIZE));
+        swapSpace.reset(new KisMappedSwapFile(config.swapDir(), DEFAULT_SEGMENT_SIZE));
+    } else {
+        allocator.reset(new KisChunkAllocator(DEFAULT_SLAB_SIZE, 2 * SWAP_SPACE_BENCHMARK_SIZE));
+        swapSpace.reset(new KisMemoryWindow(config.swapDir(), DEFAULT_WINDOW_SIZE));
+    }
+
+    QVector<KisChunk> chunks;
+    quint64 totalWritten = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (totalWritten < SWAP_SPACE_BENCHMARK_SIZE) {
+        const quint64 size = SWAP_SPACE_CHUNK_AV_SIZE - SWAP_SPACE_CHUNK_DEV_SIZE +
+            qrand() % (2 * SWAP_SPACE_CHUNK_DEV_SIZE);
+
+        KisChunk chunk = allocator->getChunk(size);
+        quint8 *ptr = swapSpace->getWriteChunkPtr(chunk);
+        QVERIFY(ptr);
+
+        memset(ptr, chunks.size() % 255, size);
+
+        chunks << chunk;
+        totalWritten += size;
+    }
+
+    const qint64 writeTime = timer.nsecsElapsed();
+
+    QByteArray buffer(SWAP_SPACE_CHUNK_AV_SIZE + SWAP_SPACE_CHUNK_DEV_SIZE, 0);
+    quint64 totalRead = 0;
+
+    timer.restart();
+
+    for (int i = 0; i < SWAP_SPACE_NUM_RANDOM_READS; i++) {
+        const int index = qrand() % chunks.size();
+        KisChunk chunk = chunks[index];
+
+        quint8 *ptr = swapSpace->getReadChunkPtr(chunk);
+        QVERIFY(ptr);
+
+        memcpy(buffer.data(), ptr, chunk.size());
+        QCOMPARE(quint8(buffer[0]), quint8(index % 255));
+
+        totalRead += chunk.size();
+    }
+
+    const qint64 readTime = timer.nsecsElapsed();
+
+    dbgKrita << (useMappedFile ? "mapped file:" : "memory window:")
+             << "chunks:" << chunks.size()
+             << "sequential write (MiB/s):" << qreal(totalWritten) / MiB / (writeTime * 1e-9)
+             << "random read (MiB/s):" << qreal(totalRead) / MiB / (readTime * 1e-9);
+}
+
+void KisLowMemoryBenchmark::benchmarkSwapSpaceWindowed()
+{
+    benchmarkSwapSpace(false);
+}
+
+void KisLowMemoryBenchmark::benchmarkSwapSpaceMapped()
+{
+    benchmarkSwapSpace(true);
+}
+
 SIMPLE_TEST_MAIN(KisLowMemoryBenchmark)
@@ -9,6 +9,8 @@
 
 #include <simpletest.h>
 
+#include "tiles3/swap/kis_compression_factory.h"
+
 class KisLowMemoryBenchmark : public QObject
 {
     Q_OBJECT
@@ -19,6 +21,13 @@ private Q_SLOTS:
 
     void memory2000History100Pool500HugeBrush();
 
+    void benchmarkSwapCompressionLzf();
+    void benchmarkSwapCompressionLz4();
+    void benchmarkSwapCompressionZstd();
+
+    void benchmarkSwapSpaceWindowed();
+    void benchmarkSwapSpaceMapped();
+
 private:
     void benchmarkWideArea(const QString presetFileName,
                            const QRectF &rect, qreal vstep,
@@ -28,6 +37,9 @@ private:
                            int softLimitMiB,
                            int poolLimitMiB,
                            int index);
+
+    void benchmarkSwapCompression(KisCompressionFactory::Type type);
+    void benchmarkSwapSpace(bool useMappedFile);
 };
 
 #endif /* __KIS_LOW_MEMORY_BENCHMARK_H */
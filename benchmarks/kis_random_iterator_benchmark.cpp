@@ -16,6 +16,9 @@
 #include <simpletest.h>
 #include <kis_random_accessor_ng.h>
 
+#include <random>
+#include <QtConcurrent>
+
 
 void KisRandomIteratorBenchmark::initTestCase()
 {
@@ -222,5 +225,60 @@ void KisRandomIteratorBenchmark::benchmarkTwoIteratorsNoMemCpy()
     }
 }
 
+/**
+ * Every thread gets its own accessor and seed, so the threads
+ * contend only on the tile hash table of the device
+ */
+void KisRandomIteratorBenchmark::benchmarkParallelTotalRandomConst()
+{
+    QVector<int> seeds;
+    for (int i = 0; i < QThread::idealThreadCount(); i++) {
+        seeds << 123456 + i;
+    }
+
+    const int pixelsPerThread = TEST_IMAGE_WIDTH * TEST_IMAGE_HEIGHT / seeds.size();
+
+    auto reader = [this, pixelsPerThread] (int seed) {
+        KisRandomConstAccessorSP it = m_device->createRandomConstAccessorNG();
+        KoColor color(m_colorSpace);
+        std::minstd_rand gen(seed);
+
+        for (int i = 0; i < pixelsPerThread; i++) {
+            it->moveTo(gen() % TEST_IMAGE_WIDTH, gen() % TEST_IMAGE_HEIGHT);
+            memcpy(color.data(), it->oldRawData(), m_colorSpace->pixelSize());
+        }
+    };
+
+    QBENCHMARK{
+        QtConcurrent::blockingMap(seeds, reader);
+    }
+}
+
+void KisRandomIteratorBenchmark::benchmarkParallelTotalRandomWrite()
+{
+    QVector<int> seeds;
+    for (int i = 0; i < QThread::idealThreadCount(); i++) {
+        seeds << 123456 + i;
+    }
+
+    const int pixelsPerThread = TEST_IMAGE_WIDTH * TEST_IMAGE_HEIGHT / seeds.size();
+
+    QBENCHMARK{
+        // the tiles are created lazily by the writers
+        KisPaintDevice dev(m_colorSpace);
+
+        auto writer = [this, &dev, pixelsPerThread] (int seed) {
+            KisRandomAccessorSP it = dev.createRandomAccessorNG();
+            std::minstd_rand gen(seed);
+
+            for (int i = 0; i < pixelsPerThread; i++) {
+                it->moveTo(gen() % TEST_IMAGE_WIDTH, gen() % TEST_IMAGE_HEIGHT);
+                memcpy(it->rawData(), m_color->data(), m_colorSpace->pixelSize());
+            }
+        };
+
+        QtConcurrent::blockingMap(seeds, writer);
+    }
+}
 
 SIMPLE_TEST_MAIN(KisRandomIteratorBenchmark)
@@ -46,6 +46,11 @@ private Q_SLOTS:
     void benchmarkNoMemCpy();
     void benchmarkConstNoMemCpy();
     void benchmarkTwoIteratorsNoMemCpy();
+
+    // randomly read data from several threads at once
+    void benchmarkParallelTotalRandomConst();
+    // randomly write data into an empty device from several threads at once
+    void benchmarkParallelTotalRandomWrite();
 };
 
 #endif
@@ -0,0 +1,49 @@
+# - Try to find the LZ4 compression library
+# Once done this will define
+#
+#  LZ4_FOUND - system has lz4
+#  LZ4_INCLUDE_DIRS - the lz4 include directories
+#  LZ4_LIBRARIES - the libraries needed to use lz4
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+include(LibFindMacros)
+libfind_pkg_check_modules(LZ4_PKGCONF liblz4)
+
+find_path(LZ4_INCLUDE_DIR
+    NAMES lz4.h
+    HINTS ${LZ4_PKGCONF_INCLUDE_DIRS} ${LZ4_PKGCONF_INCLUDEDIR}
+)
+
+find_library(LZ4_LIBRARY
+    NAMES lz4 liblz4
+    HINTS ${LZ4_PKGCONF_LIBRARY_DIRS} ${LZ4_PKGCONF_LIBDIR}
+    DOC "Libraries to link against for LZ4 swap compression"
+)
+
+set(LZ4_PROCESS_LIBS LZ4_LIBRARY)
+set(LZ4_PROCESS_INCLUDES LZ4_INCLUDE_DIR)
+libfind_process(LZ4)
+
+if(LZ4_INCLUDE_DIR)
+  set(lz4_header_file "${LZ4_INCLUDE_DIR}/lz4.h")
+  if(EXISTS ${lz4_header_file})
+      file(STRINGS ${lz4_header_file} _lz4_major REGEX "^#define LZ4_VERSION_MAJOR +[0-9]+")
+      file(STRINGS ${lz4_header_file} _lz4_minor REGEX "^#define LZ4_VERSION_MINOR +[0-9]+")
+      file(STRINGS ${lz4_header_file} _lz4_release REGEX "^#define LZ4_VERSION_RELEASE +[0-9]+")
+      string(REGEX MATCH "[0-9]+" _lz4_major "${_lz4_major}")
+      string(REGEX MATCH "[0-9]+" _lz4_minor "${_lz4_minor}")
+      string(REGEX MATCH "[0-9]+" _lz4_release "${_lz4_release}")
+      set(LZ4_VERSION "${_lz4_major}.${_lz4_minor}.${_lz4_release}")
+  endif()
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4
+    REQUIRED_VARS
+        LZ4_INCLUDE_DIR
+        LZ4_LIBRARY
+    VERSION_VAR
+        LZ4_VERSION
+)
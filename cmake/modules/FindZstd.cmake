@@ -0,0 +1,49 @@
+# - Try to find the Zstandard compression library
+# Once done this will define
+#
+#  Zstd_FOUND - system has zstd
+#  Zstd_INCLUDE_DIRS - the zstd include directories
+#  Zstd_LIBRARIES - the libraries needed to use zstd
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+include(LibFindMacros)
+libfind_pkg_check_modules(Zstd_PKGCONF libzstd)
+
+find_path(Zstd_INCLUDE_DIR
+    NAMES zstd.h
+    HINTS ${Zstd_PKGCONF_INCLUDE_DIRS} ${Zstd_PKGCONF_INCLUDEDIR}
+)
+
+find_library(Zstd_LIBRARY
+    NAMES zstd libzstd zstd_static
+    HINTS ${Zstd_PKGCONF_LIBRARY_DIRS} ${Zstd_PKGCONF_LIBDIR}
+    DOC "Libraries to link against for Zstandard swap compression"
+)
+
+set(Zstd_PROCESS_LIBS Zstd_LIBRARY)
+set(Zstd_PROCESS_INCLUDES Zstd_INCLUDE_DIR)
+libfind_process(Zstd)
+
+if(Zstd_INCLUDE_DIR)
+  set(zstd_header_file "${Zstd_INCLUDE_DIR}/zstd.h")
+  if(EXISTS ${zstd_header_file})
+      file(STRINGS ${zstd_header_file} _zstd_major REGEX "^#define ZSTD_VERSION_MAJOR +[0-9]+")
+      file(STRINGS ${zstd_header_file} _zstd_minor REGEX "^#define ZSTD_VERSION_MINOR +[0-9]+")
+      file(STRINGS ${zstd_header_file} _zstd_release REGEX "^#define ZSTD_VERSION_RELEASE +[0-9]+")
+      string(REGEX MATCH "[0-9]+" _zstd_major "${_zstd_major}")
+      string(REGEX MATCH "[0-9]+" _zstd_minor "${_zstd_minor}")
+      string(REGEX MATCH "[0-9]+" _zstd_release "${_zstd_release}")
+      set(Zstd_VERSION "${_zstd_major}.${_zstd_minor}.${_zstd_release}")
+  endif()
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Zstd
+    REQUIRED_VARS
+        Zstd_INCLUDE_DIR
+        Zstd_LIBRARY
+    VERSION_VAR
+        Zstd_VERSION
+)
@@ -318,6 +318,30 @@ const KUndo2Command *KUndo2Command::child(int index) const
     return d->child_list.at(index);
 }
 
+/*!
+    Returns the number of bytes the command keeps in memory for being
+    able to undo and redo the action. The default implementation sums
+    up the memory used by the child commands and by the commands
+    merged into this one.
+
+    \sa KUndo2QStack::setUndoMemoryLimit()
+*/
+
+qint64 KUndo2Command::memoryUsage() const
+{
+    qint64 usage = 0;
+
+    Q_FOREACH (const KUndo2Command *cmd, d->child_list) {
+        usage += cmd->memoryUsage();
+    }
+
+    Q_FOREACH (const KUndo2Command *cmd, m_mergeCommandsVector) {
+        usage += cmd->memoryUsage();
+    }
+
+    return usage;
+}
+
 bool KUndo2Command::hasParent()
 {
     return m_hasParent;
@@ -572,7 +596,9 @@ void KUndo2QStack::purgeRedoState()
     bool cleanStateChanged = false;
 
     while (m_index < m_command_list.size()) {
-        delete m_command_list.takeLast();
+        KUndo2Command *cmd = m_command_list.takeLast();
+        releaseCommandMemoryUsage(cmd);
+        delete cmd;
         redoStateChanged = true;
     }
 
@@ -600,13 +626,35 @@ void KUndo2QStack::purgeRedoState()
 
 bool KUndo2QStack::checkUndoLimit()
 {
-    if (m_undo_limit <= 0 || !m_macro_stack.isEmpty() || m_undo_limit >= m_command_list.count())
+    if (!m_macro_stack.isEmpty())
         return false;
 
-    int del_count = m_command_list.count() - m_undo_limit;
+    int del_count = 0;
 
-    for (int i = 0; i < del_count; ++i)
-        delete m_command_list.takeFirst();
+    if (m_undo_limit > 0 && m_undo_limit < m_command_list.count()) {
+        del_count = m_command_list.count() - m_undo_limit;
+    }
+
+    for (int i = 0; i < del_count; ++i) {
+        KUndo2Command *cmd = m_command_list.takeFirst();
+        releaseCommandMemoryUsage(cmd);
+        delete cmd;
+    }
+
+    // the most recent command is never deleted
+    if (m_undo_memory_limit > 0) {
+        while (m_undo_memory_usage > m_undo_memory_limit &&
+               m_command_list.count() > 1) {
+
+            KUndo2Command *cmd = m_command_list.takeFirst();
+            releaseCommandMemoryUsage(cmd);
+            delete cmd;
+            ++del_count;
+        }
+    }
+
+    if (del_count <= 0)
+        return false;
 
     m_index -= del_count;
     if (m_clean_index != -1) {
@@ -618,6 +666,31 @@ bool KUndo2QStack::checkUndoLimit()
     return true;
 }
 
+/*! \internal
+    Accounts the current memoryUsage() of \a cmd in the total memory
+    usage of the stack. Should be called when the command is added to
+    the stack and every time its usage may have changed, e.g. when
+    other commands are merged into it.
+*/
+
+void KUndo2QStack::updateCommandMemoryUsage(KUndo2Command *cmd)
+{
+    const qint64 usage = cmd->memoryUsage();
+    m_undo_memory_usage += usage - cmd->d->memoryUsage;
+    cmd->d->memoryUsage = usage;
+}
+
+/*! \internal
+    Removes \a cmd from the total memory usage of the stack. Should be
+    called when the command is removed from the stack.
+*/
+
+void KUndo2QStack::releaseCommandMemoryUsage(KUndo2Command *cmd)
+{
+    m_undo_memory_usage -= cmd->d->memoryUsage;
+    cmd->d->memoryUsage = 0;
+}
+
 /*!
     Constructs an empty undo stack with the parent \a parent. The
     stack will initially be in the clean state. If \a parent is a
@@ -627,7 +700,7 @@ bool KUndo2QStack::checkUndoLimit()
 */
 
 KUndo2QStack::KUndo2QStack(QObject *parent)
-    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
+    : QObject(parent), m_index(0), m_clean_index(0), m_group(0), m_undo_limit(0), m_undo_memory_limit(0), m_undo_memory_usage(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
 {
     setTimeT1(5);
     setTimeT2(1);
@@ -679,6 +752,7 @@ void KUndo2QStack::clear()
     m_macro_stack.clear();
     qDeleteAll(m_command_list);
     m_command_list.clear();
+    m_undo_memory_usage = 0;
 
     m_index = 0;
     m_clean_index = 0;
@@ -731,8 +805,11 @@ void KUndo2QStack::push(KUndo2Command *cmd)
     } else {
         if (m_index > 0)
             cur = m_command_list.at(m_index - 1);
-        while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+        while (m_index < m_command_list.size()) {
+            KUndo2Command *redoCmd = m_command_list.takeLast();
+            releaseCommandMemoryUsage(redoCmd);
+            delete redoCmd;
+        }
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
     }
@@ -797,6 +874,8 @@ void KUndo2QStack::push(KUndo2Command *cmd)
 
                     if(mergeDestination->timedMergeWith(mergeSource)){
                         m_command_list.removeAt(mergeSourceIndex);
+                        releaseCommandMemoryUsage(mergeSource);
+                        updateCommandMemoryUsage(mergeDestination);
                     }
 
                     m_lastMergedSetCount--;
@@ -825,6 +904,8 @@ void KUndo2QStack::push(KUndo2Command *cmd)
                             if(lastcmd->timedMergeWith(curr)){
                                 if (m_command_list.contains(curr)) {
                                     m_command_list.removeOne(curr);
+                                    releaseCommandMemoryUsage(curr);
+                                    updateCommandMemoryUsage(lastcmd);
                                 }
                              }
                         } else {
@@ -835,6 +916,8 @@ void KUndo2QStack::push(KUndo2Command *cmd)
                             if(lastcmd->timedMergeWith(curr)){
                                 if (m_command_list.contains(curr)){
                                     m_command_list.removeOne(curr);
+                                    releaseCommandMemoryUsage(curr);
+                                    updateCommandMemoryUsage(lastcmd);
                                 }
                             }
                         } else {
@@ -855,7 +938,9 @@ void KUndo2QStack::push(KUndo2Command *cmd)
             // otherwise we would have to do cleanup for the clean state
             Q_ASSERT(m_clean_index != m_index);
 
-            delete m_command_list.takeLast();
+            KUndo2Command *lastCmd = m_command_list.takeLast();
+            releaseCommandMemoryUsage(lastCmd);
+            delete lastCmd;
             m_index--;
 
             emit indexChanged(m_index);
@@ -870,6 +955,7 @@ void KUndo2QStack::push(KUndo2Command *cmd)
     } else if (try_merge && cur->mergeWith(cmd)) {
         delete cmd;
         if (!macro) {
+            updateCommandMemoryUsage(cur);
             emit indexChanged(m_index);
             emit canUndoChanged(canUndo());
             emit undoTextChanged(undoText());
@@ -880,7 +966,17 @@ void KUndo2QStack::push(KUndo2Command *cmd)
         if (macro) {
             m_macro_stack.last()->d->child_list.append(cmd);
         } else {
+            /**
+             * Committing the new command may compress the data of
+             * the previous one, so its usage is updated as well
+             */
+            if (!m_command_list.isEmpty()) {
+                updateCommandMemoryUsage(m_command_list.last());
+            }
+
             m_command_list.append(cmd);
+            updateCommandMemoryUsage(cmd);
+
             if(checkUndoLimit())
             {
                 m_lastMergedIndex = m_index - m_strokesN;
@@ -1216,8 +1312,11 @@ void KUndo2QStack::beginMacro(const KUndo2MagicString &text)
     cmd->setText(text);
 
     if (m_macro_stack.isEmpty()) {
-        while (m_index < m_command_list.size())
-            delete m_command_list.takeLast();
+        while (m_index < m_command_list.size()) {
+            KUndo2Command *redoCmd = m_command_list.takeLast();
+            releaseCommandMemoryUsage(redoCmd);
+            delete redoCmd;
+        }
         if (m_clean_index > m_index)
             m_clean_index = -1; // we've deleted the clean state
         m_command_list.append(cmd);
@@ -1250,9 +1349,11 @@ void KUndo2QStack::endMacro()
         return;
     }
 
-    m_macro_stack.removeLast();
+    KUndo2Command *cmd = m_macro_stack.takeLast();
 
     if (m_macro_stack.isEmpty()) {
+        // the children of the macro are accounted when it is complete
+        updateCommandMemoryUsage(cmd);
         checkUndoLimit();
         setIndex(m_index + 1, false);
     }
@@ -1323,6 +1424,39 @@ int KUndo2QStack::undoLimit() const
     return m_undo_limit;
 }
 
+/*!
+    \brief the maximum total memoryUsage() of the commands on this stack.
+
+    When the commands on the stack use more memory than the limit, the
+    oldest commands are deleted from the bottom of the stack on the next
+    push(). The most recent command is always kept. The default value is
+    0, which means that there is no limit.
+
+    Unlike undoLimit, the property can be changed on a non-empty stack.
+
+    \sa KUndo2Command::memoryUsage()
+*/
+
+void KUndo2QStack::setUndoMemoryLimit(qint64 limit)
+{
+    m_undo_memory_limit = limit;
+}
+
+qint64 KUndo2QStack::undoMemoryLimit() const
+{
+    return m_undo_memory_limit;
+}
+
+/*!
+    Returns the total memoryUsage() of the commands on the stack, as it
+    was when the commands were pushed or merged
+*/
+
+qint64 KUndo2QStack::undoMemoryUsage() const
+{
+    return m_undo_memory_usage;
+}
+
 /*!
     \property KUndo2QStack::active
     \brief the active status of this stack.
@@ -109,6 +109,16 @@ public:
     int childCount() const;
     const KUndo2Command *child(int index) const;
 
+    /**
+     * \return the number of bytes of memory the command keeps for
+     * being able to undo and redo the action. The default
+     * implementation returns the total usage of the child and
+     * merged commands.
+     *
+     * \see KUndo2QStack::setUndoMemoryLimit()
+     */
+    virtual qint64 memoryUsage() const;
+
     bool hasParent();
     virtual void setTime();
     virtual QTime time();
@@ -190,6 +200,10 @@ public:
     void setUndoLimit(int limit);
     int undoLimit() const;
 
+    void setUndoMemoryLimit(qint64 limit);
+    qint64 undoMemoryLimit() const;
+    qint64 undoMemoryUsage() const;
+
     const KUndo2Command *command(int index) const;
 
     void setUseCumulativeUndoRedo(bool value);
@@ -230,6 +244,8 @@ private:
     int m_clean_index;
     KUndo2Group *m_group;
     int m_undo_limit;
+    qint64 m_undo_memory_limit;
+    qint64 m_undo_memory_usage;
     bool m_useCumulativeUndoRedo;
     double m_timeT1;
     double m_timeT2;
@@ -241,6 +257,9 @@ private:
     void setIndex(int idx, bool clean);
     bool checkUndoLimit();
 
+    void updateCommandMemoryUsage(KUndo2Command *cmd);
+    void releaseCommandMemoryUsage(KUndo2Command *cmd);
+
     Q_DISABLE_COPY(KUndo2QStack)
     friend class KUndo2Group;
 };
@@ -64,12 +64,15 @@ class KUndo2Command;
 class KUndo2CommandPrivate
 {
 public:
-    KUndo2CommandPrivate() : id(-1) {}
+    KUndo2CommandPrivate() : id(-1), memoryUsage(0) {}
     QList<KUndo2Command*> child_list;
     QString actionText;
     KUndo2MagicString text;
     int id;
 
+    // the memory usage accounted by the stack
+    qint64 memoryUsage;
+
     QScopedPointer<KUndo2CommandExtraData> extraData;
 };
 
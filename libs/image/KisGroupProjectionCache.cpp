@@ -0,0 +1,308 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisGroupProjectionCache.h"
+
+#include <QGlobalStatic>
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+
+#include "kis_node.h"
+#include "kis_paint_device.h"
+#include "kis_image_config.h"
+#include "KisImageConfigNotifier.h"
+#include "tiles3/kis_tile_data_store.h"
+
+
+/**
+ * Keeps all the caches in the order they were used, the most
+ * recently used one is the last. The lock of the registry may be
+ * taken while holding the lock of a cache, so the registry locks
+ * the other caches with tryLock() only.
+ */
+struct KisGroupProjectionCacheRegistry
+{
+    KisGroupProjectionCacheRegistry() {
+        rereadConfig();
+
+        QObject::connect(KisImageConfigNotifier::instance(),
+                         &KisImageConfigNotifier::configChanged,
+                         &KisGroupProjectionCacheRegistry::rereadConfigIfAlive);
+    }
+
+    static void rereadConfigIfAlive();
+
+    void rereadConfig() {
+        KisImageConfig cfg(true);
+
+        QMutexLocker l(&lock);
+        memoryLimit = qint64(cfg.groupProjectionCacheLimit()) << 20;
+        tilesSoftLimit = MiB_TO_METRIC(qint64(cfg.tilesSoftLimit()));
+    }
+
+    bool underMemoryPressure() const {
+        return KisTileDataStore::instance()->memoryMetric() > tilesSoftLimit;
+    }
+
+    /**
+     * Drops the data of \p cache if it is not being used at the
+     * moment. Should be called under the lock of the registry.
+     */
+    bool tryRelease(KisGroupProjectionCache *cache) {
+        if (!cache->m_mutex.tryLock()) return false;
+
+        if (!cache->m_memoryUsage) {
+            cache->m_mutex.unlock();
+            return false;
+        }
+
+        totalMemory -= cache->m_memoryUsage;
+        cache->m_memoryUsage = 0;
+        cache->dropDataImpl();
+        cache->m_mutex.unlock();
+
+        return true;
+    }
+
+    QMutex lock;
+    QList<KisGroupProjectionCache*> caches;
+    qint64 totalMemory = 0;
+    qint64 memoryLimit = 0;
+    qint64 tilesSoftLimit = 0;
+};
+
+Q_GLOBAL_STATIC(KisGroupProjectionCacheRegistry, s_registry)
+
+void KisGroupProjectionCacheRegistry::rereadConfigIfAlive()
+{
+    if (!s_registry.isDestroyed()) {
+        s_registry->rereadConfig();
+    }
+}
+
+static qint64 regionArea(const QRegion &region)
+{
+    qint64 area = 0;
+    for (const QRect &rc : region) {
+        area += qint64(rc.width()) * rc.height();
+    }
+    return area;
+}
+
+
+KisGroupProjectionCache::KisGroupProjectionCache()
+{
+    QMutexLocker l(&s_registry->lock);
+    s_registry->caches.append(this);
+}
+
+KisGroupProjectionCache::~KisGroupProjectionCache()
+{
+    QMutexLocker l(&s_registry->lock);
+    s_registry->caches.removeOne(this);
+    s_registry->totalMemory -= m_memoryUsage;
+}
+
+KisGroupProjectionCache::Composites
+KisGroupProjectionCache::fetchComposites(KisNodeSP splitNode,
+                                         const QRect &rect,
+                                         KisPaintDeviceSP projection,
+                                         int graphSequenceNumber,
+                                         bool aboveIsCacheable)
+{
+    QMutexLocker l(&m_mutex);
+
+    Composites composites;
+
+    const KoColorSpace *colorSpace = projection->colorSpace();
+    const KoColor defaultPixel = projection->defaultPixel();
+
+    if (graphSequenceNumber != m_graphSequenceNumber ||
+        colorSpace != m_colorSpace ||
+        !(defaultPixel == m_defaultPixel)) {
+
+        resetImpl();
+        m_graphSequenceNumber = graphSequenceNumber;
+        m_colorSpace = colorSpace;
+        m_defaultPixel = defaultPixel;
+    }
+
+    if (splitNode.data() != m_splitNode) {
+        m_belowValidRegion -= rect;
+        m_aboveValidRegion -= rect;
+
+        /**
+         * Single updates of different nodes are not worth
+         * rebuilding the cache, wait for the second one
+         */
+        if (splitNode.data() != m_candidateNode) {
+            m_candidateNode = splitNode.data();
+            return composites;
+        }
+
+        resetImpl();
+        m_splitNode = splitNode.data();
+        m_candidateNode = splitNode.data();
+    }
+
+    /**
+     * Only the floating point composition is precise enough to
+     * be regrouped without visible differences, see the class docs
+     */
+    const KoID depthId = colorSpace->colorDepthId();
+    const bool useAbove =
+        aboveIsCacheable &&
+        (depthId == Float16BitsColorDepthID ||
+         depthId == Float32BitsColorDepthID ||
+         depthId == Float64BitsColorDepthID);
+
+    if (!useAbove) {
+        m_aboveValidRegion -= rect;
+    }
+
+    if (!reserveMemoryImpl(rect, useAbove)) {
+        resetImpl();
+        m_candidateNode = splitNode.data();
+        return composites;
+    }
+
+    if (!m_below) {
+        /**
+         * The composite of the lower nodes replaces the pixels of
+         * the projection, so it should have the same default pixel
+         */
+        m_below = new KisPaintDevice(colorSpace);
+        m_below->setDefaultPixel(defaultPixel);
+        m_below->setX(projection->x());
+        m_below->setY(projection->y());
+    }
+
+    composites.below = m_below;
+    composites.belowValid = (QRegion(rect) - m_belowValidRegion).isEmpty();
+
+    if (useAbove) {
+        if (!m_above) {
+            m_above = new KisPaintDevice(colorSpace);
+        }
+
+        composites.above = m_above;
+        composites.aboveValid = (QRegion(rect) - m_aboveValidRegion).isEmpty();
+    }
+
+    composites.generation = m_generation;
+
+    return composites;
+}
+
+void KisGroupProjectionCache::markBelowValid(int generation, const QRect &rect)
+{
+    QMutexLocker l(&m_mutex);
+    if (generation != m_generation) return;
+
+    m_belowValidRegion += rect;
+}
+
+void KisGroupProjectionCache::markAboveValid(int generation, const QRect &rect)
+{
+    QMutexLocker l(&m_mutex);
+    if (generation != m_generation) return;
+
+    m_aboveValidRegion += rect;
+}
+
+void KisGroupProjectionCache::invalidate(const QRect &rect)
+{
+    QMutexLocker l(&m_mutex);
+
+    m_belowValidRegion -= rect;
+    m_aboveValidRegion -= rect;
+    m_candidateNode = nullptr;
+}
+
+void KisGroupProjectionCache::reset()
+{
+    QMutexLocker l(&m_mutex);
+    resetImpl();
+}
+
+qint64 KisGroupProjectionCache::totalMemoryUsage()
+{
+    QMutexLocker l(&s_registry->lock);
+    return s_registry->totalMemory;
+}
+
+bool KisGroupProjectionCache::reserveMemoryImpl(const QRect &rect, bool useAbove)
+{
+    const QRegion belowGrowth = QRegion(rect) - m_belowStorage;
+    const QRegion aboveGrowth = useAbove ? QRegion(rect) - m_aboveStorage : QRegion();
+
+    const qint64 requiredMemory =
+        (regionArea(belowGrowth) + regionArea(aboveGrowth)) * m_colorSpace->pixelSize();
+
+    KisGroupProjectionCacheRegistry *registry = s_registry;
+    QMutexLocker l(&registry->lock);
+
+    registry->caches.removeOne(this);
+    registry->caches.append(this);
+
+    if (registry->underMemoryPressure()) {
+        Q_FOREACH (KisGroupProjectionCache *cache, registry->caches) {
+            if (cache != this) {
+                registry->tryRelease(cache);
+            }
+        }
+        return false;
+    }
+
+    for (auto it = registry->caches.begin();
+         registry->totalMemory + requiredMemory > registry->memoryLimit &&
+             *it != this;
+         ++it) {
+
+        registry->tryRelease(*it);
+    }
+
+    if (registry->totalMemory + requiredMemory > registry->memoryLimit) {
+        return false;
+    }
+
+    registry->totalMemory += requiredMemory;
+    m_memoryUsage += requiredMemory;
+    m_belowStorage += belowGrowth;
+    m_aboveStorage += aboveGrowth;
+
+    return true;
+}
+
+void KisGroupProjectionCache::resetImpl()
+{
+    if (m_memoryUsage) {
+        QMutexLocker l(&s_registry->lock);
+        s_registry->totalMemory -= m_memoryUsage;
+        m_memoryUsage = 0;
+    }
+
+    dropDataImpl();
+}
+
+void KisGroupProjectionCache::dropDataImpl()
+{
+    /**
+     * The devices may still be in use by the running merges, so
+     * we don't clear them, but create new ones on the next fetch
+     */
+    m_below = 0;
+    m_above = 0;
+    m_belowValidRegion = QRegion();
+    m_aboveValidRegion = QRegion();
+    m_belowStorage = QRegion();
+    m_aboveStorage = QRegion();
+    m_splitNode = nullptr;
+    m_candidateNode = nullptr;
+    m_generation++;
+}
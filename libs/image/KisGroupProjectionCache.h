@@ -0,0 +1,156 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISGROUPPROJECTIONCACHE_H
+#define KISGROUPPROJECTIONCACHE_H
+
+#include <QMutex>
+#include <QRegion>
+
+#include <KoColor.h>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class KoColorSpace;
+
+/**
+ * Partial composites of the children of a group layer, used by
+ * KisAsyncMerger to avoid recompositing the whole stack when only
+ * one child of the group changes.
+ *
+ * The cache is split at one child of the group (the "split node"),
+ * which is the node that was updated in two merges in a row (e.g.
+ * the layer the user paints on). It keeps two composites:
+ *
+ *   - "below": the state of the group's original after all the
+ *     children below the split node are composited into it. It is
+ *     exactly what the merger would get, so it is always used
+ *     instead of compositing the lower children again.
+ *
+ *   - "above": all the children above the split node composited
+ *     onto a transparent device. It is composited over the original
+ *     with COMPOSITE_OVER instead of compositing the upper children
+ *     one by one. It is used only when all the upper children are
+ *     composited with COMPOSITE_OVER, because only this op is
+ *     associative, and only in floating point color spaces. In
+ *     integer color spaces every composition is rounded, so the
+ *     regrouped composition would differ from the sequential one
+ *     and cached and uncached areas of the group would not match.
+ *
+ * Every composite has a valid region. The merger invalidates it with
+ * the rects of all the merges that go through the group with another
+ * split node or without one (e.g. full refreshes). Any change of the
+ * node graph, the color space or the default pixel of the group
+ * drops the cache.
+ *
+ * All the caches share the memory limit set by
+ * KisImageConfig::groupProjectionCacheLimit(). When a cache needs
+ * more memory, the least recently used caches are dropped. When the
+ * tiles in memory exceed the soft limit of the swapper, all the
+ * caches are dropped and no new composites are stored.
+ *
+ * The cache is used only for the merges with a constant need rect
+ * at level of detail 0. Such merges never intersect, so the rects
+ * passed to the cache by concurrent merges never intersect either.
+ */
+class KRITAIMAGE_EXPORT KisGroupProjectionCache
+{
+public:
+    struct Composites {
+        /**
+         * Null devices mean that the corresponding children should be
+         * composited as usual
+         */
+        KisPaintDeviceSP below;
+        KisPaintDeviceSP above;
+
+        /**
+         * If the composite is not valid, the merger should fill
+         * it while compositing the children and then call
+         * markBelowValid()/markAboveValid()
+         */
+        bool belowValid = false;
+        bool aboveValid = false;
+
+        int generation = -1;
+    };
+
+public:
+    KisGroupProjectionCache();
+    ~KisGroupProjectionCache();
+
+    /**
+     * Returns the composites for a merge of the children into
+     * \p projection in \p rect with \p splitNode being updated.
+     *
+     * \p aboveIsCacheable tells whether the nodes above the split
+     * node can be composited in advance.
+     */
+    Composites fetchComposites(KisNodeSP splitNode,
+                               const QRect &rect,
+                               KisPaintDeviceSP projection,
+                               int graphSequenceNumber,
+                               bool aboveIsCacheable);
+
+    void markBelowValid(int generation, const QRect &rect);
+    void markAboveValid(int generation, const QRect &rect);
+
+    /**
+     * Invalidates the cache in \p rect after a merge that doesn't
+     * fit the split node of the cache
+     */
+    void invalidate(const QRect &rect);
+
+    /**
+     * Drops all the cached data
+     */
+    void reset();
+
+    /**
+     * The estimated memory occupied by the composites of all
+     * the caches, in bytes
+     */
+    static qint64 totalMemoryUsage();
+
+private:
+    friend struct KisGroupProjectionCacheRegistry;
+
+    void resetImpl();
+    void dropDataImpl();
+    bool reserveMemoryImpl(const QRect &rect, bool useAbove);
+
+private:
+    QMutex m_mutex;
+
+    /**
+     * The nodes are used for comparison only. The graph sequence
+     * number guarantees that the pointers are not dangling.
+     */
+    const KisNode *m_splitNode = nullptr;
+    const KisNode *m_candidateNode = nullptr;
+
+    int m_graphSequenceNumber = -1;
+    const KoColorSpace *m_colorSpace = nullptr;
+    KoColor m_defaultPixel;
+    int m_generation = 0;
+
+    KisPaintDeviceSP m_below;
+    KisPaintDeviceSP m_above;
+    QRegion m_belowValidRegion;
+    QRegion m_aboveValidRegion;
+
+    /**
+     * The areas of the devices that have been handed to the merger
+     * since the last reset and the memory they occupy. The memory
+     * is accounted in the registry, under its lock.
+     */
+    QRegion m_belowStorage;
+    QRegion m_aboveStorage;
+    qint64 m_memoryUsage = 0;
+};
+
+#endif // KISGROUPPROJECTIONCACHE_H
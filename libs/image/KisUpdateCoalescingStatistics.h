@@ -0,0 +1,44 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISUPDATECOALESCINGSTATISTICS_H
+#define KISUPDATECOALESCINGSTATISTICS_H
+
+#include <QtGlobal>
+
+/**
+ * Statistics of the grid-aligned coalescing of the update rects.
+ * It is collected only when the coalescing is enabled, that is,
+ * when KisImageConfig::updateCoalescingGridSize() is not zero.
+ *
+ * \see KisSimpleUpdateQueue, KisUpdateScheduler::updateCoalescingStatistics()
+ */
+struct KisUpdateCoalescingStatistics {
+    /**
+     * The area of the pixels requested by the callers. The pixels
+     * already covered by the queued walkers are not counted twice.
+     */
+    qint64 requestedArea = 0;
+
+    /**
+     * The area of the rects of the walkers created by the queue
+     */
+    qint64 processedArea = 0;
+
+    int numRequestedRects = 0;
+    int numMergedWalkers = 0;
+    int numWalkers = 0;
+
+    /**
+     * The area of the pixels that are recomposited only because
+     * their rects were coalesced with the requested ones
+     */
+    qint64 wastedArea() const {
+        return processedArea - requestedArea;
+    }
+};
+
+#endif // KISUPDATECOALESCINGSTATISTICS_H
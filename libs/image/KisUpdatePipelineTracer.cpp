@@ -0,0 +1,460 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisUpdatePipelineTracer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGlobalStatic>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVarLengthArray>
+
+#include "kis_debug.h"
+#include "kis_image_config.h"
+
+Q_GLOBAL_STATIC(KisUpdatePipelineTracer, s_instance)
+
+namespace {
+
+/**
+ * An event takes 40 bytes and an argument 32 bytes, so the trace
+ * takes about 100 MiB at most, which is enough for a few minutes
+ * of painting. The events added after that are dropped.
+ */
+const int maxNumEvents = 1 << 20;
+const int maxTotalNumArgs = 2 << 20;
+
+struct CompactEvent
+{
+    const char *category;
+    qint64 start;
+    qint64 duration;
+    int nameId;
+    int threadId;
+    int firstArg;
+    quint8 numArgs;
+    char phase;
+};
+
+}
+
+struct Q_DECL_HIDDEN KisUpdatePipelineTracer::Private
+{
+    QElapsedTimer timer;
+    QString traceFileName;
+
+    mutable QMutex mutex;
+    QVector<CompactEvent> events;
+    QVector<Arg> args;
+    int numDroppedEvents = 0;
+
+    /**
+     * The names of the nodes and jobs repeat a lot, so they are
+     * stored only once. The tables are not cleared by clear(),
+     * because the ids may still be held by the active scopes.
+     */
+    QVector<QString> strings;
+    QHash<QString, int> stringIds;
+    QVector<QStringList> stringLists;
+    QHash<QStringList, int> stringListIds;
+
+    QHash<Qt::HANDLE, int> threadIds;
+    QVector<QString> threadNames;
+
+    int currentThreadId();
+    QVariantMap decodeArgs(const CompactEvent &event) const;
+};
+
+int KisUpdatePipelineTracer::Private::currentThreadId()
+{
+    const Qt::HANDLE handle = QThread::currentThreadId();
+
+    auto it = threadIds.find(handle);
+    if (it != threadIds.end()) {
+        return *it;
+    }
+
+    /**
+     * Chrome trace wants small integer ids of the threads, so we
+     * enumerate them in the order they appear in the trace
+     */
+    const int id = threadNames.size() + 1;
+    threadIds.insert(handle, id);
+
+    QThread *thread = QThread::currentThread();
+    QString name = thread ? thread->objectName() : QString();
+
+    if (name.isEmpty()) {
+        name = thread && qApp && thread == qApp->thread() ?
+            QString("Main Thread") : QString("Thread %1").arg(id);
+    }
+
+    threadNames.append(name);
+
+    return id;
+}
+
+QVariantMap KisUpdatePipelineTracer::Private::decodeArgs(const CompactEvent &event) const
+{
+    QVariantMap result;
+
+    for (int i = event.firstArg; i < event.firstArg + event.numArgs; i++) {
+        const Arg &arg = args[i];
+        QVariant value;
+
+        switch (arg.type) {
+        case Arg::Integer:
+            value = arg.integer;
+            break;
+        case Arg::Boolean:
+            value = bool(arg.integer);
+            break;
+        case Arg::String:
+            value = strings.value(arg.stringId);
+            break;
+        case Arg::StringList:
+            value = stringLists.value(arg.stringId);
+            break;
+        case Arg::Rect:
+            value = rectArg(QRect(arg.rect[0], arg.rect[1], arg.rect[2], arg.rect[3]));
+            break;
+        }
+
+        result.insert(QString::fromLatin1(arg.key), value);
+    }
+
+    return result;
+}
+
+KisUpdatePipelineTracer::KisUpdatePipelineTracer()
+    : m_d(new Private),
+      m_enabled(false)
+{
+    m_d->timer.start();
+    m_d->traceFileName = KisImageConfig(true).updatePipelineTraceFile();
+
+    if (!m_d->traceFileName.isEmpty()) {
+        m_enabled = true;
+    }
+}
+
+KisUpdatePipelineTracer::~KisUpdatePipelineTracer()
+{
+    if (!m_d->traceFileName.isEmpty() && !m_d->events.isEmpty()) {
+        saveChromeTrace(m_d->traceFileName);
+    }
+
+    delete m_d;
+}
+
+KisUpdatePipelineTracer* KisUpdatePipelineTracer::instance()
+{
+    return s_instance;
+}
+
+void KisUpdatePipelineTracer::setEnabled(bool value)
+{
+    m_enabled = value;
+}
+
+qint64 KisUpdatePipelineTracer::currentTime() const
+{
+    return m_d->timer.nsecsElapsed() / 1000;
+}
+
+int KisUpdatePipelineTracer::internString(const QString &string)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    auto it = m_d->stringIds.find(string);
+    if (it != m_d->stringIds.end()) {
+        return *it;
+    }
+
+    const int id = m_d->strings.size();
+    m_d->strings.append(string);
+    m_d->stringIds.insert(string, id);
+
+    return id;
+}
+
+int KisUpdatePipelineTracer::internStringList(const QStringList &list)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    auto it = m_d->stringListIds.find(list);
+    if (it != m_d->stringListIds.end()) {
+        return *it;
+    }
+
+    const int id = m_d->stringLists.size();
+    m_d->stringLists.append(list);
+    m_d->stringListIds.insert(list, id);
+
+    return id;
+}
+
+void KisUpdatePipelineTracer::addEvent(char phase, const char *category, int nameId,
+                                       qint64 start, qint64 duration,
+                                       const Arg *args, int numArgs)
+{
+    KIS_SAFE_ASSERT_RECOVER(numArgs <= 255) { numArgs = 255; }
+
+    QMutexLocker l(&m_d->mutex);
+
+    if (m_d->events.size() >= maxNumEvents ||
+        m_d->args.size() + numArgs > maxTotalNumArgs) {
+
+        m_d->numDroppedEvents++;
+        return;
+    }
+
+    CompactEvent event;
+    event.phase = phase;
+    event.category = category;
+    event.nameId = nameId;
+    event.start = start;
+    event.duration = duration;
+    event.threadId = m_d->currentThreadId();
+    event.firstArg = m_d->args.size();
+    event.numArgs = quint8(numArgs);
+
+    for (int i = 0; i < numArgs; i++) {
+        m_d->args.append(args[i]);
+    }
+
+    m_d->events.append(event);
+}
+
+void KisUpdatePipelineTracer::addCounter(const char *category, const QString &name,
+                                         std::initializer_list<std::pair<const char*, qint64>> values)
+{
+    QVarLengthArray<Arg, 4> args;
+
+    for (const auto &value : values) {
+        Arg arg;
+        arg.key = value.first;
+        arg.type = Arg::Integer;
+        arg.integer = value.second;
+        args.append(arg);
+    }
+
+    addEvent('C', category, internString(name), currentTime(), 0,
+             args.constData(), args.size());
+}
+
+QVector<KisUpdatePipelineTracer::Event> KisUpdatePipelineTracer::events() const
+{
+    QMutexLocker l(&m_d->mutex);
+
+    QVector<Event> result;
+    result.reserve(m_d->events.size());
+
+    Q_FOREACH (const CompactEvent &compactEvent, m_d->events) {
+        Event event;
+        event.phase = compactEvent.phase;
+        event.category = compactEvent.category;
+        event.name = m_d->strings.value(compactEvent.nameId);
+        event.start = compactEvent.start;
+        event.duration = compactEvent.duration;
+        event.threadId = compactEvent.threadId;
+        event.args = m_d->decodeArgs(compactEvent);
+
+        result.append(event);
+    }
+
+    return result;
+}
+
+void KisUpdatePipelineTracer::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->events.clear();
+    m_d->args.clear();
+    m_d->numDroppedEvents = 0;
+}
+
+QByteArray KisUpdatePipelineTracer::exportChromeTrace() const
+{
+    QMutexLocker l(&m_d->mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEvents;
+
+    for (int i = 0; i < m_d->threadNames.size(); i++) {
+        QJsonObject metadata;
+        metadata["name"] = "thread_name";
+        metadata["ph"] = "M";
+        metadata["pid"] = pid;
+        metadata["tid"] = i + 1;
+        metadata["args"] = QJsonObject({{"name", m_d->threadNames[i]}});
+        traceEvents.append(metadata);
+    }
+
+    Q_FOREACH (const CompactEvent &event, m_d->events) {
+        QJsonObject object;
+        object["name"] = m_d->strings.value(event.nameId);
+        object["cat"] = QString::fromLatin1(event.category);
+        object["ph"] = QString(QChar(event.phase));
+        object["ts"] = event.start;
+
+        if (event.phase == 'X') {
+            object["dur"] = event.duration;
+        }
+
+        object["pid"] = pid;
+        object["tid"] = event.threadId;
+
+        if (event.numArgs) {
+            object["args"] = QJsonObject::fromVariantMap(m_d->decodeArgs(event));
+        }
+
+        traceEvents.append(object);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"] = QJsonObject({{"droppedEvents", m_d->numDroppedEvents}});
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool KisUpdatePipelineTracer::saveChromeTrace(const QString &fileName) const
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        warnImage << "Failed to open the update pipeline trace file" << fileName;
+        return false;
+    }
+
+    return file.write(exportChromeTrace()) >= 0;
+}
+
+QVariant KisUpdatePipelineTracer::rectArg(const QRect &rect)
+{
+    return QVariantList({rect.x(), rect.y(), rect.width(), rect.height()});
+}
+
+
+KisUpdatePipelineTraceScope::KisUpdatePipelineTraceScope(const char *category)
+{
+    // the tracer may have already been destroyed on exit
+    KisUpdatePipelineTracer *tracer = KisUpdatePipelineTracer::instance();
+    m_isActive = tracer && tracer->isEnabled();
+
+    if (m_isActive) {
+        m_category = category;
+        m_start = tracer->currentTime();
+    }
+}
+
+KisUpdatePipelineTraceScope::~KisUpdatePipelineTraceScope()
+{
+    KisUpdatePipelineTracer *tracer = activeTracer();
+
+    if (tracer) {
+        tracer->addEvent('X', m_category, m_nameId,
+                         m_start, tracer->currentTime() - m_start,
+                         m_args, m_numArgs);
+    }
+}
+
+KisUpdatePipelineTracer* KisUpdatePipelineTraceScope::activeTracer() const
+{
+    /**
+     * The scope may still be active in a worker thread when the
+     * tracer is destroyed on exit, then the event is just dropped
+     */
+    return m_isActive ? KisUpdatePipelineTracer::instance() : nullptr;
+}
+
+void KisUpdatePipelineTraceScope::setName(const QString &name)
+{
+    KisUpdatePipelineTracer *tracer = activeTracer();
+    if (!tracer) return;
+
+    m_nameId = tracer->internString(name);
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, int value)
+{
+    addArg(key, qint64(value));
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, qint64 value)
+{
+    KisUpdatePipelineTracer::Arg arg;
+    arg.key = key;
+    arg.type = KisUpdatePipelineTracer::Arg::Integer;
+    arg.integer = value;
+    appendArg(arg);
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, bool value)
+{
+    KisUpdatePipelineTracer::Arg arg;
+    arg.key = key;
+    arg.type = KisUpdatePipelineTracer::Arg::Boolean;
+    arg.integer = value;
+    appendArg(arg);
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, const char *value)
+{
+    addArg(key, QString::fromLatin1(value));
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, const QString &value)
+{
+    KisUpdatePipelineTracer *tracer = activeTracer();
+    if (!tracer) return;
+
+    KisUpdatePipelineTracer::Arg arg;
+    arg.key = key;
+    arg.type = KisUpdatePipelineTracer::Arg::String;
+    arg.stringId = tracer->internString(value);
+    appendArg(arg);
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, const QStringList &value)
+{
+    KisUpdatePipelineTracer *tracer = activeTracer();
+    if (!tracer) return;
+
+    KisUpdatePipelineTracer::Arg arg;
+    arg.key = key;
+    arg.type = KisUpdatePipelineTracer::Arg::StringList;
+    arg.stringId = tracer->internStringList(value);
+    appendArg(arg);
+}
+
+void KisUpdatePipelineTraceScope::addArg(const char *key, const QRect &value)
+{
+    KisUpdatePipelineTracer::Arg arg;
+    arg.key = key;
+    arg.type = KisUpdatePipelineTracer::Arg::Rect;
+    arg.rect[0] = value.x();
+    arg.rect[1] = value.y();
+    arg.rect[2] = value.width();
+    arg.rect[3] = value.height();
+    appendArg(arg);
+}
+
+void KisUpdatePipelineTraceScope::appendArg(const KisUpdatePipelineTracer::Arg &arg)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_numArgs < maxNumArgs);
+    m_args[m_numArgs++] = arg;
+}
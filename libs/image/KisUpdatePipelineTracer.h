@@ -0,0 +1,206 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISUPDATEPIPELINETRACER_H
+#define KISUPDATEPIPELINETRACER_H
+
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+
+#include <QByteArray>
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+#include "kritaimage_export.h"
+
+/**
+ * An opt-in tracer of the update pipeline of the image.
+ *
+ * KisUpdateTimeMonitor gives only the aggregate numbers of a stroke,
+ * which is not enough to find out which layer (or layer style, or
+ * filter mask) makes the canvas lag. The tracer records every stroke
+ * job, merge walker, spontaneous job, every node composited by the
+ * walkers, the LoD syncing and the uploading of the canvas textures,
+ * with its thread and start/end times.
+ *
+ * The events can be exported in Chrome trace format, which can be
+ * loaded into chrome://tracing or https://ui.perfetto.dev.
+ *
+ * The tracing is enabled by setting the "updatePipelineTraceFile"
+ * option of kritarc (see KisImageConfig::updatePipelineTraceFile()).
+ * The trace is written into this file on exit. It can also be
+ * enabled and saved at any moment with setEnabled() and
+ * saveChromeTrace().
+ *
+ * When the tracing is disabled, the cost of a trace point is a
+ * single relaxed atomic load.
+ */
+class KRITAIMAGE_EXPORT KisUpdatePipelineTracer
+{
+public:
+    /**
+     * An argument of a recorded event. The events are stored in
+     * a compact form, the strings of the arguments are interned in
+     * the string table of the tracer and the keys should be string
+     * literals. The JSON objects are built only on export.
+     */
+    struct Arg {
+        enum Type : quint8 {
+            Integer,
+            Boolean,
+            String,
+            StringList,
+            Rect
+        };
+
+        const char *key = nullptr;
+        Type type = Integer;
+
+        union {
+            qint64 integer = 0;
+            int stringId;
+            int rect[4];
+        };
+    };
+
+    /**
+     * An event in the decoded form, as returned by events()
+     */
+    struct Event {
+        /**
+         * 'X' for a complete event with a duration,
+         * 'C' for a counter whose values are in args
+         */
+        char phase = 'X';
+        const char *category = nullptr;
+        QString name;
+        qint64 start = 0;
+        qint64 duration = 0;
+        int threadId = 0;
+        QVariantMap args;
+    };
+
+public:
+    KisUpdatePipelineTracer();
+    ~KisUpdatePipelineTracer();
+
+    static KisUpdatePipelineTracer* instance();
+
+    inline bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value);
+
+    /**
+     * Time in microseconds since the creation of the tracer
+     */
+    qint64 currentTime() const;
+
+    /**
+     * Returns the id of \p string in the string table of the tracer
+     */
+    int internString(const QString &string);
+    int internStringList(const QStringList &list);
+
+    /**
+     * Adds the event to the trace. The thread of the event is
+     * the current thread.
+     */
+    void addEvent(char phase, const char *category, int nameId,
+                  qint64 start, qint64 duration,
+                  const Arg *args, int numArgs);
+
+    /**
+     * Adds a counter event with the current time. Every value of
+     * \p values is shown as a separate series of the counter.
+     */
+    void addCounter(const char *category, const QString &name,
+                    std::initializer_list<std::pair<const char*, qint64>> values);
+
+    /**
+     * Decodes the recorded events in the order they were added
+     */
+    QVector<Event> events() const;
+
+    /**
+     * Drops all the recorded events
+     */
+    void clear();
+
+    QByteArray exportChromeTrace() const;
+    bool saveChromeTrace(const QString &fileName) const;
+
+    /**
+     * Converts the rect into the value of a decoded argument
+     */
+    static QVariant rectArg(const QRect &rect);
+
+private:
+    struct Private;
+    Private * const m_d;
+
+    std::atomic<bool> m_enabled;
+};
+
+/**
+ * A scoped trace event: the event starts in the constructor and
+ * ends in the destructor.
+ *
+ * The name and the arguments of the event should be set only when
+ * the scope is active, so that no strings are built when the tracing
+ * is disabled:
+ *
+ * \code{.cpp}
+ * KisUpdatePipelineTraceScope scope("merge");
+ * if (scope.isActive()) {
+ *     scope.setName(node->name());
+ *     scope.addArg("rect", rect);
+ * }
+ * \endcode
+ */
+class KRITAIMAGE_EXPORT KisUpdatePipelineTraceScope
+{
+public:
+    KisUpdatePipelineTraceScope(const char *category);
+    ~KisUpdatePipelineTraceScope();
+
+    inline bool isActive() const {
+        return m_isActive;
+    }
+
+    void setName(const QString &name);
+
+    void addArg(const char *key, int value);
+    void addArg(const char *key, qint64 value);
+    void addArg(const char *key, bool value);
+    void addArg(const char *key, const char *value);
+    void addArg(const char *key, const QString &value);
+    void addArg(const char *key, const QStringList &value);
+    void addArg(const char *key, const QRect &value);
+
+private:
+    KisUpdatePipelineTracer* activeTracer() const;
+    void appendArg(const KisUpdatePipelineTracer::Arg &arg);
+
+private:
+    Q_DISABLE_COPY(KisUpdatePipelineTraceScope)
+
+    static const int maxNumArgs = 4;
+
+    bool m_isActive;
+    const char *m_category = nullptr;
+    int m_nameId = -1;
+    qint64 m_start = 0;
+    KisUpdatePipelineTracer::Arg m_args[maxNumArgs];
+    int m_numArgs = 0;
+};
+
+#endif // KISUPDATEPIPELINETRACER_H
@@ -0,0 +1,213 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisWorkStealingTaskPool.h"
+
+#include <QMutexLocker>
+#include <QThreadPool>
+
+#include "kis_assert.h"
+
+namespace {
+
+/**
+ * The bands are aligned to the tile grid, so that two bands
+ * never write into the same tile
+ */
+const int tileHeight = 64;
+
+/**
+ * The bands smaller than that are not worth waking up a thread
+ */
+const int minBandArea = 64 * 256;
+
+inline int divideFloor(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+}
+
+struct KisWorkStealingTaskPool::TaskGroup
+{
+    const BandFunction *func = nullptr;
+    QVector<QRect> bands;
+
+    /**
+     * The deque of the bands that are not started yet: the owner
+     * takes them from the tail, the thieves from the head
+     */
+    int head = 0;
+    int tail = 0;
+
+    int unfinished = 0;
+};
+
+class KisWorkStealingTaskPool::StealingRunnable : public QRunnable
+{
+public:
+    StealingRunnable(KisWorkStealingTaskPool *pool)
+        : m_pool(pool)
+    {
+        /**
+         * The same runnable is started in all the idle threads
+         */
+        setAutoDelete(false);
+    }
+
+    void run() override {
+        while (m_pool->stealOneTask());
+    }
+
+private:
+    KisWorkStealingTaskPool *m_pool;
+};
+
+
+KisWorkStealingTaskPool::KisWorkStealingTaskPool(QThreadPool *threadPool)
+    : m_threadPool(threadPool),
+      m_stealingRunnable(new StealingRunnable(this))
+{
+}
+
+KisWorkStealingTaskPool::~KisWorkStealingTaskPool()
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_groups.isEmpty());
+    delete m_stealingRunnable;
+}
+
+void KisWorkStealingTaskPool::setTestingMode(bool value)
+{
+    m_testingMode = value;
+}
+
+QVector<QRect> KisWorkStealingTaskPool::splitIntoBands(const QRect &rect, int maxBands)
+{
+    if (rect.isEmpty()) return {};
+
+    const int firstRow = divideFloor(rect.top(), tileHeight);
+    const int lastRow = divideFloor(rect.bottom(), tileHeight);
+    const int numRows = lastRow - firstRow + 1;
+
+    const qint64 area = qint64(rect.width()) * rect.height();
+    const int numBands = int(qMin<qint64>(qMin(maxBands, numRows), area / minBandArea));
+
+    if (numBands <= 1) return {rect};
+
+    const int rowsPerBand = (numRows + numBands - 1) / numBands;
+
+    QVector<QRect> bands;
+    bands.reserve(numBands);
+
+    for (int row = firstRow; row <= lastRow; row += rowsPerBand) {
+        const QRect maxBandRect(rect.x(), row * tileHeight,
+                                rect.width(), rowsPerBand * tileHeight);
+        bands.append(rect & maxBandRect);
+    }
+
+    return bands;
+}
+
+void KisWorkStealingTaskPool::runBandTasks(const QRect &rect, const BandFunction &func)
+{
+    const QVector<QRect> bands = splitIntoBands(rect, 2 * m_threadPool->maxThreadCount());
+
+    if (bands.size() <= 1) {
+        if (!rect.isEmpty()) {
+            func(rect);
+        }
+        return;
+    }
+
+    TaskGroup group;
+    group.func = &func;
+    group.bands = bands;
+    group.tail = bands.size();
+    group.unfinished = bands.size();
+
+    {
+        QMutexLocker l(&m_mutex);
+        m_groups.append(&group);
+    }
+
+    /**
+     * Wake up as many idle threads as there are bands we can share.
+     * If the thread pool is busy, the owner just processes all the
+     * bands itself.
+     */
+    if (!m_testingMode) {
+        for (int i = 1; i < bands.size(); i++) {
+            if (!m_threadPool->tryStart(m_stealingRunnable)) break;
+        }
+    }
+
+    int numProcessed = 0;
+
+    while (1) {
+        QRect band;
+
+        {
+            QMutexLocker l(&m_mutex);
+
+            if (group.head >= group.tail) {
+                m_groups.removeOne(&group);
+                break;
+            }
+
+            band = group.bands[--group.tail];
+        }
+
+        func(band);
+        numProcessed++;
+    }
+
+    /**
+     * Wait for the bands that were stolen by other threads
+     */
+    QMutexLocker l(&m_mutex);
+    group.unfinished -= numProcessed;
+
+    while (group.unfinished > 0) {
+        m_groupFinished.wait(&m_mutex);
+    }
+}
+
+bool KisWorkStealingTaskPool::stealOneTask()
+{
+    TaskGroup *group = nullptr;
+    QRect band;
+
+    {
+        QMutexLocker l(&m_mutex);
+
+        const int numGroups = m_groups.size();
+
+        for (int i = 0; i < numGroups; i++) {
+            const int index = (m_nextVictim + i) % numGroups;
+            TaskGroup *candidate = m_groups[index];
+
+            if (candidate->head < candidate->tail) {
+                group = candidate;
+                band = candidate->bands[candidate->head++];
+
+                // spread the thieves over the groups
+                m_nextVictim = (index + 1) % numGroups;
+                break;
+            }
+        }
+
+        if (!group) return false;
+    }
+
+    (*group->func)(band);
+
+    QMutexLocker l(&m_mutex);
+    if (--group->unfinished == 0) {
+        m_groupFinished.wakeAll();
+    }
+
+    return true;
+}
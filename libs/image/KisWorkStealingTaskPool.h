@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISWORKSTEALINGTASKPOOL_H
+#define KISWORKSTEALINGTASKPOOL_H
+
+#include <functional>
+
+#include <QMutex>
+#include <QRect>
+#include <QRunnable>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "kritaimage_export.h"
+
+class QThreadPool;
+
+/**
+ * Splits the work of a single update job into tile-aligned bands
+ * that can be stolen by the idle threads of the updater context.
+ *
+ * KisUpdaterContext places a whole walker into a single job slot,
+ * which is needed to track the dependencies between the walkers.
+ * But when the walker is big (or the layer stack is deep), the
+ * merge occupies one thread only, while the other threads of the
+ * context sit idle. The pool lets the merger fork the pointwise
+ * steps of the merge (compositing of a layer into the projection
+ * and writing of the projection) into bands.
+ *
+ * Every fork gets its own deque of bands. The owner thread takes the
+ * bands from the back of the deque, while the helper threads, which
+ * are started in the idle threads of the context's thread pool, steal
+ * them from the front. The owner returns only when all the bands of
+ * its fork are processed, so the rects seen by the walker dependency
+ * tracking of the context stay valid.
+ *
+ * The bands are coarse (a few tiles each), so a single lock
+ * is enough to guard the deques.
+ */
+class KRITAIMAGE_EXPORT KisWorkStealingTaskPool
+{
+public:
+    using BandFunction = std::function<void(const QRect&)>;
+
+public:
+    KisWorkStealingTaskPool(QThreadPool *threadPool);
+    ~KisWorkStealingTaskPool();
+
+    /**
+     * Processes \p rect with \p func. If the rect is big enough,
+     * it is split into bands, which are processed by the calling
+     * thread and the idle threads of the thread pool. Returns when
+     * the whole rect is processed.
+     *
+     * \p func should only access the pixels inside the passed band
+     * for writing, that is, should be pointwise.
+     */
+    void runBandTasks(const QRect &rect, const BandFunction &func);
+
+    /**
+     * Splits \p rect into not more than \p maxBands horizontal
+     * bands aligned to the tile grid
+     */
+    static QVector<QRect> splitIntoBands(const QRect &rect, int maxBands);
+
+    /**
+     * In testing mode no helper threads are started and all the
+     * bands are processed by the calling thread
+     */
+    void setTestingMode(bool value);
+
+private:
+    struct TaskGroup;
+    class StealingRunnable;
+
+    bool stealOneTask();
+
+private:
+    QThreadPool *m_threadPool;
+    QRunnable *m_stealingRunnable;
+
+    QMutex m_mutex;
+    QWaitCondition m_groupFinished;
+    QVector<TaskGroup*> m_groups;
+    int m_nextVictim = 0;
+
+    bool m_testingMode = false;
+};
+
+#endif // KISWORKSTEALINGTASKPOOL_H
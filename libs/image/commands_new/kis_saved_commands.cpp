@@ -102,6 +102,11 @@ bool KisSavedCommand::canAnnihilateWith(const KUndo2Command *command) const
     return m_command->canAnnihilateWith(command);
 }
 
+qint64 KisSavedCommand::memoryUsage() const
+{
+    return m_command->memoryUsage();
+}
+
 void KisSavedCommand::addCommands(KisStrokeId id, bool undo)
 {
     strokesFacade()->
@@ -300,6 +305,17 @@ bool KisSavedMacroCommand::canAnnihilateWith(const KUndo2Command* command) const
     return true;
 }
 
+qint64 KisSavedMacroCommand::memoryUsage() const
+{
+    qint64 size = 0;
+
+    Q_FOREACH (const Private::SavedCommand &cmd, m_d->commands) {
+        size += cmd.command->memoryUsage();
+    }
+
+    return size;
+}
+
 void KisSavedMacroCommand::addCommand(KUndo2CommandSP command,
                                       KisStrokeJobData::Sequentiality sequentiality,
                                       KisStrokeJobData::Exclusivity exclusivity)
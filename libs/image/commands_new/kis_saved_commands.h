@@ -46,6 +46,7 @@ public:
     int id() const override;
     bool mergeWith(const KUndo2Command* command) override;
     bool canAnnihilateWith(const KUndo2Command *command) const override;
+    qint64 memoryUsage() const override;
 
     bool timedMergeWith(KUndo2Command *other) override;
     QVector<KUndo2Command*> mergeCommandsVector() override;
@@ -71,6 +72,7 @@ public:
     int id() const override;
     bool mergeWith(const KUndo2Command* command) override;
     bool canAnnihilateWith(const KUndo2Command *command) const override;
+    qint64 memoryUsage() const override;
 
     void setMacroId(int value);
 
@@ -33,6 +33,8 @@
 #include "kis_refresh_subtree_walker.h"
 
 #include "kis_abstract_projection_plane.h"
+#include "KisWorkStealingTaskPool.h"
+#include "KisUpdatePipelineTracer.h"
 
 
 //#define DEBUG_MERGER
@@ -208,6 +210,23 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
     const bool useTempProjections = walker.needRectVaries();
 
+    /**
+     * Start loading the swapped-out tiles of all the layers in
+     * background, so that we would not stall on them one by one
+     * while merging the stack. The stack is processed from
+     * its top, so queue the tiles in the same order.
+     */
+    for (auto it = leafStack.crbegin(); it != leafStack.crend(); ++it) {
+        const KisMergeWalker::JobItem &item = *it;
+
+        if (item.m_leaf && item.m_leaf->isLayer() && !item.m_leaf->isRoot()) {
+            KisPaintDeviceSP device = item.m_leaf->projection();
+            if (device) {
+                device->prefetchSwappedTiles(item.m_applyRect);
+            }
+        }
+    }
+
     while(!leafStack.isEmpty()) {
         KisMergeWalker::JobItem item = leafStack.pop();
         KisProjectionLeafSP currentLeaf = item.m_leaf;
@@ -225,6 +244,15 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
         QRect applyRect = item.m_applyRect;
 
+        KisUpdatePipelineTraceScope traceScope("node");
+
+        if (traceScope.isActive()) {
+            traceScope.setName(currentLeaf->node()->name());
+            traceScope.addArg("type", currentLeaf->node()->metaObject()->className());
+            traceScope.addArg("rect", applyRect);
+            traceScope.addArg("position", int(item.m_position));
+        }
+
         if (currentLeaf->isRoot()) {
             currentLeaf->projectionPlane()->recalculate(applyRect, walker.startNode());
             continue;
@@ -246,6 +274,14 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
         if (!m_currentProjection) {
             setupProjection(currentLeaf, applyRect, useTempProjections);
+
+            if (m_currentProjection) {
+                setupGroupCache(walker, currentLeaf, item.m_position, applyRect);
+
+                if (tryUseCachedBelowNodes(walker)) {
+                    continue;
+                }
+            }
         }
 
         KisUpdateOriginalVisitor originalVisitor(applyRect,
@@ -281,6 +317,11 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 
         compositeWithProjection(currentLeaf, applyRect);
 
+        if (m_groupCache && updateGroupCache(walker, currentLeaf, useTempProjections)) {
+            // the nodes above were taken from the cache
+            continue;
+        }
+
         if(item.m_position & KisMergeWalker::N_TOPMOST) {
             writeProjection(currentLeaf, useTempProjections, applyRect);
             resetProjection();
@@ -308,6 +349,224 @@ void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
 void KisAsyncMerger::resetProjection() {
     m_currentProjection = 0;
     m_finalProjection = 0;
+
+    m_groupCache.clear();
+    m_cachedComposites = KisGroupProjectionCache::Composites();
+    m_splitLeaf.clear();
+    m_numBelowLeft = 0;
+    m_numAboveLeft = 0;
+}
+
+/**
+ * The nodes above the updated one can be composited in advance
+ * only if the result of their composition doesn't depend on the
+ * nodes below them, that is, when they are all composited with
+ * COMPOSITE_OVER, which is associative.
+ */
+static bool canCompositeInAdvance(KisProjectionLeafSP leaf) {
+    if (!leaf->visible()) return true;
+    if (leaf->dependsOnLowerNodes()) return false;
+    if (!leaf->channelFlags().isEmpty()) return false;
+
+    KisLayer *layer = qobject_cast<KisLayer*>(leaf->node().data());
+
+    // layer styles composite their effects with their own blending modes
+    return layer &&
+        !layer->layerStyle() &&
+        layer->compositeOpId() == COMPOSITE_OVER;
+}
+
+void KisAsyncMerger::setupGroupCache(KisBaseRectsWalker &walker, KisProjectionLeafSP firstLeaf,
+                                     qint32 firstPosition, const QRect &firstRect) {
+    // the cache keeps level of detail 0 only
+    if (walker.levelOfDetail() > 0) return;
+
+    KisProjectionLeafSP parentLeaf = firstLeaf->parent();
+    KisGroupLayer *group =
+        parentLeaf ? qobject_cast<KisGroupLayer*>(parentLeaf->node().data()) : 0;
+    if (!group) return;
+
+    KisGroupProjectionCacheSP cache = group->projectionCache();
+
+    /**
+     * Look ahead for the rest of the children of the group,
+     * the last one is marked as N_TOPMOST
+     */
+    const KisMergeWalker::LeafStack &leafStack = walker.leafStack();
+
+    KisMergeWalker::JobItem firstItem;
+    firstItem.m_leaf = firstLeaf;
+    firstItem.m_position = firstPosition;
+    firstItem.m_applyRect = firstRect;
+
+    QVector<KisMergeWalker::JobItem> children;
+    children << firstItem;
+
+    for (int i = leafStack.size() - 1;
+         i >= 0 && !(children.last().m_position & KisMergeWalker::N_TOPMOST);
+         i--) {
+
+        children << leafStack[i];
+    }
+
+    QRect groupRect;
+    int splitIndex = -1;
+    bool isRegular =
+        !walker.needRectVaries() &&
+        children.last().m_position & KisMergeWalker::N_TOPMOST;
+    bool aboveIsCacheable = true;
+
+    for (int i = 0; i < children.size(); i++) {
+        const KisMergeWalker::JobItem &child = children[i];
+        groupRect |= child.m_applyRect;
+
+        if (child.m_position & KisMergeWalker::N_EXTRA) {
+            isRegular = false;
+        } else if (child.m_position & (KisMergeWalker::N_FILTHY | KisMergeWalker::N_FILTHY_PROJECTION)) {
+            isRegular &= splitIndex < 0;
+            splitIndex = i;
+        } else if (child.m_position & KisMergeWalker::N_ABOVE_FILTHY) {
+            isRegular &= splitIndex >= 0;
+            aboveIsCacheable &= canCompositeInAdvance(child.m_leaf);
+        } else if (child.m_position & KisMergeWalker::N_BELOW_FILTHY) {
+            isRegular &= splitIndex < 0;
+        }
+    }
+
+    isRegular &= splitIndex >= 0;
+
+    /**
+     * The children of a pass-through group are composited with
+     * its opacity, so they change together with the group
+     */
+    if (isRegular) {
+        KisGroupLayer *splitGroup =
+            qobject_cast<KisGroupLayer*>(children[splitIndex].m_leaf->node().data());
+        isRegular = !splitGroup || !splitGroup->passThroughMode();
+    }
+
+    if (!isRegular) {
+        cache->invalidate(groupRect);
+        return;
+    }
+
+    const int numAbove = children.size() - splitIndex - 1;
+
+    KisGroupProjectionCache::Composites composites =
+        cache->fetchComposites(children[splitIndex].m_leaf->node(),
+                               groupRect, m_currentProjection,
+                               group->graphSequenceNumber(),
+                               aboveIsCacheable && numAbove > 0);
+
+    if (!composites.below && !composites.above) return;
+
+    m_groupCache = cache;
+    m_cachedComposites = composites;
+    m_splitLeaf = children[splitIndex].m_leaf;
+    m_cachedRect = groupRect;
+    m_numBelowLeft = splitIndex;
+    m_numAboveLeft = numAbove;
+}
+
+bool KisAsyncMerger::tryUseCachedBelowNodes(KisBaseRectsWalker &walker) {
+    if (!m_groupCache || !m_numBelowLeft) return false;
+    if (!m_cachedComposites.belowValid) return false;
+
+    KisPaintDeviceSP srcDevice = m_cachedComposites.below;
+    KisPaintDeviceSP dstDevice = m_currentProjection;
+
+    runInBands(m_cachedRect,
+        [srcDevice, dstDevice] (const QRect &band) {
+            KisPainter::copyAreaOptimized(band.topLeft(), srcDevice, dstDevice, band);
+        });
+
+    // the current node has already been popped from the stack
+    KisMergeWalker::LeafStack &leafStack = walker.leafStack();
+    for (int i = 1; i < m_numBelowLeft; i++) {
+        leafStack.pop();
+    }
+    m_numBelowLeft = 0;
+
+    DEBUG_NODE_ACTION("Fetching cached projection", "N_BELOW_FILTHY", m_splitLeaf, m_cachedRect);
+    return true;
+}
+
+bool KisAsyncMerger::updateGroupCache(KisBaseRectsWalker &walker, KisProjectionLeafSP leaf,
+                                      bool useTempProjection) {
+    KisGroupProjectionCache::Composites &composites = m_cachedComposites;
+
+    if (m_numBelowLeft > 0) {
+        m_numBelowLeft--;
+
+        if (!m_numBelowLeft && composites.below && !composites.belowValid) {
+            KisPaintDeviceSP srcDevice = m_currentProjection;
+            KisPaintDeviceSP dstDevice = composites.below;
+
+            runInBands(m_cachedRect,
+                [srcDevice, dstDevice] (const QRect &band) {
+                    KisPainter::copyAreaOptimized(band.topLeft(), srcDevice, dstDevice, band);
+                });
+
+            m_groupCache->markBelowValid(composites.generation, m_cachedRect);
+        }
+
+        return false;
+    }
+
+    if (!composites.above || !m_numAboveLeft) return false;
+
+    if (leaf == m_splitLeaf) {
+        if (!composites.aboveValid) {
+            composites.above->clear(m_cachedRect);
+            return false;
+        }
+
+        KisPaintDeviceSP srcDevice = composites.above;
+        KisPaintDeviceSP dstDevice = m_currentProjection;
+
+        runInBands(m_cachedRect,
+            [srcDevice, dstDevice] (const QRect &band) {
+                KisPainter gc(dstDevice);
+                gc.setCompositeOp(COMPOSITE_OVER);
+                gc.bitBlt(band.topLeft(), srcDevice, band);
+            });
+
+        DEBUG_NODE_ACTION("Compositing cached projection", "N_ABOVE_FILTHY", leaf, m_cachedRect);
+
+        KisMergeWalker::LeafStack &leafStack = walker.leafStack();
+        KisMergeWalker::JobItem topmostItem;
+
+        for (int i = 0; i < m_numAboveLeft; i++) {
+            topmostItem = leafStack.pop();
+        }
+
+        KIS_SAFE_ASSERT_RECOVER_NOOP(topmostItem.m_position & KisMergeWalker::N_TOPMOST);
+
+        writeProjection(topmostItem.m_leaf, useTempProjection, topmostItem.m_applyRect);
+        resetProjection();
+        return true;
+    }
+
+    m_numAboveLeft--;
+
+    if (!composites.aboveValid) {
+        if (leaf->visible()) {
+            KisPaintDeviceSP dstDevice = composites.above;
+            KisAbstractProjectionPlaneSP plane = leaf->projectionPlane();
+
+            runInBands(m_cachedRect,
+                [dstDevice, plane] (const QRect &band) {
+                    KisPainter gc(dstDevice);
+                    plane->apply(&gc, band);
+                });
+        }
+
+        if (!m_numAboveLeft) {
+            m_groupCache->markAboveValid(composites.generation, m_cachedRect);
+        }
+    }
+
+    return false;
 }
 
 void KisAsyncMerger::setupProjection(KisProjectionLeafSP currentLeaf, const QRect& rect, bool useTempProjection) {
@@ -344,7 +603,13 @@ void KisAsyncMerger::writeProjection(KisProjectionLeafSP topmostLeaf, bool useTe
     if (!m_currentProjection) return;
 
     if(m_currentProjection != m_finalProjection) {
-        KisPainter::copyAreaOptimized(rect.topLeft(), m_currentProjection, m_finalProjection, rect);
+        KisPaintDeviceSP srcDevice = m_currentProjection;
+        KisPaintDeviceSP dstDevice = m_finalProjection;
+
+        runInBands(rect,
+            [srcDevice, dstDevice] (const QRect &band) {
+                KisPainter::copyAreaOptimized(band.topLeft(), srcDevice, dstDevice, band);
+            });
     }
     DEBUG_NODE_ACTION("Writing projection", "", topmostLeaf->parent(), rect);
 }
@@ -354,13 +619,36 @@ bool KisAsyncMerger::compositeWithProjection(KisProjectionLeafSP leaf, const QRe
     if (!m_currentProjection) return true;
     if (!leaf->visible()) return true;
 
-    KisPainter gc(m_currentProjection);
-    leaf->projectionPlane()->apply(&gc, rect);
+    KisPaintDeviceSP dstDevice = m_currentProjection;
+    KisAbstractProjectionPlaneSP plane = leaf->projectionPlane();
+
+    /**
+     * Compositing is pointwise, so the bands of the rect can
+     * be applied in parallel, like the rects of two different
+     * walkers that do not intersect
+     */
+    runInBands(rect,
+        [dstDevice, plane] (const QRect &band) {
+            KisPainter gc(dstDevice);
+            plane->apply(&gc, band);
+        });
 
     DEBUG_NODE_ACTION("Compositing projection", "", leaf, rect);
     return true;
 }
 
+void KisAsyncMerger::runInBands(const QRect &rect, const std::function<void(const QRect&)> &func) {
+    if (m_taskPool) {
+        m_taskPool->runBandTasks(rect, func);
+    } else {
+        func(rect);
+    }
+}
+
+void KisAsyncMerger::setTaskPool(KisWorkStealingTaskPool *pool) {
+    m_taskPool = pool;
+}
+
 void KisAsyncMerger::doNotifyClones(KisBaseRectsWalker &walker) {
     KisBaseRectsWalker::CloneNotificationsVector &vector =
         walker.cloneNotifications();
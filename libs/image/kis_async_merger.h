@@ -6,23 +6,41 @@
 #ifndef __KIS_ASYNC_MERGER_H
 #define __KIS_ASYNC_MERGER_H
 
+#include <functional>
+
 #include "kritaimage_export.h"
 #include "kis_types.h"
+#include "KisGroupProjectionCache.h"
 
 class QRect;
 class KisBaseRectsWalker;
+class KisWorkStealingTaskPool;
 
 class KRITAIMAGE_EXPORT KisAsyncMerger
 {
 public:
     void startMerge(KisBaseRectsWalker &walker, bool notifyClones = true);
 
+    /**
+     * Lets the merger split compositing of the big rects into
+     * bands processed by the idle threads of the updater context.
+     * Without the pool the whole merge runs in the calling thread.
+     */
+    void setTaskPool(KisWorkStealingTaskPool *pool);
+
 private:
     inline void resetProjection();
     inline void setupProjection(KisProjectionLeafSP currentLeaf, const QRect& rect, bool useTempProjection);
     inline void writeProjection(KisProjectionLeafSP topmostLeaf, bool useTempProjection, const QRect &rect);
     inline bool compositeWithProjection(KisProjectionLeafSP leaf, const QRect &rect);
     inline void doNotifyClones(KisBaseRectsWalker &walker);
+    inline void runInBands(const QRect &rect, const std::function<void(const QRect&)> &func);
+
+    inline void setupGroupCache(KisBaseRectsWalker &walker, KisProjectionLeafSP firstLeaf,
+                                qint32 firstPosition, const QRect &firstRect);
+    inline bool tryUseCachedBelowNodes(KisBaseRectsWalker &walker);
+    inline bool updateGroupCache(KisBaseRectsWalker &walker, KisProjectionLeafSP leaf,
+                                 bool useTempProjection);
 
 private:
     /**
@@ -49,6 +67,22 @@ private:
      * setupProjection()
      */
     KisPaintDeviceSP m_cachedPaintDevice;
+
+    KisWorkStealingTaskPool *m_taskPool = nullptr;
+
+    /**
+     * The cache of the group whose children are being merged
+     * and the composites fetched from it. The cache is used when
+     * the walker updates one child of the group only, that is,
+     * the children are split into m_numBelowLeft children below
+     * m_splitLeaf and m_numAboveLeft children above it.
+     */
+    KisGroupProjectionCacheSP m_groupCache;
+    KisGroupProjectionCache::Composites m_cachedComposites;
+    KisProjectionLeafSP m_splitLeaf;
+    QRect m_cachedRect;
+    int m_numBelowLeft = 0;
+    int m_numAboveLeft = 0;
 };
 
 
@@ -155,6 +155,11 @@ public:
         return ACTUAL_DATAMGR::region();
     }
 
+    KisRegion changedTilesRegion(const TileRevisions &oldRevisions,
+                                 TileRevisions *revisions) const {
+        return ACTUAL_DATAMGR::changedTilesRegion(oldRevisions, revisions);
+    }
+
 public:
 
     /**
@@ -72,6 +72,11 @@ bool KisDefaultBounds::externalFrameActive() const
     return interface ? interface->externalFrameActive() : false;
 }
 
+qint32 KisDefaultBounds::memoryAccount() const
+{
+    return m_d->image ? m_d->image->memoryAccount() : 0;
+}
+
 void *KisDefaultBounds::sourceCookie() const
 {
     return m_d->image.data();
@@ -133,6 +138,12 @@ bool KisSelectionDefaultBounds::externalFrameActive() const
                 m_d->parentDevice->defaultBounds()->externalFrameActive() : false;
 }
 
+qint32 KisSelectionDefaultBounds::memoryAccount() const
+{
+    return m_d->parentDevice ?
+                m_d->parentDevice->defaultBounds()->memoryAccount() : 0;
+}
+
 void *KisSelectionDefaultBounds::sourceCookie() const
 {
     return m_d->parentDevice.data();
@@ -203,6 +214,11 @@ bool KisWrapAroundBoundsWrapper::externalFrameActive() const
     return m_d->base->externalFrameActive();
 }
 
+qint32 KisWrapAroundBoundsWrapper::memoryAccount() const
+{
+    return m_d->base->memoryAccount();
+}
+
 void *KisWrapAroundBoundsWrapper::sourceCookie() const
 {
     return m_d->base->sourceCookie();
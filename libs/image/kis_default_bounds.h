@@ -32,6 +32,7 @@ public:
     int currentLevelOfDetail() const override;
     int currentTime() const override;
     bool externalFrameActive() const override;
+    qint32 memoryAccount() const override;
     void * sourceCookie() const override;
 
 protected:
@@ -57,6 +58,7 @@ public:
     int currentLevelOfDetail() const override;
     int currentTime() const override;
     bool externalFrameActive() const override;
+    qint32 memoryAccount() const override;
     void * sourceCookie() const override;
 
 private:
@@ -90,6 +92,7 @@ public:
     int currentLevelOfDetail() const override;
     int currentTime() const override;
     bool externalFrameActive() const override;
+    qint32 memoryAccount() const override;
     void * sourceCookie() const override;
 
 protected:
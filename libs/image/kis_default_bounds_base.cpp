@@ -15,3 +15,8 @@ QRect KisDefaultBoundsBase::imageBorderRect() const
     return bounds();
 }
 
+qint32 KisDefaultBoundsBase::memoryAccount() const
+{
+    return 0;
+}
+
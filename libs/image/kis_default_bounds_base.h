@@ -54,6 +54,14 @@ public:
     virtual int currentTime() const = 0;
     virtual bool externalFrameActive() const = 0;
 
+    /**
+     * Returns the memory account of the document the paint
+     * device belongs to. 0 means the device belongs to no document.
+     *
+     * \see KisTileDataStore::createMemoryAccount()
+     */
+    virtual qint32 memoryAccount() const;
+
     /**
      * Return an abstract pointer to the source object,
      * where default bounds takes its data from. It the
@@ -62,6 +62,11 @@ bool KisDefaultBoundsNodeWrapper::externalFrameActive() const
     return m_d->node->original() ? m_d->node->original()->defaultBounds()->externalFrameActive() : false;
 }
 
+qint32 KisDefaultBoundsNodeWrapper::memoryAccount() const
+{
+    return m_d->node->original() ? m_d->node->original()->defaultBounds()->memoryAccount() : 0;
+}
+
 void *KisDefaultBoundsNodeWrapper::sourceCookie() const
 {
     return m_d->node->original() ? m_d->node->original()->defaultBounds()->sourceCookie() : nullptr;
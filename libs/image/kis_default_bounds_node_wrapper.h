@@ -25,6 +25,7 @@ public:
     int currentLevelOfDetail() const override;
     int currentTime() const override;
     bool externalFrameActive() const override;
+    qint32 memoryAccount() const override;
     void *sourceCookie() const override;
 
     static const QRect infiniteRect;
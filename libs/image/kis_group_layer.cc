@@ -25,6 +25,7 @@
 #include "kis_selection_mask.h"
 #include "kis_psd_layer_style.h"
 #include "kis_layer_properties_icons.h"
+#include "KisGroupProjectionCache.h"
 
 
 struct Q_DECL_HIDDEN KisGroupLayer::Private
@@ -35,6 +36,7 @@ public:
         , x(0)
         , y(0)
         , passThroughMode(false)
+        , projectionCache(new KisGroupProjectionCache())
     {
     }
 
@@ -42,6 +44,7 @@ public:
     qint32 x;
     qint32 y;
     bool passThroughMode;
+    KisGroupProjectionCacheSP projectionCache;
 };
 
 KisGroupLayer::KisGroupLayer(KisImageWSP image, const QString &name, quint8 opacity) :
@@ -205,6 +208,8 @@ void KisGroupLayer::resetCache(const KoColorSpace *colorSpace)
 
         m_d->paintDevice->clear();
     }
+
+    m_d->projectionCache->reset();
 }
 
 KisLayer* KisGroupLayer::onlyMeaningfulChild() const
@@ -297,6 +302,11 @@ KoColor KisGroupLayer::defaultProjectionColor() const
     return color;
 }
 
+KisGroupProjectionCacheSP KisGroupLayer::projectionCache() const
+{
+    return m_d->projectionCache;
+}
+
 bool KisGroupLayer::passThroughMode() const
 {
     return m_d->passThroughMode;
@@ -358,6 +368,7 @@ void KisGroupLayer::setX(qint32 x)
     if(m_d->paintDevice) {
         m_d->paintDevice->setX(x);
     }
+    m_d->projectionCache->reset();
 }
 
 void KisGroupLayer::setY(qint32 y)
@@ -366,6 +377,7 @@ void KisGroupLayer::setY(qint32 y)
     if(m_d->paintDevice) {
         m_d->paintDevice->setY(y);
     }
+    m_d->projectionCache->reset();
 }
 
 struct ExtentPolicy
@@ -90,6 +90,12 @@ public:
     bool passThroughMode() const;
     void setPassThroughMode(bool value);
 
+    /**
+     * Partial composites of the children of the group,
+     * see KisGroupProjectionCache
+     */
+    KisGroupProjectionCacheSP projectionCache() const;
+
     QRect extent() const override;
     QRect exactBounds() const override;
 
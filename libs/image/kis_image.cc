@@ -42,6 +42,7 @@
 #include "kis_transaction.h"
 #include "kis_meta_data_merge_strategy.h"
 #include "kis_memory_statistics_server.h"
+#include "tiles3/kis_tile_data_store.h"
 #include "kis_node.h"
 #include "kis_types.h"
 
@@ -130,6 +131,7 @@ public:
                     KisUndoStore *undo,
                     KisImageAnimationInterface *_animationInterface)
         : q(_q)
+        , memoryAccount(KisTileDataStore::instance()->createMemoryAccount())
         , lockedForReadOnly(false)
         , width(w)
         , height(h)
@@ -186,9 +188,16 @@ public:
          * and undo are still alive
          */
         rootLayer.clear();
+
+        /**
+         * The undo store may still keep some tiles, the account
+         * will not be reused until they are freed
+         */
+        KisTileDataStore::instance()->releaseMemoryAccount(memoryAccount);
     }
 
     KisImage *q;
+    qint32 memoryAccount;
 
     quint32 lockCount = 0;
     bool lockedForReadOnly;
@@ -238,6 +247,8 @@ public:
 
     bool tryCancelCurrentStrokeAsync();
 
+    void releasePersistentLodPlanes();
+
     void notifyProjectionUpdatedInPatches(const QRect &rc, QVector<KisRunnableStrokeJobData *> &jobs);
 
     void convertImageColorSpaceImpl(const KoColorSpace *dstColorSpace,
@@ -777,6 +788,14 @@ void KisImage::unblockUpdates()
 
 void KisImage::setSize(const QSize& size)
 {
+    /**
+     * After resizing most of the persistent LoD planes of the nodes
+     * would be regenerated anyway, so just free their memory
+     */
+    if (size != this->size()) {
+        m_d->releasePersistentLodPlanes();
+    }
+
     m_d->width = size.width();
     m_d->height = size.height();
 }
@@ -1770,6 +1789,16 @@ void KisImage::waitForDone()
     KisBusyWaitBroker::instance()->notifyWaitOnImageEnded(this);
 }
 
+KisUpdateCoalescingStatistics KisImage::updateCoalescingStatistics() const
+{
+    return m_d->scheduler.updateCoalescingStatistics();
+}
+
+void KisImage::resetUpdateCoalescingStatistics()
+{
+    m_d->scheduler.resetUpdateCoalescingStatistics();
+}
+
 KisStrokeId KisImage::startStroke(KisStrokeStrategy *strokeStrategy)
 {
     /**
@@ -1990,6 +2019,18 @@ bool KisImage::KisImagePrivate::tryCancelCurrentStrokeAsync()
     return scheduler.tryCancelCurrentStrokeAsync();
 }
 
+void KisImage::KisImagePrivate::releasePersistentLodPlanes()
+{
+    if (!rootLayer) return;
+
+    KisLayerUtils::recursiveApplyNodes(rootLayer,
+        [] (KisNodeSP node) {
+            Q_FOREACH (KisPaintDeviceSP device, node->getLodCapableDevices()) {
+                device->releasePersistentLodPlanes();
+            }
+        });
+}
+
 void KisImage::requestUndoDuringStroke()
 {
     emit sigUndoDuringStrokeRequested();
@@ -2437,6 +2478,18 @@ int KisImage::currentLevelOfDetail() const
     return m_d->scheduler.currentLevelOfDetail();
 }
 
+qint32 KisImage::memoryAccount() const
+{
+    return m_d->memoryAccount;
+}
+
+void KisImage::setBackgroundMemoryPriority(bool value)
+{
+    KisTileDataStore::instance()->setMemoryAccountPriority(
+        m_d->memoryAccount,
+        value ? KisTileDataStore::BackgroundAccount : KisTileDataStore::ForegroundAccount);
+}
+
 void KisImage::explicitRegenerateLevelOfDetail()
 {
     const KisLodPreferences pref = m_d->scheduler.lodPreferences();
@@ -2448,7 +2501,18 @@ void KisImage::explicitRegenerateLevelOfDetail()
 
 void KisImage::setLodPreferences(const KisLodPreferences &value)
 {
+    const KisLodPreferences oldValue = m_d->scheduler.lodPreferences();
     m_d->scheduler.setLodPreferences(value);
+
+    /**
+     * The persistent LoD planes of the nodes are not needed
+     * anymore when the LoD mode is disabled
+     */
+    if (oldValue.lodSupported() && oldValue.lodPreferred() &&
+        (!value.lodSupported() || !value.lodPreferred())) {
+
+        m_d->releasePersistentLodPlanes();
+    }
 }
 
 KisLodPreferences KisImage::lodPreferences() const
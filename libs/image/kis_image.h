@@ -41,6 +41,7 @@ class KisImageAnimationInterface;
 class KUndo2MagicString;
 class KisProofingConfiguration;
 class KisPaintDevice;
+struct KisUpdateCoalescingStatistics;
 
 namespace KisMetaData
 {
@@ -728,6 +729,22 @@ public:
      */
     bool allowMasksOnRootNode() const;
 
+    /**
+     * The memory account all the tiles of the image are charged
+     * to. It is used for per-document memory statistics and quotas.
+     *
+     * \see KisTileDataStore::createMemoryAccount()
+     */
+    qint32 memoryAccount() const;
+
+    /**
+     * Marks the image as the one the user doesn't work with right
+     * now (e.g. it isn't shown in the active view or is being
+     * rendered in background). The swapper evicts the tiles of such
+     * images first. The images are created with background priority.
+     */
+    void setBackgroundMemoryPriority(bool value);
+
 public Q_SLOTS:
 
     /**
@@ -985,6 +1002,12 @@ public Q_SLOTS:
      */
     void waitForDone();
 
+    /**
+     * \see KisUpdateScheduler::updateCoalescingStatistics()
+     */
+    KisUpdateCoalescingStatistics updateCoalescingStatistics() const;
+    void resetUpdateCoalescingStatistics();
+
     KisStrokeId startStroke(KisStrokeStrategy *strokeStrategy) override;
     void addJob(KisStrokeId id, KisStrokeJobData *data) override;
     void endStroke(KisStrokeId id) override;
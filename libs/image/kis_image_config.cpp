@@ -79,6 +79,16 @@ void KisImageConfig::setEnablePerfLog(bool value)
     m_config.writeEntry("enablePerfLog", value);
 }
 
+QString KisImageConfig::updatePipelineTraceFile() const
+{
+    return m_config.readEntry("updatePipelineTraceFile", QString());
+}
+
+void KisImageConfig::setUpdatePipelineTraceFile(const QString &value)
+{
+    m_config.writeEntry("updatePipelineTraceFile", value);
+}
+
 qreal KisImageConfig::transformMaskOffBoundsReadArea() const
 {
     return m_config.readEntry("transformMaskOffBoundsReadArea", 0.5);
@@ -123,6 +133,18 @@ qreal KisImageConfig::maxMergeCollectAlpha() const
     return m_config.readEntry("maxMergeCollectAlpha", 1.5);
 }
 
+int KisImageConfig::updateCoalescingGridSize() const
+{
+    /**
+     * The grid is aligned to the tiles of the paint devices, so its
+     * size should be a power of two. Zero disables the grid coalescing
+     * of the update rects.
+     */
+    int gridSize = m_config.readEntry("updateCoalescingGridSize", 64);
+    if (gridSize < 0 || (gridSize & (gridSize - 1))) return 64;
+    return gridSize;
+}
+
 qreal KisImageConfig::schedulerBalancingRatio() const
 {
     /**
@@ -167,12 +189,24 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+QString KisImageConfig::swapCompression(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("swapCompression", "LZF") : "LZF";
+}
+
+void KisImageConfig::setSwapCompression(const QString &value)
+{
+    m_config.writeEntry("swapCompression", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
     qreal pp = qreal(memoryPoolLimitPercent()) / 100.0;
+    qreal cp = qreal(memoryCompressedSwapPercent()) / 100.0;
 
-    return totalRAM() * hp * (1 - pp);
+    return totalRAM() * hp * qMax(0.0, 1 - pp - cp);
 }
 
 int KisImageConfig::tilesSoftLimit() const
@@ -223,6 +257,87 @@ void KisImageConfig::setMemoryPoolLimitPercent(qreal value)
     m_config.writeEntry("memoryPoolLimitPercent", value);
 }
 
+qreal KisImageConfig::memoryDocumentQuotaPercent(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("memoryDocumentQuotaPercent", 100.) : 100.;
+}
+
+void KisImageConfig::setMemoryDocumentQuotaPercent(qreal value)
+{
+    m_config.writeEntry("memoryDocumentQuotaPercent", value);
+}
+
+int KisImageConfig::tilesDocumentQuota() const
+{
+    qreal dp = qBound(0.0, memoryDocumentQuotaPercent(), 100.0) / 100.0;
+
+    return tilesHardLimit() * dp;
+}
+
+qreal KisImageConfig::memoryCompressedSwapPercent(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("memoryCompressedSwapPercent", 10.) : 10.;
+}
+
+void KisImageConfig::setMemoryCompressedSwapPercent(qreal value)
+{
+    m_config.writeEntry("memoryCompressedSwapPercent", value);
+}
+
+int KisImageConfig::tilesCompressedSwapLimit() const
+{
+    qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
+    qreal cp = qreal(memoryCompressedSwapPercent()) / 100.0;
+
+    return totalRAM() * hp * cp;
+}
+
+bool KisImageConfig::useDeltaUndoMementos(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("useDeltaUndoMementos", false) : false;
+}
+
+void KisImageConfig::setUseDeltaUndoMementos(bool value)
+{
+    m_config.writeEntry("useDeltaUndoMementos", value);
+}
+
+int KisImageConfig::memoryStatisticsSamplingInterval(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("memoryStatisticsSamplingInterval", 10000) : 10000;
+}
+
+void KisImageConfig::setMemoryStatisticsSamplingInterval(int value)
+{
+    m_config.writeEntry("memoryStatisticsSamplingInterval", value);
+}
+
+int KisImageConfig::memoryStatisticsMaxSamples(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("memoryStatisticsMaxSamples", 8640) : 8640;
+}
+
+void KisImageConfig::setMemoryStatisticsMaxSamples(int value)
+{
+    m_config.writeEntry("memoryStatisticsMaxSamples", value);
+}
+
+int KisImageConfig::groupProjectionCacheLimit(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("groupProjectionCacheLimit", 256) : 256;
+}
+
+void KisImageConfig::setGroupProjectionCacheLimit(int value)
+{
+    m_config.writeEntry("groupProjectionCacheLimit", value);
+}
+
 QString KisImageConfig::safelyGetWritableTempLocation(const QString &suffix, const QString &configKey, bool requestDefault) const
 {
 #ifdef Q_OS_MACOS
@@ -24,6 +24,9 @@ public:
     bool enablePerfLog(bool requestDefault = false) const;
     void setEnablePerfLog(bool value);
 
+    QString updatePipelineTraceFile() const;
+    void setUpdatePipelineTraceFile(const QString &value);
+
     qreal transformMaskOffBoundsReadArea() const;
 
     int updatePatchHeight() const;
@@ -34,6 +37,7 @@ public:
     qreal maxCollectAlpha() const;
     qreal maxMergeAlpha() const;
     qreal maxMergeCollectAlpha() const;
+    int updateCoalescingGridSize() const;
     qreal schedulerBalancingRatio() const;
     void setSchedulerBalancingRatio(qreal value);
 
@@ -43,20 +47,88 @@ public:
     int swapSlabSize() const;
     void setSwapSlabSize(int value);
 
+    /**
+     * @return the size of the window the swap file is accessed
+     * through (in MiB). Zero value means that the whole swap file
+     * is mapped into memory and paging is left to the kernel.
+     */
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    /**
+     * @return the name of the algorithm used for compressing tiles
+     * in the swap file: "LZF", "LZ4" or "ZSTD". If the algorithm is
+     * not supported by the build, LZF is used instead.
+     */
+    QString swapCompression(bool requestDefault = false) const;
+    void setSwapCompression(const QString &value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
 
     qreal memoryHardLimitPercent(bool requestDefault = false) const; // % of total RAM
-    qreal memorySoftLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent() * (1 - 0.01 * memoryPoolLimitPercent())
+    qreal memorySoftLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent() * (1 - 0.01 * (memoryPoolLimitPercent() + memoryCompressedSwapPercent()))
     qreal memoryPoolLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent()
     void setMemoryHardLimitPercent(qreal value);
     void setMemorySoftLimitPercent(qreal value);
     void setMemoryPoolLimitPercent(qreal value);
 
+    /**
+     * @return the share of tilesHardLimit() a single document may
+     * occupy, in percents. When a document exceeds its quota, the
+     * swapper evicts the tiles of this document before anyone
+     * else's. 100% means no quota.
+     */
+    qreal memoryDocumentQuotaPercent(bool requestDefault = false) const;
+    void setMemoryDocumentQuotaPercent(qreal value);
+    int tilesDocumentQuota() const; // MiB
+
+    /**
+     * @return the share of memoryHardLimitPercent() used for keeping
+     * the swapped out tiles compressed in memory, in percents. The
+     * tiles are spilled to the swap file only when this tier is full
+     * or the memory usage is above the hard limit.
+     */
+    qreal memoryCompressedSwapPercent(bool requestDefault = false) const;
+    void setMemoryCompressedSwapPercent(qreal value);
+    int tilesCompressedSwapLimit() const; // MiB
+
+    /**
+     * @return true if the previous versions of the tiles stored in
+     * the undo history should be kept as compressed deltas against
+     * the newer versions
+     */
+    bool useDeltaUndoMementos(bool requestDefault = false) const;
+    void setUseDeltaUndoMementos(bool value);
+
+    /**
+     * @return the interval between the samples of the memory
+     * statistics time series in milliseconds. Zero disables
+     * sampling.
+     *
+     * \see KisMemoryStatisticsServer::samples()
+     */
+    int memoryStatisticsSamplingInterval(bool requestDefault = false) const;
+    void setMemoryStatisticsSamplingInterval(int value);
+
+    /**
+     * @return the number of the samples kept in the memory
+     * statistics time series, the oldest samples are dropped
+     */
+    int memoryStatisticsMaxSamples(bool requestDefault = false) const;
+    void setMemoryStatisticsMaxSamples(int value);
+
+    /**
+     * @return the total memory the partial composites of the group
+     * layers may occupy, in MiB. When the limit is reached, the least
+     * recently used composites are dropped.
+     *
+     * \see KisGroupProjectionCache
+     */
+    int groupProjectionCacheLimit(bool requestDefault = false) const; // MiB
+    void setGroupProjectionCacheLimit(int value);
+
     static int totalRAM(); // MiB
 
     /**
@@ -32,6 +32,7 @@
 
 #include "kis_raster_keyframe_channel.h"
 #include "KisSafeNodeProjectionStore.h"
+#include "KisUpdatePipelineTracer.h"
 
 
 struct Q_DECL_HIDDEN KisMask::Private {
@@ -270,6 +271,14 @@ bool KisMask::paintsOutsideSelection() const
 
 void KisMask::apply(KisPaintDeviceSP projection, const QRect &applyRect, const QRect &needRect, PositionToFilthy maskPos) const
 {
+    KisUpdatePipelineTraceScope traceScope("mask");
+
+    if (traceScope.isActive()) {
+        traceScope.setName(name());
+        traceScope.addArg("type", metaObject()->className());
+        traceScope.addArg("rect", applyRect);
+    }
+
     if (selection()) {
 
         flattenSelectionProjection(m_d->selection, applyRect);
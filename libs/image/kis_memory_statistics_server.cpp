@@ -8,10 +8,16 @@
 
 #include <QGlobalStatic>
 #include <QApplication>
+#include <QDateTime>
+#include <QMutex>
+#include <QTimer>
+#include <QThread>
+#include <QDebug>
 
 #include "kis_image.h"
 #include "kis_image_config.h"
 #include "kis_signal_compressor.h"
+#include "kis_assert.h"
 
 #include "tiles3/kis_tile_data_store.h"
 
@@ -20,11 +26,23 @@ Q_GLOBAL_STATIC(KisMemoryStatisticsServer, s_instance)
 struct Q_DECL_HIDDEN KisMemoryStatisticsServer::Private
 {
     Private(KisMemoryStatisticsServer *q)
-        : updateCompressor(1000 /* ms */, KisSignalCompressor::POSTPONE, q)
+        : updateCompressor(1000 /* ms */, KisSignalCompressor::POSTPONE, q),
+          samplingTimer(q)
     {
     }
 
     KisSignalCompressor updateCompressor;
+
+    QTimer samplingTimer;
+    int samplingInterval = 0;
+    int maxSamples = 0;
+
+    mutable QMutex samplesLock;
+    QVector<KisMemoryStatisticsServer::Sample> samples;
+    KisImageWSP sampledImage;
+    bool hasRatesBase = false;
+    qint64 lastSwapOutCount = 0;
+    qint64 lastSwapInCount = 0;
 };
 
 
@@ -38,6 +56,13 @@ KisMemoryStatisticsServer::KisMemoryStatisticsServer()
      */
     moveToThread(qApp->thread());
     connect(&m_d->updateCompressor, SIGNAL(timeout()), SIGNAL(sigUpdateMemoryStatistics()));
+
+    KisImageConfig cfg(true);
+    m_d->maxSamples = qMax(1, cfg.memoryStatisticsMaxSamples());
+    m_d->samplingInterval = cfg.memoryStatisticsSamplingInterval();
+
+    m_d->samplingTimer.setInterval(qMax(1, m_d->samplingInterval));
+    connect(&m_d->samplingTimer, SIGNAL(timeout()), SLOT(sampleMemoryStatistics()));
 }
 
 KisMemoryStatisticsServer::~KisMemoryStatisticsServer()
@@ -55,7 +80,8 @@ inline void addDevice(KisPaintDeviceSP dev,
                       qint64 &memBound,
                       qint64 &layersSize,
                       qint64 &projectionsSize,
-                      qint64 &lodSize)
+                      qint64 &lodSize,
+                      qint64 &historySize)
 {
     if (dev && !devices.contains(dev.data())) {
         devices.insert(dev.data());
@@ -67,6 +93,8 @@ inline void addDevice(KisPaintDeviceSP dev,
         dev->estimateMemoryStats(imageData, temporaryData, lodData);
         memBound += imageData + temporaryData + lodData;
 
+        historySize += dev->estimateHistoryMemorySize();
+
         KIS_SAFE_ASSERT_RECOVER_NOOP(!temporaryData || isProjection);
 
         if (!isProjection) {
@@ -83,7 +111,8 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
                                       QSet<KisPaintDevice*> &devices,
                                       qint64 &layersSize,
                                       qint64 &projectionsSize,
-                                      qint64 &lodSize)
+                                      qint64 &lodSize,
+                                      qint64 &historySize)
 {
     qint64 memBound = 0;
 
@@ -92,14 +121,15 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
             node->inherits("KisAdjustmentLayer");
 
 
-    addDevice(node->paintDevice(), false, devices, memBound, layersSize, projectionsSize, lodSize);
-    addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize);
-    addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize);
+    addDevice(node->paintDevice(), false, devices, memBound, layersSize, projectionsSize, lodSize, historySize);
+    addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize, historySize);
+    addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize, historySize);
 
     node = node->firstChild();
     while (node) {
         memBound += calculateNodeMemoryHiBoundStep(node, devices,
-                                                   layersSize, projectionsSize, lodSize);
+                                                   layersSize, projectionsSize, lodSize,
+                                                   historySize);
         node = node->nextSibling();
     }
 
@@ -109,18 +139,58 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
 qint64 calculateNodeMemoryHiBound(KisNodeSP node,
                                   qint64 &layersSize,
                                   qint64 &projectionsSize,
-                                  qint64 &lodSize)
+                                  qint64 &lodSize,
+                                  qint64 &historySize)
 {
     layersSize = 0;
     projectionsSize = 0;
     lodSize = 0;
+    historySize = 0;
 
     QSet<KisPaintDevice*> devices;
     return calculateNodeMemoryHiBoundStep(node,
                                           devices,
                                           layersSize,
                                           projectionsSize,
-                                          lodSize);
+                                          lodSize,
+                                          historySize);
+}
+
+void calculateNodeStatisticsStep(KisNodeSP node,
+                                 QSet<KisPaintDevice*> &devices,
+                                 QVector<KisMemoryStatisticsServer::NodeStatistics> &result)
+{
+    KisMemoryStatisticsServer::NodeStatistics nodeStats;
+    nodeStats.name = node->name();
+    nodeStats.uuid = node->uuid();
+
+    qint64 memBound = 0;
+    addDevice(node->paintDevice(), false, devices, memBound,
+              nodeStats.dataSize, nodeStats.projectionSize,
+              nodeStats.lodSize, nodeStats.historySize);
+
+    // the originals and projections are all counted as projections
+    addDevice(node->original(), true, devices, memBound,
+              nodeStats.dataSize, nodeStats.projectionSize,
+              nodeStats.lodSize, nodeStats.historySize);
+    addDevice(node->projection(), true, devices, memBound,
+              nodeStats.dataSize, nodeStats.projectionSize,
+              nodeStats.lodSize, nodeStats.historySize);
+
+    result.append(nodeStats);
+
+    node = node->firstChild();
+    while (node) {
+        calculateNodeStatisticsStep(node, devices, result);
+        node = node->nextSibling();
+    }
+}
+
+QString csvEscaped(const QString &value)
+{
+    QString result = value;
+    result.replace('"', "\"\"");
+    return '"' + result + '"';
 }
 
 
@@ -136,7 +206,17 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
             calculateNodeMemoryHiBound(image->root(),
                                        stats.layersSize,
                                        stats.projectionsSize,
-                                       stats.lodSize);
+                                       stats.lodSize,
+                                       stats.historySize);
+
+        KisTileDataStore *store = KisTileDataStore::instance();
+        const KisTileDataStore::MemoryAccountStatistics accountStats =
+            store->memoryAccountStatistics(image->memoryAccount());
+
+        stats.documentMemorySize = accountStats.memorySize;
+        stats.documentSwapSize = accountStats.swapSize;
+        stats.documentIsBackground =
+            store->memoryAccountPriority(image->memoryAccount()) == KisTileDataStore::BackgroundAccount;
     }
     stats.totalMemorySize = tileStats.totalMemorySize;
     stats.realMemorySize = tileStats.realMemorySize;
@@ -144,17 +224,215 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.compressedSwapSize = tileStats.compressedSwapSize;
+    stats.compressedMemorySize = tileStats.compressedMemorySize;
+
+    stats.numTiles = tileStats.numTiles;
+    stats.numTilesInMemory = tileStats.numTilesInMemory;
+    stats.swapOutCount = tileStats.swapOutCount;
+    stats.swapInCount = tileStats.swapInCount;
+
+    stats.tileAllocatorThreadCacheHits = tileStats.allocatorThreadCacheHits;
+    stats.tileAllocatorSharedCacheHits = tileStats.allocatorSharedCacheHits;
+    stats.tileAllocatorMisses = tileStats.allocatorMisses;
 
     KisImageConfig cfg(true);
 
     stats.tilesHardLimit = cfg.tilesHardLimit() * MiB;
     stats.tilesSoftLimit = cfg.tilesSoftLimit() * MiB;
     stats.tilesPoolLimit = cfg.poolLimit() * MiB;
-    stats.totalMemoryLimit = stats.tilesHardLimit + stats.tilesPoolLimit;
+    stats.documentMemoryQuota = cfg.tilesDocumentQuota() * MiB;
+    stats.tilesCompressedSwapLimit = cfg.tilesCompressedSwapLimit() * MiB;
+    stats.totalMemoryLimit = stats.tilesHardLimit + stats.tilesPoolLimit + stats.tilesCompressedSwapLimit;
 
     return stats;
 }
 
+QVector<KisMemoryStatisticsServer::NodeStatistics>
+KisMemoryStatisticsServer::fetchNodeMemoryStatistics(KisImageSP image) const
+{
+    QVector<NodeStatistics> result;
+
+    if (image) {
+        QSet<KisPaintDevice*> devices;
+        calculateNodeStatisticsStep(image->root(), devices, result);
+    }
+
+    return result;
+}
+
+void KisMemoryStatisticsServer::startSampling(KisImageSP image)
+{
+    // the timer lives in the GUI thread
+    KIS_SAFE_ASSERT_RECOVER_RETURN(QThread::currentThread() == thread());
+
+    if (m_d->samplingInterval <= 0) {
+        qWarning() << "WARNING: memory statistics sampling is disabled by the \'memoryStatisticsSamplingInterval\' option!";
+        return;
+    }
+
+    {
+        QMutexLocker l(&m_d->samplesLock);
+        m_d->sampledImage = image;
+
+        // the swap rates are not calculated across the pauses
+        m_d->hasRatesBase = false;
+    }
+
+    m_d->samplingTimer.start();
+    sampleMemoryStatistics();
+}
+
+void KisMemoryStatisticsServer::stopSampling()
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(QThread::currentThread() == thread());
+
+    m_d->samplingTimer.stop();
+
+    QMutexLocker l(&m_d->samplesLock);
+    m_d->sampledImage.clear();
+}
+
+bool KisMemoryStatisticsServer::isSampling() const
+{
+    return m_d->samplingTimer.isActive();
+}
+
+QVector<KisMemoryStatisticsServer::Sample> KisMemoryStatisticsServer::samples() const
+{
+    QMutexLocker l(&m_d->samplesLock);
+    return m_d->samples;
+}
+
+void KisMemoryStatisticsServer::clearSamples()
+{
+    QMutexLocker l(&m_d->samplesLock);
+    m_d->samples.clear();
+}
+
+void KisMemoryStatisticsServer::sampleMemoryStatistics()
+{
+    KisTileDataStore::MemoryStatistics tileStats =
+        KisTileDataStore::instance()->memoryStatistics();
+
+    Sample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    sample.numTiles = tileStats.numTiles;
+    sample.numTilesInMemory = tileStats.numTilesInMemory;
+
+    sample.totalMemorySize = tileStats.totalMemorySize;
+    sample.realMemorySize = tileStats.realMemorySize;
+    sample.historicalMemorySize = tileStats.historicalMemorySize;
+    sample.poolSize = tileStats.poolSize;
+    sample.swapSize = tileStats.swapSize;
+    sample.compressedMemorySize = tileStats.compressedMemorySize;
+
+    KisImageSP image;
+
+    {
+        QMutexLocker l(&m_d->samplesLock);
+        image = m_d->sampledImage.toStrongRef();
+    }
+
+    if (image) {
+        sample.nodes = fetchNodeMemoryStatistics(image);
+    }
+
+    {
+        QMutexLocker l(&m_d->samplesLock);
+
+        if (m_d->hasRatesBase && !m_d->samples.isEmpty()) {
+            const qreal seconds =
+                qMax(qint64(1), sample.timestamp - m_d->samples.last().timestamp) / 1000.0;
+
+            sample.swapOutRate = (tileStats.swapOutCount - m_d->lastSwapOutCount) / seconds;
+            sample.swapInRate = (tileStats.swapInCount - m_d->lastSwapInCount) / seconds;
+        }
+
+        m_d->lastSwapOutCount = tileStats.swapOutCount;
+        m_d->lastSwapInCount = tileStats.swapInCount;
+        m_d->hasRatesBase = true;
+
+        if (m_d->samples.size() >= m_d->maxSamples) {
+            m_d->samples.remove(0, m_d->samples.size() - m_d->maxSamples + 1);
+        }
+        m_d->samples.append(sample);
+    }
+
+    emit sigMemoryStatisticsSampled();
+}
+
+QString KisMemoryStatisticsServer::samplesToCsv(const QVector<Sample> &samples)
+{
+    QString result;
+
+    result += "timestamp,numTiles,numTilesInMemory,totalMemorySize,realMemorySize,"
+              "historicalMemorySize,poolSize,swapSize,compressedMemorySize,"
+              "swapOutRate,swapInRate\n";
+
+    Q_FOREACH (const Sample &sample, samples) {
+        result += QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11\n")
+            .arg(QDateTime::fromMSecsSinceEpoch(sample.timestamp).toString(Qt::ISODateWithMs))
+            .arg(sample.numTiles)
+            .arg(sample.numTilesInMemory)
+            .arg(sample.totalMemorySize)
+            .arg(sample.realMemorySize)
+            .arg(sample.historicalMemorySize)
+            .arg(sample.poolSize)
+            .arg(sample.swapSize)
+            .arg(sample.compressedMemorySize)
+            .arg(sample.swapOutRate, 0, 'f', 2)
+            .arg(sample.swapInRate, 0, 'f', 2);
+    }
+
+    return result;
+}
+
+QString KisMemoryStatisticsServer::nodeStatisticsToCsv(const QVector<NodeStatistics> &nodes)
+{
+    QString result;
+
+    result += "name,uuid,dataSize,projectionSize,lodSize,historySize\n";
+
+    Q_FOREACH (const NodeStatistics &node, nodes) {
+        result += QString("%1,%2,%3,%4,%5,%6\n")
+            .arg(csvEscaped(node.name))
+            .arg(node.uuid.toString())
+            .arg(node.dataSize)
+            .arg(node.projectionSize)
+            .arg(node.lodSize)
+            .arg(node.historySize);
+    }
+
+    return result;
+}
+
+QString KisMemoryStatisticsServer::samplesNodeStatisticsToCsv(const QVector<Sample> &samples)
+{
+    QString result;
+
+    result += "timestamp,name,uuid,dataSize,projectionSize,lodSize,historySize\n";
+
+    Q_FOREACH (const Sample &sample, samples) {
+        const QString timestamp =
+            QDateTime::fromMSecsSinceEpoch(sample.timestamp).toString(Qt::ISODateWithMs);
+
+        Q_FOREACH (const NodeStatistics &node, sample.nodes) {
+            result += QString("%1,%2,%3,%4,%5,%6,%7\n")
+                .arg(timestamp)
+                .arg(csvEscaped(node.name))
+                .arg(node.uuid.toString())
+                .arg(node.dataSize)
+                .arg(node.projectionSize)
+                .arg(node.lodSize)
+                .arg(node.historySize);
+        }
+    }
+
+    return result;
+}
+
 void KisMemoryStatisticsServer::tryForceUpdateMemoryStatisticsWhileIdle()
 {
     KisTileDataStore::instance()->tryForceUpdateMemoryStatisticsWhileIdle();
@@ -10,6 +10,8 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QScopedPointer>
+#include <QVector>
+#include <QUuid>
 
 #include "kritaimage_export.h"
 #include "kis_types.h"
@@ -26,6 +28,7 @@ public:
               layersSize(0),
               projectionsSize(0),
               lodSize(0),
+              historySize(0),
 
               totalMemorySize(0),
               realMemorySize(0),
@@ -33,11 +36,28 @@ public:
               poolSize(0),
 
               swapSize(0),
+              compressedSwapSize(0),
+              compressedMemorySize(0),
+
+              numTiles(0),
+              numTilesInMemory(0),
+              swapOutCount(0),
+              swapInCount(0),
+
+              documentMemorySize(0),
+              documentSwapSize(0),
+              documentMemoryQuota(0),
+              documentIsBackground(false),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
               tilesSoftLimit(0),
-              tilesPoolLimit(0)
+              tilesPoolLimit(0),
+              tilesCompressedSwapLimit(0),
+
+              tileAllocatorThreadCacheHits(0),
+              tileAllocatorSharedCacheHits(0),
+              tileAllocatorMisses(0)
         {
         }
 
@@ -46,6 +66,11 @@ public:
         qint64 projectionsSize;
         qint64 lodSize;
 
+        /**
+         * The memory kept by the undo history of the image's layers
+         */
+        qint64 historySize;
+
         qint64 totalMemorySize;
         qint64 realMemorySize;
         qint64 historicalMemorySize;
@@ -53,10 +78,99 @@ public:
 
         qint64 swapSize;
 
+        /**
+         * The uncompressed size of the swapped out tiles that are
+         * kept compressed in memory and the memory they occupy
+         * (counted in totalMemorySize)
+         */
+        qint64 compressedSwapSize;
+        qint64 compressedMemorySize;
+
+        /**
+         * The number of tile data objects (in memory and in swap) and
+         * the total number of tile swap-outs and swap-ins since start
+         */
+        qint64 numTiles;
+        qint64 numTilesInMemory;
+        qint64 swapOutCount;
+        qint64 swapInCount;
+
+        /**
+         * The memory occupied by the tiles of the image in RAM and
+         * in the swap file, the per-document quota and whether the
+         * image has background priority for the swapper
+         */
+        qint64 documentMemorySize;
+        qint64 documentSwapSize;
+        qint64 documentMemoryQuota;
+        bool documentIsBackground;
+
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
         qint64 tilesSoftLimit;
         qint64 tilesPoolLimit;
+        qint64 tilesCompressedSwapLimit;
+
+        /**
+         * Number of tile data payloads served from the thread-local
+         * free lists, from the shared free lists and by the system
+         * allocator (misses) respectively
+         */
+        qint64 tileAllocatorThreadCacheHits;
+        qint64 tileAllocatorSharedCacheHits;
+        qint64 tileAllocatorMisses;
+    };
+
+    /**
+     * The memory used by a single node of the image
+     */
+    struct NodeStatistics
+    {
+        QString name;
+        QUuid uuid;
+
+        qint64 dataSize = 0;
+        qint64 projectionSize = 0;
+        qint64 lodSize = 0;
+
+        /**
+         * The memory kept by the undo history of the node's paint device
+         */
+        qint64 historySize = 0;
+    };
+
+    /**
+     * A sample of the global tile memory statistics, the samples
+     * are collected periodically to build a time series
+     *
+     * \see KisImageConfig::memoryStatisticsSamplingInterval()
+     */
+    struct Sample
+    {
+        qint64 timestamp = 0; // msecs since epoch
+
+        qint64 numTiles = 0;
+        qint64 numTilesInMemory = 0;
+
+        qint64 totalMemorySize = 0;
+        qint64 realMemorySize = 0;
+        qint64 historicalMemorySize = 0;
+        qint64 poolSize = 0;
+        qint64 swapSize = 0;
+        qint64 compressedMemorySize = 0;
+
+        /**
+         * Number of tiles swapped out and in per second
+         * since the previous sample
+         */
+        qreal swapOutRate = 0.0;
+        qreal swapInRate = 0.0;
+
+        /**
+         * The breakdown of the memory used by the nodes of the
+         * image passed to startSampling(), if any
+         */
+        QVector<NodeStatistics> nodes;
     };
 
 
@@ -68,12 +182,54 @@ public:
 
     Statistics fetchMemoryStatistics(KisImageSP image) const;
 
+    /**
+     * Returns the breakdown of the memory used by every node of
+     * \p image. The paint devices shared by several nodes are
+     * accounted for the first node only.
+     */
+    QVector<NodeStatistics> fetchNodeMemoryStatistics(KisImageSP image) const;
+
+    /**
+     * Starts collecting the time series. If \p image is not null, every
+     * sample also contains the per-node breakdown of the memory used by
+     * the image. The sampling timer runs only until stopSampling() is
+     * called.
+     *
+     * \see KisImageConfig::memoryStatisticsSamplingInterval()
+     */
+    void startSampling(KisImageSP image = KisImageSP());
+    void stopSampling();
+    bool isSampling() const;
+
+    /**
+     * Returns the collected time series, the oldest sample first
+     */
+    QVector<Sample> samples() const;
+    void clearSamples();
+
+    static QString samplesToCsv(const QVector<Sample> &samples);
+    static QString nodeStatisticsToCsv(const QVector<NodeStatistics> &nodes);
+
+    /**
+     * Returns the per-node breakdowns of \p samples as CSV,
+     * one line per node per sample
+     */
+    static QString samplesNodeStatisticsToCsv(const QVector<Sample> &samples);
+
 public Q_SLOTS:
     void notifyImageChanged();
     void tryForceUpdateMemoryStatisticsWhileIdle();
 
+    /**
+     * Appends a new sample to the time series. Called
+     * periodically by the sampling timer while sampling
+     * is active.
+     */
+    void sampleMemoryStatistics();
+
 Q_SIGNALS:
     void sigUpdateMemoryStatistics();
+    void sigMemoryStatisticsSampled();
 
 
 private:
@@ -13,6 +13,8 @@
 #include <QImage>
 #include <QList>
 #include <QHash>
+#include <QMap>
+#include <QSharedPointer>
 #include <QIODevice>
 #include <qmath.h>
 #include <KisRegion.h>
@@ -105,7 +107,8 @@ public:
                            KoColorConversionTransformation::Intent renderingIntent,
                            KoColorConversionTransformation::ConversionFlags conversionFlags,
                            KUndo2Command *parentCommand,
-                           KoUpdater *progressUpdater);
+                           KoUpdater *progressUpdater,
+                           KisRunnableStrokeJobsInterface *jobsInterface);
     bool assignProfile(const KoColorProfile * profile, KUndo2Command *parentCommand);
 
     KUndo2Command* reincarnateWithDetachedHistory(bool copyContent);
@@ -158,6 +161,7 @@ public:
     {
 
         m_lodData.reset();
+        releasePersistentLodPlanes();
         m_externalFrameData.reset();
 
         if (!m_frames.isEmpty()) {
@@ -418,9 +422,15 @@ public:
 
     struct LodDataStructImpl;
     LodDataStruct* createLodDataStruct(int lod);
+    LodDataStruct* createPersistentLodDataStruct(int lod);
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
     KisRegion regionForLodSyncing() const;
+    KisRegion regionForLodSyncing(LodDataStruct *dst) const;
+    QVector<int> persistentLodLevels() const;
+    void releasePersistentLodPlanes();
+
+    static const int maxPersistentLod = 3;
 
     void updateLodDataManager(KisDataManager *srcDataManager,
                               KisDataManager *dstDataManager, const QPoint &srcOffset, const QPoint &dstOffset,
@@ -452,6 +462,13 @@ public:
             lodData += estimateDataSize(m_lodData.data());
         }
 
+        {
+            QMutexLocker l(&m_lodPlanesLock);
+            Q_FOREACH (QSharedPointer<LodPlane> plane, m_lodPlanes) {
+                lodData += estimateDataSize(plane->data.data());
+            }
+        }
+
         if (m_externalFrameData) {
             temporaryData += estimateDataSize(m_externalFrameData.data());
         }
@@ -461,6 +478,20 @@ public:
         }
     }
 
+    qint64 estimateHistoryMemorySize() const {
+        qint64 size = 0;
+
+        if (m_data) {
+            size += m_data->dataManager()->historyMemorySize();
+        }
+
+        Q_FOREACH (DataSP value, m_frames.values()) {
+            size += value->dataManager()->historyMemorySize();
+        }
+
+        return size;
+    }
+
 
 private:
 
@@ -591,9 +622,29 @@ private:
 private:
     friend class KisPaintDeviceFramesInterface;
 
+private:
+    /**
+     * A persistent LoD plane of the device. It keeps the downsampled
+     * data of the device and the revisions of the source tiles it has
+     * been synced with, so that the next sync of the plane processes
+     * only the tiles that changed since then.
+     */
+    struct LodPlane {
+        QScopedPointer<Data> data;
+        KisDataManager::TileRevisions revisions;
+    };
+
 private:
     DataSP m_data;
     mutable QScopedPointer<Data> m_lodData;
+    QMap<int, QSharedPointer<LodPlane>> m_lodPlanes;
+
+    /**
+     * The planes are created and released from the strokes, but the
+     * memory statistics are fetched from the GUI thread, so the map
+     * is guarded with a separate lock.
+     */
+    mutable QMutex m_lodPlanesLock;
     mutable QScopedPointer<Data> m_externalFrameData;
     mutable QMutex m_dataSwitchLock;
 
@@ -675,7 +726,22 @@ struct KisPaintDevice::Private::StrategyPolicy {
 
 struct KisPaintDevice::Private::LodDataStructImpl : public KisPaintDevice::LodDataStruct {
     LodDataStructImpl(Data *_lodData) : lodData(_lodData) {}
+    LodDataStructImpl(QSharedPointer<LodPlane> _plane) : plane(_plane) {}
+
+    inline Data* data() const {
+        return plane ? plane->data.data() : lodData.data();
+    }
+
     QScopedPointer<Data> lodData;
+
+    /**
+     * The persistent plane being synced, the region of the source
+     * that should be synced and the revisions of the source tiles
+     * that will be saved into the plane on upload
+     */
+    QSharedPointer<LodPlane> plane;
+    KisRegion dirtyRegion;
+    KisDataManager::TileRevisions revisions;
 };
 
 KisRegion KisPaintDevice::Private::regionForLodSyncing() const
@@ -684,6 +750,31 @@ KisRegion KisPaintDevice::Private::regionForLodSyncing() const
     return srcData->dataManager()->region().translated(srcData->x(), srcData->y());
 }
 
+KisRegion KisPaintDevice::Private::regionForLodSyncing(LodDataStruct *_dst) const
+{
+    LodDataStructImpl *dst = dynamic_cast<LodDataStructImpl*>(_dst);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(dst, regionForLodSyncing());
+
+    return dst->plane ? dst->dirtyRegion : regionForLodSyncing();
+}
+
+QVector<int> KisPaintDevice::Private::persistentLodLevels() const
+{
+    QMutexLocker l(&m_lodPlanesLock);
+    return m_lodPlanes.keys().toVector();
+}
+
+void KisPaintDevice::Private::releasePersistentLodPlanes()
+{
+    /**
+     * The structs that are being synced keep their planes alive, so
+     * the sync will complete safely, but its result will not be
+     * reused by the next sync.
+     */
+    QMutexLocker l(&m_lodPlanesLock);
+    m_lodPlanes.clear();
+}
+
 KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int newLod)
 {
     KIS_SAFE_ASSERT_RECOVER_NOOP(newLod > 0);
@@ -720,6 +811,65 @@ KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int
     return lodStruct;
 }
 
+KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createPersistentLodDataStruct(int newLod)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(newLod > 0);
+
+    if (newLod > maxPersistentLod) {
+        return createLodDataStruct(newLod);
+    }
+
+    Data *srcData = currentNonLodData();
+
+    QMutexLocker l(&m_lodPlanesLock);
+
+    QSharedPointer<LodPlane> plane = m_lodPlanes.value(newLod);
+    if (!plane) {
+        plane.reset(new LodPlane());
+        plane->data.reset(new Data(q, srcData, false));
+        m_lodPlanes.insert(newLod, plane);
+    }
+
+    Data *lodData = plane->data.data();
+
+    int expectedX = KisLodTransform::coordToLodCoord(srcData->x(), newLod);
+    int expectedY = KisLodTransform::coordToLodCoord(srcData->y(), newLod);
+
+    /**
+     * If the offset, the color space or the default pixel of the
+     * device have changed, the plane should be regenerated from
+     * scratch. Color spaces are compared as pure pointers, because
+     * they must be exactly the same, since they come from the
+     * common source.
+     */
+    if (lodData->levelOfDetail() != newLod ||
+        lodData->colorSpace() != srcData->colorSpace() ||
+        lodData->x() != expectedX ||
+        lodData->y() != expectedY ||
+        lodData->dataManager()->pixelSize() != srcData->dataManager()->pixelSize() ||
+        memcmp(lodData->dataManager()->defaultPixel(),
+               srcData->dataManager()->defaultPixel(),
+               srcData->dataManager()->pixelSize()) != 0) {
+
+        lodData->prepareClone(srcData);
+
+        lodData->setLevelOfDetail(newLod);
+        lodData->setX(expectedX);
+        lodData->setY(expectedY);
+
+        plane->revisions.clear();
+    }
+
+    lodData->cache()->invalidate();
+
+    LodDataStructImpl *lodStruct = new LodDataStructImpl(plane);
+    lodStruct->dirtyRegion =
+        srcData->dataManager()->changedTilesRegion(plane->revisions, &lodStruct->revisions)
+            .translated(srcData->x(), srcData->y());
+
+    return lodStruct;
+}
+
 void KisPaintDevice::Private::updateLodDataManager(KisDataManager *srcDataManager,
                                                    KisDataManager *dstDataManager,
                                                    const QPoint &srcOffset,
@@ -822,7 +972,7 @@ void KisPaintDevice::Private::updateLodDataStruct(LodDataStruct *_dst, const QRe
     LodDataStructImpl *dst = dynamic_cast<LodDataStructImpl*>(_dst);
     KIS_SAFE_ASSERT_RECOVER_RETURN(dst);
 
-    Data *lodData = dst->lodData.data();
+    Data *lodData = dst->data();
     Data *srcData = currentNonLodData();
 
     const int lod = lodData->levelOfDetail();
@@ -849,13 +999,30 @@ void KisPaintDevice::Private::uploadLodDataStruct(LodDataStruct *_dst)
     LodDataStructImpl *dst = dynamic_cast<LodDataStructImpl*>(_dst);
     KIS_SAFE_ASSERT_RECOVER_RETURN(dst);
 
+    Data *lodData = dst->data();
+
+    if (dst->plane) {
+        dst->plane->revisions = dst->revisions;
+
+        /**
+         * The persistent planes of other levels of detail are
+         * only synced in background and not uploaded anywhere
+         */
+        if (lodData->levelOfDetail() != defaultBounds->currentLevelOfDetail()) return;
+    }
+
     KIS_SAFE_ASSERT_RECOVER_RETURN(
-        dst->lodData->levelOfDetail() == defaultBounds->currentLevelOfDetail());
+        lodData->levelOfDetail() == defaultBounds->currentLevelOfDetail());
 
     ensureLodDataPresent();
 
-    m_lodData->prepareClone(dst->lodData.data());
-    m_lodData->dataManager()->bitBltRough(dst->lodData->dataManager(), dst->lodData->dataManager()->extent());
+    /**
+     * For the persistent planes the tiles are shared between the
+     * plane and the LoD data, so the LoD strokes don't change the
+     * plane
+     */
+    m_lodData->prepareClone(lodData);
+    m_lodData->dataManager()->bitBltRough(lodData->dataManager(), lodData->dataManager()->extent());
 }
 
 void KisPaintDevice::Private::transferFromData(Data *data, KisPaintDeviceSP targetDevice)
@@ -994,7 +1161,8 @@ void KisPaintDevice::Private::convertColorSpace(const KoColorSpace *dstColorSpac
                                                 KoColorConversionTransformation::Intent renderingIntent,
                                                 KoColorConversionTransformation::ConversionFlags conversionFlags,
                                                 KUndo2Command *parentCommand,
-                                                KoUpdater *progressUpdater)
+                                                KoUpdater *progressUpdater,
+                                                KisRunnableStrokeJobsInterface *jobsInterface)
 {
     QList<Data*> dataObjects = allDataObjects();
     if (dataObjects.isEmpty()) return;
@@ -1005,7 +1173,7 @@ void KisPaintDevice::Private::convertColorSpace(const KoColorSpace *dstColorSpac
     Q_FOREACH (Data *data, dataObjects) {
         if (!data) continue;
 
-        data->convertDataColorSpace(dstColorSpace, renderingIntent, conversionFlags, mainCommand, progressUpdater);
+        data->convertDataColorSpace(dstColorSpace, renderingIntent, conversionFlags, mainCommand, progressUpdater, jobsInterface);
     }
 
     q->emitColorSpaceChanged();
@@ -1203,6 +1371,11 @@ void KisPaintDevice::estimateMemoryStats(qint64 &imageData, qint64 &temporaryDat
     m_d->estimateMemoryStats(imageData, temporaryData, lodData);
 }
 
+qint64 KisPaintDevice::estimateHistoryMemorySize() const
+{
+    return m_d->estimateHistoryMemorySize();
+}
+
 void KisPaintDevice::setParentNode(KisNodeWSP parent)
 {
     m_d->parent = parent;
@@ -1218,6 +1391,13 @@ void KisPaintDevice::setDefaultBounds(KisDefaultBoundsBaseSP defaultBounds)
 {
     m_d->defaultBounds = defaultBounds;
     m_d->cache()->invalidate();
+
+    const qint32 memoryAccount = defaultBounds ? defaultBounds->memoryAccount() : 0;
+
+    Q_FOREACH (KisPaintDeviceData *data, m_d->allDataObjects()) {
+        if (!data) continue;
+        data->dataManager()->setMemoryAccount(memoryAccount);
+    }
 }
 
 KisDefaultBoundsBaseSP KisPaintDevice::defaultBounds() const
@@ -1583,9 +1763,10 @@ void KisPaintDevice::convertTo(const KoColorSpace *dstColorSpace,
                                KoColorConversionTransformation::Intent renderingIntent,
                                KoColorConversionTransformation::ConversionFlags conversionFlags,
                                KUndo2Command *parentCommand,
-                               KoUpdater *progressUpdater)
+                               KoUpdater *progressUpdater,
+                               KisRunnableStrokeJobsInterface *jobsInterface)
 {
-    m_d->convertColorSpace(dstColorSpace, renderingIntent, conversionFlags, parentCommand, progressUpdater);
+    m_d->convertColorSpace(dstColorSpace, renderingIntent, conversionFlags, parentCommand, progressUpdater, jobsInterface);
 }
 
 bool KisPaintDevice::setProfile(const KoColorProfile * profile, KUndo2Command *parentCommand)
@@ -1834,6 +2015,11 @@ QImage KisPaintDevice::createThumbnail(qint32 maxw, qint32 maxh,
                            oversample, renderingIntent, conversionFlags);
 }
 
+void KisPaintDevice::prefetchSwappedTiles(const QRect &rect) const
+{
+    m_d->dataManager()->prefetchSwappedTiles(rect.translated(-m_d->x(), -m_d->y()));
+}
+
 KisHLineIteratorSP KisPaintDevice::createHLineIteratorNG(qint32 x, qint32 y, qint32 w)
 {
     m_d->cache()->invalidate();
@@ -2163,6 +2349,26 @@ KisPaintDevice::LodDataStruct* KisPaintDevice::createLodDataStruct(int lod)
     return m_d->createLodDataStruct(lod);
 }
 
+KisRegion KisPaintDevice::regionForLodSyncing(LodDataStruct *dst) const
+{
+    return m_d->regionForLodSyncing(dst);
+}
+
+KisPaintDevice::LodDataStruct* KisPaintDevice::createPersistentLodDataStruct(int lod)
+{
+    return m_d->createPersistentLodDataStruct(lod);
+}
+
+QVector<int> KisPaintDevice::persistentLodLevels() const
+{
+    return m_d->persistentLodLevels();
+}
+
+void KisPaintDevice::releasePersistentLodPlanes()
+{
+    m_d->releasePersistentLodPlanes();
+}
+
 void KisPaintDevice::updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect)
 {
     m_d->updateLodDataStruct(dst, srcRect);
@@ -43,6 +43,7 @@ class KisRasterKeyframeChannel;
 class KisPaintDeviceFramesInterface;
 
 class KisInterstrokeData;
+class KisRunnableStrokeJobsInterface;
 using KisInterstrokeDataSP = QSharedPointer<KisInterstrokeData>;
 
 typedef KisSharedPtr<KisDataManager> KisDataManagerSP;
@@ -475,12 +476,20 @@ public:
 
     /**
      * Converts the paint device to a different colorspace
+     *
+     * If \p jobsInterface is passed, the pixels are converted in
+     * tile-aligned patches by concurrent stroke jobs added to the
+     * interface. The colorspace of the device is switched immediately,
+     * but the pixel data becomes valid only when the jobs are completed,
+     * that is, by the next barrier of the stroke. The progress is not
+     * reported to \p progressUpdater in this mode.
      */
     void convertTo(const KoColorSpace *dstColorSpace,
                    KoColorConversionTransformation::Intent renderingIntent = KoColorConversionTransformation::internalRenderingIntent(),
                    KoColorConversionTransformation::ConversionFlags conversionFlags = KoColorConversionTransformation::internalConversionFlags(),
                    KUndo2Command *parentCommand = nullptr,
-                   KoUpdater *progressUpdater = nullptr);
+                   KoUpdater *progressUpdater = nullptr,
+                   KisRunnableStrokeJobsInterface *jobsInterface = nullptr);
 
     /**
      * Changes the profile of the colorspace of this paint device to the given
@@ -809,6 +818,19 @@ public:
 
     void estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData) const;
 
+    /**
+     * @return the amount of memory kept by the undo history of
+     * the device's data (all the frames included)
+     */
+    qint64 estimateHistoryMemorySize() const;
+
+    /**
+     * Starts loading the swapped-out tiles covering \p rect in
+     * background. Call it before processing a big area of the device
+     * to avoid stalling on every swapped-out tile.
+     */
+    void prefetchSwappedTiles(const QRect &rect) const;
+
 public:
 
     KisHLineIteratorSP createHLineIteratorNG(qint32 x, qint32 y, qint32 w);
@@ -904,6 +926,36 @@ public:
     void updateLodDataStruct(LodDataStruct *dst, const QRect &srcRect);
     void uploadLodDataStruct(LodDataStruct *dst);
 
+    /**
+     * Creates a struct for syncing the persistent LoD plane of the
+     * device at level \p lod. The device keeps a plane for every level
+     * of detail up to 3 it has been synced at. The plane is updated
+     * incrementally: regionForLodSyncing(dst) returns only the tiles of
+     * the device that have changed since the last upload of the plane.
+     *
+     * Uploading the struct marks the plane as synced. If \p lod is the
+     * current level of detail of the device, the plane is also copied
+     * into the LoD data of the device.
+     *
+     * For higher levels of detail a non-persistent struct is created,
+     * which is the same as createLodDataStruct().
+     */
+    LodDataStruct* createPersistentLodDataStruct(int lod);
+    KisRegion regionForLodSyncing(LodDataStruct *dst) const;
+
+    /**
+     * The levels of detail the device has persistent planes for
+     */
+    QVector<int> persistentLodLevels() const;
+
+    /**
+     * Frees the persistent LoD planes of the device. The next sync of
+     * every level will regenerate its plane from scratch.
+     *
+     * It is safe to call the method while the planes are being synced.
+     */
+    void releasePersistentLodPlanes();
+
     void generateLodCloneDevice(KisPaintDeviceSP dst, const QRect &originalRect, int lod);
 
     void setProjectionDevice(bool value);
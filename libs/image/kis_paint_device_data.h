@@ -13,6 +13,9 @@
 #include "KoAlwaysInline.h"
 #include "kis_command_utils.h"
 #include "kundo2command.h"
+#include "krita_utils.h"
+#include "KisRunnableStrokeJobUtils.h"
+#include "KisRunnableStrokeJobsInterface.h"
 
 struct DirectDataAccessPolicy {
     DirectDataAccessPolicy(KisDataManager *dataManager, KisIteratorCompleteListener *completionListener)
@@ -66,6 +69,7 @@ public:
           m_cacheInvalidator(this)
         {
             m_cache.setupCache();
+            m_dataManager->setMemoryAccount(rhs->m_dataManager->memoryAccount());
             // WARNING: interstroke data is **not** copied while cloning, that is expected behavior!
         }
 
@@ -162,48 +166,62 @@ public:
                                KoColorConversionTransformation::Intent renderingIntent,
                                KoColorConversionTransformation::ConversionFlags conversionFlags,
                                KUndo2Command *parentCommand,
-                               KoUpdater *updater = nullptr)
+                               KoUpdater *updater = nullptr,
+                               KisRunnableStrokeJobsInterface *jobsInterface = nullptr)
     {
-        using InternalSequentialConstIterator =
-            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-        using InternalSequentialIterator =
-            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-
         if (m_colorSpace == dstColorSpace || *m_colorSpace == *dstColorSpace) {
             return;
         }
 
-        QRect rc = m_dataManager->region().boundingRect();
-
         const int dstPixelSize = dstColorSpace->pixelSize();
         QScopedArrayPointer<quint8> dstDefaultPixel(new quint8[dstPixelSize]);
         memset(dstDefaultPixel.data(), 0, dstPixelSize);
         m_colorSpace->convertPixelsTo(m_dataManager->defaultPixel(), dstDefaultPixel.data(), dstColorSpace, 1, renderingIntent, conversionFlags);
 
         KisDataManagerSP dstDataManager = new KisDataManager(dstPixelSize, dstDefaultPixel.data());
+        dstDataManager->setMemoryAccount(m_dataManager->memoryAccount());
+
+        if (jobsInterface) {
+            /**
+             * Every job converts its own set of tiles, so the jobs never
+             * write into the same tile of the destination data manager.
+             * The color conversion cache hands out a separate transformation
+             * for every thread, so the jobs don't share lcms transforms either.
+             */
+            KisRegion region = m_dataManager->region();
+            region.mergeAllRects();
+
+            const int patchSize = 4 * KisTileData::WIDTH;
+            const QVector<QRect> patches =
+                KritaUtils::splitRegionIntoPatches(region, QSize(patchSize, patchSize));
+
+            KisDataManagerSP srcDataManager = m_dataManager;
+            const KoColorSpace *srcColorSpace = m_colorSpace;
+            KisIteratorCompleteListener *completionListener = cacheInvalidator();
+
+            QVector<KisRunnableStrokeJobData*> jobs;
+
+            Q_FOREACH (const QRect &patch, patches) {
+                KritaUtils::addJobConcurrent(jobs,
+                    [srcDataManager, srcColorSpace, dstDataManager, dstColorSpace,
+                     patch, renderingIntent, conversionFlags, completionListener] () {
+
+                        convertPixels(srcDataManager.data(), srcColorSpace,
+                                      dstDataManager.data(), dstColorSpace,
+                                      patch, renderingIntent, conversionFlags,
+                                      completionListener, nullptr);
+                    });
+            }
 
+            jobsInterface->addRunnableJobs(jobs);
+        } else {
+            const QRect rc = m_dataManager->region().boundingRect();
 
-        if (!rc.isEmpty()) {
-            InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
-            InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager.data(), cacheInvalidator()), rc, updater);
-
-            int nConseqPixels = srcIt.nConseqPixels();
-
-            // since we are accessing data managers directly, the columns are always aligned
-            KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
-
-            while(srcIt.nextPixels(nConseqPixels) &&
-                  dstIt.nextPixels(nConseqPixels)) {
-
-                nConseqPixels = srcIt.nConseqPixels();
-
-                const quint8 *srcData = srcIt.rawDataConst();
-                quint8 *dstData = dstIt.rawData();
-
-                m_colorSpace->convertPixelsTo(srcData, dstData,
-                                              dstColorSpace,
-                                              nConseqPixels,
-                                              renderingIntent, conversionFlags);
+            if (!rc.isEmpty()) {
+                convertPixels(m_dataManager.data(), m_colorSpace,
+                              dstDataManager.data(), dstColorSpace,
+                              rc, renderingIntent, conversionFlags,
+                              cacheInvalidator(), updater);
             }
         }
 
@@ -258,6 +276,7 @@ public:
                     copyContent ?
                     new KisDataManager(*this->dataManager()) :
                     new KisDataManager(this->dataManager()->pixelSize(), this->dataManager()->defaultPixel());
+                newDm->setMemoryAccount(this->dataManager()->memoryAccount());
                 return new SwitchDataManager(this, this->dataManager(), newDm);
             });
     }
@@ -266,6 +285,9 @@ public:
         m_x = srcData->x();
         m_y = srcData->y();
 
+        // the data stays in the same document
+        const qint32 memoryAccount = m_dataManager->memoryAccount();
+
         if (copyContent) {
             m_dataManager = new KisDataManager(*srcData->dataManager());
         } else if (m_dataManager->pixelSize() !=
@@ -289,6 +311,8 @@ public:
             }
         }
 
+        m_dataManager->setMemoryAccount(memoryAccount);
+
         m_levelOfDetail = srcData->levelOfDetail();
         m_colorSpace = srcData->colorSpace();
         m_cache.invalidate();
@@ -362,6 +386,42 @@ public:
 
 
 private:
+    static void convertPixels(KisDataManager *srcDataManager, const KoColorSpace *srcColorSpace,
+                              KisDataManager *dstDataManager, const KoColorSpace *dstColorSpace,
+                              const QRect &rc,
+                              KoColorConversionTransformation::Intent renderingIntent,
+                              KoColorConversionTransformation::ConversionFlags conversionFlags,
+                              KisIteratorCompleteListener *completionListener,
+                              KoUpdater *updater)
+    {
+        using InternalSequentialConstIterator =
+            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
+        using InternalSequentialIterator =
+            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
+
+        InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(srcDataManager, completionListener), rc, updater);
+        InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager, completionListener), rc, updater);
+
+        int nConseqPixels = srcIt.nConseqPixels();
+
+        // since we are accessing data managers directly, the columns are always aligned
+        KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+
+        while(srcIt.nextPixels(nConseqPixels) &&
+              dstIt.nextPixels(nConseqPixels)) {
+
+            nConseqPixels = srcIt.nConseqPixels();
+
+            const quint8 *srcData = srcIt.rawDataConst();
+            quint8 *dstData = dstIt.rawData();
+
+            srcColorSpace->convertPixelsTo(srcData, dstData,
+                                           dstColorSpace,
+                                           nConseqPixels,
+                                           renderingIntent, conversionFlags);
+        }
+    }
+
     struct CacheInvalidator : public KisIteratorCompleteListener {
         CacheInvalidator(KisPaintDeviceData *_q) : q(_q) {}
 
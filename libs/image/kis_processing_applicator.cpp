@@ -231,6 +231,7 @@ KisProcessingApplicator::KisProcessingApplicator(KisImageWSP image,
       m_node(node),
       m_flags(flags),
       m_emitSignals(emitSignals),
+      m_jobsInterface(0),
       m_finalSignalsEmitted(false),
       m_sharedAllFramesToken(new bool(false))
 {
@@ -247,6 +248,7 @@ KisProcessingApplicator::KisProcessingApplicator(KisImageWSP image,
 
     strategy->setMacroId(macroId);
 
+    m_jobsInterface = strategy->runnableJobsInterface();
     m_strokeId = m_image->startStroke(strategy);
     if(!m_emitSignals.isEmpty()) {
         applyCommand(new EmitImageSignalsCommand(m_image, m_emitSignals, false), KisStrokeJobData::BARRIER);
@@ -276,6 +278,8 @@ void KisProcessingApplicator::applyVisitor(KisProcessingVisitorSP visitor,
                                            KisStrokeJobData::Sequentiality sequentiality,
                                            KisStrokeJobData::Exclusivity exclusivity)
 {
+    visitor->setRunnableJobsInterface(m_jobsInterface);
+
     KUndo2Command *initCommand = visitor->createInitCommand();
     if (initCommand) {
         applyCommand(initCommand,
@@ -297,6 +301,8 @@ void KisProcessingApplicator::applyVisitorAllFrames(KisProcessingVisitorSP visit
 {
     *m_sharedAllFramesToken = true;
 
+    visitor->setRunnableJobsInterface(m_jobsInterface);
+
     KUndo2Command *initCommand = visitor->createInitCommand();
     if (initCommand) {
         applyCommand(initCommand,
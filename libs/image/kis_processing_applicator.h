@@ -15,6 +15,8 @@
 #include "kundo2magicstring.h"
 #include "kundo2commandextradata.h"
 
+class KisRunnableStrokeJobsInterface;
+
 
 class KRITAIMAGE_EXPORT KisProcessingApplicator
 {
@@ -98,6 +100,7 @@ private:
     ProcessingFlags m_flags;
     KisImageSignalVector m_emitSignals;
     KisStrokeId m_strokeId;
+    KisRunnableStrokeJobsInterface *m_jobsInterface;
     bool m_finalSignalsEmitted;
     QSharedPointer<bool> m_sharedAllFramesToken;
 };
@@ -12,6 +12,16 @@
 #include "kis_node.h"
 #include <KLocalizedString>
 
+KisRunnableStrokeJobsInterface* KisProcessingVisitor::runnableJobsInterface() const
+{
+    return m_runnableJobsInterface;
+}
+
+void KisProcessingVisitor::setRunnableJobsInterface(KisRunnableStrokeJobsInterface *jobsInterface)
+{
+    m_runnableJobsInterface = jobsInterface;
+}
+
 KisProcessingVisitor::ProgressHelper::ProgressHelper(const KisNode *node)
 {
     KisNodeProgressProxy *progressProxy = node->nodeProgressProxy();
@@ -28,6 +28,7 @@ class KisSelectionMask;
 class KisGeneratorLayer;
 class KisColorizeMask;
 class KUndo2Command;
+class KisRunnableStrokeJobsInterface;
 
 /**
  * A visitor that processes a single layer; it does not recurse into the
@@ -59,6 +60,19 @@ public:
      */
     virtual KUndo2Command* createInitCommand();
 
+    /**
+     * When the visitor is run by KisProcessingApplicator, the applicator
+     * sets the jobs interface of its stroke. A visitor may use it to split
+     * the processing of a single node into several concurrent jobs. The
+     * jobs are guaranteed to be completed before the next barrier job of
+     * the stroke.
+     *
+     * Returns null when the visitor is not run in a stroke, then the
+     * processing should be done synchronously.
+     */
+    KisRunnableStrokeJobsInterface* runnableJobsInterface() const;
+    void setRunnableJobsInterface(KisRunnableStrokeJobsInterface *jobsInterface);
+
 public:
     class KRITAIMAGE_EXPORT ProgressHelper {
     public:
@@ -70,6 +84,9 @@ public:
         KoProgressUpdater *m_progressUpdater;
         mutable QMutex m_progressMutex;
     };
+
+private:
+    KisRunnableStrokeJobsInterface *m_runnableJobsInterface = 0;
 };
 
 #endif /* __KIS_PROCESSING_VISITOR_H */
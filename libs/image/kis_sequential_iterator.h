@@ -21,10 +21,16 @@ struct DevicePolicy {
     DevicePolicy(Convertible sel) : m_dev(sel) {}
 
     KisHLineConstIteratorSP createConstIterator(const QRect &rect) {
+        /**
+         * The sequential iterator will walk through the entire rect,
+         * so we can start loading the swapped-out tiles beforehand
+         */
+        m_dev->prefetchSwappedTiles(rect);
         return m_dev->createHLineConstIteratorNG(rect.x(), rect.y(), rect.width());
     }
 
     KisHLineIteratorSP createIterator(const QRect &rect) {
+        m_dev->prefetchSwappedTiles(rect);
         return m_dev->createHLineIteratorNG(rect.x(), rect.y(), rect.width());
     }
 
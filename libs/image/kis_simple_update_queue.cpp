@@ -7,11 +7,15 @@
 #include "kis_simple_update_queue.h"
 
 #include <QMutexLocker>
+#include <QRegion>
 #include <QVector>
 
+#include "KisRectsGrid.h"
+#include "KisRegion.h"
 #include "kis_image_config.h"
 #include "kis_full_refresh_walker.h"
 #include "kis_spontaneous_job.h"
+#include "KisUpdatePipelineTracer.h"
 
 
 //#define ENABLE_DEBUG_JOIN
@@ -41,6 +45,62 @@
 #endif /* ENABLE_ACCUMULATOR */
 
 
+//#define ENABLE_DEBUG_COALESCING
+
+#ifdef ENABLE_DEBUG_COALESCING
+    #define DEBUG_COALESCING(requestedRects, queuedRects, coalescedRects, stats) \
+        dbgKrita << "Rects were coalesced:\t"                                \
+                 << (requestedRects) << "+" << (queuedRects) << "->"         \
+                 << (coalescedRects)                                         \
+                 << "(wasted:" << (stats).wastedArea()                       \
+                 << "of" << (stats).processedArea << ")"
+#else
+    #define DEBUG_COALESCING(requestedRects, queuedRects, coalescedRects, stats)
+#endif /* ENABLE_DEBUG_COALESCING */
+
+
+namespace {
+
+qint64 rectArea(const QRect &rc)
+{
+    return qint64(rc.width()) * rc.height();
+}
+
+qint64 regionArea(const QRegion &region)
+{
+    qint64 area = 0;
+
+    for (const QRect &rc : region) {
+        area += rectArea(rc);
+    }
+
+    return area;
+}
+
+KisBaseRectsWalkerSP createWalker(KisNodeSP node, const QRect &rc,
+                                  const QRect &cropRect,
+                                  KisBaseRectsWalker::UpdateType type)
+{
+    KisBaseRectsWalkerSP walker;
+
+    if (type == KisBaseRectsWalker::UPDATE) {
+        walker = new KisMergeWalker(cropRect, KisMergeWalker::DEFAULT);
+    }
+    else if (type == KisBaseRectsWalker::FULL_REFRESH)  {
+        walker = new KisFullRefreshWalker(cropRect);
+    }
+    else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
+        walker = new KisMergeWalker(cropRect, KisMergeWalker::NO_FILTHY);
+    }
+    /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
+
+    walker->collectRects(node, rc);
+    return walker;
+}
+
+}
+
+
 KisSimpleUpdateQueue::KisSimpleUpdateQueue()
     : m_overrideLevelOfDetail(-1)
 {
@@ -68,6 +128,8 @@ void KisSimpleUpdateQueue::updateSettings()
     m_maxCollectAlpha = config.maxCollectAlpha();
     m_maxMergeAlpha = config.maxMergeAlpha();
     m_maxMergeCollectAlpha = config.maxMergeCollectAlpha();
+
+    m_coalescingGridSize = config.updateCoalescingGridSize();
 }
 
 int KisSimpleUpdateQueue::overrideLevelOfDetail() const
@@ -181,29 +243,20 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
                                   int levelOfDetail,
                                   KisBaseRectsWalker::UpdateType type)
 {
+    if (m_coalescingGridSize > 0) {
+        addCoalescedJob(node, rects, cropRect, levelOfDetail, type);
+        return;
+    }
+
     QList<KisBaseRectsWalkerSP> walkers;
 
     Q_FOREACH (const QRect &rc, rects) {
         if (rc.isEmpty()) continue;
 
-        KisBaseRectsWalkerSP walker;
-
         if(trySplitJob(node, rc, cropRect, levelOfDetail, type)) continue;
         if(tryMergeJob(node, rc, cropRect, levelOfDetail, type)) continue;
 
-        if (type == KisBaseRectsWalker::UPDATE) {
-            walker = new KisMergeWalker(cropRect, KisMergeWalker::DEFAULT);
-        }
-        else if (type == KisBaseRectsWalker::FULL_REFRESH)  {
-            walker = new KisFullRefreshWalker(cropRect);
-        }
-        else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
-            walker = new KisMergeWalker(cropRect, KisMergeWalker::NO_FILTHY);
-        }
-        /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
-
-        walker->collectRects(node, rc);
-        walkers.append(walker);
+        walkers.append(createWalker(node, rc, cropRect, type));
     }
 
     if (!walkers.isEmpty()) {
@@ -213,6 +266,153 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
     }
 }
 
+void KisSimpleUpdateQueue::addCoalescedJob(KisNodeSP node, const QVector<QRect> &rects,
+                                           const QRect& cropRect,
+                                           int levelOfDetail,
+                                           KisBaseRectsWalker::UpdateType type)
+{
+    QVector<QRect> requestedRects;
+    requestedRects.reserve(rects.size());
+
+    Q_FOREACH (const QRect &rc, rects) {
+        if (!rc.isEmpty()) {
+            requestedRects.append(rc);
+        }
+    }
+
+    if (requestedRects.isEmpty()) return;
+
+    KisRectsGrid grid(m_coalescingGridSize);
+    QVector<QRect> cells;
+
+    Q_FOREACH (const QRect &rc, requestedRects) {
+        cells += grid.addRect(rc);
+    }
+
+    const KisRegion requestedCells(cells);
+    QVector<QRect> queuedRects;
+
+    m_lock.lock();
+
+    /**
+     * The queued walkers of the same kind that share at least one
+     * grid cell with the new rects are taken out of the queue and
+     * coalesced together with the new rects.
+     *
+     * The new walkers are added to the tail of the queue, which is
+     * fine, since the queued walkers haven't been started yet.
+     */
+    KisMutableWalkersListIterator iter(m_updatesList);
+
+    while(iter.hasNext()) {
+        KisBaseRectsWalkerSP item = iter.next();
+
+        if(item->startNode() != node) continue;
+        if(item->type() != type) continue;
+        if(item->cropRect() != cropRect) continue;
+        if(item->levelOfDetail() != levelOfDetail) continue;
+
+        const QRect alignedRect = grid.alignRect(item->requestedRect());
+
+        Q_FOREACH (const QRect &cellsRect, requestedCells.rects()) {
+            if (cellsRect.intersects(alignedRect)) {
+                queuedRects.append(item->requestedRect());
+                iter.remove();
+                break;
+            }
+        }
+    }
+
+    Q_FOREACH (const QRect &rc, queuedRects) {
+        cells += grid.addRect(rc);
+    }
+
+    const QVector<QRect> coalescedRects =
+        coalesceRects(requestedRects + queuedRects, KisRegion(cells));
+
+    /**
+     * The pixels that are already covered by the queued walkers
+     * were accounted when these walkers were added
+     */
+    QRegion queuedRegion;
+    qint64 queuedArea = 0;
+
+    Q_FOREACH (const QRect &rc, queuedRects) {
+        queuedRegion += rc;
+        queuedArea += rectArea(rc);
+    }
+
+    QRegion requestedRegion;
+    Q_FOREACH (const QRect &rc, requestedRects) {
+        requestedRegion += rc;
+    }
+
+    qint64 coalescedArea = 0;
+    Q_FOREACH (const QRect &rc, coalescedRects) {
+        coalescedArea += rectArea(rc);
+    }
+
+    m_coalescingStatistics.requestedArea += regionArea(requestedRegion - queuedRegion);
+    m_coalescingStatistics.processedArea += coalescedArea - queuedArea;
+    m_coalescingStatistics.numRequestedRects += requestedRects.size();
+    m_coalescingStatistics.numMergedWalkers += queuedRects.size();
+
+    DEBUG_COALESCING(requestedRects, queuedRects, coalescedRects, m_coalescingStatistics);
+
+    m_lock.unlock();
+
+    QList<KisBaseRectsWalkerSP> walkers;
+
+    Q_FOREACH (const QRect &rc, coalescedRects) {
+        const QVector<QRect> patches =
+            rc.width() <= m_patchWidth || rc.height() <= m_patchHeight ?
+            QVector<QRect>({rc}) : splitIntoPatches(rc);
+
+        Q_FOREACH (const QRect &patch, patches) {
+            walkers.append(createWalker(node, patch, cropRect, type));
+        }
+    }
+
+    m_lock.lock();
+    m_updatesList.append(walkers);
+    m_coalescingStatistics.numWalkers += walkers.size();
+    const CoalescingStatistics statistics = m_coalescingStatistics;
+    m_lock.unlock();
+
+    KisUpdatePipelineTracer *tracer = KisUpdatePipelineTracer::instance();
+    if (tracer && tracer->isEnabled()) {
+        tracer->addCounter("updates", "update coalescing",
+                           {{"requested area", statistics.requestedArea},
+                            {"wasted area", statistics.wastedArea()}});
+    }
+}
+
+QVector<QRect> KisSimpleUpdateQueue::coalesceRects(const QVector<QRect> &rects,
+                                                   const KisRegion &cells)
+{
+    QVector<QRect> result;
+
+    /**
+     * The rects of the region are aligned to the grid and never
+     * intersect, so the walkers never share a tile. But there is no
+     * need to process the whole cells, only the bounding rect of the
+     * requested pixels inside each of them.
+     */
+    Q_FOREACH (const QRect &cellsRect, cells.rects()) {
+        QRect coalescedRect;
+
+        Q_FOREACH (const QRect &rc, rects) {
+            coalescedRect |= rc & cellsRect;
+        }
+
+        if (!coalescedRect.isEmpty()) {
+            result.append(coalescedRect);
+        }
+    }
+
+    return result;
+}
+
 void KisSimpleUpdateQueue::addSpontaneousJob(KisSpontaneousJob *spontaneousJob)
 {
     QMutexLocker locker(&m_lock);
@@ -256,6 +456,16 @@ bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
 
     // a bit of recursive splitting...
 
+    const QVector<QRect> splitRects = splitIntoPatches(rc);
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!splitRects.isEmpty());
+    addJob(node, splitRects, cropRect, levelOfDetail, type);
+
+    return true;
+}
+
+QVector<QRect> KisSimpleUpdateQueue::splitIntoPatches(const QRect &rc) const
+{
     qint32 firstCol = rc.x() / m_patchWidth;
     qint32 firstRow = rc.y() / m_patchHeight;
 
@@ -269,14 +479,14 @@ bool KisSimpleUpdateQueue::trySplitJob(KisNodeSP node, const QRect& rc,
             QRect maxPatchRect(j * m_patchWidth, i * m_patchHeight,
                                m_patchWidth, m_patchHeight);
             QRect patchRect = rc & maxPatchRect;
-            splitRects.append(patchRect);
+
+            if (!patchRect.isEmpty()) {
+                splitRects.append(patchRect);
+            }
         }
     }
 
-    KIS_SAFE_ASSERT_RECOVER_NOOP(!splitRects.isEmpty());
-    addJob(node, splitRects, cropRect, levelOfDetail, type);
-
-    return true;
+    return splitRects;
 }
 
 bool KisSimpleUpdateQueue::tryMergeJob(KisNodeSP node, const QRect& rc,
@@ -386,6 +596,18 @@ bool KisSimpleUpdateQueue::joinRects(QRect& baseRect,
     return result;
 }
 
+KisSimpleUpdateQueue::CoalescingStatistics KisSimpleUpdateQueue::coalescingStatistics() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_coalescingStatistics;
+}
+
+void KisSimpleUpdateQueue::resetCoalescingStatistics()
+{
+    QMutexLocker locker(&m_lock);
+    m_coalescingStatistics = CoalescingStatistics();
+}
+
 KisWalkersList& KisTestableSimpleUpdateQueue::getWalkersList()
 {
     return m_updatesList;
@@ -9,11 +9,14 @@
 
 #include <QMutex>
 #include "kis_updater_context.h"
+#include "KisUpdateCoalescingStatistics.h"
 
 typedef QList<KisBaseRectsWalkerSP> KisWalkersList;
 typedef QListIterator<KisBaseRectsWalkerSP> KisWalkersListIterator;
 typedef QMutableListIterator<KisBaseRectsWalkerSP> KisMutableWalkersListIterator;
 
+class KisRegion;
+
 typedef QList<KisSpontaneousJob*> KisSpontaneousJobsList;
 typedef QListIterator<KisSpontaneousJob*> KisSpontaneousJobsListIterator;
 typedef QMutableListIterator<KisSpontaneousJob*> KisMutableSpontaneousJobsListIterator;
@@ -21,6 +24,9 @@ typedef QMutableListIterator<KisSpontaneousJob*> KisMutableSpontaneousJobsListIt
 
 class KRITAIMAGE_EXPORT KisSimpleUpdateQueue
 {
+public:
+    using CoalescingStatistics = KisUpdateCoalescingStatistics;
+
 public:
     KisSimpleUpdateQueue();
     virtual ~KisSimpleUpdateQueue();
@@ -45,13 +51,25 @@ public:
 
     int overrideLevelOfDetail() const;
 
+    CoalescingStatistics coalescingStatistics() const;
+    void resetCoalescingStatistics();
+
+    /**
+     * Coalesces possibly overlapping \p rects into a set of
+     * non-overlapping rects, one per rect of \p cells. The cells should
+     * be aligned to a grid and cover all the \p rects.
+     */
+    static QVector<QRect> coalesceRects(const QVector<QRect> &rects, const KisRegion &cells);
+
 protected:
     void addJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
+    void addCoalescedJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
 
     bool processOneJob(KisUpdaterContext &updaterContext);
 
     bool trySplitJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
     bool tryMergeJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
+    QVector<QRect> splitIntoPatches(const QRect &rc) const;
 
     void collectJobs(KisBaseRectsWalkerSP &baseWalker, QRect baseRect,
                      const qreal maxAlpha);
@@ -92,6 +110,16 @@ protected:
      */
     qreal m_maxMergeCollectAlpha;
 
+    /**
+     * The size of the grid the update rects are coalesced on. The
+     * rects that share a cell of the grid are merged into a single
+     * walker, the walkers never share a cell. Zero means the rects
+     * are merged with the alpha heuristic in tryMergeJob().
+     */
+    int m_coalescingGridSize;
+
+    CoalescingStatistics m_coalescingStatistics;
+
     int m_overrideLevelOfDetail;
 };
 
@@ -12,6 +12,7 @@
 #include "kis_layer_utils.h"
 #include "kis_pointer_utils.h"
 #include "KisRunnableStrokeJobUtils.h"
+#include "KisUpdatePipelineTracer.h"
 
 struct KisSyncLodCacheStrokeStrategy::Private
 {
@@ -43,7 +44,13 @@ KisSyncLodCacheStrokeStrategy::~KisSyncLodCacheStrokeStrategy()
 void KisSyncLodCacheStrokeStrategy::initStrokeCallback()
 {
     QVector<KisStrokeJobData *> jobs;
-    createJobsData(jobs, m_d->image->root(), m_d->image->currentLevelOfDetail());
+
+    /**
+     * Forgettable syncs are started in idle time, so we also use
+     * them to bring the persistent LoD planes of other levels up
+     * to date
+     */
+    createJobsData(jobs, m_d->image->root(), m_d->image->currentLevelOfDetail(), {}, canForgetAboutMe());
     addMutatedJobs(jobs);
 }
 
@@ -53,13 +60,14 @@ QList<KisStrokeJobData*> KisSyncLodCacheStrokeStrategy::createJobsData(KisImageW
     return {};
 }
 
-void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, int levelOfDetail, KisPaintDeviceList extraDevices)
+void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, int levelOfDetail, KisPaintDeviceList extraDevices, bool syncAllPersistentLevels)
 {
     using KisLayerUtils::recursiveApplyNodes;
     using KritaUtils::splitRegionIntoPatches;
     using KritaUtils::optimalPatchSize;
 
-    using SharedData = QHash<KisPaintDeviceSP, QSharedPointer<KisPaintDevice::LodDataStruct>>;
+    using LodDataStructSP = QSharedPointer<KisPaintDevice::LodDataStruct>;
+    using SharedData = QVector<std::pair<KisPaintDeviceSP, LodDataStructSP>>;
     using SharedDataSP = QSharedPointer<SharedData>;
 
     SharedDataSP sharedData(new SharedData());
@@ -74,25 +82,40 @@ void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &
     KritaUtils::makeContainerUnique(deviceList);
 
 
-    KritaUtils::addJobBarrier(jobs, [sharedData, deviceList, levelOfDetail] () mutable {
-        Q_FOREACH (KisPaintDeviceSP device, deviceList) {
-            sharedData->insert(device, toQShared(device->createLodDataStruct(levelOfDetail)));
+    /**
+     * The jobs are created in a barrier job, so we can create the
+     * LoD structs right here. The devices keep persistent LoD planes,
+     * so only the tiles that changed since the previous sync are
+     * regenerated.
+     */
+    Q_FOREACH (KisPaintDeviceSP device, deviceList) {
+        QVector<int> levels = {levelOfDetail};
+
+        if (syncAllPersistentLevels) {
+            levels += device->persistentLodLevels();
+            KritaUtils::makeContainerUnique(levels);
         }
-    });
 
-    KritaUtils::addJobSequential(jobs, [](){});
+        Q_FOREACH (int lod, levels) {
+            LodDataStructSP data = toQShared(device->createPersistentLodDataStruct(lod));
+            sharedData->append(std::make_pair(device, data));
 
-    Q_FOREACH (KisPaintDeviceSP device, deviceList) {
-        KisRegion region = device->regionForLodSyncing();
-        QVector<QRect> rects = splitRegionIntoPatches(region, optimalPatchSize());
+            KisRegion region = device->regionForLodSyncing(data.data());
+            QVector<QRect> rects = splitRegionIntoPatches(region, optimalPatchSize());
+
+            Q_FOREACH (const QRect &rc, rects) {
+                KritaUtils::addJobConcurrent(jobs, [device, data, rc, lod] () mutable {
+                    KisUpdatePipelineTraceScope traceScope("lod sync");
 
-        Q_FOREACH (const QRect &rc, rects) {
-            KritaUtils::addJobConcurrent(jobs, [sharedData, device, rc] () mutable {
-                KIS_ASSERT(sharedData->contains(device));
+                    if (traceScope.isActive()) {
+                        traceScope.setName("Sync LoD Data");
+                        traceScope.addArg("rect", rc);
+                        traceScope.addArg("levelOfDetail", lod);
+                    }
 
-                KisPaintDevice::LodDataStruct *data = sharedData->value(device).data();
-                device->updateLodDataStruct(data, rc);
-            });
+                    device->updateLodDataStruct(data.data(), rc);
+                });
+            }
         }
     }
 
@@ -101,17 +124,19 @@ void KisSyncLodCacheStrokeStrategy::createJobsData(QVector<KisStrokeJobData *> &
     recursiveApplyNodes(imageRoot,
         [&jobs](KisNodeSP node) {
              KritaUtils::addJobConcurrent(jobs, [node] () mutable {
+                 KisUpdatePipelineTraceScope traceScope("lod sync");
+
+                 if (traceScope.isActive()) {
+                     traceScope.setName(QString("Sync LoD Cache: %1").arg(node->name()));
+                 }
+
                  node->syncLodCache();
              });
         });
 
     KritaUtils::addJobSequential(jobs, [sharedData] () mutable {
-        auto it = sharedData->begin();
-        auto end = sharedData->end();
-
-        for (; it != end; ++it) {
-            KisPaintDeviceSP dev = it.key();
-            dev->uploadLodDataStruct(it.value().data());
+        Q_FOREACH (const auto &pair, *sharedData) {
+            pair.first->uploadLodDataStruct(pair.second.data());
         }
     });
 }
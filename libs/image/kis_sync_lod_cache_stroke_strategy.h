@@ -20,7 +20,13 @@ public:
 
     static QList<KisStrokeJobData*> createJobsData(KisImageWSP image);
 
-    static void createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, int levelOfDetail, KisPaintDeviceList extraDevices = {});
+    /**
+     * Creates the jobs syncing the persistent LoD planes of all the
+     * nodes and \p extraDevices at \p levelOfDetail. If
+     * \p syncAllPersistentLevels is true, the planes of all the other
+     * levels the devices have are synced as well.
+     */
+    static void createJobsData(QVector<KisStrokeJobData *> &jobs, KisNodeSP imageRoot, int levelOfDetail, KisPaintDeviceList extraDevices = {}, bool syncAllPersistentLevels = false);
 
 private:
     void initStrokeCallback() override;
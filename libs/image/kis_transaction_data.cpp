@@ -173,6 +173,13 @@ void KisTransactionData::endTransaction()
 
         DEBUG_ACTION("Transaction ended");
         m_d->transactionFinished = true;
+
+        /**
+         * Flat fills and opaque masks produce a lot of single-color
+         * tiles, let them share one tile data before the tiles are
+         * committed into history
+         */
+        m_d->savedDataManager->shareUniformTiles(m_d->memento->extent());
         m_d->savedDataManager->commit();
         m_d->newOffset = QPoint(m_d->device->x(), m_d->device->y());
         m_d->defaultPixelChanged = m_d->oldDefaultPixel != m_d->device->defaultPixel();
@@ -350,6 +357,14 @@ void KisTransactionData::undo()
     m_d->newFrameCommand.undo();
 }
 
+qint64 KisTransactionData::memoryUsage() const
+{
+    const qint64 size = m_d->memento ?
+        m_d->savedDataManager->mementoMemorySize(m_d->memento) : 0;
+
+    return size + KUndo2Command::memoryUsage();
+}
+
 void KisTransactionData::saveSelectionOutlineCache()
 {
     m_d->savedOutlineCacheValid = false;
@@ -38,6 +38,8 @@ public:
     void redo() override;
     void undo() override;
 
+    qint64 memoryUsage() const override;
+
     virtual void endTransaction();
 
 protected:
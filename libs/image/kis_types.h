@@ -292,6 +292,9 @@ class KisProjectionLeaf;
 typedef QSharedPointer<KisProjectionLeaf> KisProjectionLeafSP;
 typedef QWeakPointer<KisProjectionLeaf> KisProjectionLeafWSP;
 
+class KisGroupProjectionCache;
+typedef QSharedPointer<KisGroupProjectionCache> KisGroupProjectionCacheSP;
+
 class KisKeyframe;
 typedef QSharedPointer<KisKeyframe> KisKeyframeSP;
 typedef QWeakPointer<KisKeyframe> KisKeyframeWSP;
@@ -17,6 +17,7 @@
 #include "kis_base_rects_walker.h"
 #include "kis_async_merger.h"
 #include "kis_updater_context.h"
+#include "KisUpdatePipelineTracer.h"
 
 //#define DEBUG_JOBS_SEQUENCE
 
@@ -39,6 +40,8 @@ public:
     {
         setAutoDelete(false);
         KIS_SAFE_ASSERT_RECOVER_NOOP(m_atomicType.is_lock_free());
+
+        m_merger.setTaskPool(&m_updaterContext->m_taskPool);
     }
     ~KisUpdateJobItem() override
     {
@@ -87,6 +90,14 @@ public:
                     }
 #endif
 
+                    KisUpdatePipelineTraceScope traceScope(
+                        m_atomicType == Type::STROKE ? "stroke" : "spontaneous");
+
+                    if (traceScope.isActive()) {
+                        traceScope.setName(m_runnableJob->debugName());
+                        traceScope.addArg("exclusive", m_exclusive);
+                    }
+
                     m_runnableJob->run();
                 }
             }
@@ -120,6 +131,21 @@ public:
 
 #endif
 
+        KisUpdatePipelineTraceScope traceScope("merge");
+
+        if (traceScope.isActive()) {
+            QStringList nodes;
+            Q_FOREACH (const KisBaseRectsWalker::JobItem &item, m_walker->leafStack()) {
+                nodes << item.m_leaf->node()->name();
+            }
+
+            traceScope.setName(QString("Merge: %1").arg(m_walker->startNode()->name()));
+            traceScope.addArg("rect", m_walker->requestedRect());
+            traceScope.addArg("changeRect", m_walker->changeRect());
+            traceScope.addArg("levelOfDetail", m_walker->levelOfDetail());
+            traceScope.addArg("nodes", nodes);
+        }
+
         m_merger.startMerge(*m_walker);
 
         QRect changeRect = m_walker->changeRect();
@@ -204,6 +204,16 @@ bool KisUpdateScheduler::hasUpdatesRunning() const
     return !m_d->updatesQueue.isEmpty();
 }
 
+KisUpdateCoalescingStatistics KisUpdateScheduler::updateCoalescingStatistics() const
+{
+    return m_d->updatesQueue.coalescingStatistics();
+}
+
+void KisUpdateScheduler::resetUpdateCoalescingStatistics()
+{
+    m_d->updatesQueue.resetCoalescingStatistics();
+}
+
 KisStrokeId KisUpdateScheduler::startStroke(KisStrokeStrategy *strokeStrategy)
 {
     KisStrokeId id  = m_d->strokesQueue.startStroke(strokeStrategy);
@@ -15,6 +15,7 @@
 #include "kis_stroke_strategy_factory.h"
 #include "kis_strokes_queue_undo_result.h"
 #include "KisLodPreferences.h"
+#include "KisUpdateCoalescingStatistics.h"
 
 class QRect;
 class KoProgressProxy;
@@ -134,6 +135,15 @@ public:
 
     bool hasUpdatesRunning() const;
 
+    /**
+     * Statistics of the coalescing of the update rects collected
+     * since the creation of the scheduler or the last call to
+     * resetUpdateCoalescingStatistics(). The statistics are also
+     * recorded as a counter by KisUpdatePipelineTracer.
+     */
+    KisUpdateCoalescingStatistics updateCoalescingStatistics() const;
+    void resetUpdateCoalescingStatistics();
+
     KisStrokeId startStroke(KisStrokeStrategy *strokeStrategy) override;
     void addJob(KisStrokeId id, KisStrokeJobData *data) override;
     void endStroke(KisStrokeId id) override;
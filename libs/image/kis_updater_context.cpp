@@ -15,7 +15,8 @@
 const int KisUpdaterContext::useIdealThreadCountTag = -1;
 
 KisUpdaterContext::KisUpdaterContext(qint32 threadCount, KisUpdateScheduler *parent)
-    : m_scheduler(parent)
+    : m_taskPool(&m_threadPool),
+      m_scheduler(parent)
 {
     if(threadCount <= 0) {
         threadCount = QThread::idealThreadCount();
@@ -246,6 +247,7 @@ void KisUpdaterContext::jobFinished()
 void KisUpdaterContext::setTestingMode(bool value)
 {
     m_testingMode = value;
+    m_taskPool.setTestingMode(value);
 }
 
 const QVector<KisUpdateJobItem*> KisUpdaterContext::getJobs()
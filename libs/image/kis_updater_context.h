@@ -14,6 +14,7 @@
 #include "kis_base_rects_walker.h"
 #include "kis_async_merger.h"
 #include "kis_lock_free_lod_counter.h"
+#include "KisWorkStealingTaskPool.h"
 
 #include "KisUpdaterContextSnapshotEx.h"
 #include "kis_update_scheduler.h"
@@ -149,6 +150,13 @@ protected:
     QMutex m_lock;
     QVector<KisUpdateJobItem*> m_jobs;
     QThreadPool m_threadPool;
+
+    /**
+     * Bands of the merge jobs, which can be stolen by
+     * the idle threads of m_threadPool
+     */
+    KisWorkStealingTaskPool m_taskPool;
+
     KisLockFreeLodCounter m_lodCounter;
     KisUpdateScheduler *m_scheduler;
     bool m_testingMode = false;
@@ -17,6 +17,7 @@
 #include "kis_painter.h"
 #include "kis_multiple_projection.h"
 #include "KisLayerStyleKnockoutBlower.h"
+#include "KisUpdatePipelineTracer.h"
 
 
 struct KisLayerStyleFilterProjectionPlane::Private
@@ -80,6 +81,13 @@ QRect KisLayerStyleFilterProjectionPlane::recalculate(const QRect& rect, KisNode
         return QRect();
     }
 
+    KisUpdatePipelineTraceScope traceScope("layer style");
+
+    if (traceScope.isActive()) {
+        traceScope.setName(QString("%1: %2").arg(m_d->sourceLayer->name(), m_d->filter->id()));
+        traceScope.addArg("rect", rect);
+    }
+
     m_d->projection.clear(rect);
     m_d->filter->processDirectly(m_d->sourceLayer->projection(),
                                  &m_d->projection,
@@ -59,6 +59,12 @@ void KisConvertColorSpaceProcessingVisitor::visitNodeWithPaintDevice(KisNode *no
 
     KUndo2Command *parentConversionCommand = new KUndo2Command();
 
+    /**
+     * The pixels may be converted asynchronously by the stroke jobs,
+     * so the extent of the layer should be fetched before the conversion
+     */
+    const QRect extent = layer->extent();
+
     if (m_srcColorSpace->colorModelId() != m_dstColorSpace->colorModelId()) {
         alphaDisabled = layer->alphaChannelDisabled();
         new KisChangeChannelFlagsCommand(QBitArray(), layer, parentConversionCommand);
@@ -69,15 +75,15 @@ void KisConvertColorSpaceProcessingVisitor::visitNodeWithPaintDevice(KisNode *no
     }
 
     if (layer->original()) {
-        layer->original()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
+        layer->original()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater(), runnableJobsInterface());
     }
 
     if (layer->paintDevice()) {
-        layer->paintDevice()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
+        layer->paintDevice()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater(), runnableJobsInterface());
     }
 
     if (layer->projection()) {
-        layer->projection()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater());
+        layer->projection()->convertTo(m_dstColorSpace, m_renderingIntent, m_conversionFlags, parentConversionCommand, helper.updater(), runnableJobsInterface());
     }
 
     if (layer && alphaDisabled) {
@@ -91,7 +97,7 @@ void KisConvertColorSpaceProcessingVisitor::visitNodeWithPaintDevice(KisNode *no
     }
 
     undoAdapter->addCommand(parentConversionCommand);
-    layer->invalidateFrames(KisTimeSpan::infinite(0), layer->extent());
+    layer->invalidateFrames(KisTimeSpan::infinite(0), extent);
 }
 
 void KisConvertColorSpaceProcessingVisitor::visit(KisTransformMask *node, KisUndoAdapter *undoAdapter)
@@ -13,6 +13,8 @@
 #include <simpletest.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpace.h>
+#include <KoColor.h>
+#include <KoColorModelStandardIds.h>
 #include "kis_image.h"
 #include "kis_paint_layer.h"
 #include "kis_group_layer.h"
@@ -21,6 +23,8 @@
 #include "kis_filter_mask.h"
 #include "kis_selection.h"
 #include "kis_paint_device_debug_utils.h"
+#include "kis_sequential_iterator.h"
+#include "KisGroupProjectionCache.h"
 #include <KisGlobalResourcesInterface.h>
 
 #include "filter/kis_filter.h"
@@ -497,5 +501,192 @@ void KisAsyncMergerTest::testFilterMaskOnFilterLayer()
 }
 
 
+    /*
+      +-----------+
+      |root       |
+      | paint 4   |
+      | paint 3   |
+      | paint 2   |  <-- filthy
+      | paint 1   |
+      | paint 0   |
+      +-----------+
+     */
+
+struct GroupProjectionCacheTester
+{
+    GroupProjectionCacheTester(const KoColorSpace *_colorSpace, const QSize &size = QSize(256, 256))
+        : colorSpace(_colorSpace),
+          image(new KisImage(0, size.width(), size.height(), colorSpace, "cache test"))
+    {
+        for (int i = 0; i < 5; i++) {
+            KisPaintLayerSP layer = new KisPaintLayer(image, QString("paint%1").arg(i), OPACITY_OPAQUE_U8 - 20 * i);
+
+            const QColor color(50 * i, 255 - 50 * i, 100, 255 - 30 * i);
+            layer->paintDevice()->fill(QRect(30 * i, 20 * i, 150, 150), KoColor(color, colorSpace));
+
+            image->addNode(layer, image->rootLayer());
+            layers << layer;
+        }
+
+        fullRefresh();
+    }
+
+    KisPaintDeviceSP fullRefresh() {
+        KisFullRefreshWalker walker(image->bounds());
+        KisAsyncMerger merger;
+
+        walker.collectRects(image->rootLayer(), image->bounds());
+        merger.startMerge(walker);
+
+        return new KisPaintDevice(*image->projection());
+    }
+
+    KisPaintDeviceSP updateFilthyLayer(const QColor &color) {
+        layers[2]->paintDevice()->fill(dirtyRect, KoColor(color, colorSpace));
+
+        KisMergeWalker walker(image->bounds());
+        walker.collectRects(layers[2], dirtyRect);
+        merger.startMerge(walker);
+
+        return new KisPaintDevice(*image->projection());
+    }
+
+    /**
+     * The first update only selects the split node, the second one
+     * fills the cache and the rest of them use it
+     */
+    KisPaintDeviceSP updateFilthyLayerSeveralTimes() {
+        KisPaintDeviceSP result;
+        for (int i = 0; i < 4; i++) {
+            result = updateFilthyLayer(QColor(60 * i, 0, 255 - 60 * i, 200));
+        }
+        return result;
+    }
+
+    const KoColorSpace *colorSpace;
+    KisImageSP image;
+    QVector<KisPaintLayerSP> layers;
+    QRect dirtyRect = QRect(20, 20, 100, 100);
+    KisAsyncMerger merger;
+};
+
+void KisAsyncMergerTest::testGroupProjectionCache()
+{
+    GroupProjectionCacheTester t(KoColorSpaceRegistry::instance()->rgb8());
+
+    /**
+     * In integer color spaces only the composite of the lower
+     * nodes is cached, so the result should be exactly the same
+     */
+    const QImage cachedResult = t.updateFilthyLayerSeveralTimes()->convertToQImage(0);
+    QCOMPARE(KisGroupProjectionCache::totalMemoryUsage(),
+             qint64(t.dirtyRect.width()) * t.dirtyRect.height() * t.colorSpace->pixelSize());
+
+    QPoint pt;
+    QVERIFY(TestUtil::compareQImages(pt, t.fullRefresh()->convertToQImage(0), cachedResult));
+
+    /**
+     * The full refresh has invalidated the cache, the next update
+     * fills it again and the following one takes the lower nodes
+     * from the cache, so it doesn't see the changes of the lower
+     * layer that were not followed by an update.
+     */
+    const QImage beforeChange = t.updateFilthyLayer(Qt::green)->convertToQImage(0);
+
+    t.layers[0]->paintDevice()->fill(t.image->bounds(), KoColor(Qt::red, t.colorSpace));
+
+    QVERIFY(TestUtil::compareQImages(pt, beforeChange, t.updateFilthyLayer(Qt::green)->convertToQImage(0)));
+    QVERIFY(!TestUtil::compareQImages(pt, t.fullRefresh()->convertToQImage(0), beforeChange, 1, 1, 0, false));
+}
+
+void KisAsyncMergerTest::testGroupProjectionCacheFloat()
+{
+    const KoColorSpace *colorSpace =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+    GroupProjectionCacheTester t(colorSpace);
+
+    KisPaintDeviceSP cachedResult = t.updateFilthyLayerSeveralTimes();
+
+    // both the lower and the upper nodes are cached
+    QCOMPARE(KisGroupProjectionCache::totalMemoryUsage(),
+             2 * qint64(t.dirtyRect.width()) * t.dirtyRect.height() * colorSpace->pixelSize());
+
+    KisPaintDeviceSP refreshedResult = t.fullRefresh();
+
+    /**
+     * The upper nodes are composited in a different order, so the
+     * result differs by the rounding error of the float channels
+     */
+    float maxDifference = 0.0f;
+
+    KisSequentialConstIterator cachedIt(cachedResult, t.image->bounds());
+    KisSequentialConstIterator refreshedIt(refreshedResult, t.image->bounds());
+
+    while (cachedIt.nextPixel() && refreshedIt.nextPixel()) {
+        const float *cachedPixel = reinterpret_cast<const float*>(cachedIt.oldRawData());
+        const float *refreshedPixel = reinterpret_cast<const float*>(refreshedIt.oldRawData());
+
+        for (int i = 0; i < 4; i++) {
+            maxDifference = qMax(maxDifference, qAbs(cachedPixel[i] - refreshedPixel[i]));
+        }
+    }
+
+    QVERIFY2(maxDifference < 1e-5f, QString("max difference: %1").arg(maxDifference).toLatin1());
+}
+
+void KisAsyncMergerTest::testGroupProjectionCacheMemoryLimit()
+{
+    {
+        KisImageConfig cfg(false);
+        cfg.setGroupProjectionCacheLimit(0);
+    }
+    KisImageConfigNotifier::instance()->notifyConfigChanged();
+
+    {
+        GroupProjectionCacheTester t(KoColorSpaceRegistry::instance()->rgb8());
+
+        const QImage result = t.updateFilthyLayerSeveralTimes()->convertToQImage(0);
+        QCOMPARE(KisGroupProjectionCache::totalMemoryUsage(), qint64(0));
+
+        QPoint pt;
+        QVERIFY(TestUtil::compareQImages(pt, t.fullRefresh()->convertToQImage(0), result));
+    }
+
+    KisImageConfig::resetConfig();
+    KisImageConfigNotifier::instance()->notifyConfigChanged();
+
+    /**
+     * A cache takes the memory of the least recently used one
+     * when there is no free memory left
+     */
+    {
+        KisImageConfig cfg(false);
+        cfg.setGroupProjectionCacheLimit(1);
+    }
+    KisImageConfigNotifier::instance()->notifyConfigChanged();
+
+    {
+        const QSize size(512, 400);
+        const qint64 cacheSize = qint64(size.width()) * size.height() * 4;
+
+        GroupProjectionCacheTester t1(KoColorSpaceRegistry::instance()->rgb8(), size);
+        GroupProjectionCacheTester t2(KoColorSpaceRegistry::instance()->rgb8(), size);
+        t1.dirtyRect = t1.image->bounds();
+        t2.dirtyRect = t2.image->bounds();
+
+        t1.updateFilthyLayerSeveralTimes();
+        QCOMPARE(KisGroupProjectionCache::totalMemoryUsage(), cacheSize);
+
+        const QImage result = t2.updateFilthyLayerSeveralTimes()->convertToQImage(0);
+        QCOMPARE(KisGroupProjectionCache::totalMemoryUsage(), cacheSize);
+
+        QPoint pt;
+        QVERIFY(TestUtil::compareQImages(pt, t2.fullRefresh()->convertToQImage(0), result));
+    }
+
+    KisImageConfig::resetConfig();
+    KisImageConfigNotifier::instance()->notifyConfigChanged();
+}
+
 SIMPLE_TEST_MAIN(KisAsyncMergerTest)
 
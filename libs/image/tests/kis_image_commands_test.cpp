@@ -8,10 +8,63 @@
 
 #include <simpletest.h>
 #include "commands/kis_image_commands.h"
+#include <kundo2stack.h>
 
 void KisImageCommandsTest::testCreation()
 {
 }
 
+struct FixedMemoryCommand : public KUndo2Command
+{
+    FixedMemoryCommand(qint64 usage) : m_usage(usage) {}
+
+    qint64 memoryUsage() const override {
+        return m_usage;
+    }
+
+    qint64 m_usage;
+};
+
+void KisImageCommandsTest::testUndoMemoryLimit()
+{
+    KUndo2Stack stack;
+
+    for (int i = 0; i < 10; i++) {
+        stack.push(new FixedMemoryCommand(100));
+    }
+
+    QCOMPARE(stack.count(), 10);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(1000));
+
+    // the limit is applied on the next push
+    stack.setUndoMemoryLimit(450);
+    QCOMPARE(stack.count(), 10);
+
+    stack.push(new FixedMemoryCommand(100));
+    QCOMPARE(stack.count(), 4);
+    QCOMPARE(stack.index(), 4);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(400));
+
+    stack.push(new FixedMemoryCommand(200));
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(400));
+
+    // the redo commands are released on push
+    stack.undo();
+    stack.undo();
+    stack.push(new FixedMemoryCommand(50));
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(150));
+
+    // the most recent command is never dropped
+    stack.push(new FixedMemoryCommand(1000));
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(1000));
+
+    stack.clear();
+    QCOMPARE(stack.count(), 0);
+    QCOMPARE(stack.undoMemoryUsage(), qint64(0));
+}
+
 
 SIMPLE_TEST_MAIN(KisImageCommandsTest)
@@ -15,6 +15,7 @@ class KisImageCommandsTest : public QObject
 private Q_SLOTS:
 
     void testCreation();
+    void testUndoMemoryLimit();
 
 };
 
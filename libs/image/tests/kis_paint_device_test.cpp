@@ -1528,6 +1528,100 @@ void KisPaintDeviceTest::testLodDevice()
                                   "lod", "lod1-offset-6-14"));
 }
 
+KisRegion syncPersistentLodCache(KisPaintDeviceSP dev, int levelOfDetail)
+{
+    KisPaintDevice::LodDataStruct* s = dev->createPersistentLodDataStruct(levelOfDetail);
+
+    KisRegion region = dev->regionForLodSyncing(s);
+    Q_FOREACH(QRect rect2, KritaUtils::splitRegionIntoPatches(region, KritaUtils::optimalPatchSize())) {
+        dev->updateLodDataStruct(s, rect2);
+    }
+
+    dev->uploadLodDataStruct(s);
+    delete s;
+
+    return region;
+}
+
+void KisPaintDeviceTest::testPersistentLodDevice()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    TestingLodDefaultBounds *bounds = new TestingLodDefaultBounds();
+    dev->setDefaultBounds(bounds);
+
+    fillGradientDevice(dev, QRect(0,0,200,200));
+    const KisRegion fullRegion = dev->regionForLodSyncing();
+
+    QImage persistentResult;
+    QImage freshResult;
+
+    // the first sync regenerates the whole plane
+    bounds->testingSetLevelOfDetail(1);
+    QCOMPARE(syncPersistentLodCache(dev, 1).boundingRect(), fullRegion.boundingRect());
+    QCOMPARE(dev->persistentLodLevels(), QVector<int>({1}));
+
+    persistentResult = dev->convertToQImage(0,0,0,100,100);
+    syncLodCache(dev, 1);
+    freshResult = dev->convertToQImage(0,0,0,100,100);
+    QCOMPARE(persistentResult, freshResult);
+
+    // nothing has changed, nothing to sync
+    QVERIFY(syncPersistentLodCache(dev, 1).isEmpty());
+
+    // only the changed tile is synced
+    bounds->testingSetLevelOfDetail(0);
+    dev->fill(QRect(10,10,20,20), KoColor(Qt::red, cs));
+
+    bounds->testingSetLevelOfDetail(1);
+    QCOMPARE(syncPersistentLodCache(dev, 1).boundingRect(), QRect(0,0,64,64));
+
+    persistentResult = dev->convertToQImage(0,0,0,100,100);
+    syncLodCache(dev, 1);
+    freshResult = dev->convertToQImage(0,0,0,100,100);
+    QCOMPARE(persistentResult, freshResult);
+
+    // a plane of a non-current level is synced, but not uploaded
+    QCOMPARE(syncPersistentLodCache(dev, 2).boundingRect(), fullRegion.boundingRect());
+    QCOMPARE(dev->persistentLodLevels(), QVector<int>({1, 2}));
+    QCOMPARE(dev->convertToQImage(0,0,0,100,100), freshResult);
+
+    // a removed tile is synced as well
+    bounds->testingSetLevelOfDetail(0);
+    dev->clear(QRect(64,64,64,64));
+
+    bounds->testingSetLevelOfDetail(1);
+    QCOMPARE(syncPersistentLodCache(dev, 1).boundingRect(), QRect(64,64,64,64));
+
+    persistentResult = dev->convertToQImage(0,0,0,100,100);
+    syncLodCache(dev, 1);
+    freshResult = dev->convertToQImage(0,0,0,100,100);
+    QCOMPARE(persistentResult, freshResult);
+
+    // moving the device regenerates the whole plane
+    bounds->testingSetLevelOfDetail(0);
+    dev->setX(20);
+    dev->setY(10);
+
+    bounds->testingSetLevelOfDetail(1);
+    QCOMPARE(syncPersistentLodCache(dev, 1).boundingRect(),
+             fullRegion.boundingRect().translated(20, 10));
+
+    persistentResult = dev->convertToQImage(0,0,0,100,100);
+    syncLodCache(dev, 1);
+    freshResult = dev->convertToQImage(0,0,0,100,100);
+    QCOMPARE(persistentResult, freshResult);
+
+    // released planes are regenerated from scratch
+    dev->releasePersistentLodPlanes();
+    QVERIFY(dev->persistentLodLevels().isEmpty());
+
+    QCOMPARE(syncPersistentLodCache(dev, 1).boundingRect(),
+             fullRegion.boundingRect().translated(20, 10));
+    QCOMPARE(dev->convertToQImage(0,0,0,100,100), freshResult);
+}
+
 void KisPaintDeviceTest::benchmarkLod1Generation()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -231,6 +231,79 @@ void KisSimpleUpdateQueueTest::testMixingTypes()
     QCOMPARE(walkersList[2]->type(), KisBaseRectsWalker::UPDATE_NO_FILTHY);
 }
 
+void KisSimpleUpdateQueueTest::testGridCoalescing()
+{
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->unlock();
+
+    KisTestableSimpleUpdateQueue queue;
+    KisWalkersList& walkersList = queue.getWalkersList();
+
+    /**
+     * The first two rects share the tiles, the third one is far away
+     */
+    queue.addUpdateJob(paintLayer,
+                       QVector<QRect>({QRect(10,10,50,50), QRect(40,40,50,50), QRect(300,300,20,20)}),
+                       imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 2);
+    QVERIFY(checkWalker(walkersList[0], QRect(10,10,80,80)));
+    QVERIFY(checkWalker(walkersList[1], QRect(300,300,20,20)));
+
+    KisSimpleUpdateQueue::CoalescingStatistics stats = queue.coalescingStatistics();
+    QCOMPARE(stats.requestedArea, qint64(5000));
+    QCOMPARE(stats.processedArea, qint64(6800));
+    QCOMPARE(stats.wastedArea(), qint64(1800));
+    QCOMPARE(stats.numRequestedRects, 3);
+    QCOMPARE(stats.numMergedWalkers, 0);
+    QCOMPARE(stats.numWalkers, 2);
+
+    /**
+     * The new rect doesn't intersect the queued walker,
+     * but shares a tile with it
+     */
+    queue.addUpdateJob(paintLayer, QRect(100,100,10,10), imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 2);
+    QVERIFY(checkWalker(walkersList[0], QRect(300,300,20,20)));
+    QVERIFY(checkWalker(walkersList[1], QRect(10,10,100,100)));
+
+    stats = queue.coalescingStatistics();
+    QCOMPARE(stats.requestedArea, qint64(5100));
+    QCOMPARE(stats.processedArea, qint64(10400));
+    QCOMPARE(stats.numRequestedRects, 4);
+    QCOMPARE(stats.numMergedWalkers, 1);
+    QCOMPARE(stats.numWalkers, 3);
+
+    /**
+     * The rect inside the queued walker changes nothing
+     */
+    queue.addUpdateJob(paintLayer, QRect(305,305,10,10), imageRect, 0);
+
+    QCOMPARE(walkersList.size(), 2);
+    QVERIFY(checkWalker(walkersList[0], QRect(10,10,100,100)));
+    QVERIFY(checkWalker(walkersList[1], QRect(300,300,20,20)));
+
+    stats = queue.coalescingStatistics();
+    QCOMPARE(stats.requestedArea, qint64(5100));
+    QCOMPARE(stats.processedArea, qint64(10400));
+    QCOMPARE(stats.numMergedWalkers, 2);
+
+    queue.resetCoalescingStatistics();
+    stats = queue.coalescingStatistics();
+    QCOMPARE(stats.requestedArea, qint64(0));
+    QCOMPARE(stats.processedArea, qint64(0));
+    QCOMPARE(stats.numWalkers, 0);
+}
+
 void KisSimpleUpdateQueueTest::testSpontaneousJobsCompression()
 {
     KisTestableSimpleUpdateQueue queue;
@@ -7,6 +7,10 @@
 #include "kis_update_scheduler_test.h"
 #include <simpletest.h>
 
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 
@@ -23,6 +27,7 @@
 #include "kis_updater_context.h"
 #include "kis_update_job_item.h"
 #include "kis_simple_update_queue.h"
+#include "KisUpdatePipelineTracer.h"
 #include <KisGlobalResourcesInterface.h>
 
 #include "../../sdk/tests/testutil.h"
@@ -400,6 +405,91 @@ void KisUpdateSchedulerTest::testTimeMonitor()
     KisUpdateTimeMonitor::instance()->endStrokeMeasure();
 }
 
+void KisUpdateSchedulerTest::testPipelineTracer()
+{
+    KisImageSP image = buildTestingImage();
+    KisNodeSP rootLayer = image->rootLayer();
+    KisNodeSP paintLayer1 = rootLayer->firstChild();
+
+    image->waitForDone();
+
+    KisUpdatePipelineTracer *tracer = KisUpdatePipelineTracer::instance();
+    tracer->clear();
+    tracer->setEnabled(true);
+
+    KisUpdateScheduler scheduler(image.data());
+    scheduler.updateProjection(paintLayer1, QRect(10,10,100,100), image->bounds());
+    scheduler.waitForDone();
+
+    tracer->setEnabled(false);
+
+    QCOMPARE(scheduler.updateCoalescingStatistics().requestedArea, qint64(10000));
+
+    bool hasMerge = false;
+    bool hasCoalescingCounter = false;
+    QStringList nodeNames;
+
+    Q_FOREACH (const KisUpdatePipelineTracer::Event &event, tracer->events()) {
+        QVERIFY(event.duration >= 0);
+        QVERIFY(event.threadId > 0);
+
+        if (event.phase == 'C') {
+            QCOMPARE(event.name, QString("update coalescing"));
+            QCOMPARE(event.args["requested area"].toLongLong(), qint64(10000));
+            hasCoalescingCounter = true;
+        } else if (!qstrcmp(event.category, "merge")) {
+            QCOMPARE(event.name, QString("Merge: paint1"));
+            QCOMPARE(event.args["rect"], KisUpdatePipelineTracer::rectArg(QRect(10,10,100,100)));
+            QVERIFY(event.args["nodes"].toStringList().contains("blur1"));
+            hasMerge = true;
+        } else if (!qstrcmp(event.category, "node")) {
+            nodeNames << event.name;
+        }
+    }
+
+    QVERIFY(hasMerge);
+    QVERIFY(hasCoalescingCounter);
+    QVERIFY(nodeNames.contains("paint1"));
+    QVERIFY(nodeNames.contains("paint2"));
+    QVERIFY(nodeNames.contains("blur1"));
+
+    const QJsonDocument doc = QJsonDocument::fromJson(tracer->exportChromeTrace());
+    const QJsonArray traceEvents = doc.object()["traceEvents"].toArray();
+
+    int numCompleteEvents = 0;
+    int numCounterEvents = 0;
+
+    Q_FOREACH (const QJsonValue &value, traceEvents) {
+        const QJsonObject object = value.toObject();
+
+        if (object["ph"].toString() == "X") {
+            QVERIFY(object.contains("ts"));
+            QVERIFY(object.contains("dur"));
+            QVERIFY(object.contains("tid"));
+
+            // the arguments are decoded from the compact storage on export
+            if (object["cat"].toString() == "merge") {
+                const QJsonObject args = object["args"].toObject();
+                QCOMPARE(args["rect"].toArray(), QJsonArray({10, 10, 100, 100}));
+                QVERIFY(args["nodes"].toArray().contains("blur1"));
+            }
+
+            numCompleteEvents++;
+        } else if (object["ph"].toString() == "C") {
+            QVERIFY(object.contains("ts"));
+            QVERIFY(object["args"].toObject().contains("wasted area"));
+            numCounterEvents++;
+        } else {
+            QCOMPARE(object["ph"].toString(), QString("M"));
+        }
+    }
+
+    QCOMPARE(numCompleteEvents + numCounterEvents, tracer->events().size());
+
+    tracer->clear();
+    QVERIFY(tracer->events().isEmpty());
+}
+
 void KisUpdateSchedulerTest::testLodSync()
 {
     KisImageSP image = buildTestingImage();
@@ -10,19 +10,29 @@
 #include "kistest.h"
 
 #include <QAtomicInt>
+#include <QMutex>
+#include <QRegion>
+#include <QSet>
+#include <QThread>
+#include <KoColor.h>
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 
 #include "kis_paint_layer.h"
+#include "kis_group_layer.h"
 
 #include "kis_merge_walker.h"
+#include "kis_full_refresh_walker.h"
+#include "kis_async_merger.h"
 #include "kis_updater_context.h"
 #include "kis_image.h"
+#include "KisWorkStealingTaskPool.h"
 
 #include "scheduler_utils.h"
 
 #include "lod_override.h"
 #include "config-limit-long-tests.h"
+#include <testutil.h>
 
 void KisUpdaterContextTest::testJobInterference()
 {
@@ -235,5 +245,111 @@ void KisUpdaterContextTest::stressTestExclusiveJobs()
              << "/" << NUM_CHECKS * NUM_JOBS;
 }
 
+void KisUpdaterContextTest::testSplitIntoBands()
+{
+    // small rects are not split
+    QCOMPARE(KisWorkStealingTaskPool::splitIntoBands(QRect(0,0,100,100), 8).size(), 1);
+    QCOMPARE(KisWorkStealingTaskPool::splitIntoBands(QRect(), 8).size(), 0);
+
+    const QRect rect(-30,-70,1000,500);
+
+    QVector<QRect> bands = KisWorkStealingTaskPool::splitIntoBands(rect, 4);
+    QVERIFY(bands.size() > 1);
+    QVERIFY(bands.size() <= 4);
+
+    QRegion coveredRegion;
+
+    Q_FOREACH (const QRect &band, bands) {
+        QVERIFY(!band.isEmpty());
+        QVERIFY(!coveredRegion.intersects(band));
+        coveredRegion += band;
+
+        // the internal edges of the bands lay on the tile grid
+        if (band.top() != rect.top()) {
+            QCOMPARE(band.top() % 64, 0);
+        }
+    }
+
+    QCOMPARE(coveredRegion, QRegion(rect));
+}
+
+void KisUpdaterContextTest::testStealingBandTasks()
+{
+    KisUpdaterContext context(NUM_THREADS);
+    KisWorkStealingTaskPool &pool = context.m_taskPool;
+
+    const QRect rect(0,0,1024,1024);
+    const QVector<QRect> bands = KisWorkStealingTaskPool::splitIntoBands(rect, 2 * NUM_THREADS);
+    QVERIFY(bands.size() > 1);
+
+    QMutex lock;
+    QVector<QRect> processedBands;
+    QSet<Qt::HANDLE> threads;
+
+    for (int i = 0; i < 100; i++) {
+        processedBands.clear();
+
+        pool.runBandTasks(rect,
+            [&] (const QRect &band) {
+                QTest::qSleep(1);
+
+                QMutexLocker l(&lock);
+                processedBands.append(band);
+                threads.insert(QThread::currentThreadId());
+            });
+
+        QCOMPARE(processedBands.size(), bands.size());
+
+        Q_FOREACH (const QRect &band, bands) {
+            QVERIFY(processedBands.contains(band));
+        }
+    }
+
+    context.waitForDone();
+
+    dbgKrita << "Band tasks were processed by" << threads.size() << "threads";
+
+    // the helper threads should have stolen at least one band
+    QVERIFY(threads.size() > 1);
+
+    /**
+     * The merge split into bands should give exactly the same
+     * pixels as the one done by a single thread
+     */
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, rect.width(), rect.height(), cs, "bands test");
+    KisGroupLayerSP group = new KisGroupLayer(image, "group", 200);
+    image->addNode(group, image->rootLayer());
+
+    for (int i = 0; i < 6; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, QString("paint%1").arg(i), OPACITY_OPAQUE_U8 - 25 * i);
+
+        const QColor color(40 * i, 255 - 40 * i, 30 * i, 255 - 20 * i);
+        layer->paintDevice()->fill(QRect(100 * i, 130 * i, 500, 500), KoColor(color, cs));
+
+        KisNodeSP parent = i % 2 ? KisNodeSP(image->rootLayer()) : KisNodeSP(group);
+        image->addNode(layer, parent);
+    }
+
+    auto mergeImage = [image] (KisWorkStealingTaskPool *pool) {
+        image->projection()->clear();
+
+        KisFullRefreshWalker walker(image->bounds());
+        KisAsyncMerger merger;
+        merger.setTaskPool(pool);
+
+        walker.collectRects(image->rootLayer(), image->bounds());
+        merger.startMerge(walker);
+
+        return image->projection()->convertToQImage(0);
+    };
+
+    const QImage unbandedResult = mergeImage(nullptr);
+    const QImage bandedResult = mergeImage(&pool);
+
+    QPoint pt;
+    QVERIFY(TestUtil::compareQImages(pt, unbandedResult, bandedResult));
+}
+
 KISTEST_MAIN(KisUpdaterContextTest)
 
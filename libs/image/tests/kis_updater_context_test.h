@@ -17,6 +17,8 @@ private Q_SLOTS:
     void testJobInterference();
     void testSnapshot();
     void stressTestExclusiveJobs();
+    void testSplitIntoBands();
+    void testStealingBandTasks();
 };
 
 #endif /* KIS_UPDATER_CONTEXT_TEST_H */
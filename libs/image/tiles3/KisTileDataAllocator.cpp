@@ -0,0 +1,362 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTileDataAllocator.h"
+
+#include <QGlobalStatic>
+
+#include <boost/pool/singleton_pool.hpp>
+
+#include "kis_tile_data_interface.h"
+
+Q_GLOBAL_STATIC(KisTileDataAllocator, s_instance)
+
+namespace {
+
+// BPP == bytes per pixel
+#define TILE_SIZE_4BPP (4 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+#define TILE_SIZE_8BPP (8 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+
+typedef boost::singleton_pool<KisTileDataAllocator, TILE_SIZE_4BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 256, 4096> BoostPool4BPP;
+typedef boost::singleton_pool<KisTileDataAllocator, TILE_SIZE_8BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 128, 2048> BoostPool8BPP;
+
+/**
+ * Pixels bigger than that are rare (e.g. CMYKA F32 is only 20 bytes),
+ * they are allocated and freed directly.
+ */
+const qint32 MAX_CACHED_PIXEL_SIZE = 32;
+
+/**
+ * Maximum amount of memory a thread may keep in a free list of
+ * one pixel size
+ */
+const qint32 THREAD_CACHE_BYTES_LIMIT = 1 << 20;
+
+/**
+ * The thread-local counters are added to the global ones after
+ * this number of allocations
+ */
+const qint32 STATISTICS_FLUSH_PERIOD = 256;
+
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+inline qint32 tileDataSize(qint32 pixelSize)
+{
+    return pixelSize * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT;
+}
+
+inline qint32 threadCacheCapacity(qint32 pixelSize)
+{
+    return qMax(8, THREAD_CACHE_BYTES_LIMIT / tileDataSize(pixelSize));
+}
+
+inline quint8* backingAllocate(qint32 pixelSize)
+{
+    switch (pixelSize) {
+    case 4:
+        return (quint8*)BoostPool4BPP::malloc();
+    case 8:
+        return (quint8*)BoostPool8BPP::malloc();
+    default:
+        return (quint8*) malloc(tileDataSize(pixelSize));
+    }
+}
+
+inline void backingFree(quint8 *ptr, qint32 pixelSize)
+{
+    switch (pixelSize) {
+    case 4:
+        BoostPool4BPP::free(ptr);
+        break;
+    case 8:
+        BoostPool8BPP::free(ptr);
+        break;
+    default:
+        ::free(ptr);
+        break;
+    }
+}
+
+}
+
+/**
+ * Thread-local free lists of the allocator. Please note that
+ * thread_local variables cannot be a part of an exported class
+ * on Windows, so it is declared outside KisTileDataAllocator.
+ */
+struct KisTileDataAllocatorThreadCache
+{
+    ~KisTileDataAllocatorThreadCache();
+
+    /**
+     * Drops the blobs that have been invalidated by
+     * KisTileDataAllocator::purge()
+     */
+    inline void syncGeneration(KisTileDataAllocator *allocator);
+
+    /**
+     * Returns all the cached blobs. If \p allocator is null, the
+     * blobs are returned to the backing allocator directly.
+     */
+    void releaseAll(KisTileDataAllocator *allocator, bool blocksAreValid);
+
+    inline void countAllocation(KisTileDataAllocator *allocator);
+    void flushStatistics(KisTileDataAllocator *allocator);
+
+    FreeBlock *freeLists[MAX_CACHED_PIXEL_SIZE + 1] = {};
+    qint32 freeListSizes[MAX_CACHED_PIXEL_SIZE + 1] = {};
+    int generation = 0;
+
+    qint64 threadCacheHits = 0;
+    qint64 sharedCacheHits = 0;
+    qint64 misses = 0;
+    qint32 pendingAllocations = 0;
+};
+
+namespace {
+thread_local KisTileDataAllocatorThreadCache s_threadCache;
+}
+
+KisTileDataAllocatorThreadCache::~KisTileDataAllocatorThreadCache()
+{
+    /**
+     * The thread may exit after the allocator has been destroyed
+     * during the application shutdown. In such a case, just free the
+     * malloc'ed blobs and leave the pooled ones to the pools.
+     */
+    KisTileDataAllocator *allocator =
+        s_instance.exists() && !s_instance.isDestroyed() ? s_instance() : 0;
+
+    if (allocator) {
+        flushStatistics(allocator);
+        releaseAll(allocator, generation == allocator->m_generation.loadAcquire());
+    } else {
+        releaseAll(0, false);
+    }
+}
+
+inline void KisTileDataAllocatorThreadCache::syncGeneration(KisTileDataAllocator *allocator)
+{
+    const int currentGeneration = allocator->m_generation.loadAcquire();
+
+    if (generation != currentGeneration) {
+        releaseAll(allocator, false);
+        generation = currentGeneration;
+    }
+}
+
+void KisTileDataAllocatorThreadCache::releaseAll(KisTileDataAllocator *allocator, bool blocksAreValid)
+{
+    for (qint32 pixelSize = 1; pixelSize <= MAX_CACHED_PIXEL_SIZE; pixelSize++) {
+        FreeBlock *block = freeLists[pixelSize];
+
+        while (block) {
+            FreeBlock *next = block->next;
+            quint8 *ptr = reinterpret_cast<quint8*>(block);
+
+            if (!KisTileDataAllocator::isPoolBacked(pixelSize)) {
+                /**
+                 * malloc'ed blobs are never invalidated by purge()
+                 */
+                if (!allocator || !allocator->trySharedPush(pixelSize, ptr)) {
+                    backingFree(ptr, pixelSize);
+                }
+            } else if (blocksAreValid) {
+                if (!allocator->trySharedPush(pixelSize, ptr)) {
+                    backingFree(ptr, pixelSize);
+                }
+            }
+
+            block = next;
+        }
+
+        freeLists[pixelSize] = 0;
+        freeListSizes[pixelSize] = 0;
+    }
+}
+
+inline void KisTileDataAllocatorThreadCache::countAllocation(KisTileDataAllocator *allocator)
+{
+    if (++pendingAllocations >= STATISTICS_FLUSH_PERIOD) {
+        flushStatistics(allocator);
+    }
+}
+
+void KisTileDataAllocatorThreadCache::flushStatistics(KisTileDataAllocator *allocator)
+{
+    allocator->m_threadCacheHits.fetchAndAddRelaxed(threadCacheHits);
+    allocator->m_sharedCacheHits.fetchAndAddRelaxed(sharedCacheHits);
+    allocator->m_misses.fetchAndAddRelaxed(misses);
+
+    threadCacheHits = 0;
+    sharedCacheHits = 0;
+    misses = 0;
+    pendingAllocations = 0;
+}
+
+
+KisTileDataAllocator::KisTileDataAllocator()
+    : m_generation(0),
+      m_threadCacheHits(0),
+      m_sharedCacheHits(0),
+      m_misses(0)
+{
+}
+
+KisTileDataAllocator::~KisTileDataAllocator()
+{
+    QWriteLocker l(&m_sharedLock);
+    quint8 *ptr = 0;
+
+    while (m_shared4Pool.pop(ptr)) {
+        BoostPool4BPP::free(ptr);
+    }
+
+    while (m_shared8Pool.pop(ptr)) {
+        BoostPool8BPP::free(ptr);
+    }
+
+    while (m_shared16Pool.pop(ptr)) {
+        ::free(ptr);
+    }
+}
+
+KisTileDataAllocator* KisTileDataAllocator::instance()
+{
+    return s_instance;
+}
+
+bool KisTileDataAllocator::isPoolBacked(qint32 pixelSize)
+{
+    return pixelSize == 4 || pixelSize == 8;
+}
+
+quint8* KisTileDataAllocator::allocate(qint32 pixelSize)
+{
+    if (pixelSize > MAX_CACHED_PIXEL_SIZE) {
+        return backingAllocate(pixelSize);
+    }
+
+    KisTileDataAllocatorThreadCache &cache = s_threadCache;
+    cache.syncGeneration(this);
+
+    quint8 *ptr = 0;
+
+    FreeBlock *block = cache.freeLists[pixelSize];
+    if (block) {
+        cache.freeLists[pixelSize] = block->next;
+        cache.freeListSizes[pixelSize]--;
+        cache.threadCacheHits++;
+        ptr = reinterpret_cast<quint8*>(block);
+    } else if (trySharedPop(pixelSize, ptr)) {
+        cache.sharedCacheHits++;
+    } else {
+        ptr = backingAllocate(pixelSize);
+        cache.misses++;
+    }
+
+    cache.countAllocation(this);
+
+    return ptr;
+}
+
+void KisTileDataAllocator::free(quint8 *ptr, qint32 pixelSize)
+{
+    if (pixelSize > MAX_CACHED_PIXEL_SIZE) {
+        backingFree(ptr, pixelSize);
+        return;
+    }
+
+    KisTileDataAllocatorThreadCache &cache = s_threadCache;
+    cache.syncGeneration(this);
+
+    if (cache.freeListSizes[pixelSize] < threadCacheCapacity(pixelSize)) {
+        FreeBlock *block = reinterpret_cast<FreeBlock*>(ptr);
+        block->next = cache.freeLists[pixelSize];
+        cache.freeLists[pixelSize] = block;
+        cache.freeListSizes[pixelSize]++;
+    } else if (!trySharedPush(pixelSize, ptr)) {
+        backingFree(ptr, pixelSize);
+    }
+}
+
+bool KisTileDataAllocator::trySharedPop(qint32 pixelSize, quint8 *&ptr)
+{
+    QReadLocker l(&m_sharedLock);
+
+    switch (pixelSize) {
+    case 4:
+        return m_shared4Pool.pop(ptr);
+    case 8:
+        return m_shared8Pool.pop(ptr);
+    case 16:
+        return m_shared16Pool.pop(ptr);
+    default:
+        return false;
+    }
+}
+
+bool KisTileDataAllocator::trySharedPush(qint32 pixelSize, quint8 *ptr)
+{
+    QReadLocker l(&m_sharedLock);
+
+    switch (pixelSize) {
+    case 4:
+        m_shared4Pool.push(ptr);
+        break;
+    case 8:
+        m_shared8Pool.push(ptr);
+        break;
+    case 16:
+        m_shared16Pool.push(ptr);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+void KisTileDataAllocator::purge()
+{
+    {
+        QWriteLocker l(&m_sharedLock);
+        quint8 *ptr = 0;
+
+        /**
+         * The pooled blobs will be released by purge_memory()
+         * below, so we just forget them
+         */
+        while (m_shared4Pool.pop(ptr)) {}
+        while (m_shared8Pool.pop(ptr)) {}
+
+        while (m_shared16Pool.pop(ptr)) {
+            ::free(ptr);
+        }
+
+        /**
+         * All the thread-local caches will drop their pooled
+         * blobs on the next access
+         */
+        m_generation.ref();
+    }
+
+    BoostPool4BPP::purge_memory();
+    BoostPool8BPP::purge_memory();
+}
+
+KisTileDataAllocator::Statistics KisTileDataAllocator::statistics() const
+{
+    Statistics stats;
+
+    stats.threadCacheHits = m_threadCacheHits.loadAcquire();
+    stats.sharedCacheHits = m_sharedCacheHits.loadAcquire();
+    stats.misses = m_misses.loadAcquire();
+
+    return stats;
+}
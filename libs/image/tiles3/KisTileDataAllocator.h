@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTILEDATAALLOCATOR_H
+#define KISTILEDATAALLOCATOR_H
+
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <QReadWriteLock>
+
+#include "kritaimage_export.h"
+#include "kis_lockless_stack.h"
+
+struct KisTileDataAllocatorThreadCache;
+
+/**
+ * Allocates 64x64 blobs for the tile data payloads.
+ *
+ * Every thread keeps its own free lists of the blobs, grouped by
+ * pixel size, so the update threads creating and destroying tiles
+ * during big strokes don't call the system allocator and don't fight
+ * for the global lock of the pool. The lists are intrusive, that is,
+ * a free blob stores the pointer to the next blob itself.
+ *
+ * When a thread-local list overflows, the blobs are moved into a
+ * shared lockless stack (for the most common pixel sizes) or are
+ * returned to the backing allocator. 4- and 8-byte pixels are backed
+ * by boost pools that allocate memory in big slabs, all other sizes
+ * are allocated with malloc().
+ */
+class KRITAIMAGE_EXPORT KisTileDataAllocator
+{
+public:
+    struct Statistics {
+        qint64 threadCacheHits = 0;
+        qint64 sharedCacheHits = 0;
+        qint64 misses = 0;
+    };
+
+public:
+    KisTileDataAllocator();
+    ~KisTileDataAllocator();
+
+    static KisTileDataAllocator* instance();
+
+    quint8* allocate(qint32 pixelSize);
+    void free(quint8 *ptr, qint32 pixelSize);
+
+    /**
+     * Returns true if the blobs of \p pixelSize are allocated
+     * from the pools, that is, purge() will release them.
+     */
+    static bool isPoolBacked(qint32 pixelSize);
+
+    /**
+     * Drops all the cached blobs and returns the memory of the
+     * backing pools to the system. All the blobs allocated from
+     * the pools become invalid, so the caller must have copied
+     * the data of the alive tiles beforehand.
+     *
+     * \see KisTileData::releaseInternalPools()
+     */
+    void purge();
+
+    /**
+     * Hit/miss counters of the allocator. The thread-local counters
+     * are flushed into the shared ones in batches, so the values are
+     * approximate.
+     */
+    Statistics statistics() const;
+
+private:
+    friend struct KisTileDataAllocatorThreadCache;
+
+    bool trySharedPop(qint32 pixelSize, quint8 *&ptr);
+    bool trySharedPush(qint32 pixelSize, quint8 *ptr);
+
+private:
+    QAtomicInt m_generation;
+
+    QReadWriteLock m_sharedLock;
+    KisLocklessStack<quint8*> m_shared4Pool;
+    KisLocklessStack<quint8*> m_shared8Pool;
+    KisLocklessStack<quint8*> m_shared16Pool;
+
+    QAtomicInteger<qint64> m_threadCacheHits;
+    QAtomicInteger<qint64> m_sharedCacheHits;
+    QAtomicInteger<qint64> m_misses;
+};
+
+#endif // KISTILEDATAALLOCATOR_H
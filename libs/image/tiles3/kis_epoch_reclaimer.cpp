@@ -0,0 +1,209 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_epoch_reclaimer.h"
+
+#include <QGlobalStatic>
+#include <QThread>
+
+#include "kis_assert.h"
+
+Q_GLOBAL_STATIC(KisEpochReclaimer, s_instance)
+
+/**
+ * The number of retired objects a list accumulates
+ * before trying to reclaim them
+ */
+#define COLLECT_THRESHOLD 64
+
+/**
+ * MSVC doesn't allow thread_local members in exported classes,
+ * so the per-thread state lives here
+ */
+struct KisEpochReclaimerThreadState
+{
+    ~KisEpochReclaimerThreadState() {
+        if (slot >= 0 && !s_instance.isDestroyed()) {
+            s_instance->releaseSlot(slot);
+        }
+    }
+
+    int slot = -1;
+    int depth = 0;
+};
+
+namespace {
+thread_local KisEpochReclaimerThreadState s_threadState;
+}
+
+KisEpochReclaimer::KisEpochReclaimer()
+{
+}
+
+KisEpochReclaimer::~KisEpochReclaimer()
+{
+}
+
+KisEpochReclaimer* KisEpochReclaimer::instance()
+{
+    return s_instance;
+}
+
+void KisEpochReclaimer::enterCriticalSection()
+{
+    KisEpochReclaimerThreadState &state = s_threadState;
+    if (state.depth++ > 0) return;
+
+    if (state.slot < 0) {
+        state.slot = acquireSlot();
+    }
+
+    if (state.slot >= 0) {
+        m_slots[state.slot].epoch.store(m_globalEpoch.load(std::memory_order_seq_cst),
+                                        std::memory_order_seq_cst);
+    } else {
+        m_numOverflowReaders.fetch_add(1, std::memory_order_seq_cst);
+    }
+}
+
+void KisEpochReclaimer::leaveCriticalSection()
+{
+    KisEpochReclaimerThreadState &state = s_threadState;
+    KIS_SAFE_ASSERT_RECOVER_RETURN(state.depth > 0);
+
+    if (--state.depth > 0) return;
+
+    if (state.slot >= 0) {
+        m_slots[state.slot].epoch.store(0, std::memory_order_release);
+    } else {
+        m_numOverflowReaders.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool KisEpochReclaimer::isInCriticalSection() const
+{
+    return s_threadState.depth > 0;
+}
+
+quint64 KisEpochReclaimer::currentEpoch() const
+{
+    return m_globalEpoch.load(std::memory_order_seq_cst);
+}
+
+bool KisEpochReclaimer::tryAdvanceEpoch()
+{
+    quint64 epoch = m_globalEpoch.load(std::memory_order_seq_cst);
+
+    if (m_numOverflowReaders.load(std::memory_order_seq_cst)) {
+        return false;
+    }
+
+    const int numSlots = m_numUsedSlots.load(std::memory_order_acquire);
+
+    for (int i = 0; i < numSlots; i++) {
+        const quint64 readerEpoch = m_slots[i].epoch.load(std::memory_order_seq_cst);
+
+        if (readerEpoch && readerEpoch != epoch) {
+            return false;
+        }
+    }
+
+    // if we fail, someone else has already advanced the epoch for us
+    m_globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+bool KisEpochReclaimer::isSafeToReclaim(quint64 epoch) const
+{
+    return m_globalEpoch.load(std::memory_order_seq_cst) >= epoch + 2;
+}
+
+void KisEpochReclaimer::synchronize(quint64 epoch)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!isInCriticalSection());
+
+    while (!isSafeToReclaim(epoch)) {
+        if (!tryAdvanceEpoch()) {
+            QThread::yieldCurrentThread();
+        }
+    }
+}
+
+int KisEpochReclaimer::acquireSlot()
+{
+    for (int i = 0; i < MAX_THREAD_SLOTS; i++) {
+        int expected = 0;
+        if (m_slots[i].owned.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) {
+
+            int numSlots = m_numUsedSlots.load(std::memory_order_acquire);
+            while (numSlots < i + 1 &&
+                   !m_numUsedSlots.compare_exchange_weak(numSlots, i + 1, std::memory_order_acq_rel)) {}
+
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void KisEpochReclaimer::releaseSlot(int slot)
+{
+    m_slots[slot].epoch.store(0, std::memory_order_release);
+    m_slots[slot].owned.store(0, std::memory_order_release);
+}
+
+
+KisEpochRetireList::KisEpochRetireList()
+{
+}
+
+KisEpochRetireList::~KisEpochRetireList()
+{
+    flush();
+}
+
+void KisEpochRetireList::retire(ReclaimFunc func, void *object)
+{
+    Item item;
+    item.epoch = KisEpochReclaimer::instance()->currentEpoch();
+    item.func = func;
+    item.object = object;
+
+    m_items.push(item);
+}
+
+void KisEpochRetireList::collect(bool force)
+{
+    if (!force && m_items.size() < COLLECT_THRESHOLD) return;
+
+    KisEpochReclaimer *reclaimer = KisEpochReclaimer::instance();
+    reclaimer->tryAdvanceEpoch();
+
+    KisLocklessStack<Item> items;
+    items.mergeFrom(m_items);
+
+    Item item;
+    while (items.pop(item)) {
+        if (reclaimer->isSafeToReclaim(item.epoch)) {
+            item.func(item.object);
+        } else {
+            m_items.push(item);
+        }
+    }
+}
+
+void KisEpochRetireList::flush()
+{
+    if (m_items.isEmpty()) return;
+
+    KisEpochReclaimer *reclaimer = KisEpochReclaimer::instance();
+    reclaimer->synchronize(reclaimer->currentEpoch());
+
+    Item item;
+    while (m_items.pop(item)) {
+        item.func(item.object);
+    }
+}
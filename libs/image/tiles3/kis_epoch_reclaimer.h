@@ -0,0 +1,158 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_EPOCH_RECLAIMER_H
+#define KIS_EPOCH_RECLAIMER_H
+
+#include <atomic>
+
+#include <QtGlobal>
+#include "kis_lockless_stack.h"
+
+#include "kritaimage_export.h"
+
+struct KisEpochReclaimerThreadState;
+
+/**
+ * Epoch-based memory reclamation for the lock-free containers.
+ *
+ * The readers wrap every access to the shared memory into a critical
+ * section (see KisEpochReclaimer::Guard). Entering the section only
+ * publishes the current global epoch in a per-thread slot, so the
+ * readers never write into shared cache lines.
+ *
+ * The writers unlink the objects from the container and retire them
+ * into a KisEpochRetireList. An object retired in epoch E can be
+ * destroyed as soon as the global epoch reaches E + 2: by that moment
+ * every thread has left all the critical sections that could have
+ * seen the object.
+ *
+ * The global epoch can advance only when all the threads that are
+ * in a critical section have observed its current value.
+ */
+class KRITAIMAGE_EXPORT KisEpochReclaimer
+{
+public:
+    KisEpochReclaimer();
+    ~KisEpochReclaimer();
+
+    static KisEpochReclaimer* instance();
+
+    class Guard
+    {
+    public:
+        Guard()
+            : m_reclaimer(KisEpochReclaimer::instance())
+        {
+            m_reclaimer->enterCriticalSection();
+        }
+
+        ~Guard()
+        {
+            m_reclaimer->leaveCriticalSection();
+        }
+
+    private:
+        Q_DISABLE_COPY(Guard)
+        KisEpochReclaimer *m_reclaimer;
+    };
+
+    /**
+     * The critical sections can be nested
+     */
+    void enterCriticalSection();
+    void leaveCriticalSection();
+    bool isInCriticalSection() const;
+
+    quint64 currentEpoch() const;
+
+    /**
+     * Tries to move the global epoch forward.
+     * \return false if some of the readers has not observed
+     *         the current epoch yet
+     */
+    bool tryAdvanceEpoch();
+
+    /**
+     * \return true if the objects retired in \p epoch
+     *         are not accessible by any reader anymore
+     */
+    bool isSafeToReclaim(quint64 epoch) const;
+
+    /**
+     * Blocks until the objects retired in \p epoch can be reclaimed.
+     * Must not be called from inside a critical section.
+     */
+    void synchronize(quint64 epoch);
+
+private:
+    friend struct KisEpochReclaimerThreadState;
+
+    int acquireSlot();
+    void releaseSlot(int slot);
+
+private:
+    static const int MAX_THREAD_SLOTS = 256;
+
+    struct alignas(64) ThreadSlot {
+        std::atomic<quint64> epoch {0};
+        std::atomic<int> owned {0};
+    };
+
+    ThreadSlot m_slots[MAX_THREAD_SLOTS];
+    std::atomic<int> m_numUsedSlots {0};
+
+    /**
+     * The threads that failed to get a slot pin the epoch
+     * through this counter
+     */
+    std::atomic<int> m_numOverflowReaders {0};
+
+    alignas(64) std::atomic<quint64> m_globalEpoch {1};
+};
+
+/**
+ * A list of the objects retired by a container, which are
+ * waiting for the readers to leave their critical sections.
+ */
+class KRITAIMAGE_EXPORT KisEpochRetireList
+{
+public:
+    typedef void (*ReclaimFunc)(void*);
+
+    KisEpochRetireList();
+    ~KisEpochRetireList();
+
+    void retire(ReclaimFunc func, void *object);
+
+    /**
+     * Reclaims the objects that are safe to be reclaimed. Does
+     * nothing until enough objects are collected, unless \p force
+     * is true.
+     */
+    void collect(bool force = false);
+
+    /**
+     * Waits for all the readers and reclaims all the objects.
+     * Must not be called from inside a critical section.
+     */
+    void flush();
+
+    qint32 size() const {
+        return m_items.size();
+    }
+
+private:
+    struct Item {
+        quint64 epoch;
+        ReclaimFunc func;
+        void *object;
+    };
+
+    KisLocklessStack<Item> m_items;
+};
+
+#endif // KIS_EPOCH_RECLAIMER_H
@@ -0,0 +1,144 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_memento_item.h"
+
+#include "kis_debug.h"
+#include "swap/kis_lzf_compression.h"
+
+/**
+ * The delta is kept only if it is at least twice smaller
+ * than the tile data itself
+ */
+#define MIN_DELTA_COMPRESSION_RATIO 2
+
+
+namespace {
+
+inline void xorBuffers(quint8 *dst, const quint8 *src, qint32 size)
+{
+    for (qint32 i = 0; i < size; i++) {
+        dst[i] ^= src[i];
+    }
+}
+
+}
+
+bool KisMementoItem::tryEncodeDelta(KisMementoItemSP base)
+{
+    if (!m_committedFlag || m_type != CHANGED ||
+        !m_tileData || isDeltaEncoded()) {
+
+        return false;
+    }
+
+    if (!base || base->m_type != CHANGED ||
+        !base->m_tileData || base->isDeltaEncoded()) {
+
+        return false;
+    }
+
+    KisTileData *td = m_tileData;
+    KisTileData *baseTD = base->m_tileData;
+
+    if (td == baseTD ||
+        td->isSharedUniform() ||
+        td->numUsers() > 1 ||
+        td->pixelSize() != baseTD->pixelSize()) {
+
+        return false;
+    }
+
+    const qint32 dataSize = td->pixelSize() * KisTileData::WIDTH * KisTileData::HEIGHT;
+    QByteArray delta(dataSize, Qt::Uninitialized);
+
+    /**
+     * Don't keep both the tile data blocked at the same
+     * time, that could cause deadlocks in the swapper
+     */
+    td->blockSwapping();
+    memcpy(delta.data(), td->data(), dataSize);
+    td->unblockSwapping();
+
+    baseTD->blockSwapping();
+    xorBuffers((quint8*)delta.data(), baseTD->data(), dataSize);
+    baseTD->unblockSwapping();
+
+    KisLzfCompression compression;
+    QByteArray compressedDelta(compression.outputBufferSize(dataSize), Qt::Uninitialized);
+
+    const qint32 compressedSize =
+        compression.compress((const quint8*)delta.constData(), dataSize,
+                             (quint8*)compressedDelta.data(), compressedDelta.size());
+
+    if (!compressedSize || compressedSize > dataSize / MIN_DELTA_COMPRESSION_RATIO) {
+        return false;
+    }
+
+    compressedDelta.resize(compressedSize);
+    compressedDelta.squeeze();
+
+    m_deltaData = compressedDelta;
+    m_deltaPixelSize = td->pixelSize();
+    m_deltaBase = base;
+
+    releaseTileData();
+    m_tileData = 0;
+
+    return true;
+}
+
+void KisMementoItem::decodeDelta()
+{
+    if (!isDeltaEncoded()) return;
+
+    KisMementoItemSP base = m_deltaBase;
+    KIS_SAFE_ASSERT_RECOVER_RETURN(base);
+
+    // the base could have been encoded against its own child
+    base->decodeDelta();
+    KIS_SAFE_ASSERT_RECOVER_RETURN(base->m_tileData);
+
+    const qint32 dataSize = m_deltaPixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+    QByteArray delta(dataSize, Qt::Uninitialized);
+
+    KisLzfCompression compression;
+    const qint32 bytesDecoded =
+        compression.decompress((const quint8*)m_deltaData.constData(), m_deltaData.size(),
+                               (quint8*)delta.data(), dataSize);
+    KIS_SAFE_ASSERT_RECOVER_NOOP(bytesDecoded == dataSize);
+
+    KisTileData *td = base->m_tileData->clone();
+
+    td->blockSwapping();
+    xorBuffers(td->data(), (const quint8*)delta.constData(), dataSize);
+    td->unblockSwapping();
+
+    /**
+     * The item is committed, so take the tile data the
+     * same way commit() does
+     */
+    m_tileData = td;
+    m_tileData->acquire();
+    m_tileData->setMementoed(true);
+
+    m_deltaData = QByteArray();
+    m_deltaPixelSize = 0;
+    m_deltaBase = 0;
+}
+
+qint64 KisMementoItem::memorySize() const
+{
+    if (isDeltaEncoded()) {
+        return m_deltaData.size();
+    }
+
+    if (m_type != CHANGED || !m_tileData || m_tileData->isSharedUniform()) {
+        return 0;
+    }
+
+    return qint64(m_tileData->pixelSize()) * KisTileData::WIDTH * KisTileData::HEIGHT;
+}
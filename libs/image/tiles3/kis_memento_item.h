@@ -7,6 +7,8 @@
 #ifndef KIS_MEMENTO_ITEM_H_
 #define KIS_MEMENTO_ITEM_H_
 
+#include <QByteArray>
+
 #include <kis_shared.h>
 #include <kis_shared_ptr.h>
 #include "kis_tile.h"
@@ -14,8 +16,9 @@
 
 class KisMementoItem;
 typedef KisSharedPtr<KisMementoItem> KisMementoItemSP;
+typedef KisWeakSharedPtr<KisMementoItem> KisMementoItemWSP;
 
-class KisMementoItem : public KisShared
+class KRITAIMAGE_EXPORT KisMementoItem : public KisShared
 {
 public:
     enum enumType {
@@ -36,7 +39,10 @@ public:
             m_col(rhs.m_col),
             m_row(rhs.m_row),
             m_next(0),
-            m_parent(0) {
+            m_parent(0),
+            m_deltaData(rhs.m_deltaData),
+            m_deltaPixelSize(rhs.m_deltaPixelSize),
+            m_deltaBase(rhs.m_deltaBase) {
         if (m_tileData) {
             if (m_committedFlag)
                 m_tileData->acquire();
@@ -142,10 +148,43 @@ public:
     }
 
     inline KisTileSP tile(KisMementoManager *mm) {
+        if (isDeltaEncoded()) {
+            decodeDelta();
+        }
+
         Q_ASSERT(m_tileData);
         return KisTileSP(new KisTile(m_col, m_row, m_tileData, mm));
     }
 
+    /**
+     * Replaces the tile data of a committed item with a compressed
+     * XOR delta against the tile data of \p base, the item that
+     * superseded this one in the history. The tile data is restored
+     * lazily, on the first call to tile().
+     *
+     * Only the tile data used by this item alone is encoded, because
+     * otherwise no memory would be saved.
+     *
+     * \return true if the item has been encoded
+     */
+    bool tryEncodeDelta(KisMementoItemSP base);
+
+    /**
+     * Restores the tile data of a delta-encoded item. The base
+     * item must still be present in the history.
+     */
+    void decodeDelta();
+
+    inline bool isDeltaEncoded() const {
+        return !m_deltaData.isNull();
+    }
+
+    /**
+     * \return the number of bytes the item keeps in memory: either
+     * the size of the delta or the size of the tile data
+     */
+    qint64 memorySize() const;
+
     inline enumType type() {
         return m_type;
     }
@@ -177,7 +216,7 @@ public:
     void debugPrintInfo() {
         QString s = QString("------\n"
                    "Memento item:\t\t0x%1 (0x%2)\n"
-                   "   status:\t(%3,%4) %5%6\n"
+                   "   status:\t(%3,%4) %5%6%11\n"
                    "   parent:\t0x%7 (0x%8)\n"
                    "   next:\t0x%9 (0x%10)\n")
                 .arg((quintptr)this)
@@ -189,7 +228,8 @@ public:
                 .arg((quintptr)m_parent.data())
                 .arg(m_parent ? (quintptr)m_parent->m_tileData : 0)
                 .arg((quintptr)m_next.data())
-                .arg(m_next ? (quintptr)m_next->m_tileData : 0);
+                .arg(m_next ? (quintptr)m_next->m_tileData : 0)
+                .arg(isDeltaEncoded() ? QString(" delta %1").arg(m_deltaData.size()) : QString());
         dbgKrita << s;
     }
 
@@ -216,6 +256,18 @@ protected:
 
     KisMementoItemSP m_next;
     KisMementoItemSP m_parent;
+
+    /**
+     * The compressed XOR delta against the tile data of m_deltaBase.
+     * The item has no tile data while it is delta-encoded.
+     *
+     * NOTE: the base is a weak pointer, because the base is the child
+     * of this item (it has us as a parent). The memento manager
+     * decodes the item before its child leaves the history.
+     */
+    QByteArray m_deltaData;
+    qint32 m_deltaPixelSize {0};
+    KisMementoItemWSP m_deltaBase;
 private:
 };
 
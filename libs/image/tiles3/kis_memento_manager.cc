@@ -5,8 +5,11 @@
  */
 
 #include <QtGlobal>
+#include <QGlobalStatic>
+#include <atomic>
 #include "kis_memento_manager.h"
 #include "kis_memento.h"
+#include "kis_image_config.h"
 
 
 //#define DEBUG_MM
@@ -53,6 +56,13 @@
  *       information. The history of such transactions is not purged
  *       automatically, but it is free'd when younger named transaction
  *       is purged.
+ *
+ * When delta mementos are enabled (see setDeltaMementosEnabled()),
+ * commit() replaces the tile data of the previous version of every
+ * committed tile with a compressed XOR delta against the new version.
+ * The delta is decoded back lazily, when the item is needed by
+ * rollback(), so only the newest version of a tile is always stored
+ * in full.
  */
 
 #define blockRegistration() (m_registrationBlocked = true)
@@ -61,6 +71,29 @@
 
 #define namedTransactionInProgress() ((bool)m_currentMemento)
 
+namespace {
+struct DeltaMementosConfig {
+    DeltaMementosConfig()
+        : enabled(KisImageConfig(true).useDeltaUndoMementos())
+    {
+    }
+
+    std::atomic<bool> enabled;
+};
+}
+
+Q_GLOBAL_STATIC(DeltaMementosConfig, s_deltaMementosConfig)
+
+void KisMementoManager::setDeltaMementosEnabled(bool value)
+{
+    s_deltaMementosConfig->enabled = value;
+}
+
+bool KisMementoManager::deltaMementosEnabled()
+{
+    return s_deltaMementosConfig->enabled;
+}
+
 KisMementoManager::KisMementoManager()
     : m_index(0),
       m_headsHashTable(0),
@@ -132,6 +165,20 @@ void KisMementoManager::registerTileChange(KisTile *tile)
     }
 }
 
+void KisMementoManager::registerTileDataReplaced(KisTile *tile)
+{
+    if (registrationBlocked()) return;
+
+    DEBUG_LOG_TILE_ACTION("reg. [R]", tile, tile->col(), tile->row());
+
+    KisMementoItemSP mi = m_index.getExistingTile(tile->col(), tile->row());
+
+    if (mi && mi->type() == KisMementoItem::CHANGED) {
+        mi->reset();
+        mi->changeTile(tile);
+    }
+}
+
 void KisMementoManager::registerTileDeleted(KisTile *tile)
 {
     if (registrationBlocked()) return;
@@ -181,6 +228,7 @@ void KisMementoManager::commit()
     KisMementoItemSP mi;
     KisMementoItemSP parentMI;
     bool newTile;
+    const bool useDeltas = deltaMementosEnabled();
 
     KisMementoItemHashTableIterator iter(&m_index);
     while ((mi = iter.tile())) {
@@ -190,6 +238,10 @@ void KisMementoManager::commit()
         mi->commit();
         revisionList.append(mi);
 
+        if (useDeltas) {
+            parentMI->tryEncodeDelta(mi);
+        }
+
         m_headsHashTable.deleteTile(mi->col(), mi->row());
 
         iter.moveCurrentToHashTable(&m_headsHashTable);
@@ -392,10 +444,67 @@ void KisMementoManager::resetRevisionHistory(KisMementoItemList list)
         while (parentMI->parent()) {
             parentMI = parentMI->parent();
         }
+
+        /**
+         * The items between the root and \p mi are going to be
+         * released, so the root cannot stay encoded against them
+         */
+        parentMI->decodeDelta();
+
         mi->setParent(parentMI);
     }
 }
 
+qint64 KisMementoManager::revisionMemorySize(KisMementoSP memento) const
+{
+    qint64 size = 0;
+
+    Q_FOREACH (const KisHistoryItem &changeList, m_revisions) {
+        if (changeList.memento != memento) continue;
+
+        // the revision keeps the previous versions of the tiles
+        Q_FOREACH (KisMementoItemSP mi, changeList.itemList) {
+            if (mi->parent()) {
+                size += mi->parent()->memorySize();
+            }
+        }
+        return size;
+    }
+
+    Q_FOREACH (const KisHistoryItem &changeList, m_cancelledRevisions) {
+        if (changeList.memento != memento) continue;
+
+        // the revision keeps the undone versions of the tiles
+        Q_FOREACH (KisMementoItemSP mi, changeList.itemList) {
+            size += mi->memorySize();
+        }
+        return size;
+    }
+
+    return size;
+}
+
+qint64 KisMementoManager::historyMemorySize() const
+{
+    qint64 size = 0;
+
+    Q_FOREACH (const KisHistoryItem &changeList, m_revisions) {
+        Q_FOREACH (KisMementoItemSP mi, changeList.itemList) {
+            if (mi->parent()) {
+                size += mi->parent()->memorySize();
+            }
+        }
+    }
+
+    Q_FOREACH (const KisHistoryItem &changeList, m_cancelledRevisions) {
+        Q_FOREACH (KisMementoItemSP mi, changeList.itemList) {
+            size += mi->memorySize();
+        }
+    }
+
+    return size;
+}
+
 void KisMementoManager::setDefaultTileData(KisTileData *defaultTileData)
 {
     m_headsHashTable.setDefaultTileData(defaultTileData);
@@ -26,7 +26,13 @@ typedef QList<KisHistoryItem> KisHistoryList;
 class KisMemento;
 typedef KisSharedPtr<KisMemento> KisMementoSP;
 
-#ifdef USE_LOCK_FREE_HASH_TABLE
+#if defined(USE_EPOCH_HASH_TABLE)
+#include "kis_tile_hash_table3.h"
+
+typedef KisTileHashTableTraits3<KisMementoItem> KisMementoItemHashTable;
+typedef KisTileHashTableIteratorTraits3<KisMementoItem> KisMementoItemHashTableIterator;
+typedef KisTileHashTableIteratorTraits3<KisMementoItem> KisMementoItemHashTableIteratorConst;
+#elif defined(USE_LOCK_FREE_HASH_TABLE)
 #include "kis_tile_hash_table2.h"
 
 typedef KisTileHashTableTraits2<KisMementoItem> KisMementoItemHashTable;
@@ -38,7 +44,7 @@ typedef KisTileHashTableIteratorTraits2<KisMementoItem> KisMementoItemHashTableI
 typedef KisTileHashTableTraits<KisMementoItem> KisMementoItemHashTable;
 typedef KisTileHashTableIteratorTraits<KisMementoItem, QWriteLocker> KisMementoItemHashTableIterator;
 typedef KisTileHashTableIteratorTraits<KisMementoItem, QReadLocker> KisMementoItemHashTableIteratorConst;
-#endif // USE_LOCK_FREE_HASH_TABLE
+#endif // USE_EPOCH_HASH_TABLE
 
 
 class KRITAIMAGE_EXPORT KisMementoManager
@@ -68,6 +74,15 @@ public:
      */
     void registerTileDeleted(KisTile *tile);
 
+    /**
+     * Called when a tile gets new tile-data with the same content,
+     * e.g. when it starts sharing uniform tile-data. The content of
+     * the tile doesn't change, so no new KisMementoItem is created,
+     * only the item already pending in the INDEX (if any) is switched
+     * to the new tile-data, so that the old one could be freed.
+     */
+    void registerTileDataReplaced(KisTile *tile);
+
 
     /**
      * Commits changes, made in  INDEX: appends m_index into m_revisions list
@@ -113,6 +128,28 @@ public:
      */
     void purgeHistory(KisMementoSP oldestMemento);
 
+    /**
+     * Returns the amount of memory (in bytes) kept in the history
+     * by the revision of \p memento, that is the memory occupied
+     * by the old versions of the tiles for an active revision and
+     * by the new versions for an undone one.
+     */
+    qint64 revisionMemorySize(KisMementoSP memento) const;
+
+    /**
+     * Returns the amount of memory (in bytes) kept by all the
+     * revisions in the history, including the undone ones
+     */
+    qint64 historyMemorySize() const;
+
+    /**
+     * Enables storing of the previous versions of the tiles as
+     * compressed XOR deltas against the newer versions. The
+     * default value is read from KisImageConfig::useDeltaUndoMementos()
+     */
+    static void setDeltaMementosEnabled(bool value);
+    static bool deltaMementosEnabled();
+
 protected:
     qint32 findRevisionByMemento(KisMementoSP memento) const;
     void resetRevisionHistory(KisMementoItemList list);
@@ -12,6 +12,11 @@
 #include "kis_memento_manager.h"
 #include "kis_debug.h"
 
+#include <atomic>
+
+namespace {
+std::atomic<quint64> s_nextTileId(1);
+}
 
 void KisTile::init(qint32 col, qint32 row,
                    KisTileData *defaultTileData, KisMementoManager* mm)
@@ -20,6 +25,9 @@ void KisTile::init(qint32 col, qint32 row,
     m_row = row;
     m_lockCounter = 0;
 
+    m_uniqueId = s_nextTileId.fetch_add(1, std::memory_order_relaxed);
+    m_writeCounter.storeRelease(0);
+
     m_extent = QRect(m_col * KisTileData::WIDTH, m_row * KisTileData::HEIGHT,
                      KisTileData::WIDTH, KisTileData::HEIGHT);
 
@@ -204,6 +212,74 @@ inline void KisTile::safeReleaseOldTileData(KisTileData *td)
     }
 }
 
+bool KisTile::isSwappedOut() const
+{
+    /**
+     * The barrier lock guarantees that the tile data will not be
+     * released by a concurrent COW while we are reading it.
+     */
+    QMutexLocker locker(&m_swapBarrierLock);
+    return !m_tileData->data();
+}
+
+bool KisTile::trySetMemoryAccount(qint32 account)
+{
+    /**
+     * The barrier lock guarantees that the tile data will not be
+     * released by a concurrent COW while we are changing it. The
+     * store doesn't block on the swap lock, so no deadlock with
+     * unblockSwapping() is possible.
+     */
+    QMutexLocker locker(&m_swapBarrierLock);
+
+    if (m_tileData->isSharedUniform()) return false;
+
+    return KisTileDataStore::instance()->trySetTileDataMemoryAccount(m_tileData, account);
+}
+
+bool KisTile::shareUniformTileData()
+{
+    bool result = false;
+
+    blockSwapping();
+
+    if (m_tileData->numUsers() == 1 && m_tileData->hasUniformContent()) {
+        QMutexLocker locker(&m_COWMutex);
+
+        KisTileData *tileData =
+            KisTileDataStore::instance()->refAndFetchUniformTileData(m_tileData->data(),
+                                                                     m_tileData->pixelSize(),
+                                                                     m_tileData->memoryAccount());
+
+        if (tileData && m_tileData->numUsers() == 1) {
+            tileData->acquire();
+            tileData->blockSwapping();
+            KisTileData *oldTileData = m_tileData;
+            m_tileData = tileData;
+            safeReleaseOldTileData(oldTileData);
+
+            /**
+             * The content of the tile is the same, so only the pending
+             * memento item should be updated, not a new one created
+             */
+            KisMementoManager *mm = m_mementoManager.load();
+            if (mm) {
+                mm->registerTileDataReplaced(this);
+            }
+
+            result = true;
+        }
+
+        if (tileData) {
+            tileData->deref();
+        }
+    }
+
+    unblockSwapping();
+
+    return result;
+}
+
 void KisTile::lockForRead() const
 {
 #ifdef DEAD_TILES_SANITY_CHECK
@@ -262,6 +338,12 @@ void KisTile::lockForWrite()
 
 void KisTile::unlockForWrite()
 {
+    /**
+     * The counter is incremented on unlocking, so that the revision
+     * read while the tile is being written is outdated as well
+     */
+    m_writeCounter.ref();
+
     unblockSwapping();
     DEBUG_LOG_ACTION("unlock [W]");
 
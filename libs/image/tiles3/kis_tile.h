@@ -39,6 +39,27 @@ class KisMementoManager;
  */
 class KRITAIMAGE_EXPORT KisTile : public KisShared
 {
+public:
+    /**
+     * Identifies the state of the pixels of the tile. The write
+     * counter is incremented every time the tile is unlocked after
+     * writing, and the tiles that replace each other in the data
+     * manager (e.g. on undo or bitBlt) have different ids, so two
+     * equal revisions always mean the same pixels.
+     */
+    struct Revision {
+        quint64 tileId = 0;
+        int writeCounter = 0;
+
+        inline bool operator==(const Revision &rhs) const {
+            return tileId == rhs.tileId && writeCounter == rhs.writeCounter;
+        }
+
+        inline bool operator!=(const Revision &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
 public:
     KisTile(qint32 col, qint32 row,
             KisTileData *defaultTileData, KisMementoManager* mm);
@@ -119,6 +140,39 @@ public:
         return m_tileData;
     }
 
+    inline Revision revision() const {
+        return {m_uniqueId, m_writeCounter.loadAcquire()};
+    }
+
+    /**
+     * Returns true if the current tile data of the tile is swapped
+     * out. The value is only a hint: the swapper may change the state
+     * of the data right after the call.
+     */
+    bool isSwappedOut() const;
+
+    /**
+     * If all the pixels of the tile have the same value, replaces
+     * the tile data with the one shared between all the tiles of
+     * this color. The full buffer will be allocated again by COW
+     * on the first write into the tile.
+     *
+     * The tile data that is already shared with other tiles or
+     * mementos is not touched, since it would save no memory.
+     *
+     * \return true if the tile data has been replaced
+     */
+    bool shareUniformTileData();
+
+    /**
+     * Charges the current tile data to the memory \p account.
+     * Fails if the tile data is being accessed at the moment.
+     * The shared uniform tile data are never changed.
+     *
+     * \see KisTileDataStore::trySetTileDataMemoryAccount()
+     */
+    bool trySetMemoryAccount(qint32 account);
+
 private:
     void init(qint32 col, qint32 row,
               KisTileData *defaultTileData, KisMementoManager* mm);
@@ -136,6 +190,13 @@ private:
     qint32 m_col;
     qint32 m_row;
 
+    /**
+     * Unique id of the tile and the number of writes into it,
+     * see Revision
+     */
+    quint64 m_uniqueId;
+    QAtomicInt m_writeCounter;
+
     /**
      * Added for faster retrieving by processors
      */
@@ -11,44 +11,12 @@
 
 #include <kis_debug.h>
 
-#include <boost/pool/singleton_pool.hpp>
+#include "KisTileDataAllocator.h"
 #include "kis_tile_data_store_iterators.h"
 
-// BPP == bytes per pixel
-#define TILE_SIZE_4BPP (4 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
-#define TILE_SIZE_8BPP (8 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
-
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_4BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 256, 4096> BoostPool4BPP;
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_8BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 128, 2048> BoostPool8BPP;
-
 const qint32 KisTileData::WIDTH = __TILE_DATA_WIDTH;
 const qint32 KisTileData::HEIGHT = __TILE_DATA_HEIGHT;
 
-SimpleCache KisTileData::m_cache;
-
-SimpleCache::~SimpleCache()
-{
-    clear();
-}
-
-void SimpleCache::clear()
-{
-    QWriteLocker l(&m_cacheLock);
-    quint8 *ptr = 0;
-
-    while (m_4Pool.pop(ptr)) {
-        BoostPool4BPP::free(ptr);
-    }
-
-    while (m_8Pool.pop(ptr)) {
-        BoostPool8BPP::free(ptr);
-    }
-
-    while (m_16Pool.pop(ptr)) {
-        free(ptr);
-    }
-}
-
 
 KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store, bool checkFreeMemory)
     : m_state(NORMAL),
@@ -57,6 +25,8 @@ KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataSt
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(pixelSize),
+      m_sharedUniform(false),
+      m_memoryAccount(0),
       m_store(store)
 {
     if (checkFreeMemory) {
@@ -86,6 +56,8 @@ KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(rhs.m_pixelSize),
+      m_sharedUniform(false),
+      m_memoryAccount(rhs.m_memoryAccount),
       m_store(rhs.m_store)
 {
     if (checkFreeMemory) {
@@ -102,6 +74,18 @@ KisTileData::~KisTileData()
     releaseMemory();
 }
 
+bool KisTileData::hasUniformContent() const
+{
+    Q_ASSERT(m_data);
+
+    /**
+     * If every byte equals to the byte one pixel further,
+     * then all the pixels are equal to the first one
+     */
+    return !memcmp(m_data, m_data + m_pixelSize,
+                   m_pixelSize * (WIDTH * HEIGHT - 1));
+}
+
 void KisTileData::fillWithPixel(const quint8 *defPixel)
 {
     quint8 *it = m_data;
@@ -134,40 +118,12 @@ void KisTileData::allocateMemory()
 
 quint8* KisTileData::allocateData(const qint32 pixelSize)
 {
-    quint8 *ptr = 0;
-
-    if (!m_cache.pop(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            ptr = (quint8*)BoostPool4BPP::malloc();
-            break;
-        case 8:
-            ptr = (quint8*)BoostPool8BPP::malloc();
-            break;
-        default:
-            ptr = (quint8*) malloc(pixelSize * WIDTH * HEIGHT);
-            break;
-        }
-    }
-
-    return ptr;
+    return KisTileDataAllocator::instance()->allocate(pixelSize);
 }
 
 void KisTileData::freeData(quint8* ptr, const qint32 pixelSize)
 {
-    if (!m_cache.push(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            BoostPool4BPP::free(ptr);
-            break;
-        case 8:
-            BoostPool8BPP::free(ptr);
-            break;
-        default:
-            free(ptr);
-            break;
-        }
-    }
+    KisTileDataAllocator::instance()->free(ptr, pixelSize);
 }
 
 //#define DEBUG_POOL_RELEASE
@@ -198,8 +154,7 @@ void KisTileData::releaseInternalPools()
             }
 
             // check if the tile data has actually been pooled
-            if (item->m_pixelSize != 4 &&
-                item->m_pixelSize != 8) {
+            if (!KisTileDataAllocator::isPoolBacked(item->m_pixelSize)) {
 
                 continue;
             }
@@ -221,9 +176,7 @@ void KisTileData::releaseInternalPools()
 
         if (!failedToLock) {
             // purge the pools memory
-            m_cache.clear();
-            BoostPool4BPP::purge_memory();
-            BoostPool8BPP::purge_memory();
+            KisTileDataAllocator::instance()->purge();
 
             auto it = dataObjects.begin();
             auto chunkIt = memoryChunks.constBegin();
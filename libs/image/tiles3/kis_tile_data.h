@@ -117,6 +117,14 @@ inline void KisTileData::markOld() {
     m_age++;
 }
 
+inline bool KisTileData::isSharedUniform() const {
+    return m_sharedUniform;
+}
+
+inline qint32 KisTileData::memoryAccount() const {
+    return m_memoryAccount;
+}
+
 inline qint32 KisTileData::numUsers() const {
     return m_usersCount;
 }
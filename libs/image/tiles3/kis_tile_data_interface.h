@@ -10,6 +10,7 @@
 
 #include <QReadWriteLock>
 #include <QAtomicInt>
+#include <QByteArray>
 
 #include "kis_lockless_stack.h"
 #include "swap/kis_chunk_allocator.h"
@@ -31,57 +32,6 @@ typedef KisTileDataList::iterator KisTileDataListIterator;
 typedef KisTileDataList::const_iterator KisTileDataListConstIterator;
 
 
-class SimpleCache
-{
-public:
-    SimpleCache() = default;
-    ~SimpleCache();
-
-    bool push(int pixelSize, quint8 *&ptr)
-    {
-        QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
-            m_4Pool.push(ptr);
-            break;
-        case 8:
-            m_8Pool.push(ptr);
-            break;
-        case 16:
-            m_16Pool.push(ptr);
-            break;
-        default:
-            return false;
-        }
-
-        return true;
-    }
-
-    bool pop(int pixelSize, quint8 *&ptr)
-    {
-        QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
-            return m_4Pool.pop(ptr);
-        case 8:
-            return m_8Pool.pop(ptr);
-        case 16:
-            return m_16Pool.pop(ptr);
-        default:
-            return false;
-        }
-    }
-
-    void clear();
-
-private:
-    QReadWriteLock m_cacheLock;
-    KisLocklessStack<quint8*> m_4Pool;
-    KisLocklessStack<quint8*> m_8Pool;
-    KisLocklessStack<quint8*> m_16Pool;
-};
-
-
 /**
  * Stores actual tile's data
  */
@@ -180,6 +130,31 @@ public:
      */
     inline bool historical() const;
 
+    /**
+     * Returns true if the tile data is a shared representation
+     * of a single-color tile, owned by KisTileDataStore. The store
+     * is always one of the users of such tile data, so any write
+     * into it causes COW.
+     *
+     * \see KisTileDataStore::refAndFetchUniformTileData()
+     */
+    inline bool isSharedUniform() const;
+
+    /**
+     * Returns true if all the pixels of the tile data have
+     * the same value. The data must be loaded into memory.
+     */
+    bool hasUniformContent() const;
+
+    /**
+     * The memory account (usually, a document) the tile data is
+     * charged to. 0 means the tile data is not accounted to any
+     * document. The clones inherit the account of their source.
+     *
+     * \see KisTileDataStore::createMemoryAccount()
+     */
+    inline qint32 memoryAccount() const;
+
     /**
      * Used for swapping purposes only.
      * Frees the memory occupied by the tile data.
@@ -201,7 +176,7 @@ public:
     /**
      * Releases internal pools, which keep blobs where the tiles are
      * stored.  The point is that we don't allocate the tiles from
-     * glibc directly, but use pools (implemented via boost) to
+     * glibc directly, but use pools (see KisTileDataAllocator) to
      * allocate bigger chunks. This method should be called when one
      * knows that we have just free'd quite a lot of memory and we
      * won't need it anymore. E.g. when a document has been closed.
@@ -230,12 +205,14 @@ private:
     friend class KisTileDataStoreIterator;
     friend class KisTileDataStoreReverseIterator;
     friend class KisTileDataStoreClockIterator;
+    friend class KisSwappedDataStore;
 
     /**
      * The state of the tile.
-     * Filled in by tileDataStore and
-     * checked in KisTile::acquireFor*
-     * see also: comment for @m_data
+     * NORMAL - the data is present in memory
+     * COMPRESSED - swapped out into the in-memory compressed tier
+     * SWAPPED - swapped out to the swap file
+     * Changed by KisSwappedDataStore only
      */
     mutable EnumTileDataState m_state;
 
@@ -252,6 +229,14 @@ private:
      */
     KisChunk m_swapChunk;
 
+    /**
+     * The compressed data of the tile data stored in the in-memory
+     * tier of KisSwappedDataStore and its position in the tier's
+     * spilling queue. Valid in COMPRESSED state only.
+     */
+    QByteArray m_compressedData;
+    KisTileDataListIterator m_compressedDataIterator;
+
 
     /**
      * The flag is set by KisMementoItem to show this
@@ -304,8 +289,19 @@ private:
     qint32 m_pixelSize;
     //qint32 m_timeStamp;
 
+    /**
+     * Set by KisTileDataStore for the shared single-color
+     * tile data, never copied to the clones
+     */
+    bool m_sharedUniform;
+
+    /**
+     * Changed by KisTileDataStore only, while holding m_swapLock
+     * in write mode
+     */
+    qint32 m_memoryAccount;
+
     KisTileDataStore *m_store;
-    static SimpleCache m_cache;
 
 public:
     static const qint32 WIDTH;
@@ -15,9 +15,16 @@
 #include "kis_debug.h"
 
 #include "kis_tile_data_store_iterators.h"
+#include "KisTileDataAllocator.h"
 
 Q_GLOBAL_STATIC(KisTileDataStore, s_instance)
 
+/**
+ * The maximum number of different colors of uniform tiles
+ * that can be shared at the same time
+ */
+#define MAX_UNIFORM_TILE_DATA 256
+
 //#define DEBUG_PRECLONE
 
 #ifdef DEBUG_PRECLONE
@@ -63,15 +70,28 @@ KisTileDataStore::KisTileDataStore()
       m_counter(1),
       m_clockIndex(1)
 {
+    for (int i = 0; i < MAX_MEMORY_ACCOUNTS; i++) {
+        m_memoryAccounts[i].state = MemoryAccount::Free;
+        m_memoryAccounts[i].priority = BackgroundAccount;
+        m_memoryAccounts[i].memoryMetric = 0;
+        m_memoryAccounts[i].swapMetric = 0;
+    }
+
+    // the account of the tile data that belong to no document
+    m_memoryAccounts[0].state = MemoryAccount::Used;
+
     m_pooler.start();
     m_swapper.start();
 }
 
 KisTileDataStore::~KisTileDataStore()
 {
+    m_prefetcher.waitForDone();
     m_pooler.terminatePooler();
     m_swapper.terminateSwapper();
 
+    releaseUniformTileData();
+
     if (numTiles() > 0) {
         errKrita << "Warning: some tiles have leaked:";
         errKrita << "\tTiles in memory:" << numTilesInMemory() << "\n"
@@ -96,10 +116,25 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
     stats.historicalMemorySize = m_pooler.lastHistoricalMemoryMetric() * metricCoeff;
     stats.poolSize = m_pooler.lastPoolMemoryMetric() * metricCoeff;
 
-    stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize;
+    stats.compressedSwapSize = m_swappedStore.compressedMemoryMetric() * metricCoeff;
+    stats.compressedMemorySize = m_swappedStore.compressedMemorySize();
+
+    stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize + stats.compressedMemorySize;
 
     stats.swapSize = m_swappedStore.totalMemoryMetric() * metricCoeff;
 
+    stats.numTiles = numTiles();
+    stats.numTilesInMemory = numTilesInMemory();
+    stats.swapOutCount = m_swappedStore.swapOutCount();
+    stats.swapInCount = m_swappedStore.swapInCount();
+
+    const KisTileDataAllocator::Statistics allocatorStats =
+        KisTileDataAllocator::instance()->statistics();
+
+    stats.allocatorThreadCacheHits = allocatorStats.threadCacheHits;
+    stats.allocatorSharedCacheHits = allocatorStats.sharedCacheHits;
+    stats.allocatorMisses = allocatorStats.misses;
+
     return stats;
 }
 
@@ -126,6 +161,7 @@ inline void KisTileDataStore::registerTileDataImp(KisTileData *td)
 
     m_numTiles.ref();
     m_memoryMetric += td->pixelSize();
+    m_memoryAccounts[td->m_memoryAccount].memoryMetric += td->pixelSize();
 }
 
 void KisTileDataStore::registerTileData(KisTileData *td)
@@ -152,6 +188,7 @@ inline void KisTileDataStore::unregisterTileDataImp(KisTileData *td)
     m_tileDataMap.erase(index);
     m_numTiles.deref();
     m_memoryMetric -= td->pixelSize();
+    m_memoryAccounts[td->m_memoryAccount].memoryMetric -= td->pixelSize();
 
     m_tileDataMap.getGC().unlockRawPointerAccess();
 }
@@ -162,9 +199,10 @@ void KisTileDataStore::unregisterTileData(KisTileData *td)
     unregisterTileDataImp(td);
 }
 
-KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *defPixel)
+KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *defPixel, qint32 memoryAccount)
 {
     KisTileData *td = new KisTileData(pixelSize, defPixel, this);
+    td->m_memoryAccount = memoryAccount;
     registerTileData(td);
     return td;
 }
@@ -199,6 +237,7 @@ void KisTileDataStore::freeTileData(KisTileData *td)
 
     if (!td->data()) {
         m_swappedStore.forgetTileData(td);
+        m_memoryAccounts[td->m_memoryAccount].swapMetric -= td->pixelSize();
     } else {
         unregisterTileDataImp(td);
     }
@@ -209,6 +248,176 @@ void KisTileDataStore::freeTileData(KisTileData *td)
     delete td;
 }
 
+void KisTileDataStore::prefetchTiles(const QVector<KisTileSP> &tiles)
+{
+    m_prefetcher.prefetch(tiles);
+}
+
+void KisTileDataStore::waitForPrefetchDone()
+{
+    m_prefetcher.waitForDone();
+}
+
+KisTileData* KisTileDataStore::refAndFetchUniformTileData(const quint8 *pixel, qint32 pixelSize,
+                                                          qint32 memoryAccount)
+{
+    QMutexLocker locker(&m_uniformTileDataLock);
+
+    QByteArray key((const char*)pixel, pixelSize);
+    key.append((const char*)&memoryAccount, sizeof(memoryAccount));
+    KisTileData *td = m_uniformTileData.value(key, 0);
+
+    if (!td) {
+        if (m_uniformTileData.size() >= MAX_UNIFORM_TILE_DATA) {
+            purgeUnusedUniformTileData();
+
+            if (m_uniformTileData.size() >= MAX_UNIFORM_TILE_DATA) {
+                return 0;
+            }
+        }
+
+        td = allocTileData(pixelSize, pixel, memoryAccount);
+        td->m_sharedUniform = true;
+
+        /**
+         * The store is a user of the tile data itself,
+         * so nobody will ever write into it without COW
+         */
+        td->acquire();
+        m_uniformTileData.insert(key, td);
+    }
+
+    td->ref();
+    return td;
+}
+
+qint32 KisTileDataStore::createMemoryAccount()
+{
+    for (int i = 1; i < MAX_MEMORY_ACCOUNTS; i++) {
+        MemoryAccount &account = m_memoryAccounts[i];
+
+        const bool canBeReused =
+            account.state.testAndSetOrdered(MemoryAccount::Free, MemoryAccount::Used) ||
+            (!account.memoryMetric.loadAcquire() &&
+             !account.swapMetric.loadAcquire() &&
+             account.state.testAndSetOrdered(MemoryAccount::Released, MemoryAccount::Used));
+
+        if (canBeReused) {
+            account.priority = BackgroundAccount;
+            return i;
+        }
+    }
+
+    warnKrita << "WARNING: KisTileDataStore: all memory accounts are in use";
+    return 0;
+}
+
+void KisTileDataStore::releaseMemoryAccount(qint32 account)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(account >= 0 && account < MAX_MEMORY_ACCOUNTS);
+    if (!account) return;
+
+    m_memoryAccounts[account].priority = BackgroundAccount;
+    m_memoryAccounts[account].state = MemoryAccount::Released;
+}
+
+void KisTileDataStore::setMemoryAccountPriority(qint32 account, MemoryAccountPriority priority)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(account >= 0 && account < MAX_MEMORY_ACCOUNTS);
+    if (!account) return;
+
+    m_memoryAccounts[account].priority = priority;
+}
+
+qint64 KisTileDataStore::backgroundMemoryMetric() const
+{
+    qint64 metric = 0;
+
+    for (int i = 0; i < MAX_MEMORY_ACCOUNTS; i++) {
+        if (memoryAccountPriority(i) == BackgroundAccount) {
+            metric += memoryAccountMetric(i);
+        }
+    }
+
+    return metric;
+}
+
+KisTileDataStore::MemoryAccountStatistics KisTileDataStore::memoryAccountStatistics(qint32 account) const
+{
+    MemoryAccountStatistics stats;
+    stats.memorySize = 0;
+    stats.swapSize = 0;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(account >= 0 && account < MAX_MEMORY_ACCOUNTS, stats);
+
+    const qint64 metricCoeff = qint64(KisTileData::WIDTH) * KisTileData::HEIGHT;
+
+    stats.memorySize = m_memoryAccounts[account].memoryMetric.loadAcquire() * metricCoeff;
+    stats.swapSize = m_memoryAccounts[account].swapMetric.loadAcquire() * metricCoeff;
+
+    return stats;
+}
+
+bool KisTileDataStore::trySetTileDataMemoryAccount(KisTileData *td, qint32 account)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(account >= 0 && account < MAX_MEMORY_ACCOUNTS, false);
+
+    /**
+     * Holding the swap lock guarantees the tile data is neither
+     * swapped in/out nor freed while we move the counters
+     */
+    if (!td->m_swapLock.tryLockForWrite()) return false;
+
+    if (td->m_memoryAccount != account) {
+        MemoryAccount &oldAccount = m_memoryAccounts[td->m_memoryAccount];
+        MemoryAccount &newAccount = m_memoryAccounts[account];
+
+        if (td->data()) {
+            oldAccount.memoryMetric -= td->pixelSize();
+            newAccount.memoryMetric += td->pixelSize();
+        } else {
+            oldAccount.swapMetric -= td->pixelSize();
+            newAccount.swapMetric += td->pixelSize();
+        }
+
+        td->m_memoryAccount = account;
+    }
+
+    td->m_swapLock.unlock();
+
+    return true;
+}
+
+void KisTileDataStore::purgeUnusedUniformTileData()
+{
+    QHash<QByteArray, KisTileData*>::iterator it = m_uniformTileData.begin();
+
+    while (it != m_uniformTileData.end()) {
+        KisTileData *td = it.value();
+
+        /**
+         * Nobody but the store uses the tile data. New users can
+         * get it only via the cache, which is locked by us.
+         */
+        if (td->numUsers() <= 1) {
+            it = m_uniformTileData.erase(it);
+            td->release();
+        } else {
+            ++it;
+        }
+    }
+}
+
+void KisTileDataStore::releaseUniformTileData()
+{
+    QMutexLocker locker(&m_uniformTileDataLock);
+
+    Q_FOREACH (KisTileData *td, m_uniformTileData) {
+        td->release();
+    }
+    m_uniformTileData.clear();
+}
+
 void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
 {
 //    dbgKrita << "#### SWAP MISS! ####" << td << ppVar(td->mementoed()) << ppVar(td->age()) << ppVar(td->numUsers());
@@ -242,6 +451,7 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
             td->m_swapLock.lockForWrite();
 
             m_swappedStore.swapInTileData(td);
+            m_memoryAccounts[td->m_memoryAccount].swapMetric -= td->pixelSize();
             registerTileDataImp(td);
 
             td->m_swapLock.unlock();
@@ -257,7 +467,7 @@ void KisTileDataStore::ensureTileDataLoaded(KisTileData *td)
     }
 }
 
-bool KisTileDataStore::trySwapTileData(KisTileData *td)
+bool KisTileDataStore::trySwapTileData(KisTileData *td, KisSwappedDataStore::SwapOutPolicy policy)
 {
     /**
      * This function is called with m_listLock acquired
@@ -267,8 +477,9 @@ bool KisTileDataStore::trySwapTileData(KisTileData *td)
     if (!td->m_swapLock.tryLockForWrite()) return result;
 
     if (td->data()) {
-        if (m_swappedStore.trySwapOutTileData(td)) {
+        if (m_swappedStore.trySwapOutTileData(td, policy)) {
             unregisterTileDataImp(td);
+            m_memoryAccounts[td->m_memoryAccount].swapMetric += td->pixelSize();
             result = true;
         }
     }
@@ -347,6 +558,12 @@ void KisTileDataStore::debugSwapAll()
 
 void KisTileDataStore::debugClear()
 {
+    {
+        // the tile data is going to be deleted below
+        QMutexLocker locker(&m_uniformTileDataLock);
+        m_uniformTileData.clear();
+    }
+
     QWriteLocker l(&m_iteratorLock);
     ConcurrentMap<int, KisTileData*>::Iterator iter(m_tileDataMap);
 
@@ -359,12 +576,18 @@ void KisTileDataStore::debugClear()
     m_clockIndex = 1;
     m_numTiles = 0;
     m_memoryMetric = 0;
+
+    for (int i = 0; i < MAX_MEMORY_ACCOUNTS; i++) {
+        m_memoryAccounts[i].memoryMetric = 0;
+        m_memoryAccounts[i].swapMetric = 0;
+    }
 }
 
 void KisTileDataStore::testingRereadConfig()
 {
     m_pooler.testingRereadConfig();
     m_swapper.testingRereadConfig();
+    m_swappedStore.testingRereadConfig();
     kickPooler();
 }
 
@@ -11,11 +11,15 @@
 #include "kritaimage_export.h"
 
 #include <QReadWriteLock>
+#include <QMutex>
+#include <QHash>
+#include <QByteArray>
 #include "kis_tile_data_interface.h"
 
 #include "kis_tile_data_pooler.h"
 #include "swap/kis_tile_data_swapper.h"
 #include "swap/kis_swapped_data_store.h"
+#include "swap/kis_tile_data_prefetcher.h"
 #include "3rdparty/lock_free_map/concurrent_map.h"
 
 class KisTileDataStoreIterator;
@@ -42,6 +46,17 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 compressedSwapSize;
+        qint64 compressedMemorySize;
+
+        qint64 numTiles;
+        qint64 numTilesInMemory;
+        qint64 swapOutCount;
+        qint64 swapInCount;
+
+        qint64 allocatorThreadCacheHits;
+        qint64 allocatorSharedCacheHits;
+        qint64 allocatorMisses;
     };
 
     MemoryStatistics memoryStatistics();
@@ -64,6 +79,110 @@ public:
         return m_numTiles.loadAcquire();
     }
 
+    /**
+     * Returns true if some of the tile data objects
+     * are swapped out (to disk or into the compressed
+     * in-memory tier)
+     */
+    inline bool hasSwappedTiles() const
+    {
+        return m_swappedStore.numTiles() > 0;
+    }
+
+    /**
+     * Starts loading \p tiles from swap in background. The tiles
+     * should be sorted in the order they are going to be accessed.
+     *
+     * \see KisTileDataPrefetcher
+     */
+    void prefetchTiles(const QVector<KisTileSP> &tiles);
+
+    /**
+     * Blocks until all the pending prefetch requests are processed
+     */
+    void waitForPrefetchDone();
+
+    /**
+     * Returns a tile data filled with \p pixel that is shared
+     * between all the uniform tiles of this color. The tile data
+     * is returned with its refCount incremented, so the caller
+     * should deref() it after use.
+     *
+     * Returns null if too many different colors are in use.
+     *
+     * \see KisTileData::isSharedUniform()
+     */
+    KisTileData* refAndFetchUniformTileData(const quint8 *pixel, qint32 pixelSize,
+                                            qint32 memoryAccount = 0);
+
+    /**
+     * Memory accounts let the store track the memory used by
+     * every document separately. Each tile data is charged to
+     * one account (see KisTileData::memoryAccount()), account 0
+     * collects the tile data that belong to no document.
+     *
+     * The swapper evicts the tiles of the background accounts
+     * first and forces the accounts exceeding the per-document
+     * quota (see KisImageConfig::memoryDocumentQuotaPercent())
+     * to swap out their own tiles before anyone else's.
+     */
+    enum MemoryAccountPriority {
+        ForegroundAccount,
+        BackgroundAccount
+    };
+
+    struct MemoryAccountStatistics {
+        qint64 memorySize;
+        qint64 swapSize;
+    };
+
+    static const qint32 MAX_MEMORY_ACCOUNTS = 256;
+
+    /**
+     * Creates a new memory account with BackgroundAccount
+     * priority. Returns 0 if all the accounts are in use.
+     */
+    qint32 createMemoryAccount();
+
+    /**
+     * Marks the account as unused. The account will be reused
+     * only after all its tile data has been freed.
+     */
+    void releaseMemoryAccount(qint32 account);
+
+    void setMemoryAccountPriority(qint32 account, MemoryAccountPriority priority);
+
+    inline MemoryAccountPriority memoryAccountPriority(qint32 account) const
+    {
+        return MemoryAccountPriority(m_memoryAccounts[account].priority.loadAcquire());
+    }
+
+    /**
+     * Returns the "metric" of the memory occupied by the
+     * tile data of \p account that are present in memory
+     */
+    inline qint64 memoryAccountMetric(qint32 account) const
+    {
+        return m_memoryAccounts[account].memoryMetric.loadAcquire();
+    }
+
+    /**
+     * Returns the total metric of the accounts
+     * with BackgroundAccount priority
+     */
+    qint64 backgroundMemoryMetric() const;
+
+    MemoryAccountStatistics memoryAccountStatistics(qint32 account) const;
+
+    /**
+     * Charges \p td to \p account. The tile data must be
+     * registered in the store (in memory or in swap).
+     *
+     * Fails if the tile data is being accessed at the
+     * moment, the same way as trySwapTileData() does.
+     */
+    bool trySetTileDataMemoryAccount(KisTileData *td, qint32 account);
+
     inline void checkFreeMemory()
     {
         m_swapper.checkFreeMemory();
@@ -86,9 +205,10 @@ public:
     KisTileDataStoreClockIterator* beginClockIteration();
     void endIteration(KisTileDataStoreClockIterator* iterator);
 
-    inline KisTileData* createDefaultTileData(qint32 pixelSize, const quint8 *defPixel)
+    inline KisTileData* createDefaultTileData(qint32 pixelSize, const quint8 *defPixel,
+                                              qint32 memoryAccount = 0)
     {
-        return allocTileData(pixelSize, defPixel);
+        return allocTileData(pixelSize, defPixel, memoryAccount);
     }
 
     // Called by The Memento Manager after every commit
@@ -104,8 +224,11 @@ public:
      * Try swap out the tile data.
      * It may fail in case the tile is being accessed
      * at the same moment of time.
+     *
+     * \see KisSwappedDataStore::SwapOutPolicy
      */
-    bool trySwapTileData(KisTileData *td);
+    bool trySwapTileData(KisTileData *td,
+                         KisSwappedDataStore::SwapOutPolicy policy = KisSwappedDataStore::PreferCompressedMemory);
 
 
     /**
@@ -133,7 +256,10 @@ public:
     void unregisterTileData(KisTileData *td);
 
 private:
-    KisTileData *allocTileData(qint32 pixelSize, const quint8 *defPixel);
+    KisTileData *allocTileData(qint32 pixelSize, const quint8 *defPixel, qint32 memoryAccount);
+
+    void purgeUnusedUniformTileData();
+    void releaseUniformTileData();
 
     inline void registerTileDataImp(KisTileData *td);
     inline void unregisterTileDataImp(KisTileData *td);
@@ -169,6 +295,34 @@ private:
     QAtomicInt m_clockIndex;
     ConcurrentMap<int, KisTileData*> m_tileDataMap;
     QReadWriteLock m_iteratorLock;
+
+    struct MemoryAccount {
+        enum State {
+            Free = 0,
+            Used,
+            Released
+        };
+
+        QAtomicInt state;
+        QAtomicInt priority;
+        QAtomicInt memoryMetric;
+        QAtomicInt swapMetric;
+    };
+
+    MemoryAccount m_memoryAccounts[MAX_MEMORY_ACCOUNTS];
+
+    /**
+     * Shared single-color tile data, the key is the pixel
+     * value followed by the memory account
+     */
+    QMutex m_uniformTileDataLock;
+    QHash<QByteArray, KisTileData*> m_uniformTileData;
+
+    /**
+     * Keeps references to the tiles while loading them,
+     * so it should be destroyed first.
+     */
+    KisTileDataPrefetcher m_prefetcher;
 };
 
 template<typename T>
@@ -52,13 +52,14 @@ public:
         return m_iterator.isValid();
     }
 
-    inline bool trySwapOut(KisTileData *td)
+    inline bool trySwapOut(KisTileData *td,
+                           KisSwappedDataStore::SwapOutPolicy policy = KisSwappedDataStore::PreferCompressedMemory)
     {
         if (td == m_iterator.getValue()) {
             m_iterator.next();
         }
 
-        return m_store->trySwapTileData(td);
+        return m_store->trySwapTileData(td, policy);
     }
 
 private:
@@ -127,13 +128,14 @@ public:
         return !(m_endReached && m_iterator.getValue() == m_startItem);
     }
 
-    inline bool trySwapOut(KisTileData *td)
+    inline bool trySwapOut(KisTileData *td,
+                           KisSwappedDataStore::SwapOutPolicy policy = KisSwappedDataStore::PreferCompressedMemory)
     {
         if (td == m_iterator.getValue()) {
             m_iterator.next();
         }
 
-        return m_store->trySwapTileData(td);
+        return m_store->trySwapTileData(td, policy);
     }
 
 private:
@@ -0,0 +1,907 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILEHASHTABLE_3_H
+#define KIS_TILEHASHTABLE_3_H
+
+#include <atomic>
+
+#include <QReadWriteLock>
+#include <QVector>
+#include <QThread>
+
+#include "kis_shared.h"
+#include "kis_shared_ptr.h"
+#include "kis_epoch_reclaimer.h"
+#include "kis_tile.h"
+#include "kis_debug.h"
+
+/**
+ * This is a template for a hash table that stores tiles (or some other
+ * objects resembling tiles). It has the same interface and semantics as
+ * KisTileHashTableTraits2, so it can be used as a drop-in replacement in
+ * KisTiledDataManager and KisMementoManager.
+ *
+ * The table uses open addressing with linear probing. Lookups, insertions
+ * and removals are lock-free: every cell is changed with a single CAS
+ * and the readers never write into the shared memory except for their
+ * epoch slot (see KisEpochReclaimer). The removed tiles and the old
+ * arrays of the table are released only when no reader can see them
+ * anymore.
+ *
+ * Keys are never removed from the cells, a removed tile leaves a
+ * tombstone that can be reused by the same key. When more than half of
+ * the cells have been claimed, the table is migrated into a new array:
+ *
+ *   1) the migrating thread links a new array to the old one
+ *   2) every cell of the old array is frozen (FROZEN_BIT is set in the
+ *      value), so that nobody could change it anymore, and its value is
+ *      copied into the new array
+ *   3) the new array is published as the root one and the old array is
+ *      retired
+ *
+ * The other threads are not blocked by the migration: a writer freezes
+ * and copies the cell of its key itself and then works with the new
+ * array; a reader that sees a frozen cell goes into the new array too.
+ *
+ * The only blocking parts are iteration and migration: they are mutually
+ * exclusive, so that the iterators could walk a stable array.
+ *
+ * How to use:
+ *   1) each hash must be unique, otherwise tiles would rewrite each-other
+ *   2) 0 key is reserved, so can't be used
+ *   3) col and row must be less than 0x7FFF to guarantee uniqueness of hash for each pair
+ */
+
+template <class T>
+class KisTileHashTableIteratorTraits3;
+
+template <class T>
+class KisTileHashTableTraits3
+{
+    static constexpr bool isInherited = std::is_convertible<T*, KisShared*>::value;
+    Q_STATIC_ASSERT_X(isInherited, "Template must inherit KisShared");
+
+public:
+    typedef T TileType;
+    typedef KisSharedPtr<T> TileTypeSP;
+    typedef KisWeakSharedPtr<T> TileTypeWSP;
+
+    KisTileHashTableTraits3(KisMementoManager *mm);
+    KisTileHashTableTraits3(const KisTileHashTableTraits3<T> &ht, KisMementoManager *mm);
+    ~KisTileHashTableTraits3();
+
+    bool isEmpty()
+    {
+        return !m_numTiles.load();
+    }
+
+    bool tileExists(qint32 col, qint32 row);
+
+    /**
+     * Returns a tile in position (col,row). If no tile exists,
+     * returns null.
+     * \param col column of the tile
+     * \param row row of the tile
+     */
+    TileTypeSP getExistingTile(qint32 col, qint32 row);
+
+    /**
+     * Returns a tile in position (col,row). If no tile exists,
+     * creates a new one, attaches it to the list and returns.
+     * \param col column of the tile
+     * \param row row of the tile
+     * \param newTile out-parameter, returns true if a new tile
+     *                was created
+     */
+    TileTypeSP getTileLazy(qint32 col, qint32 row, bool& newTile);
+
+    /**
+     * Returns a tile in position (col,row). If no tile exists,
+     * creates nothing, but returns shared default tile object
+     * of the table. Be careful, this object has column and row
+     * parameters set to (qint32_MIN, qint32_MIN).
+     * \param col column of the tile
+     * \param row row of the tile
+     * \param existingTile returns true if the tile actually exists in the table
+     *                     and it is not a lazily created default wrapper tile
+     */
+    TileTypeSP getReadOnlyTileLazy(qint32 col, qint32 row, bool &existingTile);
+    void addTile(TileTypeSP tile);
+    bool deleteTile(TileTypeSP tile);
+    bool deleteTile(qint32 col, qint32 row);
+
+    void clear();
+
+    void setDefaultTileData(KisTileData *defaultTileData);
+    KisTileData* defaultTileData();
+
+    /**
+     * Returns a pointer to the default tile data object with ref counter
+     * increased by one. Make sure you call deref() after you finished using
+     * this object.
+     */
+    KisTileData* refAndFetchDefaultTileData();
+
+
+    qint32 numTiles()
+    {
+        return m_numTiles.load();
+    }
+
+    void debugPrintInfo();
+    void debugMaxListLength(qint32 &min, qint32 &max);
+
+    friend class KisTileHashTableIteratorTraits3<T>;
+
+private:
+    static const quintptr FROZEN_BIT = 0x1;
+    static const quintptr TOMBSTONE = 0x2;
+    static const quint32 MIN_CAPACITY = 64;
+
+    struct Cell {
+        Cell() : key(0), value(0) {}
+
+        std::atomic<quint32> key;
+        std::atomic<quintptr> value;
+    };
+
+    struct Table {
+        Table(quint32 _capacity)
+            : capacity(_capacity),
+              mask(_capacity - 1),
+              usedCells(0),
+              next(nullptr),
+              cells(new Cell[_capacity])
+        {
+        }
+
+        ~Table()
+        {
+            delete[] cells;
+        }
+
+        const quint32 capacity;
+        const quint32 mask;
+        std::atomic<quint32> usedCells;
+        std::atomic<Table*> next;
+        Cell *cells;
+    };
+
+    enum UpdateMode {
+        Assign,
+        InsertIfAbsent,
+        Erase
+    };
+
+    static inline bool isLive(quintptr value)
+    {
+        return value && !(value & (FROZEN_BIT | TOMBSTONE));
+    }
+
+    static inline TileType* toTile(quintptr value)
+    {
+        return reinterpret_cast<TileType*>(value);
+    }
+
+    static inline quint32 cellIndex(quint32 key, quint32 mask)
+    {
+        // Fibonacci hashing spreads the neighbouring tiles over the table
+        const quint32 hash = key * 2654435761U;
+        return (hash ^ (hash >> 15)) & mask;
+    }
+
+    static quint32 capacityForTiles(qint32 numTiles)
+    {
+        /**
+         * The new array should be able to fit all the tiles of the old
+         * one and the tiles added by the other threads while the migration
+         * is in progress (they are limited by half of the capacity)
+         */
+        const quint32 minCapacity = 4 * (quint32(qMax(0, numTiles)) + MIN_CAPACITY);
+
+        quint32 capacity = MIN_CAPACITY;
+        while (capacity < minCapacity) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    static void destroyTable(void *table)
+    {
+        delete static_cast<Table*>(table);
+    }
+
+    static void reclaimTile(void *tile)
+    {
+        TileTypeSP::deref(nullptr, static_cast<TileType*>(tile));
+    }
+
+    static void releaseTileData(void *tileData)
+    {
+        static_cast<KisTileData*>(tileData)->release();
+    }
+
+    inline quint32 calculateHash(qint32 col, qint32 row)
+    {
+        KIS_ASSERT_RECOVER_NOOP(row < 0x7FFF && col < 0x7FFF);
+
+        if (col == 0 && row == 0) {
+            col = 0x7FFF;
+            row = 0x7FFF;
+        }
+
+        return ((static_cast<quint32>(row) << 16) | (static_cast<quint32>(col) & 0xFFFF));
+    }
+
+    static Cell* findCell(Table *table, quint32 key);
+    static Cell* findOrClaimCell(Table *table, quint32 key, bool *claimed = nullptr);
+    static void freezeCell(Cell *cell);
+    static void copyCell(Table *table, Cell *cell);
+
+    /**
+     * Returns the array where the value of \p key should be changed,
+     * moving the key from the arrays being migrated.
+     * Must be called inside a critical section.
+     */
+    Table* writableTable(quint32 key);
+
+    /**
+     * Atomically changes the value stored for \p key. Returns the
+     * previous live value of the key, the reference to it is passed
+     * to the caller. In InsertIfAbsent mode nothing is changed if the
+     * key already has a live value, it is returned in \p existing
+     * instead.
+     */
+    quintptr updateValue(quint32 key, quintptr newValue, UpdateMode mode,
+                         bool *updated, TileTypeSP *existing = 0);
+
+    void startMigration(Table *table);
+
+    void insert(quint32 key, TileTypeSP item);
+    bool erase(quint32 key);
+
+private:
+    std::atomic<Table*> m_root;
+
+    /**
+     * Iterators take it for writing, the migration takes it for
+     * reading. The lookups and updates never touch it.
+     */
+    mutable QReadWriteLock m_iteratorLock;
+
+    KisEpochRetireList m_retireList;
+
+    QAtomicInt m_numTiles;
+    std::atomic<KisTileData*> m_defaultTileData;
+    KisMementoManager *m_mementoManager;
+};
+
+template <class T>
+class KisTileHashTableIteratorTraits3
+{
+public:
+    typedef T TileType;
+    typedef KisSharedPtr<T> TileTypeSP;
+    typedef KisTileHashTableTraits3<T> HashTable;
+
+    KisTileHashTableIteratorTraits3(KisTileHashTableTraits3<T> *ht)
+        : m_ht(ht),
+          m_index(0),
+          m_currentKey(0)
+    {
+        m_ht->m_iteratorLock.lockForWrite();
+
+        // no migration can happen while we hold the lock,
+        // so the array will not be retired
+        m_table = m_ht->m_root.load(std::memory_order_acquire);
+        seek(0);
+    }
+
+    ~KisTileHashTableIteratorTraits3()
+    {
+        m_ht->m_iteratorLock.unlock();
+    }
+
+    void next()
+    {
+        seek(m_index + 1);
+    }
+
+    TileTypeSP tile() const
+    {
+        return m_currentTile;
+    }
+
+    bool isDone() const
+    {
+        return !m_currentTile;
+    }
+
+    void deleteCurrent()
+    {
+        const quint32 key = m_currentKey;
+        next();
+        m_ht->erase(key);
+    }
+
+    void moveCurrentToHashTable(KisTileHashTableTraits3<T> *newHashTable)
+    {
+        TileTypeSP tile = m_currentTile;
+        const quint32 key = m_currentKey;
+        next();
+
+        m_ht->erase(key);
+        newHashTable->insert(key, tile);
+    }
+
+private:
+    void seek(quint32 index)
+    {
+        KisEpochReclaimer::Guard guard;
+
+        m_currentTile = 0;
+
+        for (m_index = index; m_index < m_table->capacity; m_index++) {
+            typename HashTable::Cell &cell = m_table->cells[m_index];
+            const quintptr value = cell.value.load(std::memory_order_acquire);
+
+            if (HashTable::isLive(value)) {
+                m_currentTile = HashTable::toTile(value);
+                m_currentKey = cell.key.load(std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(KisTileHashTableIteratorTraits3)
+
+    KisTileHashTableTraits3<T> *m_ht;
+    typename HashTable::Table *m_table;
+    quint32 m_index;
+    quint32 m_currentKey;
+    TileTypeSP m_currentTile;
+};
+
+template <class T>
+KisTileHashTableTraits3<T>::KisTileHashTableTraits3(KisMementoManager *mm)
+    : m_root(new Table(MIN_CAPACITY)),
+      m_numTiles(0),
+      m_defaultTileData(nullptr),
+      m_mementoManager(mm)
+{
+}
+
+template <class T>
+KisTileHashTableTraits3<T>::KisTileHashTableTraits3(const KisTileHashTableTraits3<T> &ht, KisMementoManager *mm)
+    : KisTileHashTableTraits3(mm)
+{
+    setDefaultTileData(ht.m_defaultTileData.load());
+
+    QWriteLocker locker(&ht.m_iteratorLock);
+    Table *table = ht.m_root.load(std::memory_order_acquire);
+
+    for (quint32 i = 0; i < table->capacity; i++) {
+        TileTypeSP srcTile;
+        quint32 key = 0;
+
+        {
+            KisEpochReclaimer::Guard guard;
+            const quintptr value = table->cells[i].value.load(std::memory_order_acquire);
+            if (!isLive(value)) continue;
+
+            srcTile = toTile(value);
+            key = table->cells[i].key.load(std::memory_order_relaxed);
+        }
+
+        TileTypeSP tile = new TileType(*srcTile, m_mementoManager);
+        insert(key, tile);
+    }
+}
+
+template <class T>
+KisTileHashTableTraits3<T>::~KisTileHashTableTraits3()
+{
+    clear();
+    setDefaultTileData(0);
+
+    m_retireList.flush();
+    delete m_root.load();
+}
+
+template<class T>
+bool KisTileHashTableTraits3<T>::tileExists(qint32 col, qint32 row)
+{
+    return getExistingTile(col, row);
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::Cell* KisTileHashTableTraits3<T>::findCell(Table *table, quint32 key)
+{
+    quint32 index = cellIndex(key, table->mask);
+
+    for (quint32 i = 0; i < table->capacity; i++, index = (index + 1) & table->mask) {
+        const quint32 cellKey = table->cells[index].key.load(std::memory_order_acquire);
+
+        if (cellKey == key) return &table->cells[index];
+        if (!cellKey) break;
+    }
+
+    return nullptr;
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::Cell* KisTileHashTableTraits3<T>::findOrClaimCell(Table *table, quint32 key, bool *claimed)
+{
+    if (claimed) {
+        *claimed = false;
+    }
+
+    quint32 index = cellIndex(key, table->mask);
+
+    for (quint32 i = 0; i < table->capacity; i++, index = (index + 1) & table->mask) {
+        Cell &cell = table->cells[index];
+        quint32 cellKey = cell.key.load(std::memory_order_acquire);
+
+        if (!cellKey) {
+            if (cell.key.compare_exchange_strong(cellKey, key, std::memory_order_acq_rel)) {
+                table->usedCells.fetch_add(1, std::memory_order_relaxed);
+
+                if (claimed) {
+                    *claimed = true;
+                }
+                return &cell;
+            }
+            // cellKey now contains the key claimed by another thread
+        }
+
+        if (cellKey == key) return &cell;
+    }
+
+    return nullptr;
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::freezeCell(Cell *cell)
+{
+    quintptr value = cell->value.load(std::memory_order_acquire);
+
+    while (!(value & FROZEN_BIT) &&
+           !cell->value.compare_exchange_weak(value, value | FROZEN_BIT, std::memory_order_acq_rel)) {}
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::copyCell(Table *table, Cell *cell)
+{
+    const quintptr value = cell->value.load(std::memory_order_acquire) & ~FROZEN_BIT;
+    if (!isLive(value)) return;
+
+    const quint32 key = cell->key.load(std::memory_order_relaxed);
+    Table *next = table->next.load(std::memory_order_acquire);
+
+    while (next) {
+        Cell *newCell = findOrClaimCell(next, key);
+        KIS_ASSERT(newCell && "KisTileHashTableTraits3: the migration target is full");
+
+        /**
+         * If the cell has already got a value, then either someone has
+         * already copied it, or the key has been changed after copying.
+         * In both cases the value is not needed anymore.
+         */
+        quintptr expected = 0;
+        if (newCell->value.compare_exchange_strong(expected, value, std::memory_order_acq_rel) ||
+            expected != FROZEN_BIT) {
+
+            break;
+        }
+
+        // the target has already been frozen itself
+        next = next->next.load(std::memory_order_acquire);
+    }
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::Table* KisTileHashTableTraits3<T>::writableTable(quint32 key)
+{
+    Table *table = m_root.load(std::memory_order_acquire);
+    Table *next = 0;
+
+    while ((next = table->next.load(std::memory_order_acquire))) {
+        /**
+         * The table is being migrated. Claim the key in the old array
+         * even if it is absent, so that nobody could add it there
+         * after we moved to the new one.
+         */
+        Cell *cell = findOrClaimCell(table, key);
+        if (cell) {
+            freezeCell(cell);
+            copyCell(table, cell);
+        }
+        table = next;
+    }
+
+    return table;
+}
+
+template <class T>
+quintptr KisTileHashTableTraits3<T>::updateValue(quint32 key, quintptr newValue, UpdateMode mode,
+                                                 bool *updated, TileTypeSP *existing)
+{
+    *updated = false;
+
+    forever {
+        Table *fullTable = 0;
+        Table *crowdedTable = 0;
+        quintptr oldValue = 0;
+        bool done = false;
+        bool claimedCell = false;
+
+        {
+            KisEpochReclaimer::Guard guard;
+
+            Table *table = writableTable(key);
+            const bool isMigrationTarget = table != m_root.load(std::memory_order_acquire);
+
+            Cell *cell = findCell(table, key);
+
+            if (!cell && mode == Erase) {
+                done = true;
+            } else if (!cell && isMigrationTarget &&
+                       table->usedCells.load(std::memory_order_relaxed) >= table->capacity / 2) {
+
+                // leave the space for the cells copied by the migration
+                crowdedTable = table;
+
+            } else if (!cell && !(cell = findOrClaimCell(table, key, &claimedCell))) {
+                fullTable = table;
+            }
+
+            if (cell) {
+                quintptr value = cell->value.load(std::memory_order_acquire);
+
+                // a frozen cell means that the table is being migrated,
+                // then we just retry in the new array
+                while (!(value & FROZEN_BIT)) {
+                    if (mode == Erase && !isLive(value)) {
+                        done = true;
+                        break;
+                    }
+
+                    if (mode == InsertIfAbsent && isLive(value)) {
+                        *existing = toTile(value);
+                        done = true;
+                        break;
+                    }
+
+                    if (cell->value.compare_exchange_weak(value, newValue, std::memory_order_acq_rel)) {
+                        // the caller takes over the reference owned by the table
+                        oldValue = isLive(value) ? value : 0;
+                        *updated = true;
+                        done = true;
+
+                        /**
+                         * Only the inserts that claim a new cell may start
+                         * the migration. Erasing is done by the iterators,
+                         * which hold m_iteratorLock for writing, so they
+                         * would deadlock in startMigration() otherwise.
+                         */
+                        if (claimedCell && !isMigrationTarget &&
+                            table->usedCells.load(std::memory_order_relaxed) > table->capacity / 2) {
+
+                            fullTable = table;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        // blocking operations are done outside of the critical section
+
+        if (fullTable) {
+            startMigration(fullTable);
+        } else if (crowdedTable) {
+            QThread::yieldCurrentThread();
+        }
+
+        if (done) {
+            return oldValue;
+        }
+    }
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::startMigration(Table *table)
+{
+    QReadLocker locker(&m_iteratorLock);
+
+    {
+        KisEpochReclaimer::Guard guard;
+
+        /**
+         * The migrations go one by one: only the root array can
+         * be migrated and only when it is not being migrated yet
+         */
+        if (m_root.load(std::memory_order_acquire) != table ||
+            table->next.load(std::memory_order_acquire)) {
+
+            return;
+        }
+
+        Table *newTable = new Table(capacityForTiles(m_numTiles.load()));
+
+        Table *expected = nullptr;
+        if (!table->next.compare_exchange_strong(expected, newTable, std::memory_order_acq_rel)) {
+            delete newTable;
+            return;
+        }
+
+        for (quint32 i = 0; i < table->capacity; i++) {
+            Cell *cell = &table->cells[i];
+
+            freezeCell(cell);
+
+            if (cell->key.load(std::memory_order_acquire)) {
+                copyCell(table, cell);
+            }
+        }
+
+        m_root.store(newTable, std::memory_order_release);
+        m_retireList.retire(&KisTileHashTableTraits3<T>::destroyTable, table);
+    }
+
+    m_retireList.collect();
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::TileTypeSP KisTileHashTableTraits3<T>::getExistingTile(qint32 col, qint32 row)
+{
+    const quint32 key = calculateHash(col, row);
+
+    KisEpochReclaimer::Guard guard;
+    Table *table = m_root.load(std::memory_order_acquire);
+
+    while (table) {
+        Cell *cell = findCell(table, key);
+
+        if (cell) {
+            const quintptr value = cell->value.load(std::memory_order_acquire);
+
+            /**
+             * While the cell is not frozen, its value is authoritative:
+             * nobody can write the key into the new array without
+             * freezing the cell first.
+             */
+            if (!(value & FROZEN_BIT)) {
+                return isLive(value) ? TileTypeSP(toTile(value)) : TileTypeSP();
+            }
+
+            copyCell(table, cell);
+        }
+
+        table = table->next.load(std::memory_order_acquire);
+    }
+
+    return TileTypeSP();
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::TileTypeSP KisTileHashTableTraits3<T>::getTileLazy(qint32 col, qint32 row, bool &newTile)
+{
+    const quint32 key = calculateHash(col, row);
+
+    newTile = false;
+
+    forever {
+        TileTypeSP tile = getExistingTile(col, row);
+        if (tile) return tile;
+
+        KisTileData *tileData = refAndFetchDefaultTileData();
+        tile = new TileType(col, row, tileData, 0);
+        tileData->deref();
+
+        // the reference owned by the table
+        TileTypeSP::ref(nullptr, tile.data());
+
+        bool updated = false;
+        TileTypeSP existingTile;
+        updateValue(key, reinterpret_cast<quintptr>(tile.data()), InsertIfAbsent, &updated, &existingTile);
+
+        if (updated) {
+            m_numTiles.ref();
+            tile->notifyAttachedToDataManager(m_mementoManager);
+            newTile = true;
+            m_retireList.collect();
+            return tile;
+        }
+
+        // someone else has added the tile before us
+        TileTypeSP::deref(nullptr, tile.data());
+        tile->notifyDeadWithoutDetaching();
+
+        if (existingTile) return existingTile;
+    }
+}
+
+template <class T>
+typename KisTileHashTableTraits3<T>::TileTypeSP KisTileHashTableTraits3<T>::getReadOnlyTileLazy(qint32 col, qint32 row, bool &existingTile)
+{
+    TileTypeSP tile = getExistingTile(col, row);
+    existingTile = tile;
+
+    if (!existingTile) {
+        KisTileData *tileData = refAndFetchDefaultTileData();
+        tile = new TileType(col, row, tileData, 0);
+        tileData->deref();
+    }
+
+    return tile;
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::addTile(TileTypeSP tile)
+{
+    insert(calculateHash(tile->col(), tile->row()), tile);
+}
+
+template <class T>
+bool KisTileHashTableTraits3<T>::deleteTile(TileTypeSP tile)
+{
+    return deleteTile(tile->col(), tile->row());
+}
+
+template <class T>
+bool KisTileHashTableTraits3<T>::deleteTile(qint32 col, qint32 row)
+{
+    return erase(calculateHash(col, row));
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::insert(quint32 key, TileTypeSP item)
+{
+    TileTypeSP::ref(nullptr, item.data());
+
+    bool updated = false;
+    const quintptr oldValue = updateValue(key, reinterpret_cast<quintptr>(item.data()), Assign, &updated);
+
+    if (oldValue) {
+        TileType *oldTile = toTile(oldValue);
+        oldTile->notifyDeadWithoutDetaching();
+        m_retireList.retire(&KisTileHashTableTraits3<T>::reclaimTile, oldTile);
+    } else {
+        m_numTiles.ref();
+    }
+
+    m_retireList.collect();
+}
+
+template <class T>
+bool KisTileHashTableTraits3<T>::erase(quint32 key)
+{
+    bool updated = false;
+    const quintptr oldValue = updateValue(key, TOMBSTONE, Erase, &updated);
+
+    if (oldValue) {
+        TileType *oldTile = toTile(oldValue);
+        oldTile->notifyDetachedFromDataManager();
+        m_numTiles.deref();
+        m_retireList.retire(&KisTileHashTableTraits3<T>::reclaimTile, oldTile);
+    }
+
+    m_retireList.collect();
+    return oldValue;
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::clear()
+{
+    QVector<TileType*> removedTiles;
+
+    {
+        // keeps the root array from being migrated
+        QWriteLocker locker(&m_iteratorLock);
+        KisEpochReclaimer::Guard guard;
+
+        Table *table = m_root.load(std::memory_order_acquire);
+
+        for (quint32 i = 0; i < table->capacity; i++) {
+            Cell &cell = table->cells[i];
+            quintptr value = cell.value.load(std::memory_order_acquire);
+
+            while (isLive(value)) {
+                if (cell.value.compare_exchange_weak(value, TOMBSTONE, std::memory_order_acq_rel)) {
+                    removedTiles.append(toTile(value));
+                    break;
+                }
+            }
+        }
+    }
+
+    Q_FOREACH (TileType *tile, removedTiles) {
+        tile->notifyDetachedFromDataManager();
+        m_numTiles.deref();
+        m_retireList.retire(&KisTileHashTableTraits3<T>::reclaimTile, tile);
+    }
+
+    m_retireList.collect();
+}
+
+template <class T>
+inline void KisTileHashTableTraits3<T>::setDefaultTileData(KisTileData *defaultTileData)
+{
+    if (defaultTileData) {
+        defaultTileData->acquire();
+    }
+
+    KisTileData *oldTileData = m_defaultTileData.exchange(defaultTileData, std::memory_order_acq_rel);
+
+    if (oldTileData) {
+        m_retireList.retire(&KisTileHashTableTraits3<T>::releaseTileData, oldTileData);
+        m_retireList.collect();
+    }
+}
+
+template <class T>
+inline KisTileData* KisTileHashTableTraits3<T>::defaultTileData()
+{
+    return m_defaultTileData.load(std::memory_order_acquire);
+}
+
+template <class T>
+inline KisTileData* KisTileHashTableTraits3<T>::refAndFetchDefaultTileData()
+{
+    KisEpochReclaimer::Guard guard;
+
+    KisTileData *tileData = m_defaultTileData.load(std::memory_order_acquire);
+    tileData->ref();
+    return tileData;
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::debugPrintInfo()
+{
+    KisEpochReclaimer::Guard guard;
+    Table *table = m_root.load(std::memory_order_acquire);
+
+    dbgTiles << "==========================\n"
+             << "TileHashTable:"
+             << "\n   def. data:\t\t" << m_defaultTileData.load()
+             << "\n   numTiles:\t\t" << numTiles()
+             << "\n   capacity:\t\t" << table->capacity
+             << "\n   usedCells:\t\t" << table->usedCells.load()
+             << "\n   retired:\t\t" << m_retireList.size();
+}
+
+template <class T>
+void KisTileHashTableTraits3<T>::debugMaxListLength(qint32 &min, qint32 &max)
+{
+    KisEpochReclaimer::Guard guard;
+    Table *table = m_root.load(std::memory_order_acquire);
+
+    min = table->capacity;
+    max = 0;
+
+    // the length of the probe sequence of each key
+    for (quint32 i = 0; i < table->capacity; i++) {
+        const quint32 key = table->cells[i].key.load(std::memory_order_relaxed);
+        if (!key) continue;
+
+        const qint32 length = ((i - cellIndex(key, table->mask)) & table->mask) + 1;
+        min = qMin(min, length);
+        max = qMax(max, length);
+    }
+
+    if (max == 0) {
+        min = 0;
+    }
+}
+
+typedef KisTileHashTableTraits3<KisTile> KisTileHashTable;
+typedef KisTileHashTableIteratorTraits3<KisTile> KisTileHashTableIterator;
+typedef KisTileHashTableIteratorTraits3<KisTile> KisTileHashTableConstIterator;
+
+#endif // KIS_TILEHASHTABLE_3_H
@@ -57,6 +57,7 @@ KisTiledDataManager::KisTiledDataManager(const KisTiledDataManager &dm)
     m_hashTable = new KisTileHashTable(*dm.m_hashTable, m_mementoManager);
 
     m_pixelSize = dm.m_pixelSize;
+    m_memoryAccount = dm.m_memoryAccount;
     m_defaultPixel = new quint8[m_pixelSize];
     /**
      * We won't call setDefaultTileData here, as defaultTileDatas
@@ -90,7 +91,7 @@ void KisTiledDataManager::setDefaultPixel(const quint8 *defaultPixel)
 
 void KisTiledDataManager::setDefaultPixelImpl(const quint8 *defaultPixel)
 {
-    KisTileData *td = KisTileDataStore::instance()->createDefaultTileData(pixelSize(), defaultPixel);
+    KisTileData *td = KisTileDataStore::instance()->createDefaultTileData(pixelSize(), defaultPixel, m_memoryAccount);
     m_hashTable->setDefaultTileData(td);
     m_mementoManager->setDefaultTileData(td);
 
@@ -348,7 +349,7 @@ void KisTiledDataManager::clear(QRect clearRect, const quint8 *clearPixel)
         clearRect.width() >= KisTileData::WIDTH &&
         clearRect.height() >= KisTileData::HEIGHT) {
 
-        td = KisTileDataStore::instance()->createDefaultTileData(pixelSize, clearPixel);
+        td = KisTileDataStore::instance()->createDefaultTileData(pixelSize, clearPixel, m_memoryAccount);
         td->acquire();
     }
 
@@ -675,6 +676,142 @@ KisRegion KisTiledDataManager::region() const
     return KisRegion(std::move(rects));
 }
 
+namespace {
+inline quint64 tileRevisionKey(qint32 col, qint32 row)
+{
+    return (quint64(quint32(col)) << 32) | quint32(row);
+}
+
+inline QRect tileRevisionRect(quint64 key)
+{
+    const qint32 col = qint32(quint32(key >> 32));
+    const qint32 row = qint32(quint32(key));
+
+    return QRect(col * KisTileData::WIDTH, row * KisTileData::HEIGHT,
+                 KisTileData::WIDTH, KisTileData::HEIGHT);
+}
+}
+
+KisRegion KisTiledDataManager::changedTilesRegion(const TileRevisions &oldRevisions,
+                                                  TileRevisions *revisions) const
+{
+    QVector<QRect> rects;
+    TileRevisions newRevisions;
+    newRevisions.reserve(oldRevisions.size());
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        const quint64 key = tileRevisionKey(tile->col(), tile->row());
+        const KisTile::Revision revision = tile->revision();
+
+        auto it = oldRevisions.constFind(key);
+        if (it == oldRevisions.constEnd() || *it != revision) {
+            rects << tile->extent();
+        }
+
+        newRevisions.insert(key, revision);
+        iter.next();
+    }
+
+    for (auto it = oldRevisions.constBegin(); it != oldRevisions.constEnd(); ++it) {
+        if (!newRevisions.contains(it.key())) {
+            rects << tileRevisionRect(it.key());
+        }
+    }
+
+    if (revisions) {
+        *revisions = std::move(newRevisions);
+    }
+
+    return KisRegion(std::move(rects));
+}
+
+void KisTiledDataManager::prefetchSwappedTiles(const QRect &rect) const
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    if (rect.isEmpty() || !store->hasSwappedTiles()) return;
+
+    const QRect tilesRect = rect & extent();
+    if (tilesRect.isEmpty()) return;
+
+    const qint32 firstColumn = xToCol(tilesRect.left());
+    const qint32 lastColumn = xToCol(tilesRect.right());
+    const qint32 firstRow = yToRow(tilesRect.top());
+    const qint32 lastRow = yToRow(tilesRect.bottom());
+
+    QVector<KisTileSP> swappedTiles;
+
+    // the iterators walk row by row, so queue the tiles in the same order
+    for (qint32 row = firstRow; row <= lastRow; row++) {
+        for (qint32 column = firstColumn; column <= lastColumn; column++) {
+            KisTileSP tile = m_hashTable->getExistingTile(column, row);
+
+            if (tile && tile->isSwappedOut()) {
+                swappedTiles << tile;
+            }
+        }
+    }
+
+    if (!swappedTiles.isEmpty()) {
+        store->prefetchTiles(swappedTiles);
+    }
+}
+
+qint32 KisTiledDataManager::shareUniformTiles(const QRect &rect)
+{
+    QReadLocker locker(&m_lock);
+
+    const QRect tilesRect = rect & extent();
+    if (tilesRect.isEmpty()) return 0;
+
+    const qint32 firstColumn = xToCol(tilesRect.left());
+    const qint32 lastColumn = xToCol(tilesRect.right());
+    const qint32 firstRow = yToRow(tilesRect.top());
+    const qint32 lastRow = yToRow(tilesRect.bottom());
+
+    qint32 numSharedTiles = 0;
+
+    for (qint32 row = firstRow; row <= lastRow; row++) {
+        for (qint32 column = firstColumn; column <= lastColumn; column++) {
+            KisTileSP tile = m_hashTable->getExistingTile(column, row);
+
+            if (tile && tile->shareUniformTileData()) {
+                numSharedTiles++;
+            }
+        }
+    }
+
+    return numSharedTiles;
+}
+
+void KisTiledDataManager::setMemoryAccount(qint32 account)
+{
+    QWriteLocker locker(&m_lock);
+
+    if (m_memoryAccount == account) return;
+    m_memoryAccount = account;
+
+    KisTileData *td = KisTileDataStore::instance()->createDefaultTileData(pixelSize(), m_defaultPixel, m_memoryAccount);
+    m_hashTable->setDefaultTileData(td);
+    m_mementoManager->setDefaultTileData(td);
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        tile->trySetMemoryAccount(account);
+        iter.next();
+    }
+}
+
+qint32 KisTiledDataManager::memoryAccount() const
+{
+    QReadLocker locker(&m_lock);
+    return m_memoryAccount;
+}
+
 void KisTiledDataManager::setPixel(qint32 x, qint32 y, const quint8 * data)
 {
     KisTileDataWrapper tw(this, x, y, KisTileDataWrapper::WRITE);
@@ -8,6 +8,7 @@
 #define KIS_TILEDDATAMANAGER_H_
 
 #include <QtGlobal>
+#include <QHash>
 #include <QVector>
 #include <KisRegion.h>
 
@@ -18,11 +19,13 @@
 //#include "kis_debug.h"
 #include "kritaimage_export.h"
 
-#ifdef USE_LOCK_FREE_HASH_TABLE
+#if defined(USE_EPOCH_HASH_TABLE)
+#include "kis_tile_hash_table3.h"
+#elif defined(USE_LOCK_FREE_HASH_TABLE)
 #include "kis_tile_hash_table2.h"
 #else
 #include "kis_tile_hash_table.h"
-#endif // USE_LOCK_FREE_HASH_TABLE
+#endif // USE_EPOCH_HASH_TABLE
 
 #include "kis_memento_manager.h"
 #include "kis_memento.h"
@@ -190,6 +193,26 @@ public:
         m_mementoManager->purgeHistory(oldestMemento);
     }
 
+    /**
+     * Returns the amount of memory kept in the history by
+     * the revision of \p memento
+     *
+     * \see KisMementoManager::revisionMemorySize()
+     */
+    qint64 mementoMemorySize(KisMementoSP memento) const {
+        QReadLocker locker(&m_lock);
+        return m_mementoManager->revisionMemorySize(memento);
+    }
+
+    /**
+     * Returns the amount of memory kept by the whole
+     * history of the data manager
+     */
+    qint64 historyMemorySize() const {
+        QReadLocker locker(&m_lock);
+        return m_mementoManager->historyMemorySize();
+    }
+
     static void releaseInternalPools();
 
 protected:
@@ -216,6 +239,53 @@ public:
 
     KisRegion region() const;
 
+    /**
+     * Revisions of all the tiles of the data manager indexed by the
+     * position of the tile, see KisTile::Revision
+     */
+    typedef QHash<quint64, KisTile::Revision> TileRevisions;
+
+    /**
+     * Saves the revisions of all the tiles into \p revisions and
+     * returns the region of the tiles whose revision differs from
+     * \p oldRevisions: the written, created and removed tiles.
+     * The region is in the coordinates of the data manager.
+     */
+    KisRegion changedTilesRegion(const TileRevisions &oldRevisions,
+                                 TileRevisions *revisions) const;
+
+    /**
+     * Starts loading the swapped-out tiles of \p rect in background
+     * threads. Should be called before iterating through a big area
+     * to avoid stalls on every swapped-out tile.
+     *
+     * \see KisTileDataPrefetcher
+     */
+    void prefetchSwappedTiles(const QRect &rect) const;
+
+    /**
+     * Replaces the data of the tiles of \p rect that have only one
+     * color with the tile data shared between all such tiles.
+     * Called on committing a transaction.
+     *
+     * \return the number of tiles that have been replaced
+     *
+     * \see KisTile::shareUniformTileData()
+     */
+    qint32 shareUniformTiles(const QRect &rect);
+
+    /**
+     * Charges the tile data of the data manager to \p account
+     * (usually, the account of the image the device belongs to).
+     * The new tiles inherit the account from the default tile data.
+     * The tiles that are being accessed right now keep the old
+     * account.
+     *
+     * \see KisTileDataStore::createMemoryAccount()
+     */
+    void setMemoryAccount(qint32 account);
+    qint32 memoryAccount() const;
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
@@ -336,6 +406,7 @@ private:
     KisMementoManager *m_mementoManager;
     quint8* m_defaultPixel;
     qint32 m_pixelSize;
+    qint32 m_memoryAccount = 0;
     KisTiledExtentManager m_extentManager;
 
     mutable QReadWriteLock m_lock;
@@ -0,0 +1,47 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ABSTRACT_SWAP_SPACE_H
+#define __KIS_ABSTRACT_SWAP_SPACE_H
+
+#include "kritaimage_export.h"
+#include "kis_chunk_allocator.h"
+
+/**
+ * Base class for the backends of the swap file. A backend gives
+ * access to the chunks of the file allocated by KisChunkAllocator.
+ * The returned pointers are valid only until the next call to the
+ * backend.
+ */
+
+class KRITAIMAGE_EXPORT KisAbstractSwapSpace
+{
+public:
+    KisAbstractSwapSpace();
+    virtual ~KisAbstractSwapSpace();
+
+    inline quint8* getReadChunkPtr(KisChunk readChunk) {
+        return getReadChunkPtr(readChunk.data());
+    }
+
+    inline quint8* getWriteChunkPtr(KisChunk writeChunk) {
+        return getWriteChunkPtr(writeChunk.data());
+    }
+
+    /**
+     * \return a pointer to the beginning of \p readChunk
+     *         or null if the swap file is not accessible
+     */
+    virtual quint8* getReadChunkPtr(const KisChunkData &readChunk) = 0;
+
+    /**
+     * \return a pointer to the beginning of \p writeChunk
+     *         or null if the swap file cannot be grown
+     */
+    virtual quint8* getWriteChunkPtr(const KisChunkData &writeChunk) = 0;
+};
+
+#endif /* __KIS_ABSTRACT_SWAP_SPACE_H */
@@ -18,10 +18,11 @@
 #define WRAP_PREVIOUS_CHUNK_DATA(iter) (KisChunk((iter)-1))
 
 
-KisChunkAllocator::KisChunkAllocator(quint64 slabSize, quint64 storeSize)
+KisChunkAllocator::KisChunkAllocator(quint64 slabSize, quint64 storeSize, quint64 segmentSize)
 {
     m_storeMaxSize = storeSize;
     m_storeSlabSize = slabSize;
+    m_segmentSize = segmentSize;
 
     m_iterator = m_list.begin();
     m_storeSize = m_storeSlabSize;
@@ -93,7 +94,24 @@ bool KisChunkAllocator::tryInsertChunk(KisChunkDataList &list,
         shift = 1;
     }
 
-    if(GAP_SIZE(lowBound, highBound) >= size) {
+    if(m_segmentSize) {
+        /**
+         * Segment-aligned policy: if the chunk doesn't fit into
+         * the rest of the current segment, move it to the
+         * beginning of the next one
+         */
+        quint64 begin = lowBound + shift;
+        const quint64 segmentEnd = (begin / m_segmentSize + 1) * m_segmentSize;
+
+        if(begin + size > segmentEnd)
+            begin = segmentEnd;
+
+        if(size <= m_segmentSize && begin + size <= highBound) {
+            list.insert(iterator, KisChunkData(begin, size));
+            result = true;
+        }
+    }
+    else if(GAP_SIZE(lowBound, highBound) >= size) {
         list.insert(iterator, KisChunkData(lowBound + shift, size));
         result = true;
     }
@@ -116,8 +116,17 @@ private:
 class KRITAIMAGE_EXPORT KisChunkAllocator
 {
 public:
+    /**
+     * \param segmentSize if non-zero, the allocator uses the
+     *        segment-aligned policy: no chunk will cross the
+     *        boundary of a \p segmentSize block of the store. It is
+     *        needed for the backends that map the store in segments,
+     *        like KisMappedSwapFile. With zero value the chunks are
+     *        packed tightly.
+     */
     KisChunkAllocator(quint64 slabSize = DEFAULT_SLAB_SIZE,
-                      quint64 storeSize = DEFAULT_STORE_SIZE);
+                      quint64 storeSize = DEFAULT_STORE_SIZE,
+                      quint64 segmentSize = 0);
     ~KisChunkAllocator();
 
     inline quint64 numChunks() const {
@@ -139,6 +148,7 @@ private:
 private:
     quint64 m_storeMaxSize;
     quint64 m_storeSlabSize;
+    quint64 m_segmentSize;
 
 
     KisChunkDataList m_list;
@@ -0,0 +1,95 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_compression_factory.h"
+
+#include <config-swap-compression.h>
+
+#include "kis_lzf_compression.h"
+
+#ifdef HAVE_LZ4
+#include "kis_lz4_compression.h"
+#endif
+
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
+
+
+KisAbstractCompression* KisCompressionFactory::create(Type type)
+{
+    switch (type) {
+#ifdef HAVE_LZ4
+    case LZ4:
+        return new KisLz4Compression();
+#endif
+#ifdef HAVE_ZSTD
+    case ZSTD:
+        return new KisZstdCompression();
+#endif
+    default:
+        return new KisLzfCompression();
+    }
+}
+
+bool KisCompressionFactory::isSupported(Type type)
+{
+    switch (type) {
+    case LZF:
+        return true;
+    case LZ4:
+#ifdef HAVE_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case ZSTD:
+#ifdef HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+QList<KisCompressionFactory::Type> KisCompressionFactory::supportedTypes()
+{
+    QList<Type> result;
+
+    Q_FOREACH (Type type, QList<Type>() << LZF << LZ4 << ZSTD) {
+        if (isSupported(type)) {
+            result << type;
+        }
+    }
+
+    return result;
+}
+
+QString KisCompressionFactory::name(Type type)
+{
+    switch (type) {
+    case LZF:
+        return "LZF";
+    case LZ4:
+        return "LZ4";
+    case ZSTD:
+        return "ZSTD";
+    }
+
+    return "LZF";
+}
+
+KisCompressionFactory::Type KisCompressionFactory::fromName(const QString &name, Type defaultType)
+{
+    const QString upperName = name.toUpper();
+
+    return upperName == "LZF" ? LZF :
+        upperName == "LZ4" ? LZ4 :
+        upperName == "ZSTD" ? ZSTD :
+        defaultType;
+}
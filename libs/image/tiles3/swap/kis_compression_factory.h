@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_COMPRESSION_FACTORY_H
+#define __KIS_COMPRESSION_FACTORY_H
+
+#include "kritaimage_export.h"
+#include <QString>
+#include <QList>
+
+class KisAbstractCompression;
+
+/**
+ * Creates compression backends for the tile compressors. LZF is
+ * always available, LZ4 and Zstd are present only when Krita is
+ * built with the corresponding libraries.
+ */
+class KRITAIMAGE_EXPORT KisCompressionFactory
+{
+public:
+    enum Type {
+        LZF = 0,
+        LZ4,
+        ZSTD
+    };
+
+    /**
+     * Creates a compression object of type \p type. If the type
+     * is not supported by the build, falls back to LZF.
+     */
+    static KisAbstractCompression* create(Type type);
+
+    static bool isSupported(Type type);
+    static QList<Type> supportedTypes();
+
+    /**
+     * The name of the algorithm as written into the tile headers
+     * and into the configuration file, e.g. "LZF"
+     */
+    static QString name(Type type);
+
+    /**
+     * Returns the type by its \p name or \p defaultType if the
+     * name is unknown
+     */
+    static Type fromName(const QString &name, Type defaultType = LZF);
+
+private:
+    KisCompressionFactory();
+};
+
+#endif /* __KIS_COMPRESSION_FACTORY_H */
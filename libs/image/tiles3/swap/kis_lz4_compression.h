@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_LZ4_COMPRESSION_H
+#define __KIS_LZ4_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+#include <QByteArray>
+
+/**
+ * LZ4 based compression. It gives a slightly worse compression
+ * ratio than LZF, but decompresses several times faster, which
+ * lowers the latency of swapping the tiles in.
+ */
+class KRITAIMAGE_EXPORT KisLz4Compression : public KisAbstractCompression
+{
+public:
+    KisLz4Compression();
+    ~KisLz4Compression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+private:
+    /**
+     * The hash table used by the compressor. It is rather big
+     * (16 KiB), so we allocate it once per compression object
+     * instead of putting it on stack on every call.
+     */
+    QByteArray m_state;
+};
+
+#endif /* __KIS_LZ4_COMPRESSION_H */
@@ -0,0 +1,130 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_debug.h"
+#include "kis_mapped_swap_file.h"
+
+#include <QDir>
+
+#define SWP_PREFIX "KRITA_SWAP_FILE_XXXXXX"
+
+KisMappedSwapFile::KisMappedSwapFile(const QString &swapDir, quint64 segmentSize)
+    : m_segmentSize(segmentSize),
+      m_numMappedSegments(0)
+{
+    m_valid = true;
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!swapDir.isEmpty());
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_segmentSize > 0);
+
+    QDir d(swapDir);
+    if (!d.exists()) {
+        m_valid = d.mkpath(swapDir);
+    }
+
+    const QString swapFileTemplate = swapDir + '/' + SWP_PREFIX;
+
+    if (m_valid) {
+        m_file.setFileTemplate(swapFileTemplate);
+        bool res = m_file.open();
+        if (!res || m_file.fileName().isEmpty()) {
+            m_valid = false;
+        }
+    }
+
+    if (!m_valid) {
+        qWarning() << "Could not create or open swapfile; disabling swapfile" << swapFileTemplate;
+    }
+}
+
+KisMappedSwapFile::~KisMappedSwapFile()
+{
+    unmapAllSegments();
+}
+
+quint8* KisMappedSwapFile::getReadChunkPtr(const KisChunkData &readChunk)
+{
+    return getChunkPtr(readChunk, false);
+}
+
+quint8* KisMappedSwapFile::getWriteChunkPtr(const KisChunkData &writeChunk)
+{
+    return getChunkPtr(writeChunk, true);
+}
+
+quint8* KisMappedSwapFile::getChunkPtr(const KisChunkData &chunk, bool allowGrowing)
+{
+    if (!m_valid) return nullptr;
+
+    const int segment = chunk.m_begin / m_segmentSize;
+
+    if (segment != int(chunk.m_end / m_segmentSize)) {
+        warnKrita << "KisMappedSwapFile: the requested chunk crosses the segment boundary!"
+                  << ppVar(chunk.m_begin) << ppVar(chunk.m_end) << ppVar(m_segmentSize);
+        return nullptr;
+    }
+
+    if (segment >= m_segments.size()) {
+        if (!allowGrowing || !growFile(segment + 1)) {
+            return nullptr;
+        }
+    }
+
+    quint8 *&mapping = m_segments[segment];
+
+    if (!mapping) {
+#ifdef Q_OS_UNIX
+        // A workaround for https://bugreports.qt-project.org/browse/QTBUG-6330
+        m_file.exists();
+#endif
+
+        mapping = m_file.map(quint64(segment) * m_segmentSize, m_segmentSize);
+        if (!mapping) {
+            return nullptr;
+        }
+
+        m_numMappedSegments++;
+    }
+
+    return mapping + chunk.m_begin - quint64(segment) * m_segmentSize;
+}
+
+bool KisMappedSwapFile::growFile(int numSegments)
+{
+#ifdef Q_OS_WIN32
+    /**
+     * On Windows the mapping handle is limited to the size of the
+     * file at the moment of its creation, so all the mappings
+     * should be released before resizing the file (see the comment
+     * in KisMemoryWindow). They will be recreated on demand.
+     */
+    unmapAllSegments();
+#endif
+
+    /**
+     * The file is grown in whole segments, on most of the systems
+     * it is sparse, so no disk space is consumed until the data is
+     * actually written.
+     */
+    if (!m_file.resize(quint64(numSegments) * m_segmentSize)) {
+        return false;
+    }
+
+    m_segments.resize(numSegments);
+    return true;
+}
+
+void KisMappedSwapFile::unmapAllSegments()
+{
+    for (int i = 0; i < m_segments.size(); i++) {
+        if (m_segments[i]) {
+            m_file.unmap(m_segments[i]);
+            m_segments[i] = 0;
+        }
+    }
+
+    m_numMappedSegments = 0;
+}
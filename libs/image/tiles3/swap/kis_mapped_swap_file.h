@@ -0,0 +1,67 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_MAPPED_SWAP_FILE_H
+#define __KIS_MAPPED_SWAP_FILE_H
+
+#include <QTemporaryFile>
+#include <QVector>
+
+#include "kis_abstract_swap_space.h"
+
+
+#define DEFAULT_SEGMENT_SIZE (256*MiB)
+
+/**
+ * The swap file backend that maps the whole swap file in large
+ * segments and keeps them mapped for its entire lifetime. Paging
+ * the data in and out is left to the kernel, so there is no
+ * remapping when the swapper jumps around the file.
+ *
+ * The chunks must never cross the segment boundary, so the store
+ * should be allocated with the segment-aligned policy of
+ * KisChunkAllocator using the same segment size.
+ */
+class KRITAIMAGE_EXPORT KisMappedSwapFile : public KisAbstractSwapSpace
+{
+public:
+    /**
+     * @param swapDir If the dir doesn't exist, it'll be created, if it's empty QDir::tempPath will be used.
+     * @param segmentSize the size of a single mapping.
+     */
+    KisMappedSwapFile(const QString &swapDir, quint64 segmentSize = DEFAULT_SEGMENT_SIZE);
+    ~KisMappedSwapFile() override;
+
+    using KisAbstractSwapSpace::getReadChunkPtr;
+    using KisAbstractSwapSpace::getWriteChunkPtr;
+
+    quint8* getReadChunkPtr(const KisChunkData &readChunk) override;
+    quint8* getWriteChunkPtr(const KisChunkData &writeChunk) override;
+
+    inline quint64 segmentSize() const {
+        return m_segmentSize;
+    }
+
+    inline int numMappedSegments() const {
+        return m_numMappedSegments;
+    }
+
+private:
+    quint8* getChunkPtr(const KisChunkData &chunk, bool allowGrowing);
+    bool growFile(int numSegments);
+    void unmapAllSegments();
+
+private:
+    QTemporaryFile m_file;
+
+    bool m_valid;
+    const quint64 m_segmentSize;
+
+    QVector<quint8*> m_segments;
+    int m_numMappedSegments;
+};
+
+#endif /* __KIS_MAPPED_SWAP_FILE_H */
@@ -7,30 +7,44 @@
 //#include "kis_debug.h"
 #include "kis_swapped_data_store.h"
 #include "kis_memory_window.h"
+#include "kis_mapped_swap_file.h"
 #include "kis_image_config.h"
 
-#include "kis_tile_compressor_2.h"
-
-//#define COMPRESSOR_VERSION 2
+#include "kis_tile_compressor_factory.h"
+#include "tiles3/kis_tile_data.h"
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_memoryMetric(0)
+    : m_memoryMetric(0),
+      m_compressedMemorySize(0),
+      m_compressedMemoryMetric(0),
+      m_swapOutCount(0),
+      m_swapInCount(0)
 {
     KisImageConfig config(true);
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
     const quint64 swapSlabSize = config.swapSlabSize() * MiB;
     const quint64 swapWindowSize = config.swapWindowSize() * MiB;
 
-    m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    if (swapWindowSize > 0) {
+        m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
+        m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    } else {
+        /**
+         * Zero window size means the whole swap file is mapped
+         * and paging is done by the kernel
+         */
+        m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize, DEFAULT_SEGMENT_SIZE);
+        m_swapSpace = new KisMappedSwapFile(config.swapDir(), DEFAULT_SEGMENT_SIZE);
+    }
+
+    m_compressor = KisTileCompressorFactory::createForSwap(
+        KisCompressionFactory::fromName(config.swapCompression()));
 
-    // FIXME: use a factory after the patch is committed
-    m_compressor = new KisTileCompressor2();
+    m_compressedMemoryLimit = qint64(config.tilesCompressedSwapLimit()) * MiB;
 }
 
 KisSwappedDataStore::~KisSwappedDataStore()
 {
-    delete m_compressor;
     delete m_swapSpace;
     delete m_allocator;
 }
@@ -40,10 +54,15 @@ quint64 KisSwappedDataStore::numTiles() const
     // We are not acquiring the lock here...
     // Hope QLinkedList will ensure atomic access to it's size...
 
-    return m_allocator->numChunks();
+    return m_allocator->numChunks() + m_compressedTiles.size();
+}
+
+quint64 KisSwappedDataStore::numCompressedTiles() const
+{
+    return m_compressedTiles.size();
 }
 
-bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
+bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td, SwapOutPolicy policy)
 {
     Q_ASSERT(td->data());
     QMutexLocker locker(&m_lock);
@@ -61,18 +80,33 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     qint32 bytesWritten;
     m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
 
-    KisChunk chunk = m_allocator->getChunk(bytesWritten);
-    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
-    if (!ptr) {
-        qWarning() << "swap out of tile failed";
+    bool keepInMemory = false;
+
+    if (policy == PreferCompressedMemory && bytesWritten <= m_compressedMemoryLimit) {
+        const qint64 overflow = m_compressedMemorySize + bytesWritten - m_compressedMemoryLimit;
+
+        if (overflow > 0) {
+            spillCompressedTiles(overflow);
+        }
+
+        keepInMemory = m_compressedMemorySize + bytesWritten <= m_compressedMemoryLimit;
+    }
+
+    if (keepInMemory) {
+        td->m_compressedData = QByteArray(m_buffer.constData(), bytesWritten);
+        td->m_compressedDataIterator = m_compressedTiles.insert(m_compressedTiles.end(), td);
+        td->m_state = KisTileData::COMPRESSED;
+
+        m_compressedMemorySize += bytesWritten;
+        m_compressedMemoryMetric += td->pixelSize();
+    } else if (!writeToSwapFile(td, (quint8*) m_buffer.data(), bytesWritten)) {
         return false;
     }
-    memcpy(ptr, m_buffer.data(), bytesWritten);
 
     td->releaseMemory();
-    td->setSwapChunk(chunk);
 
     m_memoryMetric += td->pixelSize();
+    m_swapOutCount.fetchAndAddRelaxed(1);
 
     return true;
 }
@@ -84,36 +118,127 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
 
     // see comment in swapOutTileData()
 
-    KisChunk chunk = td->swapChunk();
-
     td->allocateMemory();
-    td->setSwapChunk(KisChunk());
 
-    quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
-    Q_ASSERT(ptr);
-    m_compressor->decompressTileData(ptr, chunk.size(), td);
-    m_allocator->freeChunk(chunk);
+    if (td->m_state == KisTileData::COMPRESSED) {
+        m_compressor->decompressTileData((quint8*) td->m_compressedData.data(),
+                                         td->m_compressedData.size(), td);
+        forgetCompressedData(td);
+    } else {
+        KisChunk chunk = td->swapChunk();
+        td->setSwapChunk(KisChunk());
+
+        quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
+        Q_ASSERT(ptr);
+        m_compressor->decompressTileData(ptr, chunk.size(), td);
+        m_allocator->freeChunk(chunk);
+    }
+
+    td->m_state = KisTileData::NORMAL;
 
     m_memoryMetric -= td->pixelSize();
+    m_swapInCount.fetchAndAddRelaxed(1);
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
 {
     QMutexLocker locker(&m_lock);
 
-    m_allocator->freeChunk(td->swapChunk());
-    td->setSwapChunk(KisChunk());
+    if (td->m_state == KisTileData::COMPRESSED) {
+        forgetCompressedData(td);
+    } else {
+        m_allocator->freeChunk(td->swapChunk());
+        td->setSwapChunk(KisChunk());
+    }
+
+    td->m_state = KisTileData::NORMAL;
 
     m_memoryMetric -= td->pixelSize();
 }
 
+bool KisSwappedDataStore::writeToSwapFile(KisTileData *td, quint8 *buffer, qint32 size)
+{
+    KisChunk chunk = m_allocator->getChunk(size);
+    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
+    if (!ptr) {
+        qWarning() << "swap out of tile failed";
+        m_allocator->freeChunk(chunk);
+        return false;
+    }
+    memcpy(ptr, buffer, size);
+
+    td->setSwapChunk(chunk);
+    td->m_state = KisTileData::SWAPPED;
+
+    return true;
+}
+
+void KisSwappedDataStore::forgetCompressedData(KisTileData *td)
+{
+    m_compressedMemorySize -= td->m_compressedData.size();
+    m_compressedMemoryMetric -= td->pixelSize();
+
+    m_compressedTiles.erase(td->m_compressedDataIterator);
+    td->m_compressedDataIterator = KisTileDataListIterator();
+    td->m_compressedData = QByteArray();
+}
+
+void KisSwappedDataStore::spillCompressedTiles(qint64 sizeToFree)
+{
+    /**
+     * The tile data stored in the compressed tier is not accessed
+     * by anyone without taking m_lock, so we can move it to
+     * the swap file without locking the tile data itself
+     */
+
+    qint64 freedSize = 0;
+
+    while (freedSize < sizeToFree && !m_compressedTiles.isEmpty()) {
+        KisTileData *td = m_compressedTiles.first();
+        const qint32 size = td->m_compressedData.size();
+
+        if (!writeToSwapFile(td, (quint8*) td->m_compressedData.data(), size)) {
+            break;
+        }
+
+        forgetCompressedData(td);
+        freedSize += size;
+    }
+}
+
 qint64 KisSwappedDataStore::totalMemoryMetric() const
 {
     return m_memoryMetric;
 }
 
+qint64 KisSwappedDataStore::compressedMemoryMetric() const
+{
+    return m_compressedMemoryMetric;
+}
+
+qint64 KisSwappedDataStore::compressedMemorySize() const
+{
+    return m_compressedMemorySize;
+}
+
+qint64 KisSwappedDataStore::swapOutCount() const
+{
+    return m_swapOutCount.loadAcquire();
+}
+
+qint64 KisSwappedDataStore::swapInCount() const
+{
+    return m_swapInCount.loadAcquire();
+}
+
 void KisSwappedDataStore::debugStatistics()
 {
     m_allocator->sanityCheck();
     m_allocator->debugFragmentation();
 }
+
+void KisSwappedDataStore::testingRereadConfig()
+{
+    QMutexLocker locker(&m_lock);
+    m_compressedMemoryLimit = qint64(KisImageConfig(true).tilesCompressedSwapLimit()) * MiB;
+}
@@ -11,32 +11,57 @@
 
 #include <QMutex>
 #include <QByteArray>
+#include <QAtomicInteger>
 
+#include "kis_shared_ptr.h"
+#include "tiles3/kis_tile_data_interface.h"
 
 class QMutex;
 class KisTileData;
 class KisAbstractTileCompressor;
+typedef KisSharedPtr<KisAbstractTileCompressor> KisAbstractTileCompressorSP;
 class KisChunkAllocator;
-class KisMemoryWindow;
-
+class KisAbstractSwapSpace;
+
+/**
+ * The swapped out tile data is stored in two tiers. First, the
+ * compressed data is kept in memory, while the size of this tier
+ * is below KisImageConfig::tilesCompressedSwapLimit(). When the
+ * tier overflows, the oldest compressed tiles are spilled to the
+ * swap file on disk.
+ */
 class KRITAIMAGE_EXPORT KisSwappedDataStore
 {
 public:
     KisSwappedDataStore();
     ~KisSwappedDataStore();
 
+    enum SwapOutPolicy {
+        PreferCompressedMemory,
+        ForceDisk
+    };
+
     /**
      * Returns number of swapped out tile data objects
+     * (both in memory and on disk)
      */
     quint64 numTiles() const;
 
     /**
-     * Swap out the data stored in the \a td to the swap file
-     * and free memory occupied by td->data().
+     * Returns number of tile data objects stored in the
+     * compressed in-memory tier
+     */
+    quint64 numCompressedTiles() const;
+
+    /**
+     * Swap out the data stored in the \a td and free memory
+     * occupied by td->data(). With PreferCompressedMemory policy
+     * the compressed data is kept in memory if the tier has
+     * enough space, otherwise it is written to the swap file.
      * LOCKING: the lock on the tile data should be taken
      *          by the caller before making a call.
      */
-    bool trySwapOutTileData(KisTileData *td);
+    bool trySwapOutTileData(KisTileData *td, SwapOutPolicy policy = PreferCompressedMemory);
 
     /**
      * Restore the data of a \a td basing on information
@@ -59,21 +84,64 @@ public:
      */
     qint64 totalMemoryMetric() const;
 
+    /**
+     * Returns the metric of the tiles stored in the compressed
+     * in-memory tier in *uncompressed* form
+     */
+    qint64 compressedMemoryMetric() const;
+
+    /**
+     * Returns the number of bytes actually occupied by
+     * the compressed in-memory tier
+     */
+    qint64 compressedMemorySize() const;
+
+    /**
+     * Return the total number of tile data objects swapped
+     * out and swapped in since the store was created. The
+     * swapped out tile data that was discarded without being
+     * read back is not counted as swapped in.
+     */
+    qint64 swapOutCount() const;
+    qint64 swapInCount() const;
+
     /**
      * Some debugging output
      */
     void debugStatistics();
 
+    void testingRereadConfig();
+
+private:
+    bool writeToSwapFile(KisTileData *td, quint8 *buffer, qint32 size);
+    void forgetCompressedData(KisTileData *td);
+    void spillCompressedTiles(qint64 sizeToFree);
+
 private:
     QByteArray m_buffer;
-    KisAbstractTileCompressor *m_compressor;
+    KisAbstractTileCompressorSP m_compressor;
 
     KisChunkAllocator *m_allocator;
-    KisMemoryWindow *m_swapSpace;
+    KisAbstractSwapSpace *m_swapSpace;
 
     QMutex m_lock;
 
     qint64 m_memoryMetric;
+
+    /**
+     * The compressed tiles in the order they have been
+     * swapped out, the first ones are spilled to disk first
+     */
+    KisTileDataList m_compressedTiles;
+    qint64 m_compressedMemoryLimit;
+    qint64 m_compressedMemorySize;
+    qint64 m_compressedMemoryMetric;
+
+    /**
+     * The counters are read without taking m_lock
+     */
+    QAtomicInteger<qint64> m_swapOutCount;
+    QAtomicInteger<qint64> m_swapInCount;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
@@ -10,12 +10,16 @@
 #include "kis_paint_device_writer.h"
 #define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
-
-
 KisTileCompressor2::KisTileCompressor2()
+    : m_compression(new KisLzfCompression()),
+      m_compressionName("LZF")
+{
+}
+
+KisTileCompressor2::KisTileCompressor2(KisAbstractCompression *compression, const QString &compressionName)
+    : m_compression(compression),
+      m_compressionName(compressionName)
 {
-    m_compression = new KisLzfCompression();
 }
 
 KisTileCompressor2::~KisTileCompressor2()
@@ -15,6 +15,14 @@ class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
     KisTileCompressor2();
+
+    /**
+     * Creates a compressor that uses \p compression as a backend.
+     * The compressor takes ownership of the \p compression object.
+     * \p compressionName is written into the tile headers.
+     */
+    KisTileCompressor2(KisAbstractCompression *compression, const QString &compressionName);
+
     ~KisTileCompressor2() override;
 
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
@@ -46,7 +54,7 @@ private:
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
     KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+    const QString m_compressionName;
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
@@ -9,6 +9,7 @@
 
 #include "tiles3/swap/kis_legacy_tile_compressor.h"
 #include "tiles3/swap/kis_tile_compressor_2.h"
+#include "tiles3/swap/kis_compression_factory.h"
 
 class KRITAIMAGE_EXPORT KisTileCompressorFactory
 {
@@ -27,6 +28,21 @@ public:
         };
     }
 
+    /**
+     * Creates a compressor for the swap file. The swap file is never
+     * shared between Krita versions, so it may use any algorithm
+     * supported by the build, not only LZF used by the .kra files.
+     */
+    static KisAbstractTileCompressorSP createForSwap(KisCompressionFactory::Type type) {
+        if (!KisCompressionFactory::isSupported(type)) {
+            type = KisCompressionFactory::LZF;
+        }
+
+        return KisAbstractTileCompressorSP(
+            new KisTileCompressor2(KisCompressionFactory::create(type),
+                                   KisCompressionFactory::name(type)));
+    }
+
 private:
     KisTileCompressorFactory();
 };
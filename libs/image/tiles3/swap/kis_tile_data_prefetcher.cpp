@@ -0,0 +1,104 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_data_prefetcher.h"
+
+#include <QRunnable>
+#include <QThread>
+
+#include "../kis_tile.h"
+
+namespace {
+
+/**
+ * The maximum number of tiles waiting for the swap-in. For RGBA8
+ * it is 64 MiB of data.
+ */
+const int MAX_QUEUED_TILES = 4096;
+
+/**
+ * The tiles are queued in small batches to reduce the
+ * overhead of the thread pool
+ */
+const int TILES_PER_JOB = 16;
+
+class PrefetchJob : public QRunnable
+{
+public:
+    PrefetchJob(const QVector<KisTileSP> &tiles, QAtomicInt *numQueuedTiles)
+        : m_tiles(tiles),
+          m_numQueuedTiles(numQueuedTiles)
+    {
+    }
+
+    void run() override {
+        Q_FOREACH (KisTileSP tile, m_tiles) {
+            /**
+             * Locking the tile for read makes the store load the
+             * tile data from swap. We don't need the data itself,
+             * so unlock it right away and let the tile age normally.
+             */
+            tile->lockForRead();
+            tile->unlockForRead();
+
+            m_numQueuedTiles->deref();
+        }
+    }
+
+private:
+    QVector<KisTileSP> m_tiles;
+    QAtomicInt *m_numQueuedTiles;
+};
+
+}
+
+KisTileDataPrefetcher::KisTileDataPrefetcher()
+    : m_numQueuedTiles(0)
+{
+    /**
+     * The swap-in itself is serialized by the store, so the
+     * threads mostly overlap the disk reads with the work of
+     * the update threads. A couple of them is enough.
+     */
+    m_threadPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 4, 4));
+}
+
+KisTileDataPrefetcher::~KisTileDataPrefetcher()
+{
+    waitForDone();
+}
+
+void KisTileDataPrefetcher::prefetch(const QVector<KisTileSP> &tiles)
+{
+    QVector<KisTileSP> batch;
+    batch.reserve(TILES_PER_JOB);
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        if (m_numQueuedTiles.loadAcquire() >= MAX_QUEUED_TILES) break;
+
+        m_numQueuedTiles.ref();
+        batch << tile;
+
+        if (batch.size() >= TILES_PER_JOB) {
+            m_threadPool.start(new PrefetchJob(batch, &m_numQueuedTiles));
+            batch.clear();
+        }
+    }
+
+    if (!batch.isEmpty()) {
+        m_threadPool.start(new PrefetchJob(batch, &m_numQueuedTiles));
+    }
+}
+
+int KisTileDataPrefetcher::numQueuedTiles() const
+{
+    return m_numQueuedTiles.loadAcquire();
+}
+
+void KisTileDataPrefetcher::waitForDone()
+{
+    m_threadPool.waitForDone();
+}
@@ -0,0 +1,64 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_TILE_DATA_PREFETCHER_H
+#define __KIS_TILE_DATA_PREFETCHER_H
+
+#include <QVector>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+#include "kritaimage_export.h"
+#include "kis_shared_ptr.h"
+
+class KisTile;
+typedef KisSharedPtr<KisTile> KisTileSP;
+
+
+/**
+ * Loads swapped-out tiles back into memory in background threads.
+ *
+ * When an iterator or a merge walker starts processing a rect, it
+ * queues all the swapped-out tiles of that rect here, so that they
+ * are read from the swap file while the processing thread is busy
+ * with the tiles that are already in memory. Without that the
+ * processing thread would stall on every swapped tile in turn.
+ *
+ * The prefetcher only keeps a limited number of tiles in the queue,
+ * so that prefetching of a huge rect would not evict the tiles that
+ * have just been prefetched.
+ */
+class KRITAIMAGE_EXPORT KisTileDataPrefetcher
+{
+public:
+    KisTileDataPrefetcher();
+    ~KisTileDataPrefetcher();
+
+    /**
+     * Queues \p tiles for loading. The tiles are loaded in the
+     * order they are stored in the vector. The tiles exceeding
+     * the queue limit are silently skipped.
+     */
+    void prefetch(const QVector<KisTileSP> &tiles);
+
+    /**
+     * The number of tiles currently waiting in the queue
+     */
+    int numQueuedTiles() const;
+
+    /**
+     * Blocks until all the queued tiles are loaded
+     */
+    void waitForDone();
+
+private:
+    Q_DISABLE_COPY(KisTileDataPrefetcher)
+
+    QThreadPool m_threadPool;
+    QAtomicInt m_numQueuedTiles;
+};
+
+#endif /* __KIS_TILE_DATA_PREFETCHER_H */
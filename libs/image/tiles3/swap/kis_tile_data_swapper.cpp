@@ -114,23 +114,78 @@ void KisTileDataSwapper::doJob()
     DEBUG_VALUE(m_d->limits.hardLimitThreshold());
 
 
+    DEBUG_ACTION("\t quota pass");
+    memoryMetric -= quotaPass();
+    DEBUG_VALUE(memoryMetric);
+
     if(memoryMetric > m_d->limits.softLimitThreshold()) {
         qint32 softFree =  memoryMetric - m_d->limits.softLimit();
         DEBUG_VALUE(softFree);
         DEBUG_ACTION("\t pass0");
-        memoryMetric -= pass<SoftSwapStrategy>(softFree);
+        memoryMetric -= tieredPass<SoftSwapStrategy>(softFree);
         DEBUG_VALUE(memoryMetric);
 
         if(memoryMetric > m_d->limits.hardLimitThreshold()) {
             qint32 hardFree =  memoryMetric - m_d->limits.hardLimit();
             DEBUG_VALUE(hardFree);
             DEBUG_ACTION("\t pass1");
-            memoryMetric -= pass<AggressiveSwapStrategy>(hardFree);
+            memoryMetric -= tieredPass<AggressiveSwapStrategy>(hardFree);
             DEBUG_VALUE(memoryMetric);
         }
     }
 }
 
+qint64 KisTileDataSwapper::quotaPass()
+{
+    qint64 freedMetric = 0;
+
+    /**
+     * Account 0 belongs to no document, so it has no quota
+     */
+    for (qint32 account = 1; account < KisTileDataStore::MAX_MEMORY_ACCOUNTS; account++) {
+        qint64 accountMetric = m_d->store->memoryAccountMetric(account);
+        if (accountMetric <= m_d->limits.documentQuotaThreshold()) continue;
+
+        DEBUG_VALUE(account);
+        DEBUG_VALUE(accountMetric);
+
+        const KisSwapAccountFilter filter(m_d->store, KisSwapAccountFilter::SingleAccount, account);
+
+        qint64 freed = pass<SoftSwapStrategy>(accountMetric - m_d->limits.documentQuota(), filter);
+        accountMetric -= freed;
+
+        if (accountMetric > m_d->limits.documentQuotaThreshold()) {
+            freed += pass<AggressiveSwapStrategy>(accountMetric - m_d->limits.documentQuota(), filter);
+        }
+
+        freedMetric += freed;
+    }
+
+    return freedMetric;
+}
+
+template<class strategy>
+qint64 KisTileDataSwapper::tieredPass(qint64 needToFreeMetric)
+{
+    qint64 freedMetric = 0;
+
+    /**
+     * The documents the user doesn't work with right
+     * now are the first victims of the swapper
+     */
+    if (m_d->store->backgroundMemoryMetric() > 0) {
+        const KisSwapAccountFilter filter(m_d->store, KisSwapAccountFilter::BackgroundAccounts);
+        freedMetric += pass<strategy>(needToFreeMetric, filter);
+    }
+
+    if (freedMetric < needToFreeMetric) {
+        const KisSwapAccountFilter filter(m_d->store, KisSwapAccountFilter::AllAccounts);
+        freedMetric += pass<strategy>(needToFreeMetric - freedMetric, filter);
+    }
+
+    return freedMetric;
+}
+
 
 class SoftSwapStrategy
 {
@@ -153,6 +208,12 @@ public:
     static inline bool swapOutFirst(KisTileData *td) {
         return td->age() > 0;
     }
+
+    static inline KisSwappedDataStore::SwapOutPolicy swapOutPolicy() {
+        // the memento tiles are compressed well and are
+        // rarely needed, keep them in memory while possible
+        return KisSwappedDataStore::PreferCompressedMemory;
+    }
 };
 
 class AggressiveSwapStrategy
@@ -170,18 +231,24 @@ public:
 
     static inline bool isInteresting(KisTileData *td) {
         // Add some aggression...
-        Q_UNUSED(td);
-        return true; // >:)
+        // (but the shared uniform tiles are used by too many tiles
+        // to be worth swapping out)
+        return !td->isSharedUniform(); // >:)
     }
 
     static inline bool swapOutFirst(KisTileData *td) {
         return td->age() > 0;
     }
+
+    static inline KisSwappedDataStore::SwapOutPolicy swapOutPolicy() {
+        // we are under hard pressure, go to disk directly
+        return KisSwappedDataStore::ForceDisk;
+    }
 };
 
 
 template<class strategy>
-qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
+qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric, const KisSwapAccountFilter &filter)
 {
     qint64 freedMetric = 0;
     QList<KisTileData*> additionalCandidates;
@@ -196,10 +263,10 @@ qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
 
         if (freedMetric >= needToFreeMetric) break;
 
-        if (!strategy::isInteresting(item)) continue;
+        if (!strategy::isInteresting(item) || !filter.accepts(item)) continue;
 
         if (strategy::swapOutFirst(item)) {
-            if (iter->trySwapOut(item)) {
+            if (iter->trySwapOut(item, strategy::swapOutPolicy())) {
                 freedMetric += item->pixelSize();
             }
         }
@@ -213,7 +280,7 @@ qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
     Q_FOREACH (item, additionalCandidates) {
         if (freedMetric >= needToFreeMetric) break;
 
-        if (iter->trySwapOut(item)) {
+        if (iter->trySwapOut(item, strategy::swapOutPolicy())) {
             freedMetric += item->pixelSize();
         }
     }
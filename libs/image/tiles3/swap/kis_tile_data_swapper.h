@@ -14,6 +14,7 @@
 
 class KisTileDataStore;
 class KisTileData;
+class KisSwapAccountFilter;
 
 class KRITAIMAGE_EXPORT KisTileDataSwapper : public QThread
 {
@@ -35,7 +36,9 @@ private:
     void run() override;
 
     void doJob();
-    template<class strategy> qint64 pass(qint64 needToFreeMetric);
+    qint64 quotaPass();
+    template<class strategy> qint64 tieredPass(qint64 needToFreeMetric);
+    template<class strategy> qint64 pass(qint64 needToFreeMetric, const KisSwapAccountFilter &filter);
 
 private:
     static const qint32 TIMEOUT;
@@ -8,6 +8,7 @@
 
 #include "kis_image_config.h"
 #include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
 
 
 /*
@@ -41,6 +42,17 @@
   |                        |
   +------------------------+  <-- 0 MiB
 
+  Every document (memory account) has its own pair of limits:
+  when the memory of a document exceeds documentQuotaThreshold,
+  the swapper swaps out its tiles until the level reaches
+  documentQuota. When swapping because of the global limits, the
+  tiles of the background documents are swapped out first.
+
+  The tiles swapped out above softLimitThreshold are compressed
+  and kept in memory (KisSwappedDataStore's in-memory tier). They
+  are spilled to disk when the tier overflows. The tiles swapped
+  out above hardLimitThreshold are written to disk directly.
+
  */
 
 
@@ -57,6 +69,9 @@ public:
 
         m_softLimitThreshold = qBound(0, MiB_TO_METRIC(config.tilesSoftLimit()), m_hardLimitThreshold);
         m_softLimit = m_softLimitThreshold - m_softLimitThreshold / 8;
+
+        m_documentQuotaThreshold = qBound(0, MiB_TO_METRIC(config.tilesDocumentQuota()), m_hardLimitThreshold);
+        m_documentQuota = m_documentQuotaThreshold - m_documentQuotaThreshold / 8;
     }
 
     /**
@@ -83,12 +98,62 @@ public:
         return m_softLimit;
     }
 
+    inline qint32 documentQuotaThreshold() {
+        return m_documentQuotaThreshold;
+    }
+
+    inline qint32 documentQuota() {
+        return m_documentQuota;
+    }
+
 private:
     qint32 m_emergencyThreshold;
     qint32 m_hardLimitThreshold;
     qint32 m_hardLimit;
     qint32 m_softLimitThreshold;
     qint32 m_softLimit;
+    qint32 m_documentQuotaThreshold;
+    qint32 m_documentQuota;
+};
+
+/**
+ * Selects the tile data the swapper is allowed to
+ * swap out during a pass
+ */
+class KisSwapAccountFilter
+{
+public:
+    enum Mode {
+        AllAccounts,
+        BackgroundAccounts,
+        SingleAccount
+    };
+
+    KisSwapAccountFilter(KisTileDataStore *store, Mode mode, qint32 account = 0)
+        : m_store(store),
+          m_mode(mode),
+          m_account(account)
+    {
+    }
+
+    inline bool accepts(KisTileData *td) const {
+        switch (m_mode) {
+        case AllAccounts:
+            return true;
+        case BackgroundAccounts:
+            return m_store->memoryAccountPriority(td->memoryAccount()) ==
+                KisTileDataStore::BackgroundAccount;
+        case SingleAccount:
+            return td->memoryAccount() == m_account;
+        }
+
+        return true;
+    }
+
+private:
+    KisTileDataStore *m_store;
+    Mode m_mode;
+    qint32 m_account;
 };
 
 
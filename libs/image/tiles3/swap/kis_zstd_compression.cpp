@@ -0,0 +1,49 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zstd_compression.h"
+
+#include <zstd.h>
+
+
+KisZstdCompression::KisZstdCompression(int compressionLevel)
+    : m_compressionLevel(compressionLevel),
+      m_compressionContext(ZSTD_createCCtx()),
+      m_decompressionContext(ZSTD_createDCtx())
+{
+}
+
+KisZstdCompression::~KisZstdCompression()
+{
+    ZSTD_freeCCtx(m_compressionContext);
+    ZSTD_freeDCtx(m_decompressionContext);
+}
+
+qint32 KisZstdCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result =
+        ZSTD_compressCCtx(m_compressionContext,
+                          output, outputLength,
+                          input, inputLength,
+                          m_compressionLevel);
+
+    return !ZSTD_isError(result) ? qint32(result) : 0;
+}
+
+qint32 KisZstdCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    const size_t result =
+        ZSTD_decompressDCtx(m_decompressionContext,
+                            output, outputLength,
+                            input, inputLength);
+
+    return !ZSTD_isError(result) ? qint32(result) : 0;
+}
+
+qint32 KisZstdCompression::outputBufferSize(qint32 dataSize)
+{
+    return ZSTD_compressBound(dataSize);
+}
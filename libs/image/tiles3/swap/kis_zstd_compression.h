@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_ZSTD_COMPRESSION_H
+#define __KIS_ZSTD_COMPRESSION_H
+
+#include "kis_abstract_compression.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+/**
+ * Zstandard based compression. It is slower than LZF on compression,
+ * but gives much better ratio, so the swap file grows slower.
+ */
+class KRITAIMAGE_EXPORT KisZstdCompression : public KisAbstractCompression
+{
+public:
+    KisZstdCompression(int compressionLevel = 3);
+    ~KisZstdCompression() override;
+
+    qint32 compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+    qint32 decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength) override;
+
+    qint32 outputBufferSize(qint32 dataSize) override;
+
+private:
+    Q_DISABLE_COPY(KisZstdCompression)
+
+    int m_compressionLevel;
+    ZSTD_CCtx_s *m_compressionContext;
+    ZSTD_DCtx_s *m_decompressionContext;
+};
+
+#endif /* __KIS_ZSTD_COMPRESSION_H */
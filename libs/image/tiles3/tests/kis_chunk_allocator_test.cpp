@@ -109,5 +109,26 @@ void KisChunkAllocatorTest::testFragmentation()
 }
 
 
+void KisChunkAllocatorTest::testSegmentAlignedPolicy()
+{
+    const quint64 segmentSize = 100;
+    KisChunkAllocator allocator(1000, 1000, segmentSize);
+
+    KisChunk chunk1 = allocator.getChunk(60);
+    KisChunk chunk2 = allocator.getChunk(60);
+    KisChunk chunk3 = allocator.getChunk(30);
+
+    QCOMPARE(chunk1.begin(), 0ULL);
+    QCOMPARE(chunk2.begin(), segmentSize);
+    QCOMPARE(chunk3.begin(), 160ULL);
+
+    for (int i = 0; i < 10; i++) {
+        KisChunk chunk = allocator.getChunk(35);
+        QCOMPARE(chunk.begin() / segmentSize, chunk.end() / segmentSize);
+    }
+
+    allocator.sanityCheck();
+}
+
 SIMPLE_TEST_MAIN(KisChunkAllocatorTest)
 
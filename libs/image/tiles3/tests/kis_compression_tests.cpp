@@ -11,6 +11,7 @@
 
 #include "../../../sdk/tests/testutil.h"
 #include "tiles3/swap/kis_lzf_compression.h"
+#include "tiles3/swap/kis_compression_factory.h"
 #include <kis_debug.h>
 
 #define TEST_FILE "tile.png"
@@ -209,6 +210,56 @@ void KisCompressionTests::testLzfOverflow()
     delete compression;
 }
 
+void KisCompressionTests::testLz4RoundTrip()
+{
+    if (!KisCompressionFactory::isSupported(KisCompressionFactory::LZ4)) {
+        QSKIP("LZ4 is not supported by this build");
+    }
+
+    KisAbstractCompression *compression = KisCompressionFactory::create(KisCompressionFactory::LZ4);
+
+    roundTrip(compression);
+    roundTripTwoPass(compression);
+
+    delete compression;
+}
+
+void KisCompressionTests::testLz4Overflow()
+{
+    if (!KisCompressionFactory::isSupported(KisCompressionFactory::LZ4)) {
+        QSKIP("LZ4 is not supported by this build");
+    }
+
+    KisAbstractCompression *compression = KisCompressionFactory::create(KisCompressionFactory::LZ4);
+    testOverflow(compression);
+    delete compression;
+}
+
+void KisCompressionTests::testZstdRoundTrip()
+{
+    if (!KisCompressionFactory::isSupported(KisCompressionFactory::ZSTD)) {
+        QSKIP("Zstd is not supported by this build");
+    }
+
+    KisAbstractCompression *compression = KisCompressionFactory::create(KisCompressionFactory::ZSTD);
+
+    roundTrip(compression);
+    roundTripTwoPass(compression);
+
+    delete compression;
+}
+
+void KisCompressionTests::testZstdOverflow()
+{
+    if (!KisCompressionFactory::isSupported(KisCompressionFactory::ZSTD)) {
+        QSKIP("Zstd is not supported by this build");
+    }
+
+    KisAbstractCompression *compression = KisCompressionFactory::create(KisCompressionFactory::ZSTD);
+    testOverflow(compression);
+    delete compression;
+}
+
 void KisCompressionTests::benchmarkMemCpy()
 {
     QImage image(QString(FILES_DATA_DIR) + QDir::separator() + TEST_FILE);
@@ -30,6 +30,12 @@ private Q_SLOTS:
     void testLzfRoundTrip();
     void testLzfOverflow();
 
+    void testLz4RoundTrip();
+    void testLz4Overflow();
+
+    void testZstdRoundTrip();
+    void testZstdOverflow();
+
     void benchmarkMemCpy();
 
     void benchmarkCompressionLzf();
@@ -24,6 +24,7 @@ void KisLowMemoryTests::initTestCase()
     config.setMemoryHardLimitPercent(1.1 * 100.0 / KisImageConfig::totalRAM());
     config.setMemorySoftLimitPercent(0);
     config.setMemoryPoolLimitPercent(0);
+    config.setMemoryCompressedSwapPercent(0);
 }
 
 
@@ -11,6 +11,7 @@
 #include <QTemporaryDir>
 
 #include "../swap/kis_memory_window.h"
+#include "../swap/kis_mapped_swap_file.h"
 
 void KisMemoryWindowTest::testWindow()
 {
@@ -42,6 +43,46 @@ void KisMemoryWindowTest::testWindow()
     QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
 }
 
+void KisMemoryWindowTest::testMappedSwapFile()
+{
+    QTemporaryDir swapDir;
+    KisMappedSwapFile memory(swapDir.path(), 1024);
+
+    quint8 oddValue = 0xee;
+    const quint8 chunkLength = 10;
+
+    quint8 oddBuf[chunkLength];
+    memset(oddBuf, oddValue, chunkLength);
+
+
+    KisChunkData chunk1(0, chunkLength);
+    KisChunkData chunk2(3 * 1024, chunkLength);
+    KisChunkData chunk3(1020, chunkLength);
+
+    quint8 *ptr;
+
+    // reading from the segments that have never been written fails
+    QVERIFY(!memory.getReadChunkPtr(chunk2));
+
+    ptr = memory.getWriteChunkPtr(chunk1);
+    memcpy(ptr, oddBuf, chunkLength);
+
+    ptr = memory.getWriteChunkPtr(chunk2);
+    memcpy(ptr, oddBuf, chunkLength);
+
+    ptr = memory.getReadChunkPtr(chunk2);
+    QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
+
+    ptr = memory.getReadChunkPtr(chunk1);
+    QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
+
+    // the chunks crossing the segment boundary are not supported
+    QVERIFY(!memory.getWriteChunkPtr(chunk3));
+
+    // the segments are mapped on demand only
+    QCOMPARE(memory.numMappedSegments(), 2);
+}
+
 void KisMemoryWindowTest::testTopReports()
 {
 
@@ -119,5 +119,79 @@ void KisSwappedDataStoreTest::testRandomAccess()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testCompressedTier()
+{
+    qsrand(10);
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 1000;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(40);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+    config.setMemoryHardLimitPercent(50);
+
+    // the tier can keep about 250 noisy tiles
+    config.setMemoryCompressedSwapPercent(1.5 * 100.0 / (0.5 * KisImageConfig::totalRAM()));
+    QCOMPARE(config.tilesCompressedSwapLimit(), 1);
+
+
+    KisSwappedDataStore store;
+
+    QList<KisTileData*> tileDataList;
+    QList<QByteArray> tileContents;
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+
+        for (qint32 j = 0; j < TILESIZE; j++) {
+            td->data()[j] = qrand() % 256;
+        }
+
+        tileDataList.append(td);
+        tileContents.append(QByteArray((const char*)td->data(), TILESIZE));
+
+        QVERIFY(store.trySwapOutTileData(td));
+    }
+
+    const quint64 numCompressedTiles = store.numCompressedTiles();
+
+    QVERIFY(numCompressedTiles > 0);
+    QVERIFY(numCompressedTiles < quint64(NUM_TILES));
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+    QVERIFY(store.compressedMemorySize() <= qint64(MiB));
+    QCOMPARE(store.compressedMemoryMetric(), qint64(numCompressedTiles * pixelSize));
+    QCOMPARE(store.totalMemoryMetric(), qint64(NUM_TILES * pixelSize));
+
+    // the forced swap out doesn't go through the tier
+    KisTileData *forcedTD = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+    QVERIFY(store.trySwapOutTileData(forcedTD, KisSwappedDataStore::ForceDisk));
+    QCOMPARE(store.numCompressedTiles(), numCompressedTiles);
+
+    store.swapInTileData(forcedTD);
+    QVERIFY(memoryIsFilled(defaultPixel, forcedTD->data(), TILESIZE));
+    delete forcedTD;
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        QVERIFY(!td->data());
+
+        store.swapInTileData(td);
+        QVERIFY(!memcmp(tileContents[i].constData(), td->data(), TILESIZE));
+    }
+
+    QCOMPARE(store.numTiles(), quint64(0));
+    QCOMPARE(store.compressedMemorySize(), qint64(0));
+    QCOMPARE(store.totalMemoryMetric(), qint64(0));
+
+    store.debugStatistics();
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+
+    config.setMemoryCompressedSwapPercent(config.memoryCompressedSwapPercent(true));
+}
+
 SIMPLE_TEST_MAIN(KisSwappedDataStoreTest)
 
@@ -0,0 +1,101 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_data_allocator_test.h"
+#include <simpletest.h>
+
+#include <QtConcurrent>
+#include <kis_assert.h>
+
+#include "tiles3/KisTileDataAllocator.h"
+#include "tiles3/kis_tile_data.h"
+
+
+void KisTileDataAllocatorTest::testThreadCacheReuse()
+{
+    KisTileDataAllocator *allocator = KisTileDataAllocator::instance();
+    const qint32 pixelSize = 4;
+
+    const KisTileDataAllocator::Statistics before = allocator->statistics();
+
+    for (int i = 0; i < 1024; i++) {
+        quint8 *ptr = allocator->allocate(pixelSize);
+        QVERIFY(ptr);
+
+        memset(ptr, i % 256, pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT);
+        allocator->free(ptr, pixelSize);
+    }
+
+    const KisTileDataAllocator::Statistics after = allocator->statistics();
+
+    /**
+     * The counters are flushed in batches of 256 allocations,
+     * so all the 1024 allocations must already be counted
+     */
+    QCOMPARE(after.threadCacheHits + after.sharedCacheHits + after.misses -
+             before.threadCacheHits - before.sharedCacheHits - before.misses,
+             qint64(1024));
+
+    // the same blob is reused again and again
+    QVERIFY(after.threadCacheHits - before.threadCacheHits >= 1023);
+}
+
+void allocatorWorker(int &pixelSize)
+{
+    KisTileDataAllocator *allocator = KisTileDataAllocator::instance();
+
+    QVector<quint8*> blobs;
+    const int blobSize = pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    for (int cycle = 0; cycle < 50; cycle++) {
+        for (int i = 0; i < 100; i++) {
+            quint8 *ptr = allocator->allocate(pixelSize);
+            memset(ptr, pixelSize, blobSize);
+            blobs << ptr;
+        }
+
+        Q_FOREACH (quint8 *ptr, blobs) {
+            // check no one else has written into our blob
+            KIS_ASSERT(ptr[0] == pixelSize && ptr[blobSize - 1] == pixelSize);
+            allocator->free(ptr, pixelSize);
+        }
+        blobs.clear();
+    }
+}
+
+void KisTileDataAllocatorTest::testMultipleThreads()
+{
+    QList<int> pixelSizes;
+    for (int i = 0; i < 3; i++) {
+        pixelSizes << 1 << 2 << 4 << 8 << 16 << 20 << 40;
+    }
+
+    QtConcurrent::blockingMap(pixelSizes, allocatorWorker);
+}
+
+void KisTileDataAllocatorTest::testPurge()
+{
+    KisTileDataAllocator *allocator = KisTileDataAllocator::instance();
+
+    QVector<quint8*> blobs;
+    for (int i = 0; i < 100; i++) {
+        blobs << allocator->allocate(8);
+    }
+
+    Q_FOREACH (quint8 *ptr, blobs) {
+        allocator->free(ptr, 8);
+    }
+
+    allocator->purge();
+
+    // the stale blobs must not be reused after purging
+    quint8 *ptr = allocator->allocate(8);
+    QVERIFY(ptr);
+    memset(ptr, 0xff, 8 * KisTileData::WIDTH * KisTileData::HEIGHT);
+    allocator->free(ptr, 8);
+}
+
+SIMPLE_TEST_MAIN(KisTileDataAllocatorTest)
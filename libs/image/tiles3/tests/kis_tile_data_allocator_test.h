@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_TILE_DATA_ALLOCATOR_TEST_H
+#define __KIS_TILE_DATA_ALLOCATOR_TEST_H
+
+#include <simpletest.h>
+
+class KisTileDataAllocatorTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testThreadCacheReuse();
+    void testMultipleThreads();
+    void testPurge();
+};
+
+#endif /* __KIS_TILE_DATA_ALLOCATOR_TEST_H */
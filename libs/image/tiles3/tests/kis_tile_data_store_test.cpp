@@ -176,5 +176,102 @@ void KisTileDataStoreTest::testSwapping()
     }
 }
 
+void KisTileDataStoreTest::testPrefetch()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisTiledDataManager dm(pixelSize, &defaultPixel);
+
+    for(qint32 col = 0; col < 100; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->tileData()->data(), COLUMN2COLOR(col), TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    store->debugSwapAll();
+    QCOMPARE(store->numTilesInMemory(), 0);
+
+    dm.prefetchSwappedTiles(QRect(0, 0, 50 * KisTileData::WIDTH, KisTileData::HEIGHT));
+    store->waitForPrefetchDone();
+
+    QCOMPARE(store->numTilesInMemory(), 50);
+
+    for(qint32 col = 0; col < 100; col++) {
+        KisTileSP tile = dm.getTile(col, 0, false);
+        QCOMPARE(tile->isSwappedOut(), col >= 50);
+
+        tile->lockForRead();
+        QVERIFY(memoryIsFilled(COLUMN2COLOR(col), tile->tileData()->data(), TILESIZE));
+        tile->unlockForRead();
+    }
+}
+
+void KisTileDataStoreTest::testMemoryAccounts()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 account = store->createMemoryAccount();
+    QVERIFY(account > 0);
+    QCOMPARE(store->memoryAccountPriority(account), KisTileDataStore::BackgroundAccount);
+
+    store->setMemoryAccountPriority(account, KisTileDataStore::ForegroundAccount);
+    QCOMPARE(store->memoryAccountPriority(account), KisTileDataStore::ForegroundAccount);
+
+    const qint32 pixelSize = 1;
+    quint8 defaultPixel = 128;
+    KisTiledDataManager *dm = new KisTiledDataManager(pixelSize, &defaultPixel);
+
+    // the existing tiles are moved into the account
+    for(qint32 col = 0; col < 10; col++) {
+        KisTileSP tile = dm->getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->tileData()->data(), COLUMN2COLOR(col), TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    dm->setMemoryAccount(account);
+    QCOMPARE(dm->memoryAccount(), account);
+
+    // the new tiles inherit the account from the default tile data
+    for(qint32 col = 10; col < 20; col++) {
+        KisTileSP tile = dm->getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->tileData()->data(), COLUMN2COLOR(col), TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    // 20 tiles and the default tile data
+    const qint64 accountSize = 21 * TILESIZE;
+
+    KisTileDataStore::MemoryAccountStatistics stats = store->memoryAccountStatistics(account);
+    QCOMPARE(stats.memorySize, accountSize);
+    QCOMPARE(stats.swapSize, qint64(0));
+    QCOMPARE(store->backgroundMemoryMetric(), store->memoryAccountMetric(0));
+
+    store->debugSwapAll();
+
+    stats = store->memoryAccountStatistics(account);
+    QVERIFY(stats.swapSize > 0);
+    QCOMPARE(stats.memorySize + stats.swapSize, accountSize);
+
+    // the account is not reused while its tiles are alive
+    store->releaseMemoryAccount(account);
+    const qint32 otherAccount = store->createMemoryAccount();
+    QVERIFY(otherAccount != account);
+
+    delete dm;
+
+    stats = store->memoryAccountStatistics(account);
+    QCOMPARE(stats.memorySize, qint64(0));
+    QCOMPARE(stats.swapSize, qint64(0));
+
+    store->releaseMemoryAccount(otherAccount);
+}
+
 SIMPLE_TEST_MAIN(KisTileDataStoreTest)
 
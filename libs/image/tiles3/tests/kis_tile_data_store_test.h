@@ -18,6 +18,8 @@ private Q_SLOTS:
     void testClockIterator();
     void testLeaks();
     void testSwapping();
+    void testPrefetch();
+    void testMemoryAccounts();
 };
 
 #endif /* KIS_TILE_DATA_STORE_TEST_H */
@@ -0,0 +1,274 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_hash_table3_test.h"
+#include <simpletest.h>
+
+#include <random>
+#include <QtConcurrent>
+
+#include "tiles3/kis_tile.h"
+#include "tiles3/kis_tile_hash_table3.h"
+#include "tiles3/kis_tile_data_store.h"
+
+typedef KisTileHashTableTraits3<KisTile> TestHashTable;
+typedef KisTileHashTableIteratorTraits3<KisTile> TestHashTableIterator;
+
+namespace {
+
+void initDefaultTileData(TestHashTable &table)
+{
+    quint8 defaultPixel = 0;
+    table.setDefaultTileData(KisTileDataStore::instance()->createDefaultTileData(1, &defaultPixel));
+}
+
+}
+
+void KisTileHashTable3Test::testAddDelete()
+{
+    const qint32 tileDataBefore = KisTileDataStore::instance()->numTiles();
+
+    {
+        TestHashTable table(0);
+        initDefaultTileData(table);
+
+        QVERIFY(table.isEmpty());
+        QVERIFY(!table.tileExists(0, 0));
+
+        bool newTile = false;
+        KisTileSP tile = table.getTileLazy(0, 0, newTile);
+        QVERIFY(newTile);
+        QCOMPARE(table.numTiles(), 1);
+
+        KisTileSP sameTile = table.getTileLazy(0, 0, newTile);
+        QVERIFY(!newTile);
+        QCOMPARE(sameTile, tile);
+
+        bool existingTile = true;
+        KisTileSP readOnlyTile = table.getReadOnlyTileLazy(1, 1, existingTile);
+        QVERIFY(!existingTile);
+        QVERIFY(readOnlyTile);
+        QCOMPARE(table.numTiles(), 1);
+
+        // adding a tile into an existing position replaces it
+        KisTileSP otherTile = new KisTile(0, 0, table.defaultTileData(), 0);
+        table.addTile(otherTile);
+        QCOMPARE(table.numTiles(), 1);
+        QCOMPARE(table.getExistingTile(0, 0), otherTile);
+
+        QVERIFY(table.deleteTile(0, 0));
+        QVERIFY(!table.deleteTile(0, 0));
+        QVERIFY(!table.tileExists(0, 0));
+        QVERIFY(table.isEmpty());
+
+        // the key is reused after deletion
+        table.addTile(tile);
+        QCOMPARE(table.getExistingTile(0, 0), tile);
+        QCOMPARE(table.numTiles(), 1);
+    }
+
+    QCOMPARE(KisTileDataStore::instance()->numTiles(), tileDataBefore);
+}
+
+void KisTileHashTable3Test::testMigration()
+{
+    const qint32 tileDataBefore = KisTileDataStore::instance()->numTiles();
+
+    {
+        TestHashTable table(0);
+        initDefaultTileData(table);
+
+        const int size = 100;
+
+        // the table starts with 64 cells, so it will be migrated a few times
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                bool newTile = false;
+                table.getTileLazy(col, row, newTile);
+                QVERIFY(newTile);
+            }
+        }
+
+        QCOMPARE(table.numTiles(), size * size);
+
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                if ((row + col) % 2) {
+                    QVERIFY(table.deleteTile(col, row));
+                }
+            }
+        }
+
+        QCOMPARE(table.numTiles(), size * size / 2);
+
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) {
+                KisTileSP tile = table.getExistingTile(col, row);
+                QCOMPARE(bool(tile), !((row + col) % 2));
+
+                if (tile) {
+                    QCOMPARE(tile->col(), col);
+                    QCOMPARE(tile->row(), row);
+                }
+            }
+        }
+
+        qint32 minLength = 0;
+        qint32 maxLength = 0;
+        table.debugMaxListLength(minLength, maxLength);
+        QCOMPARE(minLength, 1);
+    }
+
+    QCOMPARE(KisTileDataStore::instance()->numTiles(), tileDataBefore);
+}
+
+void KisTileHashTable3Test::testIterator()
+{
+    TestHashTable table(0);
+    TestHashTable otherTable(0);
+    initDefaultTileData(table);
+    initDefaultTileData(otherTable);
+
+    for (int i = 0; i < 300; i++) {
+        bool newTile = false;
+        table.getTileLazy(i, -i, newTile);
+    }
+
+    {
+        TestHashTableIterator iter(&table);
+        int index = 0;
+
+        while (!iter.isDone()) {
+            if (index++ % 3) {
+                iter.next();
+            } else {
+                iter.moveCurrentToHashTable(&otherTable);
+            }
+        }
+    }
+
+    QCOMPARE(table.numTiles(), 200);
+    QCOMPARE(otherTable.numTiles(), 100);
+
+    {
+        TestHashTableIterator iter(&otherTable);
+        while (KisTileSP tile = iter.tile()) {
+            QVERIFY(!table.tileExists(tile->col(), tile->row()));
+            iter.deleteCurrent();
+        }
+    }
+
+    QVERIFY(otherTable.isEmpty());
+
+    TestHashTable copiedTable(table, 0);
+    QCOMPARE(copiedTable.numTiles(), table.numTiles());
+
+    table.clear();
+    QVERIFY(table.isEmpty());
+    QCOMPARE(copiedTable.numTiles(), 200);
+}
+
+void KisTileHashTable3Test::testEraseWhileMigrationPending()
+{
+    TestHashTable table(0);
+    initDefaultTileData(table);
+
+    // half of the 64 cells are claimed, the next insert starts the migration
+    for (int i = 0; i < 32; i++) {
+        bool newTile = false;
+        table.getTileLazy(i, 0, newTile);
+    }
+
+    QFuture<void> insertion;
+
+    {
+        TestHashTableIterator iter(&table);
+
+        /**
+         * The insert crosses the threshold and blocks in the migration,
+         * waiting for the iterator to release the table
+         */
+        insertion = QtConcurrent::run([&table] () {
+            bool newTile = false;
+            table.getTileLazy(0, 1, newTile);
+        });
+
+        while (!table.tileExists(0, 1)) {
+            QThread::yieldCurrentThread();
+        }
+
+        // erasing should neither migrate nor wait for the migration
+        while (KisTileSP tile = iter.tile()) {
+            if (tile->row() == 0) {
+                iter.deleteCurrent();
+            } else {
+                iter.next();
+            }
+        }
+    }
+
+    // now the insertion can finish its migration
+    insertion.waitForFinished();
+
+    QCOMPARE(table.numTiles(), 1);
+    QVERIFY(table.tileExists(0, 1));
+}
+
+void KisTileHashTable3Test::testConcurrentAccess()
+{
+    const qint32 tileDataBefore = KisTileDataStore::instance()->numTiles();
+
+    {
+        TestHashTable table(0);
+        initDefaultTileData(table);
+
+        const int size = 64;
+
+        auto worker = [&table, size] (int seed) {
+            std::minstd_rand gen(seed);
+
+            for (int i = 0; i < 100000; i++) {
+                const int col = gen() % size;
+                const int row = gen() % size;
+
+                switch (gen() % 4) {
+                case 0:
+                    table.deleteTile(col, row);
+                    break;
+                case 1: {
+                    bool newTile = false;
+                    KisTileSP tile = table.getTileLazy(col, row, newTile);
+                    KIS_ASSERT(tile->col() == col && tile->row() == row);
+                    break;
+                }
+                default: {
+                    KisTileSP tile = table.getExistingTile(col, row);
+                    KIS_ASSERT(!tile || (tile->col() == col && tile->row() == row));
+                    break;
+                }
+                }
+            }
+        };
+
+        QVector<int> seeds;
+        for (int i = 0; i < 8; i++) {
+            seeds << 1000 + i;
+        }
+
+        QtConcurrent::blockingMap(seeds, worker);
+
+        int numTiles = 0;
+        for (TestHashTableIterator iter(&table); !iter.isDone(); iter.next()) {
+            numTiles++;
+        }
+
+        QCOMPARE(table.numTiles(), numTiles);
+    }
+
+    QCOMPARE(KisTileDataStore::instance()->numTiles(), tileDataBefore);
+}
+
+SIMPLE_TEST_MAIN(KisTileHashTable3Test)
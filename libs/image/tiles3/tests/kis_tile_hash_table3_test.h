@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __KIS_TILE_HASH_TABLE3_TEST_H
+#define __KIS_TILE_HASH_TABLE3_TEST_H
+
+#include <simpletest.h>
+
+class KisTileHashTable3Test : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testAddDelete();
+    void testMigration();
+    void testIterator();
+    void testEraseWhileMigrationPending();
+    void testConcurrentAccess();
+};
+
+#endif /* __KIS_TILE_HASH_TABLE3_TEST_H */
@@ -527,6 +527,140 @@ void KisTiledDataManagerTest::testUndoSetDefaultPixel()
     QVERIFY(memoryIsFilled(oddPixel2, tile10->data(), TILESIZE));
 }
 
+void KisTiledDataManagerTest::testShareUniformTiles()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    KisMementoSP memento1 = dm.getMemento();
+
+    for (qint32 col = 0; col < 4; col++) {
+        KisTileSP tile = dm.getTile(col, 0, true);
+        tile->lockForWrite();
+        memset(tile->data(), oddPixel1, TILESIZE);
+        tile->unlockForWrite();
+    }
+
+    // the last tile is not uniform anymore
+    KisTileSP tile30 = dm.getTile(3, 0, true);
+    tile30->lockForWrite();
+    tile30->data()[0] = oddPixel2;
+    tile30->unlockForWrite();
+
+    QCOMPARE(dm.shareUniformTiles(QRect(0, 0, 256, 64)), 3);
+    dm.commit();
+
+    KisTileSP tile00 = dm.getTile(0, 0, false);
+    KisTileSP tile10 = dm.getTile(1, 0, false);
+    QVERIFY(tile00->tileData()->isSharedUniform());
+    QCOMPARE(tile00->tileData(), tile10->tileData());
+    QVERIFY(!tile30->tileData()->isSharedUniform());
+
+    // the shared tile data has already been handled
+    QCOMPARE(dm.shareUniformTiles(QRect(0, 0, 256, 64)), 0);
+
+    dm.rollback(memento1);
+
+    tile00 = dm.getTile(0, 0, false);
+    QVERIFY(memoryIsFilled(defaultPixel, tile00->data(), TILESIZE));
+
+    dm.rollforward(memento1);
+
+    tile00 = dm.getTile(0, 0, false);
+    tile10 = dm.getTile(1, 0, false);
+    QVERIFY(memoryIsFilled(oddPixel1, tile00->data(), TILESIZE));
+    QCOMPARE(tile00->tileData(), tile10->tileData());
+
+    // the first write allocates the buffer again
+    tile00 = dm.getTile(0, 0, true);
+    tile00->lockForWrite();
+    QVERIFY(!tile00->tileData()->isSharedUniform());
+    QVERIFY(memoryIsFilled(oddPixel1, tile00->data(), TILESIZE));
+    memset(tile00->data(), oddPixel2, TILESIZE);
+    tile00->unlockForWrite();
+
+    QVERIFY(memoryIsFilled(oddPixel2, tile00->data(), TILESIZE));
+    QVERIFY(memoryIsFilled(oddPixel1, tile10->data(), TILESIZE));
+}
+
+void fillTilePattern(KisTiledDataManager &dm, quint8 base)
+{
+    KisTileSP tile = dm.getTile(0, 0, true);
+    tile->lockForWrite();
+    for (qint32 i = 0; i < TILESIZE; i++) {
+        tile->data()[i] = base + i % 7;
+    }
+    tile->unlockForWrite();
+}
+
+bool checkTilePattern(KisTiledDataManager &dm, quint8 base)
+{
+    KisTileSP tile = dm.getTile(0, 0, false);
+    for (qint32 i = 0; i < TILESIZE; i++) {
+        if (tile->data()[i] != quint8(base + i % 7)) return false;
+    }
+    return true;
+}
+
+void KisTiledDataManagerTest::testDeltaMementos()
+{
+    KisMementoManager::setDeltaMementosEnabled(true);
+
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    KisMementoSP memento1 = dm.getMemento();
+    fillTilePattern(dm, 10);
+    dm.commit();
+
+    KisMementoSP memento2 = dm.getMemento();
+    fillTilePattern(dm, 20);
+    dm.commit();
+
+    KisMementoSP memento3 = dm.getMemento();
+    fillTilePattern(dm, 30);
+    dm.commit();
+
+    // the undone versions of the tile are kept as deltas
+    QVERIFY(dm.mementoMemorySize(memento2) > 0);
+    QVERIFY(dm.mementoMemorySize(memento2) < TILESIZE / 2);
+    QVERIFY(dm.mementoMemorySize(memento3) > 0);
+    QVERIFY(dm.mementoMemorySize(memento3) < TILESIZE / 2);
+
+    // the version of the first revision is the default tile
+    QCOMPARE(dm.mementoMemorySize(memento1), qint64(0));
+
+    dm.rollback(memento3);
+    QVERIFY(checkTilePattern(dm, 20));
+
+    // the undone revision keeps the new version in full
+    QCOMPARE(dm.mementoMemorySize(memento3), qint64(TILESIZE));
+
+    dm.rollback(memento2);
+    QVERIFY(checkTilePattern(dm, 10));
+
+    dm.rollforward(memento2);
+    QVERIFY(checkTilePattern(dm, 20));
+
+    dm.rollforward(memento3);
+    QVERIFY(checkTilePattern(dm, 30));
+
+    dm.rollback(memento3);
+    dm.rollback(memento2);
+    QVERIFY(checkTilePattern(dm, 10));
+
+    dm.rollforward(memento2);
+    dm.rollforward(memento3);
+
+    dm.purgeHistory(memento3);
+    QVERIFY(checkTilePattern(dm, 30));
+
+    KisMementoManager::setDeltaMementosEnabled(false);
+}
+
 //#include <valgrind/callgrind.h>
 
 void KisTiledDataManagerTest::benchmarkReadOnlyTileLazy()
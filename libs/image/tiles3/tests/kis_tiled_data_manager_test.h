@@ -40,6 +40,8 @@ private Q_SLOTS:
     void testTransactions();
     void testPurgeHistory();
     void testUndoSetDefaultPixel();
+    void testShareUniformTiles();
+    void testDeltaMementos();
 
     void benchmarkReadOnlyTileLazy();
     void benchmarkSharedPointers();
@@ -63,6 +63,7 @@
 #include <QMessageBox>
 
 #include <kis_image_animation_interface.h>
+#include <kis_memory_statistics_server.h>
 
 struct Document::Private {
     Private() {}
@@ -1092,3 +1093,40 @@ void Document::removeAnnotation(const QString &type)
     KisImageSP image = d->document->image().toStrongRef();
     image->removeAnnotation(type);
 }
+
+QMap<QString, QVariant> Document::memoryStatistics() const
+{
+    QMap<QString, QVariant> result;
+    if (!d->document) return result;
+
+    KisMemoryStatisticsServer::Statistics stats =
+        KisMemoryStatisticsServer::instance()->fetchMemoryStatistics(d->document->image().toStrongRef());
+
+    result["imageSize"] = stats.imageSize;
+    result["layersSize"] = stats.layersSize;
+    result["projectionsSize"] = stats.projectionsSize;
+    result["lodSize"] = stats.lodSize;
+    result["historySize"] = stats.historySize;
+    result["documentMemorySize"] = stats.documentMemorySize;
+    result["documentSwapSize"] = stats.documentSwapSize;
+    result["totalMemorySize"] = stats.totalMemorySize;
+    result["realMemorySize"] = stats.realMemorySize;
+    result["historicalMemorySize"] = stats.historicalMemorySize;
+    result["poolSize"] = stats.poolSize;
+    result["swapSize"] = stats.swapSize;
+    result["compressedMemorySize"] = stats.compressedMemorySize;
+    result["numTiles"] = stats.numTiles;
+    result["numTilesInMemory"] = stats.numTilesInMemory;
+    result["swapOutCount"] = stats.swapOutCount;
+    result["swapInCount"] = stats.swapInCount;
+
+    return result;
+}
+
+QString Document::nodeMemoryStatisticsCsv() const
+{
+    if (!d->document) return QString();
+
+    KisMemoryStatisticsServer *server = KisMemoryStatisticsServer::instance();
+    return server->nodeStatisticsToCsv(server->fetchNodeMemoryStatistics(d->document->image().toStrongRef()));
+}
@@ -899,6 +899,29 @@ print(root.childNodes())
      * @param type the type defining the annotation
      */
     void removeAnnotation(const QString &type);
+
+    /**
+     * @brief memoryStatistics returns the memory used by the document and
+     * by the tile engine as a whole. The sizes are in bytes. The keys are:
+     *
+     * imageSize, layersSize, projectionsSize, lodSize, historySize,
+     * documentMemorySize, documentSwapSize, totalMemorySize, realMemorySize,
+     * historicalMemorySize, poolSize, swapSize, compressedMemorySize,
+     * numTiles, numTilesInMemory, swapOutCount and swapInCount.
+     *
+     * @return a map of the statistics values
+     */
+    QMap<QString, QVariant> memoryStatistics() const;
+
+    /**
+     * @brief nodeMemoryStatisticsCsv returns the breakdown of the memory
+     * used by the nodes of the document as CSV text: the name and unique id
+     * of every node followed by the size of its data, projections,
+     * level-of-detail data and undo history in bytes.
+     *
+     * @return a string in CSV format, one line per node
+     */
+    QString nodeMemoryStatisticsCsv() const;
 private:
 
     friend class Krita;
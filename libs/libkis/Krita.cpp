@@ -43,6 +43,7 @@
 #include <KisBrushServerProvider.h>
 #include <kis_action_registry.h>
 #include <kis_icon_utils.h>
+#include <kis_memory_statistics_server.h>
 
 #include <KisResourceModel.h>
 #include <KisGlobalResourcesInterface.h>
@@ -389,6 +390,34 @@ QIcon Krita::icon(QString &iconName) const
     return KisIconUtils::loadIcon(iconName);
 }
 
+void Krita::startMemoryStatisticsSampling(Document *document)
+{
+    KisImageSP image;
+
+    if (document && document->document()) {
+        image = document->document()->image().toStrongRef();
+    }
+
+    KisMemoryStatisticsServer::instance()->startSampling(image);
+}
+
+void Krita::stopMemoryStatisticsSampling()
+{
+    KisMemoryStatisticsServer::instance()->stopSampling();
+}
+
+QString Krita::memoryStatisticsHistoryCsv() const
+{
+    KisMemoryStatisticsServer *server = KisMemoryStatisticsServer::instance();
+    return server->samplesToCsv(server->samples());
+}
+
+QString Krita::memoryStatisticsNodeHistoryCsv() const
+{
+    KisMemoryStatisticsServer *server = KisMemoryStatisticsServer::instance();
+    return server->samplesNodeStatisticsToCsv(server->samples());
+}
+
 void Krita::addDockWidgetFactory(DockWidgetFactoryBase* factory)
 {
     KoDockRegistry::instance()->add(factory);
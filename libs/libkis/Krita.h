@@ -312,6 +312,46 @@ add_document_to_window()
      */
     QIcon icon(QString &iconName) const;
 
+    /**
+     * @brief startMemoryStatisticsSampling starts collecting the time series
+     * of the memory statistics of the tile engine. The statistics are
+     * sampled periodically until stopMemoryStatisticsSampling() is called.
+     *
+     * The sampling interval and the number of the samples kept are
+     * configured by the memoryStatisticsSamplingInterval and
+     * memoryStatisticsMaxSamples settings.
+     *
+     * @param document if not null, every sample also records the memory
+     * used by every node of the document
+     */
+    void startMemoryStatisticsSampling(Document *document = 0);
+
+    /**
+     * @brief stopMemoryStatisticsSampling stops collecting the time series
+     * of the memory statistics. The collected samples are kept.
+     */
+    void stopMemoryStatisticsSampling();
+
+    /**
+     * @brief memoryStatisticsHistoryCsv returns the collected time series of
+     * the memory statistics of the tile engine. Every line contains the time
+     * of the sample, the number of tiles, the memory sizes in bytes and the
+     * swap-out and swap-in rates in tiles per second.
+     *
+     * @return a string in CSV format, one line per sample
+     */
+    QString memoryStatisticsHistoryCsv() const;
+
+    /**
+     * @brief memoryStatisticsNodeHistoryCsv returns the per-node breakdown of
+     * the collected time series. Every line contains the time of the sample,
+     * the name and unique id of the node and the size of its data,
+     * projections, level-of-detail data and undo history in bytes.
+     *
+     * @return a string in CSV format, one line per node per sample
+     */
+    QString memoryStatisticsNodeHistoryCsv() const;
+
     /**
      * @brief instance retrieve the singleton instance of the Application object.
      */
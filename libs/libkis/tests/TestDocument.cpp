@@ -217,5 +217,42 @@ void TestDocument::testAnnotations()
 }
 
 
+void TestDocument::testMemoryStatistics()
+{
+    QScopedPointer<KisDocument> kisdoc(KisPart::instance()->createDocument());
+    KisImageSP image = new KisImage(0, 100, 100, KoColorSpaceRegistry::instance()->rgb8(), "test");
+    KisNodeSP layer = new KisPaintLayer(image, "test \"1\"", 255);
+    KisFillPainter gc(layer->paintDevice());
+    gc.fillRect(0, 0, 100, 100, KoColor(Qt::red, layer->colorSpace()));
+    image->addNode(layer);
+    kisdoc->setCurrentImage(image);
+
+    Document d(kisdoc.data(), false);
+
+    QMap<QString, QVariant> stats = d.memoryStatistics();
+    QVERIFY(stats.contains("historySize"));
+    QVERIFY(stats["layersSize"].toLongLong() >= 100 * 100 * 4);
+
+    QStringList lines = d.nodeMemoryStatisticsCsv().split('\n', QString::SkipEmptyParts);
+    // the header, the root node and the layer
+    QCOMPARE(lines.size(), 3);
+    QCOMPARE(lines[0], QString("name,uuid,dataSize,projectionSize,lodSize,historySize"));
+    QVERIFY(lines[2].startsWith("\"test \"\"1\"\"\","));
+    QVERIFY(lines[2].contains(layer->uuid().toString()));
+
+    // starting the sampling takes the first sample right away
+    Krita::instance()->startMemoryStatisticsSampling(&d);
+    Krita::instance()->stopMemoryStatisticsSampling();
+
+    QStringList samples = Krita::instance()->memoryStatisticsHistoryCsv().split('\n', QString::SkipEmptyParts);
+    QVERIFY(samples.size() >= 2);
+
+    QStringList nodeSamples = Krita::instance()->memoryStatisticsNodeHistoryCsv().split('\n', QString::SkipEmptyParts);
+    QCOMPARE(nodeSamples[0], QString("timestamp,name,uuid,dataSize,projectionSize,lodSize,historySize"));
+    QVERIFY(nodeSamples.last().contains(layer->uuid().toString()));
+
+    KisPart::instance()->removeDocument(kisdoc.data(), false);
+}
+
 KISTEST_MAIN(TestDocument)
 
@@ -18,6 +18,7 @@ private Q_SLOTS:
     void testThumbnail();
     void testCreateFillLayer();
     void testAnnotations();
+    void testMemoryStatistics();
 };
 
 #endif
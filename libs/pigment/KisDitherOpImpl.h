@@ -10,6 +10,8 @@
 
 #include <type_traits>
 
+#include <QScopedPointer>
+
 #include "DebugPigment.h"
 #include "KoConfig.h"
 
@@ -24,6 +26,7 @@
 
 #include "KisDitherOp.h"
 #include "KisDitherMaths.h"
+#include "dithering/KisOptimizedDitherFactory.h"
 
 template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class KisDitherOpImpl : public KisDitherOp
 {
@@ -34,6 +37,9 @@ public:
     KisDitherOpImpl(const KoID &srcId, const KoID &dstId)
         : m_srcDepthId(srcId)
         , m_dstDepthId(dstId)
+        , m_optimizedDither(createOptimizedDither(KoColorSpaceMathsTraits<srcChannelsType>::unitValue,
+                                                  KoColorSpaceMathsTraits<dstChannelsType>::unitValue,
+                                                  false))
     {
     }
 
@@ -62,9 +68,50 @@ public:
         return dType;
     }
 
+protected:
+    /**
+     * Used by the dither ops that normalize the color channels
+     * differently, takes the ownership of \p optimizedDither
+     */
+    KisDitherOpImpl(const KoID &srcId, const KoID &dstId, KisOptimizedDitherBase *optimizedDither)
+        : m_srcDepthId(srcId)
+        , m_dstDepthId(dstId)
+        , m_optimizedDither(optimizedDither)
+    {
+    }
+
+    /**
+     * Creates the vectorized implementation of the row dithering,
+     * \p srcColorUnitValue and \p dstColorUnitValue are the values
+     * of the color channels that are normalized into 1.0. Returns
+     * null if the depths are not supported by the optimized code.
+     */
+    static KisOptimizedDitherBase *createOptimizedDither(float srcColorUnitValue, float dstColorUnitValue, bool truncateColorChannels)
+    {
+        if (dType == DITHER_NONE) {
+            return nullptr;
+        }
+
+        KisOptimizedDitherBase::Parameters params;
+        params.srcValueType = KoColorSpaceMathsTraits<srcChannelsType>::channelValueType;
+        params.dstValueType = KoColorSpaceMathsTraits<dstChannelsType>::channelValueType;
+        params.type = dType;
+        params.channelCount = srcCSTraits::channels_nb;
+        params.alphaPos = srcCSTraits::alpha_pos;
+        params.srcColorUnitValue = srcColorUnitValue;
+        params.dstColorUnitValue = dstColorUnitValue;
+        params.truncateColorChannels = truncateColorChannels;
+
+        return KisOptimizedDitherFactory::create(params);
+    }
+
 private:
     const KoID m_srcDepthId, m_dstDepthId;
 
+protected:
+    QScopedPointer<KisOptimizedDitherBase> m_optimizedDither;
+
+private:
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr> inline void ditherImpl(const quint8 *src, quint8 *dst, int, int) const
     {
         memcpy(dst, src, srcCSTraits::pixelSize);
@@ -137,6 +184,11 @@ private:
     template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
     {
+        if (m_optimizedDither) {
+            m_optimizedDither->dither(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
@@ -88,6 +88,40 @@ void KoBasicHistogramProducer::makeExternalToInternal()
     }
 }
 
+QVector<quint8> KoBasicHistogramProducer::includedPixels(const quint8 *pixels, const quint8 *selectionMask, quint32 nPixels, const KoColorSpace *cs) const
+{
+    QVector<quint8> result(nPixels, OPACITY_OPAQUE_U8);
+
+    if (m_skipTransparent) {
+        cs->copyOpacityU8(pixels, result.data(), nPixels);
+    }
+
+    if (selectionMask && m_skipUnselected) {
+        for (quint32 i = 0; i < nPixels; i++) {
+            if (selectionMask[i] == 0) {
+                result[i] = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+QVector<float> KoBasicHistogramProducer::normalisedChannelsOfPixels(const quint8 *pixels, quint32 nPixels, const KoColorSpace *cs) const
+{
+    QVector<float> channels(nPixels * m_colorSpace->channelCount());
+
+    if (*cs == *m_colorSpace) {
+        m_colorSpace->normalisedChannelsValues(pixels, channels.data(), nPixels);
+    } else {
+        QVector<quint8> dstPixels(nPixels * m_colorSpace->pixelSize());
+        cs->convertPixelsTo(pixels, dstPixels.data(), m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
+        m_colorSpace->normalisedChannelsValues(dstPixels.constData(), channels.data(), nPixels);
+    }
+
+    return channels;
+}
+
 // ------------ U8 ---------------------
 
 KoBasicU8HistogramProducer::KoBasicU8HistogramProducer(const KoID& id, const KoColorSpace *cs)
@@ -103,36 +137,19 @@ QString KoBasicU8HistogramProducer::positionToString(qreal pos) const
 void KoBasicU8HistogramProducer::addRegionToBin(const quint8 * pixels, const quint8 * selectionMask, quint32 nPixels, const KoColorSpace *cs)
 {
     quint32 dstPixelSize = m_colorSpace->pixelSize();
-    quint8 *dstPixels = new quint8[nPixels * dstPixelSize];
-    cs->convertPixelsTo(pixels, dstPixels, m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
-
-    if (selectionMask) {
-        quint8 *dst = dstPixels;
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    m_bins[i][m_colorSpace->scaleToU8(dst,i)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            selectionMask++;
-            nPixels--;
-        }
-    } else {
-        quint8 *dst = dstPixels;
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    m_bins[i][m_colorSpace->scaleToU8(dst,i)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            nPixels--;
+    QVector<quint8> dstPixels(nPixels * dstPixelSize);
+    cs->convertPixelsTo(pixels, dstPixels.data(), m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
+
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
+    const quint8 *dst = dstPixels.constData();
+
+    for (quint32 p = 0; p < nPixels; p++, dst += dstPixelSize) {
+        if (!included[p]) continue;
+
+        for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
+            m_bins[i][m_colorSpace->scaleToU8(dst,i)]++;
         }
+        m_count++;
     }
 }
 
@@ -161,50 +178,24 @@ void KoBasicU16HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
     quint16 to = from + width;
     qreal factor = 255.0 / width;
 
-    quint32 dstPixelSize = m_colorSpace->pixelSize();
-    quint8 *dstPixels = new quint8[nPixels * dstPixelSize];
-    cs->convertPixelsTo(pixels, dstPixels, m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
-    quint8 *dst = dstPixels;
-    QVector<float> channels(m_colorSpace->channelCount());
-
-    if (selectionMask) {
-        while (nPixels > 0) {
-            if (!((m_skipUnselected && *selectionMask == 0) || (m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    quint16 value = channels[i]*UINT16_MAX;
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            selectionMask++;
-            nPixels--;
-        }
-    } else {
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    quint16 value = channels[i]*UINT16_MAX;
-
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            nPixels--;
+    const QVector<float> channels = normalisedChannelsOfPixels(pixels, nPixels, cs);
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
+    const int channelCount = m_colorSpace->channelCount();
+    const float *values = channels.constData();
+
+    for (quint32 p = 0; p < nPixels; p++, values += channelCount) {
+        if (!included[p]) continue;
+
+        for (int i = 0; i < channelCount; i++) {
+            quint16 value = values[i]*UINT16_MAX;
+            if (value > to)
+                m_outRight[i]++;
+            else if (value < from)
+                m_outLeft[i]++;
+            else
+                m_bins[i][static_cast<quint8>((value - from) * factor)]++;
         }
+        m_count++;
     }
 }
 
@@ -233,51 +224,24 @@ void KoBasicF32HistogramProducer::addRegionToBin(const quint8 * pixels, const qu
     float to = from + width;
     float factor = 255.0 / width;
 
-    quint32 dstPixelSize = m_colorSpace->pixelSize();
-    quint8 *dstPixels = new quint8[nPixels * dstPixelSize];
-    cs->convertPixelsTo(pixels, dstPixels, m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
-    quint8 *dst = dstPixels;
-    QVector<float> channels(m_colorSpace->channelCount());
-
-    if (selectionMask) {
-        while (nPixels > 0) {
-            if (!((m_skipUnselected && *selectionMask == 0) || (m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    float value = channels[i];
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            selectionMask++;
-            nPixels--;
-
-        }
-    } else {
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    float value = channels[i];
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            nPixels--;
-
+    const QVector<float> channels = normalisedChannelsOfPixels(pixels, nPixels, cs);
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
+    const int channelCount = m_colorSpace->channelCount();
+    const float *values = channels.constData();
+
+    for (quint32 p = 0; p < nPixels; p++, values += channelCount) {
+        if (!included[p]) continue;
+
+        for (int i = 0; i < channelCount; i++) {
+            float value = values[i];
+            if (value > to)
+                m_outRight[i]++;
+            else if (value < from)
+                m_outLeft[i]++;
+            else
+                m_bins[i][static_cast<quint8>((value - from) * factor)]++;
         }
+        m_count++;
     }
 }
 
@@ -308,49 +272,24 @@ void KoBasicF16HalfHistogramProducer::addRegionToBin(const quint8 * pixels, cons
     float to = from + width;
     float factor = 255.0 / width;
 
-    quint32 dstPixelSize = m_colorSpace->pixelSize();
-    quint8 *dstPixels = new quint8[nPixels * dstPixelSize];
-    cs->convertPixelsTo(pixels, dstPixels, m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
-    quint8 *dst = dstPixels;
-    QVector<float> channels(m_colorSpace->channelCount());
-
-    if (selectionMask) {
-        while (nPixels > 0) {
-            if (!((m_skipUnselected  && *selectionMask == 0) || (m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    float value = channels[i];
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            selectionMask++;
-            nPixels--;
-        }
-    } else {
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-                m_colorSpace->normalisedChannelsValue(dst,channels);
-                for (int i = 0; i < (int)m_colorSpace->channelCount(); i++) {
-                    float value = channels[i];
-                    if (value > to)
-                        m_outRight[i]++;
-                    else if (value < from)
-                        m_outLeft[i]++;
-                    else
-                        m_bins[i][static_cast<quint8>((value - from) * factor)]++;
-                }
-                m_count++;
-            }
-            dst += dstPixelSize;
-            nPixels--;
+    const QVector<float> channels = normalisedChannelsOfPixels(pixels, nPixels, cs);
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
+    const int channelCount = m_colorSpace->channelCount();
+    const float *values = channels.constData();
+
+    for (quint32 p = 0; p < nPixels; p++, values += channelCount) {
+        if (!included[p]) continue;
+
+        for (int i = 0; i < channelCount; i++) {
+            float value = values[i];
+            if (value > to)
+                m_outRight[i]++;
+            else if (value < from)
+                m_outLeft[i]++;
+            else
+                m_bins[i][static_cast<quint8>((value - from) * factor)]++;
         }
+        m_count++;
     }
 }
 #endif
@@ -389,37 +328,20 @@ void KoGenericRGBHistogramProducer::addRegionToBin(const quint8 * pixels, const
         m_outLeft[i] = 0;
     }
 
-    QColor c;
-    qint32 pSize = cs->pixelSize();
-    if (selectionMask) {
-        while (nPixels > 0) {
-            if (!((m_skipUnselected  && *selectionMask == 0) || (m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))) {
-                cs->toQColor(pixels, &c);
-                m_bins[0][c.red()]++;
-                m_bins[1][c.green()]++;
-                m_bins[2][c.blue()]++;
-
-                m_count++;
-            }
-            pixels += pSize;
-            selectionMask++;
-            nPixels--;
-        }
+    QVector<QColor> colors(nPixels);
+    cs->toQColors(pixels, colors.data(), nPixels);
 
-    } else {
-        while (nPixels > 0) {
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
 
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8)) {
-                cs->toQColor(pixels, &c);
-                m_bins[0][c.red()]++;
-                m_bins[1][c.green()]++;
-                m_bins[2][c.blue()]++;
+    for (quint32 p = 0; p < nPixels; p++) {
+        if (!included[p]) continue;
 
-                m_count++;
-            }
-            pixels += pSize;
-            nPixels--;
-        }
+        const QColor &c = colors[p];
+        m_bins[0][c.red()]++;
+        m_bins[1][c.green()]++;
+        m_bins[2][c.blue()]++;
+
+        m_count++;
     }
 }
 
@@ -475,36 +397,21 @@ void KoGenericLabHistogramProducer::addRegionToBin(const quint8 *pixels, const q
 
     qint32 dstPixelSize = m_colorSpace->pixelSize();
 
-    quint8 *dstPixels = new quint8[nPixels * dstPixelSize];
-    cs->convertPixelsTo(pixels, dstPixels, m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
+    QVector<quint8> dstPixels(nPixels * dstPixelSize);
+    cs->convertPixelsTo(pixels, dstPixels.data(), m_colorSpace, nPixels, KoColorConversionTransformation::IntentAbsoluteColorimetric, KoColorConversionTransformation::Empty);
 
-    qint32 pSize = cs->pixelSize();
+    const QVector<quint8> included = includedPixels(pixels, selectionMask, nPixels, cs);
+    const quint8 *dst = dstPixels.constData();
 
-    if (selectionMask) {
-        while (nPixels > 0) {
-            if (!((m_skipUnselected  && *selectionMask == 0) || (m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))) {
-                m_count++;
-            }
-            pixels += pSize;
-            selectionMask++;
-            nPixels--;
-        }
-    } else {
-        quint8 *dst = dstPixels;
-        while (nPixels > 0) {
-            if (!(m_skipTransparent && cs->opacityU8(pixels) == OPACITY_TRANSPARENT_U8))  {
+    for (quint32 p = 0; p < nPixels; p++, dst += dstPixelSize) {
+        if (!included[p]) continue;
 
-                m_bins[0][m_colorSpace->scaleToU8(dst, 0)]++;
-                m_bins[1][m_colorSpace->scaleToU8(dst, 1)]++;
-                m_bins[2][m_colorSpace->scaleToU8(dst, 2)]++;
+        m_bins[0][m_colorSpace->scaleToU8(dst, 0)]++;
+        m_bins[1][m_colorSpace->scaleToU8(dst, 1)]++;
+        m_bins[2][m_colorSpace->scaleToU8(dst, 2)]++;
 
-                m_count++;
-            }
-            dst+= dstPixelSize;
-            nPixels--;
-        }
+        m_count++;
     }
-    delete[] dstPixels;
 }
 
 KoGenericLabHistogramProducerFactory::KoGenericLabHistogramProducerFactory()
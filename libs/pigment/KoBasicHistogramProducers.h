@@ -78,6 +78,20 @@ protected:
     }
     // not virtual since that is useless: we call it from constructor
     void makeExternalToInternal();
+
+    /**
+     * Returns a non-zero value for every pixel that should be added
+     * to the bins, i.e. is not transparent or unselected, if the
+     * producer is configured to skip such pixels
+     */
+    QVector<quint8> includedPixels(const quint8 *pixels, const quint8 *selectionMask, quint32 nPixels, const KoColorSpace *cs) const;
+
+    /**
+     * Converts the pixels from \p cs into the color space of the
+     * producer and returns the normalized values of their channels
+     */
+    QVector<float> normalisedChannelsOfPixels(const quint8 *pixels, quint32 nPixels, const KoColorSpace *cs) const;
+
     typedef QVector<quint32> vBins;
     QVector<vBins> m_bins;
     vBins m_outLeft, m_outRight;
@@ -89,6 +103,10 @@ protected:
     QVector<qint32> m_external;
 };
 
+/**
+ * Like the other basic producers, skips the pixels that are unselected
+ * in the selection mask, unless setSkipUnselected(false) is called
+ */
 class KRITAPIGMENT_EXPORT KoBasicU8HistogramProducer : public KoBasicHistogramProducer
 {
 public:
@@ -6,12 +6,24 @@
 
 #include "KoColorConversionCache.h"
 
+#include <atomic>
+
+#include <QCache>
 #include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QThreadStorage>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QStandardPaths>
+
+#include <KSharedConfig>
+#include <KConfigGroup>
 
 #include <KoColorSpace.h>
+#include <KoColorProfile.h>
+#include <KoColorModelStandardIds.h>
+#include "KoColorConversionLut.h"
 
 struct KoColorConversionCacheKey {
 
@@ -68,11 +80,54 @@ struct KoColorConversionCache::Private {
     QMutex cacheMutex;
 
     QThreadStorage<FastPathCacheItem*> fastStorage;
+
+    std::atomic<bool> lutTransformationsEnabled {false};
+    std::atomic<int> lutGridSize {33};
+    QString lutCacheLocation;
+
+    /**
+     * The tables that are not used by any transformation anymore
+     * are evicted when the cache grows over maxLutCacheCost KiB
+     */
+    QCache<QByteArray, QSharedPointer<const KoColorConversionLut>> luts;
+    QMutex lutMutex;
+
+    static const int maxLutCacheCost = 64 * 1024;
+
+    static QByteArray colorSpaceKey(const KoColorSpace *cs);
+    static bool needsLutTransformation(const KoColorSpace *src, const KoColorSpace *dst);
 };
 
+QByteArray KoColorConversionCache::Private::colorSpaceKey(const KoColorSpace *cs)
+{
+    QByteArray key = cs->colorModelId().id().toLatin1() + '/' + cs->colorDepthId().id().toLatin1();
+
+    if (cs->profile()) {
+        key += '/' + cs->profile()->uniqueId().toHex() + '/' + cs->profile()->name().toUtf8();
+    }
+
+    return key;
+}
+
+bool KoColorConversionCache::Private::needsLutTransformation(const KoColorSpace *src, const KoColorSpace *dst)
+{
+    return dst->colorModelId() == CMYKAColorModelID ||
+        (dst->colorModelId() == LABAColorModelID && src->colorModelId() != LABAColorModelID);
+}
+
 
 KoColorConversionCache::KoColorConversionCache() : d(new Private)
 {
+    d->luts.setMaxCost(Private::maxLutCacheCost);
+
+    KConfigGroup cfg = KSharedConfig::openConfig()->group("");
+    d->lutTransformationsEnabled = cfg.readEntry("useColorConversionLuts", false);
+    d->lutGridSize = cfg.readEntry("colorConversionLutGridSize", 33);
+
+    const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheLocation.isEmpty()) {
+        d->lutCacheLocation = cacheLocation + "/colorconversionluts";
+    }
 }
 
 KoColorConversionCache::~KoColorConversionCache()
@@ -115,7 +170,23 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
         }
     }
     if (!cacheItem) {
+        /**
+         * Creating a transformation may take a lot of time (e.g. when
+         * it bakes a lookup table), so we don't block the other
+         * conversions meanwhile. If another thread creates the same
+         * transformation in parallel, both of them are kept in the
+         * cache, since every transformation is used by one thread
+         * at a time anyway.
+         */
+        lock.unlock();
+
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
+        if (d->lutTransformationsEnabled && Private::needsLutTransformation(src, dst)) {
+            transfo = createLutTransformation(transfo);
+        }
+
+        lock.relock();
+
         CachedTransformation* ct = new CachedTransformation(transfo);
         d->cache.insert(key, ct);
         cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(this, ct));
@@ -142,6 +213,108 @@ void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
     }
 }
 
+KoColorConversionTransformation* KoColorConversionCache::createLutTransformation(KoColorConversionTransformation *transformation,
+                                                                                 const QByteArray &extraKey)
+{
+    const KoColorSpace *src = transformation->srcColorSpace();
+    const KoColorSpace *dst = transformation->dstColorSpace();
+
+    if (!d->lutTransformationsEnabled || !KoColorConversionLut::isSupported(src, dst)) {
+        return transformation;
+    }
+
+    const int gridSize = d->lutGridSize.load();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(Private::colorSpaceKey(src));
+    hash.addData(Private::colorSpaceKey(dst));
+    hash.addData(QByteArray::number(int(transformation->renderingIntent())));
+    hash.addData(QByteArray::number(int(transformation->conversionFlags())));
+    hash.addData(QByteArray::number(gridSize));
+    hash.addData(extraKey);
+    const QByteArray key = hash.result().toHex();
+
+    QSharedPointer<const KoColorConversionLut> lut;
+
+    {
+        QMutexLocker lock(&d->lutMutex);
+        if (QSharedPointer<const KoColorConversionLut> *cachedLut = d->luts.object(key)) {
+            lut = *cachedLut;
+        }
+    }
+
+    if (!lut) {
+        const QString fileName = !d->lutCacheLocation.isEmpty() ?
+            d->lutCacheLocation + '/' + QString::fromLatin1(key) + ".lut" : QString();
+
+        // the table is loaded or baked without holding the lock
+        QSharedPointer<KoColorConversionLut> newLut;
+        bool isLoaded = false;
+
+        if (!fileName.isEmpty()) {
+            newLut = KoColorConversionLut::load(fileName, transformation, gridSize);
+            isLoaded = !newLut.isNull();
+        }
+
+        if (!newLut) {
+            newLut = KoColorConversionLut::bake(transformation, gridSize);
+        }
+
+        if (newLut) {
+            bool isInserted = false;
+
+            {
+                QMutexLocker lock(&d->lutMutex);
+
+                // another thread might have baked the same table meanwhile
+                if (QSharedPointer<const KoColorConversionLut> *cachedLut = d->luts.object(key)) {
+                    lut = *cachedLut;
+                } else {
+                    lut = newLut;
+                    d->luts.insert(key, new QSharedPointer<const KoColorConversionLut>(lut),
+                                   qMax(1, int(lut->memoryUsage() / 1024)));
+                    isInserted = true;
+                }
+            }
+
+            if (isInserted && !isLoaded && !fileName.isEmpty() && QDir().mkpath(d->lutCacheLocation)) {
+                newLut->save(fileName);
+            }
+        }
+    }
+
+    if (!lut) return transformation;
+
+    KoColorConversionTransformation *result =
+        new KoColorConversionLutTransformation(src, dst,
+                                               transformation->renderingIntent(),
+                                               transformation->conversionFlags(),
+                                               lut);
+    delete transformation;
+
+    return result;
+}
+
+void KoColorConversionCache::setLutTransformationsEnabled(bool value)
+{
+    d->lutTransformationsEnabled = value;
+}
+
+bool KoColorConversionCache::lutTransformationsEnabled() const
+{
+    return d->lutTransformationsEnabled;
+}
+
+void KoColorConversionCache::setLutGridSize(int value)
+{
+    d->lutGridSize = value;
+}
+
+int KoColorConversionCache::lutGridSize() const
+{
+    return d->lutGridSize;
+}
+
 //--------- KoCachedColorConversionTransformation ----------//
 
 struct KoCachedColorConversionTransformation::Private {
@@ -10,6 +10,8 @@
 class KoCachedColorConversionTransformation;
 class KoColorSpace;
 
+#include <QByteArray>
+
 #include "KoColorConversionTransformation.h"
 
 /**
@@ -45,6 +47,40 @@ public:
      * @param src source color space
      */
     void colorSpaceIsDestroyed(const KoColorSpace* src);
+
+    /**
+     * Returns a transformation that evaluates \p transformation via
+     * a precompiled KoColorConversionLut. The table is baked on the
+     * first request and is cached in memory and on disk, keyed by the
+     * hashes of the profiles, the intent, the flags, the grid size
+     * and \p extraKey. The memory cache is limited to 64 MiB, the
+     * tables evicted from it live as long as their transformations.
+     *
+     * The table is baked without holding any lock of the cache.
+     *
+     * The ownership of \p transformation is transferred to the cache.
+     * If the lookup tables are disabled or the color spaces are not
+     * supported, \p transformation is returned as it is.
+     */
+    KoColorConversionTransformation* createLutTransformation(KoColorConversionTransformation *transformation,
+                                                             const QByteArray &extraKey = QByteArray());
+
+    /**
+     * Enables baking of the expensive ICC transforms (the conversions
+     * to CMYK and Lab and soft-proofing) into lookup tables. The
+     * initial value is read from "useColorConversionLuts" option,
+     * disabled by default.
+     */
+    void setLutTransformationsEnabled(bool value);
+    bool lutTransformationsEnabled() const;
+
+    /**
+     * The number of the nodes of the lookup tables per dimension, the
+     * initial value is read from "colorConversionLutGridSize" option
+     */
+    void setLutGridSize(int value);
+    int lutGridSize() const;
+
 private:
     struct Private;
     Private* const d;
@@ -0,0 +1,576 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "KoColorConversionLut.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QVarLengthArray>
+
+#include "KoChannelInfo.h"
+#include "KoColorSpace.h"
+#include "KoColorProfile.h"
+#include "kis_assert.h"
+
+namespace {
+
+template <typename T>
+struct ChannelTraits;
+
+template <>
+struct ChannelTraits<quint8> {
+    static inline float read(const quint8 *ptr) {
+        return *ptr;
+    }
+    static inline void write(quint8 *ptr, float value) {
+        *ptr = quint8(qBound(0.0f, value, 255.0f) + 0.5f);
+    }
+};
+
+template <>
+struct ChannelTraits<quint16> {
+    static inline float read(const quint8 *ptr) {
+        return *reinterpret_cast<const quint16*>(ptr);
+    }
+    static inline void write(quint8 *ptr, float value) {
+        *reinterpret_cast<quint16*>(ptr) = quint16(qBound(0.0f, value, 65535.0f) + 0.5f);
+    }
+};
+
+template <>
+struct ChannelTraits<float> {
+    static inline float read(const quint8 *ptr) {
+        return *reinterpret_cast<const float*>(ptr);
+    }
+    static inline void write(quint8 *ptr, float value) {
+        *reinterpret_cast<float*>(ptr) = value;
+    }
+};
+
+struct ChannelAccessor
+{
+    int offset = 0;
+    float uiMin = 0.0f;
+    float uiRange = 1.0f;
+
+    template <typename T>
+    inline float readNormalized(const quint8 *pixel) const {
+        return (ChannelTraits<T>::read(pixel + offset) - uiMin) / uiRange;
+    }
+
+    template <typename T>
+    inline void write(quint8 *pixel, float value) const {
+        ChannelTraits<T>::write(pixel + offset, value);
+    }
+
+    template <typename T>
+    inline void writeNormalized(quint8 *pixel, float value) const {
+        write<T>(pixel, uiMin + value * uiRange);
+    }
+};
+
+struct ColorSpaceLayout
+{
+    QVector<ChannelAccessor> colorChannels;
+    ChannelAccessor alphaChannel;
+    bool hasAlpha = false;
+
+    /**
+     * All the channels of the supported color spaces
+     * have the same type
+     */
+    KoChannelInfo::enumChannelValueType valueType = KoChannelInfo::UINT8;
+
+    bool init(const KoColorSpace *cs) {
+        colorChannels.clear();
+        hasAlpha = false;
+
+        const QList<KoChannelInfo*> channels = cs->channels();
+        if (channels.isEmpty()) return false;
+
+        valueType = channels.first()->channelValueType();
+
+        if (valueType != KoChannelInfo::UINT8 &&
+            valueType != KoChannelInfo::UINT16 &&
+            valueType != KoChannelInfo::FLOAT32) {
+
+            return false;
+        }
+
+        Q_FOREACH (const KoChannelInfo *channel, channels) {
+            if (channel->channelValueType() != valueType) return false;
+
+            ChannelAccessor accessor;
+            accessor.offset = channel->pos();
+            accessor.uiMin = channel->getUIMin();
+            accessor.uiRange = channel->getUIMax() - channel->getUIMin();
+
+            if (accessor.uiRange <= 0.0f) return false;
+
+            if (channel->channelType() == KoChannelInfo::ALPHA) {
+                alphaChannel = accessor;
+                hasAlpha = true;
+            } else {
+                colorChannels.append(accessor);
+            }
+        }
+
+        return !colorChannels.isEmpty();
+    }
+
+    bool isIntegerSource(const KoColorSpace *cs) const {
+        /**
+         * The grid samples the source uniformly in [0, 1], which is
+         * fine only for the perceptually encoded bounded data. Float
+         * data may be linear and go above 1.0 (HDR), so a uniform
+         * grid loses either the values or the precision of the darks.
+         */
+        return (valueType == KoChannelInfo::UINT8 || valueType == KoChannelInfo::UINT16) &&
+            !(cs->profile() && cs->profile()->isLinear());
+    }
+};
+
+/**
+ * Writes the nodes of the grid, \p values keeps \p numInputs
+ * normalized values per pixel
+ */
+template <typename T>
+void writeNodesImpl(const ColorSpaceLayout &layout, quint8 *pixels, int pixelSize,
+                    const float *values, int numInputs, int numPixels)
+{
+    for (int i = 0; i < numPixels; i++) {
+        for (int c = 0; c < numInputs; c++) {
+            layout.colorChannels[c].writeNormalized<T>(pixels, *values++);
+        }
+
+        if (layout.hasAlpha) {
+            layout.alphaChannel.writeNormalized<T>(pixels, 1.0f);
+        }
+
+        pixels += pixelSize;
+    }
+}
+
+void writeNodes(const ColorSpaceLayout &layout, quint8 *pixels, int pixelSize,
+                const float *values, int numInputs, int numPixels)
+{
+    switch (layout.valueType) {
+    case KoChannelInfo::UINT8:
+        writeNodesImpl<quint8>(layout, pixels, pixelSize, values, numInputs, numPixels);
+        break;
+    case KoChannelInfo::UINT16:
+        writeNodesImpl<quint16>(layout, pixels, pixelSize, values, numInputs, numPixels);
+        break;
+    default:
+        writeNodesImpl<float>(layout, pixels, pixelSize, values, numInputs, numPixels);
+        break;
+    }
+}
+
+/**
+ * Reads the raw values of the color channels of the pixels
+ */
+template <typename T>
+void readValuesImpl(const ColorSpaceLayout &layout, const quint8 *pixels, int pixelSize,
+                    float *values, int numPixels)
+{
+    for (int i = 0; i < numPixels; i++) {
+        for (int c = 0; c < layout.colorChannels.size(); c++) {
+            *values++ = ChannelTraits<T>::read(pixels + layout.colorChannels[c].offset);
+        }
+        pixels += pixelSize;
+    }
+}
+
+void readValues(const ColorSpaceLayout &layout, const quint8 *pixels, int pixelSize,
+                float *values, int numPixels)
+{
+    switch (layout.valueType) {
+    case KoChannelInfo::UINT8:
+        readValuesImpl<quint8>(layout, pixels, pixelSize, values, numPixels);
+        break;
+    case KoChannelInfo::UINT16:
+        readValuesImpl<quint16>(layout, pixels, pixelSize, values, numPixels);
+        break;
+    default:
+        readValuesImpl<float>(layout, pixels, pixelSize, values, numPixels);
+        break;
+    }
+}
+
+}
+
+bool KoColorConversionLut::isSupported(const KoColorSpace *srcCs, const KoColorSpace *dstCs)
+{
+    ColorSpaceLayout srcLayout;
+    ColorSpaceLayout dstLayout;
+
+    return srcLayout.init(srcCs) && dstLayout.init(dstCs) &&
+        srcLayout.isIntegerSource(srcCs) &&
+        (srcLayout.colorChannels.size() == 3 || srcLayout.colorChannels.size() == 4);
+}
+
+KoColorConversionLut::KoColorConversionLut(int numInputs, int numOutputs, int gridSize)
+    : m_numInputs(numInputs),
+      m_numOutputs(numOutputs),
+      m_gridSize(gridSize)
+{
+    int numNodes = 1;
+    for (int i = 0; i < m_numInputs; i++) {
+        numNodes *= m_gridSize;
+    }
+
+    m_table.resize(numNodes * m_numOutputs);
+}
+
+QSharedPointer<KoColorConversionLut> KoColorConversionLut::bake(const KoColorConversionTransformation *transformation, int gridSize)
+{
+    const KoColorSpace *srcCs = transformation->srcColorSpace();
+    const KoColorSpace *dstCs = transformation->dstColorSpace();
+
+    ColorSpaceLayout srcLayout;
+    ColorSpaceLayout dstLayout;
+
+    if (!isSupported(srcCs, dstCs) ||
+        !srcLayout.init(srcCs) || !dstLayout.init(dstCs)) {
+
+        return QSharedPointer<KoColorConversionLut>();
+    }
+
+    const int numInputs = srcLayout.colorChannels.size();
+    const int numOutputs = dstLayout.colorChannels.size();
+
+    gridSize = qBound(2, gridSize, numInputs == 3 ? 65 : 33);
+
+    QSharedPointer<KoColorConversionLut> lut(new KoColorConversionLut(numInputs, numOutputs, gridSize));
+
+    const int numNodes = lut->m_table.size() / numOutputs;
+    const int srcPixelSize = srcCs->pixelSize();
+    const int dstPixelSize = dstCs->pixelSize();
+    const float step = 1.0f / (gridSize - 1);
+
+    const int chunkSize = 4096;
+    QVector<float> nodeValues(chunkSize * numInputs);
+    QVector<quint8> srcBuffer(chunkSize * srcPixelSize);
+    QVector<quint8> dstBuffer(chunkSize * dstPixelSize);
+
+    for (int base = 0; base < numNodes; base += chunkSize) {
+        const int numPixels = qMin(chunkSize, numNodes - base);
+
+        float *values = nodeValues.data();
+
+        for (int i = 0; i < numPixels; i++) {
+            /**
+             * The third input changes the fastest, the fourth one
+             * the slowest, so every 3D slice of the table is
+             * contiguous in memory
+             */
+            int node = base + i;
+            for (int c = 2; c >= 0; c--) {
+                values[c] = (node % gridSize) * step;
+                node /= gridSize;
+            }
+            if (numInputs == 4) {
+                values[3] = node * step;
+            }
+
+            values += numInputs;
+        }
+
+        srcBuffer.fill(0);
+        writeNodes(srcLayout, srcBuffer.data(), srcPixelSize, nodeValues.constData(), numInputs, numPixels);
+
+        transformation->transform(srcBuffer.constData(), dstBuffer.data(), numPixels);
+
+        readValues(dstLayout, dstBuffer.constData(), dstPixelSize,
+                   lut->m_table.data() + base * numOutputs, numPixels);
+    }
+
+    return lut;
+}
+
+namespace {
+const quint32 lutFileMagic = 0x4b4c5554; // "KLUT"
+const quint32 lutFileVersion = 1;
+}
+
+QSharedPointer<KoColorConversionLut> KoColorConversionLut::load(const QString &fileName,
+                                                                const KoColorConversionTransformation *transformation,
+                                                                int gridSize)
+{
+    ColorSpaceLayout srcLayout;
+    ColorSpaceLayout dstLayout;
+
+    if (!isSupported(transformation->srcColorSpace(), transformation->dstColorSpace()) ||
+        !srcLayout.init(transformation->srcColorSpace()) ||
+        !dstLayout.init(transformation->dstColorSpace())) {
+
+        return QSharedPointer<KoColorConversionLut>();
+    }
+
+    const int numInputs = srcLayout.colorChannels.size();
+    const int numOutputs = dstLayout.colorChannels.size();
+
+    gridSize = qBound(2, gridSize, numInputs == 3 ? 65 : 33);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return QSharedPointer<KoColorConversionLut>();
+
+    QDataStream stream(&file);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 fileNumInputs = 0;
+    qint32 fileNumOutputs = 0;
+    qint32 fileGridSize = 0;
+
+    stream >> magic >> version >> fileNumInputs >> fileNumOutputs >> fileGridSize;
+
+    if (stream.status() != QDataStream::Ok ||
+        magic != lutFileMagic || version != lutFileVersion ||
+        fileNumInputs != numInputs || fileNumOutputs != numOutputs ||
+        fileGridSize != gridSize) {
+
+        return QSharedPointer<KoColorConversionLut>();
+    }
+
+    QSharedPointer<KoColorConversionLut> lut(new KoColorConversionLut(numInputs, numOutputs, gridSize));
+
+    // the cache is machine-local, so the table is stored in the native byte order
+    const int numBytes = lut->m_table.size() * int(sizeof(float));
+    if (stream.readRawData(reinterpret_cast<char*>(lut->m_table.data()), numBytes) != numBytes) {
+        return QSharedPointer<KoColorConversionLut>();
+    }
+
+    return lut;
+}
+
+bool KoColorConversionLut::save(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    QDataStream stream(&file);
+
+    stream << lutFileMagic << lutFileVersion
+           << qint32(m_numInputs) << qint32(m_numOutputs) << qint32(m_gridSize);
+
+    const int numBytes = m_table.size() * int(sizeof(float));
+    if (stream.writeRawData(reinterpret_cast<const char*>(m_table.constData()), numBytes) != numBytes) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+int KoColorConversionLut::numInputs() const
+{
+    return m_numInputs;
+}
+
+int KoColorConversionLut::numOutputs() const
+{
+    return m_numOutputs;
+}
+
+int KoColorConversionLut::gridSize() const
+{
+    return m_gridSize;
+}
+
+qint64 KoColorConversionLut::memoryUsage() const
+{
+    return qint64(m_table.size()) * qint64(sizeof(float));
+}
+
+void KoColorConversionLut::evaluate3D(const float *input, const float *table, float *output) const
+{
+    const int lastCell = m_gridSize - 2;
+    const float scale = m_gridSize - 1;
+
+    const float fx = qBound(0.0f, input[0], 1.0f) * scale;
+    const float fy = qBound(0.0f, input[1], 1.0f) * scale;
+    const float fz = qBound(0.0f, input[2], 1.0f) * scale;
+
+    const int x0 = qMin(int(fx), lastCell);
+    const int y0 = qMin(int(fy), lastCell);
+    const int z0 = qMin(int(fz), lastCell);
+
+    const float dx = fx - x0;
+    const float dy = fy - y0;
+    const float dz = fz - z0;
+
+    const int strideZ = m_numOutputs;
+    const int strideY = m_gridSize * strideZ;
+    const int strideX = m_gridSize * strideY;
+
+    const float *c000 = table + x0 * strideX + y0 * strideY + z0 * strideZ;
+    const float *c111 = c000 + strideX + strideY + strideZ;
+
+    /**
+     * Tetrahedral interpolation: the cube is split into six
+     * tetrahedra along its main diagonal, the tetrahedron is
+     * selected by the order of the fractional parts
+     */
+    int offset1, offset2;
+    float w1, w2, w3;
+
+    if (dx >= dy) {
+        if (dy >= dz) {
+            offset1 = strideX; offset2 = strideX + strideY;
+            w1 = dx; w2 = dy; w3 = dz;
+        } else if (dx >= dz) {
+            offset1 = strideX; offset2 = strideX + strideZ;
+            w1 = dx; w2 = dz; w3 = dy;
+        } else {
+            offset1 = strideZ; offset2 = strideX + strideZ;
+            w1 = dz; w2 = dx; w3 = dy;
+        }
+    } else {
+        if (dz >= dy) {
+            offset1 = strideZ; offset2 = strideY + strideZ;
+            w1 = dz; w2 = dy; w3 = dx;
+        } else if (dx >= dz) {
+            offset1 = strideY; offset2 = strideX + strideY;
+            w1 = dy; w2 = dx; w3 = dz;
+        } else {
+            offset1 = strideY; offset2 = strideY + strideZ;
+            w1 = dy; w2 = dz; w3 = dx;
+        }
+    }
+
+    const float *c1 = c000 + offset1;
+    const float *c2 = c000 + offset2;
+
+    for (int i = 0; i < m_numOutputs; i++) {
+        output[i] = c000[i] +
+            w1 * (c1[i] - c000[i]) +
+            w2 * (c2[i] - c1[i]) +
+            w3 * (c111[i] - c2[i]);
+    }
+}
+
+void KoColorConversionLut::evaluate(const float *input, float *output) const
+{
+    if (m_numInputs == 3) {
+        evaluate3D(input, m_table.constData(), output);
+    } else {
+        const float fk = qBound(0.0f, input[3], 1.0f) * (m_gridSize - 1);
+        const int k0 = qMin(int(fk), m_gridSize - 2);
+        const float dk = fk - k0;
+
+        const int sliceSize = m_gridSize * m_gridSize * m_gridSize * m_numOutputs;
+
+        QVarLengthArray<float, 8> upper(m_numOutputs);
+
+        evaluate3D(input, m_table.constData() + k0 * sliceSize, output);
+        evaluate3D(input, m_table.constData() + (k0 + 1) * sliceSize, upper.data());
+
+        for (int i = 0; i < m_numOutputs; i++) {
+            output[i] += dk * (upper[i] - output[i]);
+        }
+    }
+}
+
+
+struct KoColorConversionLutTransformation::Private
+{
+    ColorSpaceLayout srcLayout;
+    ColorSpaceLayout dstLayout;
+    QSharedPointer<const KoColorConversionLut> lut;
+};
+
+KoColorConversionLutTransformation::KoColorConversionLutTransformation(const KoColorSpace *srcCs,
+                                                                       const KoColorSpace *dstCs,
+                                                                       Intent renderingIntent,
+                                                                       ConversionFlags conversionFlags,
+                                                                       QSharedPointer<const KoColorConversionLut> lut)
+    : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags),
+      m_d(new Private)
+{
+    m_d->lut = lut;
+
+    const bool layoutsAreValid = m_d->srcLayout.init(srcCs) && m_d->dstLayout.init(dstCs);
+    KIS_SAFE_ASSERT_RECOVER_NOOP(layoutsAreValid);
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->lut->numInputs() == m_d->srcLayout.colorChannels.size());
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_d->lut->numOutputs() == m_d->dstLayout.colorChannels.size());
+}
+
+KoColorConversionLutTransformation::~KoColorConversionLutTransformation()
+{
+}
+
+namespace {
+
+template <typename SrcT, typename DstT>
+void transformImpl(const KoColorConversionLut *lut,
+                   const ColorSpaceLayout &srcLayout, int srcPixelSize,
+                   const ColorSpaceLayout &dstLayout, int dstPixelSize,
+                   const quint8 *src, quint8 *dst, qint32 nPixels)
+{
+    const int numInputs = srcLayout.colorChannels.size();
+    const int numOutputs = dstLayout.colorChannels.size();
+
+    float input[4];
+    QVarLengthArray<float, 8> output(numOutputs);
+
+    for (qint32 i = 0; i < nPixels; i++) {
+        for (int c = 0; c < numInputs; c++) {
+            input[c] = srcLayout.colorChannels[c].readNormalized<SrcT>(src);
+        }
+
+        lut->evaluate(input, output.data());
+
+        for (int c = 0; c < numOutputs; c++) {
+            dstLayout.colorChannels[c].write<DstT>(dst, output[c]);
+        }
+
+        if (dstLayout.hasAlpha) {
+            dstLayout.alphaChannel.writeNormalized<DstT>(dst,
+                srcLayout.hasAlpha ? srcLayout.alphaChannel.readNormalized<SrcT>(src) : 1.0f);
+        }
+
+        src += srcPixelSize;
+        dst += dstPixelSize;
+    }
+}
+
+template <typename SrcT>
+void transformImpl(const KoColorConversionLut *lut,
+                   const ColorSpaceLayout &srcLayout, int srcPixelSize,
+                   const ColorSpaceLayout &dstLayout, int dstPixelSize,
+                   const quint8 *src, quint8 *dst, qint32 nPixels)
+{
+    switch (dstLayout.valueType) {
+    case KoChannelInfo::UINT8:
+        transformImpl<SrcT, quint8>(lut, srcLayout, srcPixelSize, dstLayout, dstPixelSize, src, dst, nPixels);
+        break;
+    case KoChannelInfo::UINT16:
+        transformImpl<SrcT, quint16>(lut, srcLayout, srcPixelSize, dstLayout, dstPixelSize, src, dst, nPixels);
+        break;
+    default:
+        transformImpl<SrcT, float>(lut, srcLayout, srcPixelSize, dstLayout, dstPixelSize, src, dst, nPixels);
+        break;
+    }
+}
+
+}
+
+void KoColorConversionLutTransformation::transform(const quint8 *src, quint8 *dst, qint32 nPixels) const
+{
+    const KoColorConversionLut *lut = m_d->lut.data();
+    const int srcPixelSize = srcColorSpace()->pixelSize();
+    const int dstPixelSize = dstColorSpace()->pixelSize();
+
+    // only the integer sources are supported, see isSupported()
+    if (m_d->srcLayout.valueType == KoChannelInfo::UINT8) {
+        transformImpl<quint8>(lut, m_d->srcLayout, srcPixelSize, m_d->dstLayout, dstPixelSize, src, dst, nPixels);
+    } else {
+        transformImpl<quint16>(lut, m_d->srcLayout, srcPixelSize, m_d->dstLayout, dstPixelSize, src, dst, nPixels);
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef KOCOLORCONVERSIONLUT_H
+#define KOCOLORCONVERSIONLUT_H
+
+#include <QVector>
+#include <QSharedPointer>
+#include <QScopedPointer>
+#include <QString>
+
+#include "KoColorConversionTransformation.h"
+
+#include "kritapigment_export.h"
+
+/**
+ * A color conversion baked into a regular grid of 3 (RGB) or
+ * 4 (CMYK) input dimensions. The grid stores the raw values of
+ * the color channels of the destination color space, they are
+ * interpolated tetrahedrally in the first three dimensions and
+ * linearly in the fourth one.
+ *
+ * The grid samples the source uniformly, so only the sources with
+ * integer channels and non-linear profiles are supported. The
+ * destination may also have 32-bit float channels.
+ */
+class KRITAPIGMENT_EXPORT KoColorConversionLut
+{
+public:
+    /**
+     * @return true if the conversion between \p srcCs and \p dstCs
+     * can be represented by a lookup table
+     */
+    static bool isSupported(const KoColorSpace *srcCs, const KoColorSpace *dstCs);
+
+    /**
+     * Evaluates \p transformation at every node of the grid. The
+     * grid size is clamped to [2, 65] for 3D and [2, 33] for 4D
+     * tables.
+     */
+    static QSharedPointer<KoColorConversionLut> bake(const KoColorConversionTransformation *transformation, int gridSize);
+
+    /**
+     * Loads the table saved with save(). Returns null if the file
+     * does not exist or its dimensions don't match the ones bake()
+     * would produce for \p transformation and \p gridSize.
+     */
+    static QSharedPointer<KoColorConversionLut> load(const QString &fileName,
+                                                     const KoColorConversionTransformation *transformation,
+                                                     int gridSize);
+    bool save(const QString &fileName) const;
+
+    int numInputs() const;
+    int numOutputs() const;
+    int gridSize() const;
+
+    /**
+     * The size of the table in bytes
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * Interpolates the table at \p input, which is normalized into
+     * [0, 1] range, and writes numOutputs() values into \p output
+     */
+    void evaluate(const float *input, float *output) const;
+
+private:
+    KoColorConversionLut(int numInputs, int numOutputs, int gridSize);
+
+    void evaluate3D(const float *input, const float *table, float *output) const;
+
+private:
+    int m_numInputs;
+    int m_numOutputs;
+    int m_gridSize;
+    QVector<float> m_table;
+};
+
+/**
+ * A color conversion transformation that evaluates a baked
+ * KoColorConversionLut instead of running the original transform
+ * pipeline for every pixel. The alpha channel is copied separately.
+ */
+class KRITAPIGMENT_EXPORT KoColorConversionLutTransformation : public KoColorConversionTransformation
+{
+public:
+    KoColorConversionLutTransformation(const KoColorSpace *srcCs,
+                                       const KoColorSpace *dstCs,
+                                       Intent renderingIntent,
+                                       ConversionFlags conversionFlags,
+                                       QSharedPointer<const KoColorConversionLut> lut);
+    ~KoColorConversionLutTransformation() override;
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KOCOLORCONVERSIONLUT_H
@@ -25,6 +25,9 @@ KoColorConversionSystem::KoColorConversionSystem(RegistryInterface *registryInte
 
 KoColorConversionSystem::~KoColorConversionSystem()
 {
+    Q_FOREACH (const Private::PendingLink &link, d->pendingLinks) {
+        delete link.factory;
+    }
     qDeleteAll(d->graph);
     qDeleteAll(d->vertexes);
     delete d;
@@ -91,25 +94,14 @@ void KoColorConversionSystem::insertColorSpace(const KoColorSpaceFactory* csf)
             }
         }
     }
+    // the links of the previous color spaces may lead to the new nodes
+    insertPendingConversionLinks();
+
     // Construct a link for "custom" transformation
     const QList<KoColorConversionTransformationFactory*> cctfs = csf->colorConversionLinks();
     Q_FOREACH (KoColorConversionTransformationFactory* cctf, cctfs) {
-        Node* srcNode = nodeFor(cctf->srcColorModelId(), cctf->srcColorDepthId(), cctf->srcProfile());
-        Q_ASSERT(srcNode);
-        Node* dstNode = nodeFor(cctf->dstColorModelId(), cctf->dstColorDepthId(), cctf->dstProfile());
-        Q_ASSERT(dstNode);
-        // Check if the two nodes are already connected
-        Vertex* v = vertexBetween(srcNode, dstNode);
-        // If the vertex doesn't already exist, then create it
-        if (!v) {
-            v = createVertex(srcNode, dstNode);
-        }
-        Q_ASSERT(v); // we should have one now
-        if (dstNode->modelId == modelId && dstNode->depthId == depthId) {
-            v->setFactoryFromDst(cctf);
-        }
-        if (srcNode->modelId == modelId && srcNode->depthId == depthId) {
-            v->setFactoryFromSrc(cctf);
+        if (!insertConversionLink(cctf, modelId, depthId)) {
+            d->pendingLinks << Private::PendingLink{cctf, modelId, depthId};
         }
     }
 }
@@ -133,31 +125,86 @@ void KoColorConversionSystem::insertColorProfile(const KoColorProfile* _profile)
                 connectToEngine(n, engineNode);
             }
         }
+    }
+
+    insertPendingConversionLinks();
+
+    /**
+     * The links are added after all the nodes of the profile are
+     * created, because the link between two depths of the profile
+     * is provided by one of the factories only
+     */
+    Q_FOREACH (const KoColorSpaceFactory* factory, factories) {
+        QString modelId = factory->colorModelId().id();
+        QString depthId = factory->colorDepthId().id();
+
         const QList<KoColorConversionTransformationFactory*> cctfs = factory->colorConversionLinks();
         Q_FOREACH (KoColorConversionTransformationFactory* cctf, cctfs) {
-            Node* srcNode = nodeFor(cctf->srcColorModelId(), cctf->srcColorDepthId(), cctf->srcProfile());
-            Q_ASSERT(srcNode);
-            Node* dstNode = nodeFor(cctf->dstColorModelId(), cctf->dstColorDepthId(), cctf->dstProfile());
-            Q_ASSERT(dstNode);
-            if (srcNode == n || dstNode == n) {
-                // Check if the two nodes are already connected
-                Vertex* v = vertexBetween(srcNode, dstNode);
-                // If the vertex doesn't already exist, then create it
-                if (!v) {
-                    v = createVertex(srcNode, dstNode);
-                }
-                Q_ASSERT(v); // we should have one now
-                if (dstNode->modelId == modelId && dstNode->depthId == depthId) {
-                    v->setFactoryFromDst(cctf);
-                }
-                if (srcNode->modelId == modelId && srcNode->depthId == depthId) {
-                    v->setFactoryFromSrc(cctf);
+            if (cctf->srcProfile() == _profile->name() || cctf->dstProfile() == _profile->name()) {
+                if (!insertConversionLink(cctf, modelId, depthId)) {
+                    d->pendingLinks << Private::PendingLink{cctf, modelId, depthId};
                 }
+            } else {
+                // the link is not related to this profile, it is
+                // owned by nobody
+                delete cctf;
             }
         }
     }
 }
 
+bool KoColorConversionSystem::insertConversionLink(KoColorConversionTransformationFactory* cctf, const QString& modelId, const QString& depthId)
+{
+    Node* srcNode = existingNodeFor(NodeKey(cctf->srcColorModelId(), cctf->srcColorDepthId(), cctf->srcProfile()));
+    Node* dstNode = existingNodeFor(NodeKey(cctf->dstColorModelId(), cctf->dstColorDepthId(), cctf->dstProfile()));
+    if (!srcNode || !dstNode) {
+        return false;
+    }
+
+    const bool fromDst = dstNode->modelId == modelId && dstNode->depthId == depthId;
+    const bool fromSrc = srcNode->modelId == modelId && srcNode->depthId == depthId;
+
+    // Check if the two nodes are already connected
+    Vertex* v = vertexBetween(srcNode, dstNode);
+
+    /**
+     * The same link may come several times, e.g. when a profile is
+     * inserted after the color space, keep the first one
+     */
+    const bool useFromDst = fromDst && (!v || !v->hasFactoryFromDst());
+    const bool useFromSrc = fromSrc && (!v || !v->hasFactoryFromSrc());
+
+    if (!useFromDst && !useFromSrc) {
+        delete cctf;
+        return true;
+    }
+
+    // If the vertex doesn't already exist, then create it
+    if (!v) {
+        v = createVertex(srcNode, dstNode);
+    }
+    Q_ASSERT(v); // we should have one now
+    if (useFromDst) {
+        v->setFactoryFromDst(cctf);
+    }
+    if (useFromSrc) {
+        v->setFactoryFromSrc(cctf);
+    }
+
+    return true;
+}
+
+void KoColorConversionSystem::insertPendingConversionLinks()
+{
+    for (auto it = d->pendingLinks.begin(); it != d->pendingLinks.end();) {
+        if (insertConversionLink(it->factory, it->modelId, it->depthId)) {
+            it = d->pendingLinks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 const KoColorSpace* KoColorConversionSystem::defaultColorSpaceForNode(const Node* node) const
 {
     return d->registryInterface->colorSpace(node->modelId, node->depthId, node->profileName);
@@ -192,6 +239,11 @@ const KoColorConversionSystem::Node* KoColorConversionSystem::nodeFor(const Node
     return d->graph.value(key);
 }
 
+KoColorConversionSystem::Node* KoColorConversionSystem::existingNodeFor(const NodeKey& key) const
+{
+    return d->graph.value(key);
+}
+
 KoColorConversionSystem::Node* KoColorConversionSystem::nodeFor(const QString& _colorModelId, const QString& _colorDepthId, const QString& _profileName)
 {
     return nodeFor(NodeKey(_colorModelId, _colorDepthId, _profileName));
@@ -11,6 +11,7 @@ class KoColorProfile;
 class KoColorSpace;
 class KoColorSpaceFactory;
 class KoColorSpaceEngine;
+class KoColorConversionTransformationFactory;
 class KoID;
 
 #include "KoColorConversionTransformation.h"
@@ -140,6 +141,22 @@ private:
      */
     void connectToEngine(Node* _node, Node* _engine);
     const Node* nodeFor(const KoColorSpace*) const;
+    /**
+     * @return the node corresponding to that key, or null if it doesn't exist
+     */
+    Node* existingNodeFor(const NodeKey& key) const;
+    /**
+     * Connect the nodes of the conversion link \p cctf provided by the
+     * color space factory of \p modelId and \p depthId.
+     *
+     * @return false if any of the nodes doesn't exist, the link
+     * is not taken then
+     */
+    bool insertConversionLink(KoColorConversionTransformationFactory* cctf, const QString& modelId, const QString& depthId);
+    /**
+     * Insert the pending links whose nodes exist now
+     */
+    void insertPendingConversionLinks();
     /**
      * @return the node corresponding to that key, or create it if needed
      */
@@ -127,6 +127,14 @@ struct KoColorConversionSystem::Vertex {
         return factoryFromDst;
     }
 
+    bool hasFactoryFromSrc() const {
+        return factoryFromSrc;
+    }
+
+    bool hasFactoryFromDst() const {
+        return factoryFromDst;
+    }
+
     Node* srcNode;
     Node* dstNode;
 
@@ -296,8 +304,19 @@ struct Q_DECL_HIDDEN KoColorConversionSystem::Private {
 
     Private(RegistryInterface *_registryInterface) : registryInterface(_registryInterface) {}
 
+    /**
+     * A conversion link whose source or destination node doesn't
+     * exist yet. The link is inserted as soon as both nodes appear.
+     */
+    struct PendingLink {
+        KoColorConversionTransformationFactory *factory;
+        QString modelId;
+        QString depthId;
+    };
+
     QHash<NodeKey, Node*> graph;
     QList<Vertex*> vertexes;
+    QList<PendingLink> pendingLinks;
     RegistryInterface *registryInterface;
 };
 
@@ -29,6 +29,7 @@
 #include <KoColorSpacePreserveLightnessUtils.h>
 #include "KisDitherOp.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QThreadStorage>
@@ -409,6 +410,36 @@ const KoColorConversionTransformation* KoColorSpace::fromRgbA16Converter() const
     return d->transfoFromRGBA16;
 }
 
+void KoColorSpace::normalisedChannelsValues(const quint8 *pixels, float *channels, qint32 nPixels) const
+{
+    const int numChannels = channelCount();
+    const int psize = pixelSize();
+    QVector<float> values(numChannels);
+
+    for (; nPixels > 0; --nPixels, pixels += psize, channels += numChannels) {
+        normalisedChannelsValue(pixels, values);
+        std::copy(values.constBegin(), values.constEnd(), channels);
+    }
+}
+
+void KoColorSpace::fromQColors(const QColor *colors, quint8 *dst, qint32 nPixels, const KoColorProfile *profile) const
+{
+    const int psize = pixelSize();
+
+    for (; nPixels > 0; --nPixels, ++colors, dst += psize) {
+        fromQColor(*colors, dst, profile);
+    }
+}
+
+void KoColorSpace::toQColors(const quint8 *src, QColor *colors, qint32 nPixels, const KoColorProfile *profile) const
+{
+    const int psize = pixelSize();
+
+    for (; nPixels > 0; --nPixels, src += psize, ++colors) {
+        toQColor(src, colors, profile);
+    }
+}
+
 void KoColorSpace::toLabA16(const quint8 * src, quint8 * dst, quint32 nPixels) const
 {
     toLabA16Converter()->transform(src, dst, nPixels);
@@ -463,7 +494,28 @@ KoColorConversionTransformation * KoColorSpace::createProofingTransform(const Ko
     }
     if (!d->iccEngine) return 0;
 
-    return d->iccEngine->createColorProofingTransformation(this, dstColorSpace, proofingSpace, renderingIntent, proofingIntent, conversionFlags, gamutWarning, adaptationState);
+    KoColorConversionTransformation *transform =
+        d->iccEngine->createColorProofingTransformation(this, dstColorSpace, proofingSpace, renderingIntent, proofingIntent, conversionFlags, gamutWarning, adaptationState);
+    if (!transform) return 0;
+
+    /**
+     * Soft-proofing runs the whole ICC pipeline twice per pixel, so
+     * bake it into a lookup table when it is enabled. The proofing
+     * parameters are not a part of the transformation itself, so they
+     * are passed to the cache as an extra key.
+     */
+    QByteArray proofingKey = proofingSpace->id().toLatin1();
+    if (proofingSpace->profile()) {
+        proofingKey += proofingSpace->profile()->uniqueId().toHex() + proofingSpace->profile()->name().toUtf8();
+    }
+    proofingKey += QByteArray::number(int(proofingIntent));
+    proofingKey += QByteArray::number(adaptationState);
+    if (gamutWarning && conversionFlags.testFlag(KoColorConversionTransformation::GamutCheck)) {
+        // the ICC engine uses only the first three bytes of the warning color
+        proofingKey += QByteArray(reinterpret_cast<const char*>(gamutWarning), 3);
+    }
+
+    return KoColorSpaceRegistry::instance()->colorConversionCache()->createLutTransformation(transform, proofingKey);
 }
 
 bool KoColorSpace::proofPixelsTo(const quint8 *src,
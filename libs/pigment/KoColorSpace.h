@@ -166,6 +166,16 @@ public:
      */
     virtual void normalisedChannelsValue(const quint8 *pixel, QVector<float> &channels) const = 0;
 
+    /**
+     * Write the normalized values of the channels of \p nPixels pixels
+     * into \p channels, channelCount() values per pixel in the same
+     * order as normalisedChannelsValue() returns them.
+     *
+     * Use it instead of calling normalisedChannelsValue() in a loop,
+     * the color spaces may convert the whole run of pixels at once.
+     */
+    virtual void normalisedChannelsValues(const quint8 *pixels, float *channels, qint32 nPixels) const;
+
     /**
      * Write in the pixel the value from the normalized vector.
      */
@@ -290,6 +300,18 @@ public:
      */
     virtual void toQColor(const quint8 *src, QColor *c, const KoColorProfile * profile = 0) const = 0;
 
+    /**
+     * Same as fromQColor(), but converts \p nPixels colors into
+     * a contiguous run of pixels at once
+     */
+    virtual void fromQColors(const QColor *colors, quint8 *dst, qint32 nPixels, const KoColorProfile * profile = 0) const;
+
+    /**
+     * Same as toQColor(), but converts a contiguous run of
+     * \p nPixels pixels at once
+     */
+    virtual void toQColors(const quint8 *src, QColor *colors, qint32 nPixels, const KoColorProfile * profile = 0) const;
+
     /**
      * Convert the pixels in data to (8-bit BGRA) QImage using the specified profiles.
      *
@@ -454,7 +476,7 @@ public:
     * nPixels -- the number of pixels
     *
     */
-    virtual void copyOpacityU8(quint8* src, quint8* dst, qint32 nPixels) const = 0;
+    virtual void copyOpacityU8(const quint8* src, quint8* dst, qint32 nPixels) const = 0;
 
     /**
      * Multiply the alpha channel of the given run of pixels by the given value.
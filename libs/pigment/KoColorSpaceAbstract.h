@@ -8,6 +8,8 @@
 #ifndef KOCOLORSPACEABSTRACT_H
 #define KOCOLORSPACEABSTRACT_H
 
+#include <algorithm>
+
 #include <QBitArray>
 #include <klocalizedstring.h>
 
@@ -22,6 +24,9 @@
 #include "KoConvolutionOpImpl.h"
 #include "KoInvertColorTransformation.h"
 #include "KoAlphaMaskApplicatorFactory.h"
+#include "KoOptimizedPixelOpsFactory.h"
+#include "KoNormalisedChannelsOp.h"
+#include "KoColorSpaceTraits.h"
 #include "KoColorModelStandardIdsUtils.h"
 
 /**
@@ -42,8 +47,9 @@ public:
 
 public:
     KoColorSpaceAbstract(const QString &id, const QString &name)
-        : KoColorSpace(id, name, new KoMixColorsOpImpl< _CSTrait>(), new KoConvolutionOpImpl< _CSTrait>()),
-          m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos))
+        : KoColorSpace(id, name, createMixColorsOp(), createConvolutionOp()),
+          m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos)),
+          m_normalisedChannelsOp(createNormalisedChannelsOp())
     {
     }
 
@@ -79,6 +85,19 @@ public:
         return _CSTrait::normalisedChannelsValue(pixel, channels);
     }
 
+    void normalisedChannelsValues(const quint8 *pixels, float *channels, qint32 nPixels) const override {
+        if (m_normalisedChannelsOp) {
+            m_normalisedChannelsOp->normalise(pixels, channels, nPixels * _CSTrait::channels_nb);
+        } else {
+            QVector<float> values(_CSTrait::channels_nb);
+
+            for (; nPixels > 0; --nPixels, pixels += _CSTrait::pixelSize, channels += _CSTrait::channels_nb) {
+                _CSTrait::normalisedChannelsValue(pixels, values);
+                std::copy(values.constBegin(), values.constEnd(), channels);
+            }
+        }
+    }
+
     void fromNormalisedChannelsValue(quint8 *pixel, const QVector<float> &values) const override {
         return _CSTrait::fromNormalisedChannelsValue(pixel, values);
     }
@@ -108,7 +127,7 @@ public:
         _CSTrait::setOpacity(pixels, alpha, nPixels);
     }
 
-    void copyOpacityU8(quint8* src, quint8 *dst, qint32 nPixels) const override {
+    void copyOpacityU8(const quint8* src, quint8 *dst, qint32 nPixels) const override {
         _CSTrait::copyOpacityU8(src, dst, nPixels);
     }
 
@@ -246,8 +265,43 @@ private:
         }
     }
 
+    /**
+     * The color spaces with RGBA-like pixels get the vectorized
+     * versions of the ops, all the others use the generic ones
+     */
+    static KoMixColorsOp* createMixColorsOp() {
+        KoMixColorsOp *op =
+            KoOptimizedPixelOpsFactory::createMixColorsOp(colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+                                                          _CSTrait::channels_nb, _CSTrait::alpha_pos);
+        return op ? op : new KoMixColorsOpImpl<_CSTrait>();
+    }
+
+    static KoConvolutionOp* createConvolutionOp() {
+        KoConvolutionOp *op =
+            KoOptimizedPixelOpsFactory::createConvolutionOp(colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+                                                            _CSTrait::channels_nb, _CSTrait::alpha_pos);
+        return op ? op : new KoConvolutionOpImpl<_CSTrait>();
+    }
+
+    /**
+     * The vectorized normalization divides all the channels by the
+     * unit value, so it is used only when the traits don't redefine
+     * normalisedChannelsValue(), e.g. Lab and CMYK do.
+     */
+    static KoNormalisedChannelsOp* createNormalisedChannelsOp() {
+        typedef typename _CSTrait::channels_type channels_type;
+        typedef KoColorSpaceTrait<channels_type, _CSTrait::channels_nb, _CSTrait::alpha_pos> PlainTrait;
+
+        if (&_CSTrait::normalisedChannelsValue != &PlainTrait::normalisedChannelsValue) {
+            return 0;
+        }
+
+        return KoOptimizedPixelOpsFactory::createNormalisedChannelsOp(colorDepthIdForChannelType<channels_type>());
+    }
+
 private:
     QScopedPointer<KoAlphaMaskApplicatorBase> m_alphaMaskApplicator;
+    QScopedPointer<KoNormalisedChannelsOp> m_normalisedChannelsOp;
 };
 
 #endif // KOCOLORSPACEABSTRACT_H
@@ -100,7 +100,7 @@ struct KoColorSpaceTrait {
     /**
      * Copy alpha channel of all pixels in src to dst
      */
-    inline static void copyOpacityU8(quint8* src, quint8* dst, qint32 nPixels) {
+    inline static void copyOpacityU8(const quint8* src, quint8* dst, qint32 nPixels) {
         if (alpha_pos < 0) return;
         qint32 psize = pixelSize;
         for (; nPixels > 0; --nPixels, src += psize, dst++) {
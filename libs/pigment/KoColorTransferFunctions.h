@@ -118,4 +118,24 @@ ALWAYS_INLINE float removeSMPTE_ST_428Curve(float x) noexcept
     return (52.37f / 48.0f) * powf(x, 2.6f);
 }
 
+// IEC 61966-2-1, the values below the linear segment (including negative
+// ones) are mapped linearly, the same way lcms handles unbounded values.
+ALWAYS_INLINE float applySRGBCurve(float x) noexcept
+{
+    if (x <= 0.0031308f) {
+        return 12.92f * x;
+    } else {
+        return 1.055f * powf(x, 1.f / 2.4f) - 0.055f;
+    }
+}
+
+ALWAYS_INLINE float removeSRGBCurve(float x) noexcept
+{
+    if (x <= 0.04045f) {
+        return x * (1.f / 12.92f);
+    } else {
+        return powf((x + 0.055f) * (1.f / 1.055f), 2.4f);
+    }
+}
+
 #endif // KOCOLORTRANSFERFUNCTIONS_H
@@ -10,6 +10,8 @@
 #include <KoID.h>
 #include <QList>
 
+#include <cstring>
+
 #include "KoColorSpace.h"
 #include "KoColorSpaceMaths.h"
 #include "KoCompositeOpRegistry.h"
@@ -188,3 +190,23 @@ const KoColorSpace * KoCompositeOp::colorSpace() const
 {
     return d->colorSpace;
 }
+
+qint32 KoCompositeOp::countEqualBytes(const quint8 *data, qint32 size, quint8 value)
+{
+    const quint64 pattern = 0x0101010101010101ULL * value;
+
+    qint32 count = 0;
+
+    for (; count + 8 <= size; count += 8) {
+        quint64 word;
+        memcpy(&word, data + count, sizeof(word));
+
+        if (word != pattern) break;
+    }
+
+    while (count < size && data[count] == value) {
+        count++;
+    }
+
+    return count;
+}
@@ -126,6 +126,14 @@ public:
     */
     virtual void composite(const ParameterInfo& params) const;
 
+protected:
+    /**
+     * @return the number of leading bytes of \p data equal to \p value,
+     * at most \p size. Used by the composite ops to find the spans of
+     * the mask they can skip or copy without blending.
+     */
+    static qint32 countEqualBytes(const quint8 *data, qint32 size, quint8 value);
+
 private:
     KoCompositeOp();
     struct Private;
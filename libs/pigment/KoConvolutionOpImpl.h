@@ -13,7 +13,39 @@
 #include "KoConvolutionOp.h"
 #include "KoColorSpaceTraits.h"
 
+/**
+ * The default pixel accumulator of KoConvolutionOpImpl. It adds the
+ * weighted channels of every non-transparent pixel into the totals
+ * one-by-one.
+ *
+ * \see KoOptimizedPixelOps.h for the vectorized version
+ */
 template<class _CSTrait>
+struct KoConvolutionOpGenericAccumulator
+{
+    typedef typename _CSTrait::channels_type channels_type;
+
+    static void accumulate(const quint8* const* colors, const qreal* kernelValues, qint32 nPixels,
+                           qreal *totals, qreal &totalWeight, qreal &totalWeightTransparent)
+    {
+        for (; nPixels--; colors++, kernelValues++) {
+            qreal weight = *kernelValues;
+            const channels_type* color = _CSTrait::nativeArray(*colors);
+            if (weight != 0) {
+                if (_CSTrait::opacityU8(*colors) == 0) {
+                    totalWeightTransparent += weight;
+                } else {
+                    for (uint i = 0; i < _CSTrait::channels_nb; i++) {
+                        totals[i] += color[i] * weight;
+                    }
+                }
+                totalWeight += weight;
+            }
+        }
+    }
+};
+
+template<class _CSTrait, class _Accumulator = KoConvolutionOpGenericAccumulator<_CSTrait>>
 class KoConvolutionOpImpl : public KoConvolutionOp
 {
     typedef typename KoColorSpaceMathsTraits<typename _CSTrait::channels_type>::compositetype compositetype;
@@ -70,20 +102,7 @@ public:
 
         memset(totals, 0, sizeof(qreal) * _CSTrait::channels_nb);
 
-        for (; nPixels--; colors++, kernelValues++) {
-            qreal weight = *kernelValues;
-            const channels_type* color = _CSTrait::nativeArray(*colors);
-            if (weight != 0) {
-                if (_CSTrait::opacityU8(*colors) == 0) {
-                    totalWeightTransparent += weight;
-                } else {
-                    for (uint i = 0; i < _CSTrait::channels_nb; i++) {
-                        totals[i] += color[i] * weight;
-                    }
-                }
-                totalWeight += weight;
-            }
-        }
+        _Accumulator::accumulate(colors, kernelValues, nPixels, totals, totalWeight, totalWeightTransparent);
 
         typename _CSTrait::channels_type* dstColor = _CSTrait::nativeArray(dst);
 
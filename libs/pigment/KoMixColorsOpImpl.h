@@ -33,7 +33,49 @@ static inline T safeDivideWithRound(T dividend,
 
 
 
+/**
+ * The default pixel accumulator of KoMixColorsOpImpl. It adds the
+ * channels of every pixel into the totals one-by-one.
+ *
+ * \see KoOptimizedPixelOps.h for the vectorized version
+ */
 template<class _CSTrait>
+struct KoMixColorsOpGenericAccumulator
+{
+    using channels_type = typename _CSTrait::channels_type;
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+    using MathsTraits = KoColorSpaceMathsTraits<channels_type>;
+
+    template<class AbstractSource, class WeightsWrapper>
+    static void accumulate(AbstractSource &source, WeightsWrapper &weightsWrapper, int nColors,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        while (nColors--) {
+            const channels_type* color = _CSTrait::nativeArray(source.getPixel());
+            mix_type alphaTimesWeight;
+
+            if (_CSTrait::alpha_pos != -1) {
+                alphaTimesWeight = color[_CSTrait::alpha_pos];
+            } else {
+                alphaTimesWeight = MathsTraits::unitValue;
+            }
+
+            weightsWrapper.premultiplyAlphaWithWeight(alphaTimesWeight);
+
+            for (int i = 0; i < (int)_CSTrait::channels_nb; i++) {
+                if (i != _CSTrait::alpha_pos) {
+                    totals[i] += color[i] * alphaTimesWeight;
+                }
+            }
+
+            totalAlpha += alphaTimesWeight;
+            source.nextPixel();
+            weightsWrapper.nextPixel();
+        }
+    }
+};
+
+template<class _CSTrait, class _Accumulator = KoMixColorsOpGenericAccumulator<_CSTrait>>
 class KoMixColorsOpImpl : public KoMixColorsOp
 {
 public:
@@ -263,28 +305,7 @@ private:
             m_numPixels += nColors;
 #endif
 
-            while (nColors--) {
-                const channels_type* color = _CSTrait::nativeArray(source.getPixel());
-                mix_type alphaTimesWeight;
-
-                if (_CSTrait::alpha_pos != -1) {
-                    alphaTimesWeight = color[_CSTrait::alpha_pos];
-                } else {
-                    alphaTimesWeight = MathsTraits::unitValue;
-                }
-
-                weightsWrapper.premultiplyAlphaWithWeight(alphaTimesWeight);
-
-                for (int i = 0; i < (int)_CSTrait::channels_nb; i++) {
-                    if (i != _CSTrait::alpha_pos) {
-                        totals[i] += color[i] * alphaTimesWeight;
-                    }
-                }
-
-                totalAlpha += alphaTimesWeight;
-                source.nextPixel();
-                weightsWrapper.nextPixel();
-            }
+            _Accumulator::accumulate(source, weightsWrapper, nColors, totals, totalAlpha);
 
             normalizeFactor += weightsWrapper.normalizeFactor();
         }
@@ -304,8 +325,8 @@ private:
 
 };
 
-template<class _CSTrait>
-class KoMixColorsOpImpl<_CSTrait>::MixerImpl : public KoMixColorsOp::Mixer
+template<class _CSTrait, class _Accumulator>
+class KoMixColorsOpImpl<_CSTrait, _Accumulator>::MixerImpl : public KoMixColorsOp::Mixer
 {
 public:
     MixerImpl()
@@ -336,8 +357,8 @@ private:
     MixDataResult result;
 };
 
-template<class _CSTrait>
-KoMixColorsOp::Mixer *KoMixColorsOpImpl<_CSTrait>::createMixer() const
+template<class _CSTrait, class _Accumulator>
+KoMixColorsOp::Mixer *KoMixColorsOpImpl<_CSTrait, _Accumulator>::createMixer() const
 {
     return new MixerImpl();
 }
@@ -0,0 +1,31 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+#ifndef KO_NORMALISED_CHANNELS_OP_H
+#define KO_NORMALISED_CHANNELS_OP_H
+
+#include <QtGlobal>
+
+/**
+ * Converts a contiguous stream of channel values of a single depth
+ * into floats normalized by the unit value of the channel type. It is
+ * the batch version of KoColorSpaceTrait::normalisedChannelsValue(),
+ * the pixel layout doesn't matter, since every channel is scaled in
+ * the same way.
+ *
+ * \see KoOptimizedPixelOpsFactory::createNormalisedChannelsOp
+ */
+class KoNormalisedChannelsOp
+{
+public:
+    virtual ~KoNormalisedChannelsOp() { }
+
+    /**
+     * Normalize \p nValues channel values from \p src into \p dst
+     */
+    virtual void normalise(const quint8 *src, float *dst, qint32 nValues) const = 0;
+};
+
+#endif // KO_NORMALISED_CHANNELS_OP_H
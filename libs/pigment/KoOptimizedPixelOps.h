@@ -0,0 +1,213 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDPIXELOPS_H
+#define KOOPTIMIZEDPIXELOPS_H
+
+#include <limits>
+#include <type_traits>
+
+#include "KoVcMultiArchBuildSupport.h"
+#include "KoMixColorsOpImpl.h"
+#include "KoConvolutionOpImpl.h"
+#include "KoNormalisedChannelsOp.h"
+
+
+/**
+ * Pixel accumulators of KoMixColorsOpImpl and KoConvolutionOpImpl
+ * for the color spaces with four channels and alpha in the last
+ * position. All four channels of a pixel are processed in a single
+ * vector, so the totals of every channel are summed up in exactly
+ * the same order as in the generic accumulators.
+ *
+ * The generic versions are used for the scalar implementation and
+ * when Vc is not available.
+ */
+template<class _CSTrait,
+         Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KoMixColorsOpOptimizedAccumulator : public KoMixColorsOpGenericAccumulator<_CSTrait>
+{
+};
+
+template<class _CSTrait,
+         Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KoConvolutionOpOptimizedAccumulator : public KoConvolutionOpGenericAccumulator<_CSTrait>
+{
+};
+
+#ifdef HAVE_VC
+
+template<class _CSTrait, Vc::Implementation _impl>
+struct KoMixColorsOpOptimizedAccumulator<
+        _CSTrait,
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    static_assert(_CSTrait::channels_nb == 4 && _CSTrait::alpha_pos == 3,
+                  "the accumulator supports RGBA-like pixels only");
+
+    using channels_type = typename _CSTrait::channels_type;
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+    using MathsTraits = KoColorSpaceMathsTraits<channels_type>;
+    using pixel_v = Vc::SimdArray<double, 4>;
+
+    /**
+     * The products are accumulated in doubles, for integer channels
+     * they stay exact as long as the sum is below 2^53. The weights
+     * are signed 16-bit values, so the sum is flushed into the 64-bit
+     * totals after every pixelsPerBlock pixels.
+     */
+    static constexpr int blockBits = qMax(0, 53 - 2 * MathsTraits::bits - 16);
+
+    static constexpr int pixelsPerBlock =
+        std::is_integral<mix_type>::value ?
+            int(qint64(1) << qMin(30, blockBits)) :
+            std::numeric_limits<int>::max();
+
+    template<class AbstractSource, class WeightsWrapper>
+    static void accumulate(AbstractSource &source, WeightsWrapper &weightsWrapper, int nColors,
+                           mix_type *totals, mix_type &totalAlpha)
+    {
+        const pixel_v::mask_type alphaLane =
+            pixel_v::IndexesFromZero() == pixel_v(double(_CSTrait::alpha_pos));
+
+        while (nColors > 0) {
+            const int blockSize = qMin(nColors, int(pixelsPerBlock));
+            pixel_v blockTotals(Vc::Zero);
+
+            for (int i = 0; i < blockSize; i++) {
+                const channels_type* color = _CSTrait::nativeArray(source.getPixel());
+
+                mix_type alphaTimesWeight = color[_CSTrait::alpha_pos];
+                weightsWrapper.premultiplyAlphaWithWeight(alphaTimesWeight);
+
+                /**
+                 * The alpha lane is replaced with one, so that it
+                 * accumulates the sum of the weighted alpha values
+                 */
+                pixel_v pixel(color, Vc::Unaligned);
+                pixel(alphaLane) = 1.0;
+
+                blockTotals += pixel * pixel_v(double(alphaTimesWeight));
+
+                source.nextPixel();
+                weightsWrapper.nextPixel();
+            }
+
+            for (int i = 0; i < _CSTrait::alpha_pos; i++) {
+                totals[i] += mix_type(blockTotals[i]);
+            }
+            totalAlpha += mix_type(blockTotals[_CSTrait::alpha_pos]);
+
+            nColors -= blockSize;
+        }
+    }
+};
+
+template<class _CSTrait, Vc::Implementation _impl>
+struct KoConvolutionOpOptimizedAccumulator<
+        _CSTrait,
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    static_assert(_CSTrait::channels_nb == 4 && _CSTrait::alpha_pos == 3,
+                  "the accumulator supports RGBA-like pixels only");
+
+    using channels_type = typename _CSTrait::channels_type;
+    using pixel_v = Vc::SimdArray<qreal, 4>;
+
+    static void accumulate(const quint8* const* colors, const qreal* kernelValues, qint32 nPixels,
+                           qreal *totals, qreal &totalWeight, qreal &totalWeightTransparent)
+    {
+        pixel_v pixelTotals(totals, Vc::Unaligned);
+
+        for (; nPixels--; colors++, kernelValues++) {
+            const qreal weight = *kernelValues;
+            if (weight != 0) {
+                if (_CSTrait::opacityU8(*colors) == 0) {
+                    totalWeightTransparent += weight;
+                } else {
+                    const pixel_v pixel(_CSTrait::nativeArray(*colors), Vc::Unaligned);
+                    pixelTotals += pixel * pixel_v(weight);
+                }
+                totalWeight += weight;
+            }
+        }
+
+        pixelTotals.store(totals, Vc::Unaligned);
+    }
+};
+
+#endif /* HAVE_VC */
+
+
+/**
+ * Normalizes the beginning of the stream of channel values with
+ * vector instructions and returns the number of processed values.
+ * The generic version processes nothing.
+ */
+template<typename channels_type,
+         Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KoNormalisedChannelsOptimizedKernel
+{
+    static int normalise(const channels_type *, float *, int)
+    {
+        return 0;
+    }
+};
+
+#ifdef HAVE_VC
+
+template<typename channels_type, Vc::Implementation _impl>
+struct KoNormalisedChannelsOptimizedKernel<
+        channels_type,
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    static int normalise(const channels_type *src, float *dst, int nValues)
+    {
+        const int laneCount = static_cast<int>(Vc::float_v::size());
+
+        /**
+         * Division instead of multiplication by the reciprocal keeps
+         * the result equal to the one of the scalar version
+         */
+        const Vc::float_v unitValue(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+
+        int i = 0;
+        for (; i + laneCount <= nValues; i += laneCount) {
+            Vc::float_v c;
+            c.load(src + i, Vc::Unaligned);
+            c /= unitValue;
+            c.store(dst + i, Vc::Unaligned);
+        }
+
+        return i;
+    }
+};
+
+#endif /* HAVE_VC */
+
+template<typename channels_type, Vc::Implementation _impl>
+class KoOptimizedNormalisedChannelsOp : public KoNormalisedChannelsOp
+{
+public:
+    void normalise(const quint8 *src, float *dst, qint32 nValues) const override
+    {
+        const channels_type *values = reinterpret_cast<const channels_type*>(src);
+
+        int i = KoNormalisedChannelsOptimizedKernel<channels_type, _impl>::normalise(values, dst, nValues);
+
+        for (; i < nValues; i++) {
+            dst[i] = ((qreal)values[i]) / KoColorSpaceMathsTraits<channels_type>::unitValue;
+        }
+    }
+};
+
+#endif // KOOPTIMIZEDPIXELOPS_H
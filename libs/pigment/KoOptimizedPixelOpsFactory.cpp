@@ -0,0 +1,49 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedPixelOpsFactory.h"
+
+#include "KoOptimizedPixelOpsFactoryImpl.h"
+#include "KoColorModelStandardIds.h"
+
+namespace {
+template<template<typename> class FactoryImpl>
+typename FactoryImpl<quint8>::ReturnType createForDepth(const KoID &depthId)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        return createOptimizedClass<FactoryImpl<quint8>>(0);
+    } else if (depthId == Integer16BitsColorDepthID) {
+        return createOptimizedClass<FactoryImpl<quint16>>(0);
+    } else if (depthId == Float32BitsColorDepthID) {
+        return createOptimizedClass<FactoryImpl<float>>(0);
+    }
+
+    return 0;
+}
+
+template<template<typename> class FactoryImpl>
+typename FactoryImpl<quint8>::ReturnType createForDepth(const KoID &depthId, int numChannels, int alphaPos)
+{
+    if (numChannels != 4 || alphaPos != 3) return 0;
+
+    return createForDepth<FactoryImpl>(depthId);
+}
+}
+
+KoMixColorsOp *KoOptimizedPixelOpsFactory::createMixColorsOp(const KoID &depthId, int numChannels, int alphaPos)
+{
+    return createForDepth<KoOptimizedMixColorsOpFactoryImpl>(depthId, numChannels, alphaPos);
+}
+
+KoConvolutionOp *KoOptimizedPixelOpsFactory::createConvolutionOp(const KoID &depthId, int numChannels, int alphaPos)
+{
+    return createForDepth<KoOptimizedConvolutionOpFactoryImpl>(depthId, numChannels, alphaPos);
+}
+
+KoNormalisedChannelsOp *KoOptimizedPixelOpsFactory::createNormalisedChannelsOp(const KoID &depthId)
+{
+    return createForDepth<KoOptimizedNormalisedChannelsOpFactoryImpl>(depthId);
+}
@@ -0,0 +1,37 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDPIXELOPSFACTORY_H
+#define KOOPTIMIZEDPIXELOPSFACTORY_H
+
+#include "kritapigment_export.h"
+
+class KoID;
+class KoMixColorsOp;
+class KoConvolutionOp;
+class KoNormalisedChannelsOp;
+
+/**
+ * Creates the mix colors and convolution ops that process all
+ * channels of a pixel in a single vector. Only the pixels with four
+ * channels of 8-bit, 16-bit or 32-bit float depth and alpha in the
+ * last position are supported, the functions return null for all
+ * the other layouts.
+ *
+ * The normalization op doesn't depend on the pixel layout, it is
+ * created for any number of channels of the supported depths.
+ *
+ * \see KoOptimizedPixelOps.h
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelOpsFactory
+{
+public:
+    static KoMixColorsOp* createMixColorsOp(const KoID &depthId, int numChannels, int alphaPos);
+    static KoConvolutionOp* createConvolutionOp(const KoID &depthId, int numChannels, int alphaPos);
+    static KoNormalisedChannelsOp* createNormalisedChannelsOp(const KoID &depthId);
+};
+
+#endif // KOOPTIMIZEDPIXELOPSFACTORY_H
@@ -0,0 +1,45 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedPixelOpsFactoryImpl.h"
+
+#include "KoColorSpaceTraits.h"
+#include "KoOptimizedPixelOps.h"
+
+template<typename _channels_type_>
+template<Vc::Implementation _impl>
+KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<_channels_type_>::create(int)
+{
+    typedef KoColorSpaceTrait<_channels_type_, 4, 3> Traits;
+    return new KoMixColorsOpImpl<Traits, KoMixColorsOpOptimizedAccumulator<Traits, _impl>>();
+}
+
+template<typename _channels_type_>
+template<Vc::Implementation _impl>
+KoConvolutionOp* KoOptimizedConvolutionOpFactoryImpl<_channels_type_>::create(int)
+{
+    typedef KoColorSpaceTrait<_channels_type_, 4, 3> Traits;
+    return new KoConvolutionOpImpl<Traits, KoConvolutionOpOptimizedAccumulator<Traits, _impl>>();
+}
+
+template<typename _channels_type_>
+template<Vc::Implementation _impl>
+KoNormalisedChannelsOp* KoOptimizedNormalisedChannelsOpFactoryImpl<_channels_type_>::create(int)
+{
+    return new KoOptimizedNormalisedChannelsOp<_channels_type_, _impl>();
+}
+
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint8>::create<Vc::CurrentImplementation::current()>(int);
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint16>::create<Vc::CurrentImplementation::current()>(int);
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<float>::create<Vc::CurrentImplementation::current()>(int);
+
+template KoConvolutionOp* KoOptimizedConvolutionOpFactoryImpl<quint8>::create<Vc::CurrentImplementation::current()>(int);
+template KoConvolutionOp* KoOptimizedConvolutionOpFactoryImpl<quint16>::create<Vc::CurrentImplementation::current()>(int);
+template KoConvolutionOp* KoOptimizedConvolutionOpFactoryImpl<float>::create<Vc::CurrentImplementation::current()>(int);
+
+template KoNormalisedChannelsOp* KoOptimizedNormalisedChannelsOpFactoryImpl<quint8>::create<Vc::CurrentImplementation::current()>(int);
+template KoNormalisedChannelsOp* KoOptimizedNormalisedChannelsOpFactoryImpl<quint16>::create<Vc::CurrentImplementation::current()>(int);
+template KoNormalisedChannelsOp* KoOptimizedNormalisedChannelsOpFactoryImpl<float>::create<Vc::CurrentImplementation::current()>(int);
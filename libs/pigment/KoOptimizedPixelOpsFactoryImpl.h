@@ -0,0 +1,50 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDPIXELOPSFACTORYIMPL_H
+#define KOOPTIMIZEDPIXELOPSFACTORYIMPL_H
+
+#include "kritapigment_export.h"
+#include <KoVcMultiArchBuildSupport.h>
+
+class KoMixColorsOp;
+class KoConvolutionOp;
+class KoNormalisedChannelsOp;
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactoryImpl
+{
+public:
+    typedef int ParamType;
+    typedef KoMixColorsOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KoMixColorsOp* create(int);
+};
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedConvolutionOpFactoryImpl
+{
+public:
+    typedef int ParamType;
+    typedef KoConvolutionOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KoConvolutionOp* create(int);
+};
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedNormalisedChannelsOpFactoryImpl
+{
+public:
+    typedef int ParamType;
+    typedef KoNormalisedChannelsOp* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KoNormalisedChannelsOp* create(int);
+};
+
+#endif // KOOPTIMIZEDPIXELOPSFACTORYIMPL_H
@@ -0,0 +1,467 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPER_H
+#define KOOPTIMIZEDRGBSHAPER_H
+
+#include "KoOptimizedRgbShaperBase.h"
+
+#include <limits>
+#include <type_traits>
+
+#include "KoVcMultiArchBuildSupport.h"
+#include "KoColorSpaceMaths.h"
+#include "KoColorTransferFunctions.h"
+#include "KoOptimizedHalfConversion.h"
+#include "kis_assert.h"
+
+
+/**
+ * Scalar versions of the curves. They are templated over the
+ * implementation to avoid merging of the code compiled for
+ * different architectures.
+ */
+template<Vc::Implementation _impl>
+struct KoOptimizedRgbShaperScalarCurves
+{
+    static void removeCurve(KoOptimizedRgbShaperBase::TransferFunction transfer,
+                            float *values, int numValues)
+    {
+        switch (transfer) {
+        case KoOptimizedRgbShaperBase::LinearTransfer:
+            break;
+        case KoOptimizedRgbShaperBase::SRGBTransfer:
+            for (int i = 0; i < numValues; i++) {
+                values[i] = removeSRGBCurve(values[i]);
+            }
+            break;
+        case KoOptimizedRgbShaperBase::PQTransfer:
+            for (int i = 0; i < numValues; i++) {
+                values[i] = removeSmpte2048Curve(values[i]);
+            }
+            break;
+        }
+    }
+
+    static void applyCurve(KoOptimizedRgbShaperBase::TransferFunction transfer,
+                           float *values, int numValues)
+    {
+        switch (transfer) {
+        case KoOptimizedRgbShaperBase::LinearTransfer:
+            break;
+        case KoOptimizedRgbShaperBase::SRGBTransfer:
+            for (int i = 0; i < numValues; i++) {
+                values[i] = applySRGBCurve(values[i]);
+            }
+            break;
+        case KoOptimizedRgbShaperBase::PQTransfer:
+            for (int i = 0; i < numValues; i++) {
+                values[i] = applySmpte2048Curve(values[i]);
+            }
+            break;
+        }
+    }
+};
+
+/**
+ * Applies or removes the transfer curve on a plane of
+ * normalized channel values. The generic version is used for
+ * the scalar implementation and when Vc is not available.
+ */
+template<Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KoOptimizedRgbShaperCurves : public KoOptimizedRgbShaperScalarCurves<_impl>
+{
+};
+
+#ifdef HAVE_VC
+
+template<Vc::Implementation _impl>
+struct KoOptimizedRgbShaperCurves<
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    using ScalarCurves = KoOptimizedRgbShaperScalarCurves<_impl>;
+
+    /**
+     * pow() for positive bases, non-positive bases yield zero
+     */
+    static inline Vc::float_v powPositive(Vc::float_v::AsArg x, float y)
+    {
+        const Vc::float_v safeX = Vc::max(x, Vc::float_v(std::numeric_limits<float>::min()));
+        Vc::float_v result = Vc::exp(y * Vc::log(safeX));
+        result.setZero(x <= Vc::float_v::Zero());
+        return result;
+    }
+
+    static inline Vc::float_v removeSRGB(Vc::float_v::AsArg x)
+    {
+        const Vc::float_v linear = x * (1.f / 12.92f);
+        const Vc::float_v curved = powPositive((x + 0.055f) * (1.f / 1.055f), 2.4f);
+        return Vc::iif(x <= Vc::float_v(0.04045f), linear, curved);
+    }
+
+    static inline Vc::float_v applySRGB(Vc::float_v::AsArg x)
+    {
+        const Vc::float_v linear = x * 12.92f;
+        const Vc::float_v curved = 1.055f * powPositive(x, 1.f / 2.4f) - 0.055f;
+        return Vc::iif(x <= Vc::float_v(0.0031308f), linear, curved);
+    }
+
+    static inline Vc::float_v removePQ(Vc::float_v::AsArg x)
+    {
+        const float m1_r = 4096.0f * 4.0f / 2610.0f;
+        const float m2_r = 4096.0f / 2523.0f / 128.0f;
+        const float a1 = 3424.0f / 4096.0f;
+        const float c2 = 2413.0f / 4096.0f * 32.0f;
+        const float c3 = 2392.0f / 4096.0f * 32.0f;
+
+        const Vc::float_v x_p = powPositive(x, m2_r);
+        const Vc::float_v res = powPositive(Vc::max(Vc::float_v::Zero(), x_p - a1) / (c2 - c3 * x_p), m1_r);
+        return res * 125.0f;
+    }
+
+    static inline Vc::float_v applyPQ(Vc::float_v::AsArg x)
+    {
+        const float m1 = 2610.0f / 4096.0f / 4.0f;
+        const float m2 = 2523.0f / 4096.0f * 128.0f;
+        const float a1 = 3424.0f / 4096.0f;
+        const float c2 = 2413.0f / 4096.0f * 32.0f;
+        const float c3 = 2392.0f / 4096.0f * 32.0f;
+
+        const Vc::float_v x_p = powPositive(0.008f * x, m1);
+        return powPositive((a1 + c2 * x_p) / (1.0f + c3 * x_p), m2);
+    }
+
+    template<Vc::float_v (*func)(Vc::float_v::AsArg)>
+    static inline int processAligned(float *values, int numValues)
+    {
+        const int vectorSize = static_cast<int>(Vc::float_v::size());
+        const int numVectors = numValues / vectorSize;
+
+        for (int i = 0; i < numVectors; i++) {
+            Vc::float_v x(values, Vc::Aligned);
+            x = func(x);
+            x.store(values, Vc::Aligned);
+            values += vectorSize;
+        }
+
+        return numVectors * vectorSize;
+    }
+
+    /**
+     * \p values must be aligned to the vector size
+     */
+    static void removeCurve(KoOptimizedRgbShaperBase::TransferFunction transfer,
+                            float *values, int numValues)
+    {
+        int numProcessed = 0;
+
+        switch (transfer) {
+        case KoOptimizedRgbShaperBase::LinearTransfer:
+            return;
+        case KoOptimizedRgbShaperBase::SRGBTransfer:
+            numProcessed = processAligned<&removeSRGB>(values, numValues);
+            break;
+        case KoOptimizedRgbShaperBase::PQTransfer:
+            numProcessed = processAligned<&removePQ>(values, numValues);
+            break;
+        }
+
+        ScalarCurves::removeCurve(transfer, values + numProcessed, numValues - numProcessed);
+    }
+
+    static void applyCurve(KoOptimizedRgbShaperBase::TransferFunction transfer,
+                           float *values, int numValues)
+    {
+        int numProcessed = 0;
+
+        switch (transfer) {
+        case KoOptimizedRgbShaperBase::LinearTransfer:
+            return;
+        case KoOptimizedRgbShaperBase::SRGBTransfer:
+            numProcessed = processAligned<&applySRGB>(values, numValues);
+            break;
+        case KoOptimizedRgbShaperBase::PQTransfer:
+            numProcessed = processAligned<&applyPQ>(values, numValues);
+            break;
+        }
+
+        ScalarCurves::applyCurve(transfer, values + numProcessed, numValues - numProcessed);
+    }
+};
+
+#endif /* HAVE_VC */
+
+
+/**
+ * Converts the beginning of the block of half-float RGBA pixels
+ * from/into the planes with vector instructions and returns the
+ * number of processed pixels. The generic version is used for the
+ * scalar implementation and when Vc is not available, it processes
+ * nothing.
+ */
+template<Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KoOptimizedRgbShaperHalfKernel
+{
+    static int readBlock(const quint8 *, float *, float *, float *, float *, int)
+    {
+        return 0;
+    }
+
+    static int writeBlock(const float *, const float *, const float *, const float *, quint8 *, int)
+    {
+        return 0;
+    }
+};
+
+#ifdef HAVE_VC
+
+template<Vc::Implementation _impl>
+struct KoOptimizedRgbShaperHalfKernel<
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    using Conversion = KoOptimizedHalfConversion<_impl>;
+
+    static const int halfPixelSize = 4 * sizeof(quint16);
+
+    /**
+     * The planes must be aligned to the vector size
+     */
+    static int readBlock(const quint8 *src,
+                         float *red, float *green, float *blue, float *alpha,
+                         int numPixels)
+    {
+        const int laneCount = static_cast<int>(Vc::float_v::size());
+
+        int i = 0;
+        for (; i + laneCount <= numPixels; i += laneCount) {
+            Vc::float_v r, g, b, a;
+            Conversion::readPixels(src, r, g, b, a);
+
+            r.store(red + i, Vc::Aligned);
+            g.store(green + i, Vc::Aligned);
+            b.store(blue + i, Vc::Aligned);
+            a.store(alpha + i, Vc::Aligned);
+
+            src += laneCount * halfPixelSize;
+        }
+
+        return i;
+    }
+
+    static int writeBlock(const float *red, const float *green, const float *blue, const float *alpha,
+                          quint8 *dst, int numPixels)
+    {
+        const int laneCount = static_cast<int>(Vc::float_v::size());
+
+        int i = 0;
+        for (; i + laneCount <= numPixels; i += laneCount) {
+            const Vc::float_v r(red + i, Vc::Aligned);
+            const Vc::float_v g(green + i, Vc::Aligned);
+            const Vc::float_v b(blue + i, Vc::Aligned);
+            const Vc::float_v a(alpha + i, Vc::Aligned);
+
+            Conversion::writePixels(dst, r, g, b, a, Vc::Unaligned);
+
+            dst += laneCount * halfPixelSize;
+        }
+
+        return i;
+    }
+};
+
+#endif /* HAVE_VC */
+
+
+template<Vc::Implementation _impl>
+class KoOptimizedRgbShaper : public KoOptimizedRgbShaperBase
+{
+    static constexpr int blockSize = 256;
+
+    /**
+     * The pixels are converted in blocks, every channel
+     * is stored in a separate plane, so that the curves
+     * could be applied to a contiguous array of values
+     */
+    struct Block {
+        alignas(64) float red[blockSize];
+        alignas(64) float green[blockSize];
+        alignas(64) float blue[blockSize];
+        alignas(64) float alpha[blockSize];
+    };
+
+    using Curves = KoOptimizedRgbShaperCurves<_impl>;
+    using HalfKernel = KoOptimizedRgbShaperHalfKernel<_impl>;
+
+public:
+    KoOptimizedRgbShaper(const Parameters &params)
+        : m_params(params),
+          m_convertCurves(params.srcTransfer != params.dstTransfer),
+          m_useSrcLut(m_convertCurves &&
+                      params.srcValueType == KoChannelInfo::UINT8 &&
+                      params.srcTransfer != LinearTransfer)
+    {
+        if (m_useSrcLut) {
+            for (int i = 0; i < 256; i++) {
+                m_srcLut[i] = KoColorSpaceMaths<quint8, float>::scaleToA(quint8(i));
+            }
+            KoOptimizedRgbShaperScalarCurves<_impl>::removeCurve(params.srcTransfer, m_srcLut, 256);
+        }
+    }
+
+    void transform(const quint8 *src, quint8 *dst, int nPixels) const override
+    {
+        const int srcPixelSize = pixelSize(m_params.srcValueType);
+        const int dstPixelSize = pixelSize(m_params.dstValueType);
+
+        Block block;
+
+        while (nPixels > 0) {
+            const int numPixels = qMin(nPixels, int(blockSize));
+
+            switch (m_params.srcValueType) {
+            case KoChannelInfo::UINT8:
+                if (m_useSrcLut) {
+                    readBlockLut(src, block, numPixels);
+                } else {
+                    readBlock<quint8, true>(src, block, numPixels);
+                }
+                break;
+            case KoChannelInfo::UINT16:
+                readBlock<quint16, true>(src, block, numPixels);
+                break;
+            case KoChannelInfo::FLOAT32:
+                readBlock<float, false>(src, block, numPixels);
+                break;
+#ifdef HAVE_OPENEXR
+            case KoChannelInfo::FLOAT16:
+                readBlockHalf(src, block, numPixels);
+                break;
+#endif
+            default:
+                KIS_SAFE_ASSERT_RECOVER_RETURN(0 && "unsupported source depth");
+            }
+
+            if (m_convertCurves) {
+                if (!m_useSrcLut) {
+                    Curves::removeCurve(m_params.srcTransfer, block.red, numPixels);
+                    Curves::removeCurve(m_params.srcTransfer, block.green, numPixels);
+                    Curves::removeCurve(m_params.srcTransfer, block.blue, numPixels);
+                }
+
+                Curves::applyCurve(m_params.dstTransfer, block.red, numPixels);
+                Curves::applyCurve(m_params.dstTransfer, block.green, numPixels);
+                Curves::applyCurve(m_params.dstTransfer, block.blue, numPixels);
+            }
+
+            switch (m_params.dstValueType) {
+            case KoChannelInfo::UINT8:
+                writeBlock<quint8, true>(block, dst, numPixels);
+                break;
+            case KoChannelInfo::UINT16:
+                writeBlock<quint16, true>(block, dst, numPixels);
+                break;
+            case KoChannelInfo::FLOAT32:
+                writeBlock<float, false>(block, dst, numPixels);
+                break;
+#ifdef HAVE_OPENEXR
+            case KoChannelInfo::FLOAT16:
+                writeBlockHalf(block, dst, numPixels);
+                break;
+#endif
+            default:
+                KIS_SAFE_ASSERT_RECOVER_RETURN(0 && "unsupported destination depth");
+            }
+
+            src += numPixels * srcPixelSize;
+            dst += numPixels * dstPixelSize;
+            nPixels -= numPixels;
+        }
+    }
+
+private:
+    static int pixelSize(KoChannelInfo::enumChannelValueType valueType)
+    {
+        return valueType == KoChannelInfo::UINT8 ? 4 * sizeof(quint8) :
+               valueType == KoChannelInfo::UINT16 ? 4 * sizeof(quint16) :
+               valueType == KoChannelInfo::FLOAT16 ? 4 * sizeof(quint16) :
+               4 * sizeof(float);
+    }
+
+    /**
+     * Reads pixels [firstPixel, numPixels) of the block, \p src points
+     * to the beginning of the block
+     */
+    template<typename channels_type, bool isBgr>
+    static void readBlock(const quint8 *src, Block &block, int numPixels, int firstPixel = 0)
+    {
+        const channels_type *srcPtr = reinterpret_cast<const channels_type*>(src) + 4 * firstPixel;
+        const int redPos = isBgr ? 2 : 0;
+        const int bluePos = isBgr ? 0 : 2;
+
+        for (int i = firstPixel; i < numPixels; i++) {
+            block.red[i] = KoColorSpaceMaths<channels_type, float>::scaleToA(srcPtr[redPos]);
+            block.green[i] = KoColorSpaceMaths<channels_type, float>::scaleToA(srcPtr[1]);
+            block.blue[i] = KoColorSpaceMaths<channels_type, float>::scaleToA(srcPtr[bluePos]);
+            block.alpha[i] = KoColorSpaceMaths<channels_type, float>::scaleToA(srcPtr[3]);
+            srcPtr += 4;
+        }
+    }
+
+    void readBlockLut(const quint8 *src, Block &block, int numPixels) const
+    {
+        for (int i = 0; i < numPixels; i++) {
+            block.red[i] = m_srcLut[src[2]];
+            block.green[i] = m_srcLut[src[1]];
+            block.blue[i] = m_srcLut[src[0]];
+            block.alpha[i] = KoColorSpaceMaths<quint8, float>::scaleToA(src[3]);
+            src += 4;
+        }
+    }
+
+    template<typename channels_type, bool isBgr>
+    static void writeBlock(const Block &block, quint8 *dst, int numPixels, int firstPixel = 0)
+    {
+        channels_type *dstPtr = reinterpret_cast<channels_type*>(dst) + 4 * firstPixel;
+        const int redPos = isBgr ? 2 : 0;
+        const int bluePos = isBgr ? 0 : 2;
+
+        for (int i = firstPixel; i < numPixels; i++) {
+            dstPtr[redPos] = KoColorSpaceMaths<float, channels_type>::scaleToA(block.red[i]);
+            dstPtr[1] = KoColorSpaceMaths<float, channels_type>::scaleToA(block.green[i]);
+            dstPtr[bluePos] = KoColorSpaceMaths<float, channels_type>::scaleToA(block.blue[i]);
+            dstPtr[3] = KoColorSpaceMaths<float, channels_type>::scaleToA(block.alpha[i]);
+            dstPtr += 4;
+        }
+    }
+
+#ifdef HAVE_OPENEXR
+    static void readBlockHalf(const quint8 *src, Block &block, int numPixels)
+    {
+        const int numProcessed =
+            HalfKernel::readBlock(src, block.red, block.green, block.blue, block.alpha, numPixels);
+        readBlock<half, false>(src, block, numPixels, numProcessed);
+    }
+
+    static void writeBlockHalf(const Block &block, quint8 *dst, int numPixels)
+    {
+        const int numProcessed =
+            HalfKernel::writeBlock(block.red, block.green, block.blue, block.alpha, dst, numPixels);
+        writeBlock<half, false>(block, dst, numPixels, numProcessed);
+    }
+#endif
+
+private:
+    const Parameters m_params;
+    const bool m_convertCurves;
+    const bool m_useSrcLut;
+    float m_srcLut[256];
+};
+
+#endif // KOOPTIMIZEDRGBSHAPER_H
@@ -0,0 +1,67 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERBASE_H
+#define KOOPTIMIZEDRGBSHAPERBASE_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+#include "KoChannelInfo.h"
+
+/**
+ * @brief Converts RGBA pixels between two profiles that have the same
+ * primaries and differ only in the channel depth or the transfer curve
+ *
+ * Such conversions don't need a full ICC transform: the pixel is
+ * normalized, the source curve is removed, the destination curve is
+ * applied and the result is scaled to the destination depth. The curves
+ * are evaluated with vector instructions (or a lookup table for 8-bit
+ * sources), which is much faster than passing the data through lcms.
+ *
+ * The pixels are expected in the layout Krita uses for RGBA color
+ * spaces, that is, BGRA for integer depths and RGBA for floating point
+ * ones.
+ *
+ * The actual implementation is placed in class `KoOptimizedRgbShaper`.
+ * To create a shaper, call the factory. It will return a version
+ * optimized for your CPU architecture or null if the depths are not
+ * supported.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedRgbShaperBase> shaper(
+ *     KoOptimizedRgbShaperFactory::create(Integer8BitsColorDepthID,
+ *                                         KoOptimizedRgbShaperBase::SRGBTransfer,
+ *                                         Float32BitsColorDepthID,
+ *                                         KoOptimizedRgbShaperBase::LinearTransfer));
+ *
+ * shaper->transform(src, dst, numPixels);
+ * \endcode
+ *
+ * \see KoOptimizedRgbShaperFactory
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedRgbShaperBase
+{
+public:
+    enum TransferFunction {
+        LinearTransfer,
+        SRGBTransfer,
+        PQTransfer // SMPTE ST 2084, the linear value of 1.0 is 80 nits
+    };
+
+    struct Parameters {
+        KoChannelInfo::enumChannelValueType srcValueType;
+        TransferFunction srcTransfer;
+        KoChannelInfo::enumChannelValueType dstValueType;
+        TransferFunction dstTransfer;
+    };
+
+public:
+    virtual ~KoOptimizedRgbShaperBase();
+
+    virtual void transform(const quint8 *src, quint8 *dst, int nPixels) const = 0;
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERBASE_H
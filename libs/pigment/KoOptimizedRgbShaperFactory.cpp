@@ -0,0 +1,58 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbShaperFactory.h"
+
+#include "KoOptimizedRgbShaperFactoryImpl.h"
+#include "KoColorModelStandardIds.h"
+
+#include <KoConfig.h>
+
+namespace {
+bool valueTypeForDepth(const KoID &depthId, KoChannelInfo::enumChannelValueType *valueType)
+{
+    if (depthId == Integer8BitsColorDepthID) {
+        *valueType = KoChannelInfo::UINT8;
+    } else if (depthId == Integer16BitsColorDepthID) {
+        *valueType = KoChannelInfo::UINT16;
+    } else if (depthId == Float32BitsColorDepthID) {
+        *valueType = KoChannelInfo::FLOAT32;
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID) {
+        *valueType = KoChannelInfo::FLOAT16;
+#endif
+    } else {
+        return false;
+    }
+
+    return true;
+}
+}
+
+bool KoOptimizedRgbShaperFactory::isDepthSupported(const KoID &depthId)
+{
+    KoChannelInfo::enumChannelValueType valueType;
+    return valueTypeForDepth(depthId, &valueType);
+}
+
+KoOptimizedRgbShaperBase *KoOptimizedRgbShaperFactory::create(const KoID &srcDepthId,
+                                                              KoOptimizedRgbShaperBase::TransferFunction srcTransfer,
+                                                              const KoID &dstDepthId,
+                                                              KoOptimizedRgbShaperBase::TransferFunction dstTransfer)
+{
+    KoOptimizedRgbShaperBase::Parameters params;
+
+    if (!valueTypeForDepth(srcDepthId, &params.srcValueType) ||
+        !valueTypeForDepth(dstDepthId, &params.dstValueType)) {
+
+        return 0;
+    }
+
+    params.srcTransfer = srcTransfer;
+    params.dstTransfer = dstTransfer;
+
+    return createOptimizedClass<KoOptimizedRgbShaperFactoryImpl>(params);
+}
@@ -0,0 +1,38 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERFACTORY_H
+#define KOOPTIMIZEDRGBSHAPERFACTORY_H
+
+#include "KoOptimizedRgbShaperBase.h"
+
+class KoID;
+
+/**
+ * \see KoOptimizedRgbShaperBase
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedRgbShaperFactory
+{
+public:
+    /**
+     * Returns true if the shaper can read and write
+     * RGBA pixels of depth \p depthId
+     */
+    static bool isDepthSupported(const KoID &depthId);
+
+    /**
+     * Creates a shaper converting pixels of depth \p srcDepthId with
+     * transfer curve \p srcTransfer into pixels of depth \p dstDepthId
+     * with transfer curve \p dstTransfer. Returns null if either of the
+     * depths is not supported.
+     */
+    static KoOptimizedRgbShaperBase* create(const KoID &srcDepthId,
+                                            KoOptimizedRgbShaperBase::TransferFunction srcTransfer,
+                                            const KoID &dstDepthId,
+                                            KoOptimizedRgbShaperBase::TransferFunction dstTransfer);
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERFACTORY_H
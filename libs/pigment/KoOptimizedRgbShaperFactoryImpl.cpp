@@ -0,0 +1,17 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedRgbShaperFactoryImpl.h"
+
+#include "KoOptimizedRgbShaper.h"
+
+template<Vc::Implementation _impl>
+KoOptimizedRgbShaperBase *KoOptimizedRgbShaperFactoryImpl::create(ParamType params)
+{
+    return new KoOptimizedRgbShaper<_impl>(params);
+}
+
+template KoOptimizedRgbShaperBase *KoOptimizedRgbShaperFactoryImpl::create<Vc::CurrentImplementation::current()>(ParamType);
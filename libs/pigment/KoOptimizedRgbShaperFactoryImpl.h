@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOOPTIMIZEDRGBSHAPERFACTORYIMPL_H
+#define KOOPTIMIZEDRGBSHAPERFACTORYIMPL_H
+
+#include <KoOptimizedRgbShaperBase.h>
+#include <KoVcMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoOptimizedRgbShaperFactoryImpl
+{
+public:
+    typedef KoOptimizedRgbShaperBase::Parameters ParamType;
+    typedef KoOptimizedRgbShaperBase* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KoOptimizedRgbShaperBase* create(ParamType);
+};
+
+#endif // KOOPTIMIZEDRGBSHAPERFACTORYIMPL_H
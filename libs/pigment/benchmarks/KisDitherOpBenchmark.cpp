@@ -0,0 +1,185 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDitherOpBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QScopedPointer>
+
+#include <KoColorSpaceTraits.h>
+#include <KoColorModelStandardIds.h>
+#include "dithering/KisCmykDitherOpFactory.h"
+
+#define WIDTH 1024
+#define HEIGHT 1024
+
+Q_DECLARE_METATYPE(DitherType)
+
+namespace {
+
+template<class srcTraits, class dstTraits, template<typename, typename, DitherType> class Op>
+KisDitherOp *createOpForType(const KoID &srcDepth, const KoID &dstDepth, DitherType type)
+{
+    if (type == DITHER_BAYER) {
+        return new Op<srcTraits, dstTraits, DITHER_BAYER>(srcDepth, dstDepth);
+    } else {
+        return new Op<srcTraits, dstTraits, DITHER_BLUE_NOISE>(srcDepth, dstDepth);
+    }
+}
+
+template<class srcTraits, class U8Traits, class U16Traits, class F32Traits,
+         template<typename, typename, DitherType> class Op>
+KisDitherOp *createOpForDstDepth(const KoID &srcDepth, const KoID &dstDepth, DitherType type)
+{
+    if (dstDepth == Integer8BitsColorDepthID) {
+        return createOpForType<srcTraits, U8Traits, Op>(srcDepth, dstDepth, type);
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        return createOpForType<srcTraits, U16Traits, Op>(srcDepth, dstDepth, type);
+    } else {
+        return createOpForType<srcTraits, F32Traits, Op>(srcDepth, dstDepth, type);
+    }
+}
+
+template<class U8Traits, class U16Traits, class F32Traits,
+         template<typename, typename, DitherType> class Op>
+KisDitherOp *createOp(const KoID &srcDepth, const KoID &dstDepth, DitherType type)
+{
+    if (srcDepth == Integer8BitsColorDepthID) {
+        return createOpForDstDepth<U8Traits, U8Traits, U16Traits, F32Traits, Op>(srcDepth, dstDepth, type);
+    } else if (srcDepth == Integer16BitsColorDepthID) {
+        return createOpForDstDepth<U16Traits, U8Traits, U16Traits, F32Traits, Op>(srcDepth, dstDepth, type);
+    } else {
+        return createOpForDstDepth<F32Traits, U8Traits, U16Traits, F32Traits, Op>(srcDepth, dstDepth, type);
+    }
+}
+
+int channelSize(const KoID &depth)
+{
+    return depth == Integer8BitsColorDepthID ? 1 :
+           depth == Integer16BitsColorDepthID ? 2 :
+           4;
+}
+
+QVector<quint8> generateSource(const KoID &depth, int numChannels)
+{
+    const int numValues = WIDTH * HEIGHT * numChannels;
+    QVector<quint8> data(numValues * channelSize(depth));
+
+    if (depth == Float32BitsColorDepthID) {
+        float *ptr = reinterpret_cast<float*>(data.data());
+        for (int i = 0; i < numValues; i++) {
+            ptr[i] = float(i % 251) / 250.0f;
+        }
+    } else {
+        for (int i = 0; i < data.size(); i++) {
+            data[i] = quint8(i * 7 + 13);
+        }
+    }
+
+    return data;
+}
+
+}
+
+void KisDitherOpBenchmark::createRows()
+{
+    QTest::addColumn<QString>("srcDepthID");
+    QTest::addColumn<QString>("dstDepthID");
+    QTest::addColumn<DitherType>("type");
+
+    const QList<KoID> depths = {Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID};
+
+    Q_FOREACH (const KoID &srcDepth, depths) {
+        Q_FOREACH (const KoID &dstDepth, depths) {
+            const QString name = QString("%1-%2").arg(srcDepth.id()).arg(dstDepth.id());
+
+            QTest::newRow(QString("%1-bayer").arg(name).toLatin1())
+                << srcDepth.id() << dstDepth.id() << DITHER_BAYER;
+            QTest::newRow(QString("%1-blue-noise").arg(name).toLatin1())
+                << srcDepth.id() << dstDepth.id() << DITHER_BLUE_NOISE;
+        }
+    }
+}
+
+#define START_BENCHMARK(U8Traits, U16Traits, F32Traits, Op) \
+    QFETCH(QString, srcDepthID); \
+    QFETCH(QString, dstDepthID); \
+    QFETCH(DitherType, type); \
+    \
+    const KoID srcDepth(srcDepthID); \
+    const KoID dstDepth(dstDepthID); \
+    \
+    QScopedPointer<KisDitherOp> op(createOp<U8Traits, U16Traits, F32Traits, Op>(srcDepth, dstDepth, type)); \
+    \
+    const int numChannels = U8Traits::channels_nb; \
+    const int srcPixelSize = numChannels * channelSize(srcDepth); \
+    const int dstPixelSize = numChannels * channelSize(dstDepth); \
+    \
+    const QVector<quint8> src = generateSource(srcDepth, numChannels); \
+    QVector<quint8> dst(WIDTH * HEIGHT * dstPixelSize);
+
+void KisDitherOpBenchmark::benchmarkDitherRows_data()
+{
+    createRows();
+}
+
+void KisDitherOpBenchmark::benchmarkDitherRows()
+{
+    START_BENCHMARK(KoBgrU8Traits, KoBgrU16Traits, KoRgbF32Traits, KisDitherOpImpl)
+
+    QBENCHMARK {
+        // KisPaintDeviceFramesInterface converts tiles of 64x64 pixels
+        for (int y = 0; y < HEIGHT; y += 64) {
+            for (int x = 0; x < WIDTH; x += 64) {
+                const int offset = y * WIDTH + x;
+                op->dither(src.constData() + offset * srcPixelSize, WIDTH * srcPixelSize,
+                           dst.data() + offset * dstPixelSize, WIDTH * dstPixelSize,
+                           x, y, 64, 64);
+            }
+        }
+    }
+}
+
+void KisDitherOpBenchmark::benchmarkDitherPixels_data()
+{
+    createRows();
+}
+
+void KisDitherOpBenchmark::benchmarkDitherPixels()
+{
+    START_BENCHMARK(KoBgrU8Traits, KoBgrU16Traits, KoRgbF32Traits, KisDitherOpImpl)
+
+    QBENCHMARK {
+        // the per-pixel version is not vectorized, it is the baseline
+        for (int y = 0; y < HEIGHT; y++) {
+            for (int x = 0; x < WIDTH; x++) {
+                const int offset = y * WIDTH + x;
+                op->dither(src.constData() + offset * srcPixelSize,
+                           dst.data() + offset * dstPixelSize,
+                           x, y);
+            }
+        }
+    }
+}
+
+void KisDitherOpBenchmark::benchmarkDitherCmykRows_data()
+{
+    createRows();
+}
+
+void KisDitherOpBenchmark::benchmarkDitherCmykRows()
+{
+    START_BENCHMARK(KoCmykU8Traits, KoCmykU16Traits, KoCmykF32Traits, KisCmykDitherOpImpl)
+
+    QBENCHMARK {
+        op->dither(src.constData(), WIDTH * srcPixelSize,
+                   dst.data(), WIDTH * dstPixelSize,
+                   0, 0, WIDTH, HEIGHT);
+    }
+}
+
+QTEST_GUILESS_MAIN(KisDitherOpBenchmark)
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDITHEROPBENCHMARK_H
+#define KISDITHEROPBENCHMARK_H
+
+#include <QObject>
+
+class KisDitherOpBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    void createRows();
+private Q_SLOTS:
+    void benchmarkDitherRows_data();
+    void benchmarkDitherRows();
+    void benchmarkDitherPixels_data();
+    void benchmarkDitherPixels();
+    void benchmarkDitherCmykRows_data();
+    void benchmarkDitherCmykRows();
+};
+
+#endif // KISDITHEROPBENCHMARK_H
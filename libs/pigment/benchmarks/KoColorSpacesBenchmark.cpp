@@ -9,6 +9,7 @@
 #include <simpletest.h>
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
 
 #define NB_PIXELS 1000000
 
@@ -134,4 +135,41 @@ void KoColorSpacesBenchmark::benchmarkSetAlpha2IndividualCall()
     END_BENCHMARK
 }
 
+void KoColorSpacesBenchmark::benchmarkLinearToSRGBConversion_data()
+{
+    QTest::addColumn<QString>("depthID");
+
+    QTest::newRow("F32") << Float32BitsColorDepthID.id();
+    QTest::newRow("F16") << Float16BitsColorDepthID.id();
+}
+
+void KoColorSpacesBenchmark::benchmarkLinearToSRGBConversion()
+{
+    QFETCH(QString, depthID);
+
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthID, "sRGB-elle-V2-g10.icc");
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthID, "sRGB-elle-V2-srgbtrc.icc");
+
+    if (!srcCS || !dstCS) {
+        QSKIP("The color spaces are not available");
+    }
+
+    QVector<float> channels(4, 0.5f);
+    QByteArray src(NB_PIXELS * srcCS->pixelSize(), 0);
+    QByteArray dst(NB_PIXELS * dstCS->pixelSize(), 0);
+
+    for (int i = 0; i < NB_PIXELS; ++i) {
+        channels[0] = float(i % 1024) / 1023.0f;
+        srcCS->fromNormalisedChannelsValue(reinterpret_cast<quint8*>(src.data()) + i * srcCS->pixelSize(), channels);
+    }
+
+    QBENCHMARK {
+        srcCS->convertPixelsTo(reinterpret_cast<const quint8*>(src.constData()),
+                               reinterpret_cast<quint8*>(dst.data()),
+                               dstCS, NB_PIXELS,
+                               KoColorConversionTransformation::internalRenderingIntent(),
+                               KoColorConversionTransformation::internalConversionFlags());
+    }
+}
+
 SIMPLE_TEST_MAIN(KoColorSpacesBenchmark)
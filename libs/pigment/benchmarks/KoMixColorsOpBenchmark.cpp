@@ -0,0 +1,126 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoMixColorsOpBenchmark.h"
+
+#include <simpletest.h>
+
+#include <QBitArray>
+#include <QScopedPointer>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoColorSpace.h>
+#include <KoColorModelStandardIds.h>
+#include <KoMixColorsOp.h>
+#include <KoConvolutionOp.h>
+
+#define NB_PIXELS 1000000
+#define KERNEL_SIZE 25
+
+void KoMixColorsOpBenchmark::createRows()
+{
+    QTest::addColumn<QString>("depthID");
+
+    QTest::newRow("rgb8") << Integer8BitsColorDepthID.id();
+    QTest::newRow("rgb16") << Integer16BitsColorDepthID.id();
+    QTest::newRow("rgbf32") << Float32BitsColorDepthID.id();
+}
+
+#define START_BENCHMARK \
+    QFETCH(QString, depthID); \
+    \
+    const KoColorSpace* colorSpace = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthID, 0); \
+    QVERIFY(colorSpace); \
+    const int pixelSize = colorSpace->pixelSize(); \
+    QVector<quint8> data(NB_PIXELS * pixelSize); \
+    for (int i = 0; i < data.size(); i++) { \
+        data[i] = quint8(i * 7 + 13); \
+    } \
+    if (colorSpace->colorDepthId() == Float32BitsColorDepthID) { \
+        float *ptr = reinterpret_cast<float*>(data.data()); \
+        for (int i = 0; i < NB_PIXELS * 4; i++) { \
+            ptr[i] = float(i % 251) / 250.0f; \
+        } \
+    }
+
+void KoMixColorsOpBenchmark::benchmarkMixColorsWeighted_data()
+{
+    createRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixColorsWeighted()
+{
+    START_BENCHMARK
+
+    QVector<qint16> weights(NB_PIXELS);
+    for (int i = 0; i < NB_PIXELS; i++) {
+        weights[i] = i % 256;
+    }
+
+    QVector<quint8> result(pixelSize);
+
+    QBENCHMARK {
+        colorSpace->mixColorsOp()->mixColors(data.constData(), weights.constData(), NB_PIXELS, result.data(), 128 * NB_PIXELS);
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixerAccumulateAverage_data()
+{
+    createRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixerAccumulateAverage()
+{
+    START_BENCHMARK
+
+    QVector<quint8> result(pixelSize);
+
+    QBENCHMARK {
+        QScopedPointer<KoMixColorsOp::Mixer> mixer(colorSpace->mixColorsOp()->createMixer());
+
+        // smudge-like usage: a 1000x1000 dab is accumulated row-by-row
+        for (int row = 0; row < 1000; row++) {
+            mixer->accumulateAverage(data.constData() + row * 1000 * pixelSize, 1000);
+        }
+        mixer->computeMixedColor(result.data());
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkConvolution_data()
+{
+    createRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkConvolution()
+{
+    START_BENCHMARK
+
+    QVector<qreal> kernel(KERNEL_SIZE);
+    qreal kernelSum = 0;
+    for (int i = 0; i < KERNEL_SIZE; i++) {
+        kernel[i] = 1 + i % 3;
+        kernelSum += kernel[i];
+    }
+
+    QVector<const quint8*> pointers(KERNEL_SIZE);
+    QVector<quint8> result(pixelSize);
+    const QBitArray channelFlags;
+
+    QBENCHMARK {
+        // one convolution per output pixel, like KisConvolutionWorkerSpatial does
+        for (int i = 0; i + KERNEL_SIZE <= NB_PIXELS; i += KERNEL_SIZE) {
+            for (int j = 0; j < KERNEL_SIZE; j++) {
+                pointers[j] = data.constData() + (i + j) * pixelSize;
+            }
+
+            colorSpace->convolutionOp()->convolveColors(pointers.constData(), kernel.constData(),
+                                                        result.data(), kernelSum, 0,
+                                                        KERNEL_SIZE, channelFlags);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(KoMixColorsOpBenchmark)
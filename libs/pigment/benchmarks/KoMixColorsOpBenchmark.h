@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOMIXCOLORSOPBENCHMARK_H
+#define KOMIXCOLORSOPBENCHMARK_H
+
+#include <QObject>
+
+class KoMixColorsOpBenchmark : public QObject
+{
+    Q_OBJECT
+private:
+    void createRows();
+private Q_SLOTS:
+    void benchmarkMixColorsWeighted_data();
+    void benchmarkMixColorsWeighted();
+    void benchmarkMixerAccumulateAverage_data();
+    void benchmarkMixerAccumulateAverage();
+    void benchmarkConvolution_data();
+    void benchmarkConvolution();
+};
+
+#endif // KOMIXCOLORSOPBENCHMARK_H
@@ -26,6 +26,11 @@
  *
  * @param _compositeOp this class should define a function with the
  *        following signature: inline static void composeColorChannels
+ *
+ *        If an opaque source pixel painted with unit mask and opacity
+ *        just replaces the destination pixel, the class may redefine
+ *        opaqueSourceIsCopy to let the base class copy such spans
+ *        without blending.
  */
 template<class _CSTraits, class _compositeOp, bool _alphaLocked>
 class KoCompositeOpAlphaBase : public KoCompositeOp
@@ -37,6 +42,8 @@ public:
             : KoCompositeOp(cs, id, category) {
     }
 
+    static const bool opaqueSourceIsCopy = false;
+
 public:
     using KoCompositeOp::composite;
 
@@ -56,6 +63,10 @@ public:
 
         channels_type opacity = KoColorSpaceMaths<quint8, channels_type>::scaleToA(U8_opacity);
 
+        const bool copyOpaqueSpans =
+            _compositeOp::opaqueSourceIsCopy && !alphaLocked && !_alphaLocked && allChannelFlags &&
+            _CSTraits::alpha_pos != -1 && srcInc != 0 && opacity == NATIVE_OPACITY_OPAQUE;
+
         while (rows > 0) {
             const channels_type *srcN = reinterpret_cast<const channels_type *>(srcRowStart);
             channels_type *dstN = reinterpret_cast<channels_type *>(dstRowStart);
@@ -65,6 +76,34 @@ public:
 
             while (columns > 0) {
 
+                qint32 spanLength = 0;
+
+                if (mask != 0 && *mask == 0) {
+                    // the pixels under zero mask are never changed
+                    spanLength = countEqualBytes(mask, columns, 0);
+
+                } else if (copyOpaqueSpans) {
+                    while (spanLength < columns &&
+                           srcN[spanLength * _CSTraits::channels_nb + _CSTraits::alpha_pos] == NATIVE_OPACITY_OPAQUE &&
+                           (mask == 0 || mask[spanLength] == OPACITY_OPAQUE_U8)) {
+
+                        spanLength++;
+                    }
+
+                    memcpy(dstN, srcN, spanLength * _CSTraits::pixelSize);
+                }
+
+                if (spanLength > 0) {
+                    columns -= spanLength;
+                    srcN += srcInc * spanLength;
+                    dstN += _CSTraits::channels_nb * spanLength;
+
+                    if (mask != 0) {
+                        mask += spanLength;
+                    }
+                    continue;
+                }
+
                 channels_type srcAlpha = _CSTraits::alpha_pos == -1 ? NATIVE_OPACITY_OPAQUE : _compositeOp::selectAlpha(srcN[_CSTraits::alpha_pos], dstN[_CSTraits::alpha_pos]);
 
                 // apply the alphamask
@@ -27,6 +27,17 @@
  *        )
  *
  *        where channels_type is _CSTraits::channels_type
+ *
+ *        The composite op may also redefine the following flags to let
+ *        the base class skip or copy spans of pixels without calling
+ *        composeColorChannels() for each of them:
+ *
+ *        zeroMaskIsNoOp           the pixels with zero mask or opacity
+ *                                 are left untouched
+ *        zeroAppliedAlphaIsNoOp   the pixels with zero source alpha, mask
+ *                                 or opacity are left untouched
+ *        unitOpacityIsCopy        the pixels with unit mask and opacity
+ *                                 become copies of the source pixels
  */
 template<class _CSTraits, class _compositeOp>
 class KoCompositeOpBase : public KoCompositeOp
@@ -40,6 +51,10 @@ public:
     KoCompositeOpBase(const KoColorSpace* cs, const QString& id, const QString& category)
         : KoCompositeOp(cs, id, category) { }
 
+    static const bool zeroMaskIsNoOp = false;
+    static const bool zeroAppliedAlphaIsNoOp = false;
+    static const bool unitOpacityIsCopy = false;
+
     using KoCompositeOp::composite;
 
     void composite(const KoCompositeOp::ParameterInfo& params) const override {
@@ -49,6 +64,13 @@ public:
         bool             alphaLocked     = (alpha_pos != -1) && !flags.testBit(alpha_pos);
         bool             useMask         = params.maskRowStart != 0;
 
+        if (allChannelFlags &&
+            (_compositeOp::zeroMaskIsNoOp || _compositeOp::zeroAppliedAlphaIsNoOp) &&
+            Arithmetic::scale<channels_type>(params.opacity) == Arithmetic::zeroValue<channels_type>()) {
+
+            return;
+        }
+
         if(useMask) {
             if(alphaLocked) {
                 if(allChannelFlags) { genericComposite<true,true,true> (params, flags); }
@@ -83,12 +105,55 @@ private:
         const quint8* srcRowStart  = params.srcRowStart;
         const quint8* maskRowStart = params.maskRowStart;
 
+        /**
+         * The spans are classified only when all the channels are
+         * processed, otherwise the color of the transparent destination
+         * pixels is reset even when the pixel is not changed.
+         */
+        const bool skipZeroMask =
+            useMask && allChannelFlags &&
+            (_compositeOp::zeroMaskIsNoOp || _compositeOp::zeroAppliedAlphaIsNoOp);
+
+        const bool skipTransparentSource =
+            allChannelFlags && alpha_pos != -1 &&
+            _compositeOp::zeroAppliedAlphaIsNoOp;
+
+        const bool copyOpaqueSpans =
+            !alphaLocked && allChannelFlags && srcInc != 0 &&
+            _compositeOp::unitOpacityIsCopy &&
+            opacity == unitValue<channels_type>();
+
         for (qint32 r=0; r<params.rows; ++r) {
             const channels_type* src  = reinterpret_cast<const channels_type*>(srcRowStart);
             channels_type*       dst  = reinterpret_cast<channels_type*>(dstRowStart);
             const quint8*        mask = maskRowStart;
 
-            for (qint32 c=0; c<params.cols; ++c) {
+            for (qint32 c=0; c<params.cols; ) {
+                const qint32 remaining = params.cols - c;
+                qint32 spanLength = 0;
+
+                if (skipZeroMask && *mask == 0) {
+                    spanLength = countEqualBytes(mask, remaining, 0);
+
+                } else if (skipTransparentSource && src[alpha_pos] == zeroValue<channels_type>()) {
+                    spanLength = srcInc ? countTransparentPixels(src, remaining) : remaining;
+
+                } else if (copyOpaqueSpans && (!useMask || *mask == 0xFF)) {
+                    spanLength = useMask ? countEqualBytes(mask, remaining, 0xFF) : remaining;
+                    memcpy(dst, src, spanLength * pixel_size);
+                }
+
+                if (spanLength > 0) {
+                    src += srcInc * spanLength;
+                    dst += channels_nb * spanLength;
+
+                    if(useMask)
+                        mask += spanLength;
+
+                    c += spanLength;
+                    continue;
+                }
+
                 channels_type srcAlpha = (alpha_pos == -1) ? unitValue<channels_type>() : src[alpha_pos];
                 channels_type dstAlpha = (alpha_pos == -1) ? unitValue<channels_type>() : dst[alpha_pos];
                 channels_type mskAlpha = useMask ? scale<channels_type>(*mask) : unitValue<channels_type>();
@@ -109,6 +174,8 @@ private:
 
                 if(useMask)
                     ++mask;
+
+                ++c;
             }
 
             srcRowStart  += params.srcRowStride;
@@ -116,6 +183,17 @@ private:
             maskRowStart += params.maskRowStride;
         }
     }
+
+    static qint32 countTransparentPixels(const channels_type *src, qint32 size) {
+        qint32 count = 0;
+
+        while (count < size && src[alpha_pos] == Arithmetic::zeroValue<channels_type>()) {
+            src += channels_nb;
+            count++;
+        }
+
+        return count;
+    }
 };
 
 #endif // KOCOMPOSITEOP_BASE_H_
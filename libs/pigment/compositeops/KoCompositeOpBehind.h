@@ -25,6 +25,8 @@ public:
     KoCompositeOpBehind(const KoColorSpace * cs)
         : base_class(cs, COMPOSITE_BEHIND, KoCompositeOp::categoryMix()) { }
 
+    static const bool zeroAppliedAlphaIsNoOp = true;
+
 public:
     template<bool alphaLocked, bool allChannelFlags>
     inline static channels_type composeColorChannels(const channels_type* src, channels_type srcAlpha,
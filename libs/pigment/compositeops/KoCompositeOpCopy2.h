@@ -31,6 +31,9 @@ public:
     KoCompositeOpCopy2(const KoColorSpace* cs)
         : base_class(cs, COMPOSITE_COPY, KoCompositeOp::categoryMisc()) { }
 
+    static const bool zeroMaskIsNoOp = true;
+    static const bool unitOpacityIsCopy = true;
+
 public:
     template<bool alphaLocked, bool allChannelFlags>
     inline static channels_type composeColorChannels(const channels_type* src, channels_type srcAlpha,
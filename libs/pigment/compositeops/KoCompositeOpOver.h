@@ -49,6 +49,8 @@ public:
             : KoCompositeOpAlphaBase<_CSTraits, KoCompositeOpOver<_CSTraits>, false >(cs, COMPOSITE_OVER, KoCompositeOp::categoryMix()) {
     }
 
+    static const bool opaqueSourceIsCopy = true;
+
 public:
     inline static channels_type selectAlpha(channels_type srcAlpha, channels_type dstAlpha) {
         Q_UNUSED(dstAlpha);
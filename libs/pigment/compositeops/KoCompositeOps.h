@@ -122,6 +122,52 @@ struct OptimizedOpsSelector<KoBgrU16Traits>
     }
 };
 
+#ifdef HAVE_OPENEXR
+/**
+ * The optimized ops handle four-channel pixels only, so Gray F16,
+ * like the other gray colorspaces, keeps the generic ops
+ */
+template<>
+struct OptimizedOpsSelector<KoRgbF16Traits>
+{
+    static KoCompositeOp* createAlphaDarkenOp(const KoColorSpace *cs) {
+        return useCreamyAlphaDarken() ?
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs) :
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(cs);
+
+    }
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    }
+};
+#endif
+
+/**
+ * Some of the blending modes have vectorized versions for the
+ * 8-bit RGBA colorspaces, they replace the generic ones on
+ * registration
+ */
+template<class Traits>
+struct OptimizedBlendOpsSelector
+{
+    static KoCompositeOp* createBlendOp(const KoColorSpace *cs, const QString &id) {
+        Q_UNUSED(cs);
+        Q_UNUSED(id);
+        return 0;
+    }
+};
+
+template<>
+struct OptimizedBlendOpsSelector<KoBgrU8Traits>
+{
+    static KoCompositeOp* createBlendOp(const KoColorSpace *cs, const QString &id) {
+        return KoOptimizedCompositeOpFactory::createBlendOp32(cs, id);
+    }
+};
+
 
 template<class Traits>
 struct AddGeneralOps<Traits, true>
@@ -132,7 +178,8 @@ struct AddGeneralOps<Traits, true>
 
      template<CompositeFunc func>
      static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-         cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func>(cs, id, category));
+         KoCompositeOp *op = OptimizedBlendOpsSelector<Traits>::createBlendOp(cs, id);
+         cs->addCompositeOp(op ? op : new KoCompositeOpGenericSC<Traits, func>(cs, id, category));
      }
 
      static void add(KoColorSpace* cs) {
@@ -255,7 +302,8 @@ struct AddRGBOps<Traits, true>
     template<void compositeFunc(Arg, Arg, Arg, Arg&, Arg&, Arg&)>
 
     static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-        cs->addCompositeOp(new KoCompositeOpGenericHSL<Traits, compositeFunc>(cs, id, category));
+        KoCompositeOp *op = OptimizedBlendOpsSelector<Traits>::createBlendOp(cs, id);
+        cs->addCompositeOp(op ? op : new KoCompositeOpGenericHSL<Traits, compositeFunc>(cs, id, category));
     }
 
     static void add(KoColorSpace* cs) {
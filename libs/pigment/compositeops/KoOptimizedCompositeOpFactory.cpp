@@ -7,6 +7,8 @@
 #include "KoOptimizedCompositeOpFactoryPerArch.h" // vc.h must come first
 #include "KoOptimizedCompositeOpFactory.h"
 
+#include <KoCompositeOpRegistry.h>
+
 #if defined(__clang__)
 #pragma GCC diagnostic ignored "-Wundef"
 #endif
@@ -83,3 +85,70 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+#ifdef HAVE_OPENEXR
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createOverOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenHardF16>>(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenCreamyF16>>(cs);
+}
+
+#endif
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createBlendOp32(const KoColorSpace *cs, const QString &id)
+{
+    KoCompositeOp *op = 0;
+
+    if (id == COMPOSITE_MULT) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32> >(cs);
+    } else if (id == COMPOSITE_SCREEN) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32> >(cs);
+    } else if (id == COMPOSITE_OVERLAY) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32> >(cs);
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32> >(cs);
+    } else if (id == COMPOSITE_DODGE) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32> >(cs);
+    } else if (id == COMPOSITE_BURN) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32> >(cs);
+    } else if (id == COMPOSITE_ADD) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdd32> >(cs);
+    } else if (id == COMPOSITE_LINEAR_DODGE) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32> >(cs);
+    } else if (id == COMPOSITE_SUBTRACT) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32> >(cs);
+    } else if (id == COMPOSITE_DARKEN) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpDarken32> >(cs);
+    } else if (id == COMPOSITE_LIGHTEN) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLighten32> >(cs);
+    } else if (id == COMPOSITE_COLOR) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColor32> >(cs);
+    } else if (id == COMPOSITE_HUE) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpHue32> >(cs);
+    } else if (id == COMPOSITE_SATURATION) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSaturation32> >(cs);
+    } else if (id == COMPOSITE_LUMINIZE) {
+        op = createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLuminize32> >(cs);
+    }
+
+    return op;
+}
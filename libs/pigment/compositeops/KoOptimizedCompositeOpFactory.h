@@ -8,9 +8,11 @@
 #define KOOPTIMIZEDCOMPOSITEOPFACTORY_H
 
 #include "kritapigment_export.h"
+#include <KoConfig.h>
 
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
 
 /**
  * The creation of the optimized composite ops is moved into a separate
@@ -39,6 +41,24 @@ public:
     static KoCompositeOp* createCopyOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpHardU64(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpCreamyU64(const KoColorSpace *cs);
+
+#ifdef HAVE_OPENEXR
+    /**
+     * Versions for RGBA half-float colorspaces, the pixels are
+     * converted into floats and back with vector instructions
+     */
+    static KoCompositeOp* createOverOpF16(const KoColorSpace *cs);
+    static KoCompositeOp* createCopyOpF16(const KoColorSpace *cs);
+    static KoCompositeOp* createAlphaDarkenOpHardF16(const KoColorSpace *cs);
+    static KoCompositeOp* createAlphaDarkenOpCreamyF16(const KoColorSpace *cs);
+#endif
+
+    /**
+     * Creates an optimized version of a separable or HSY blending
+     * mode \p id for BGRA 8-bit colorspaces. Returns null if there
+     * is no optimized version of the mode.
+     */
+    static KoCompositeOp* createBlendOp32(const KoColorSpace *cs, const QString &id);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
@@ -14,6 +14,7 @@
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
 #include "KoOptimizedCompositeOpCopy128.h"
+#include "KoOptimizedCompositeOpGeneric32.h"
 
 #include <QString>
 #include "DebugPigment.h"
@@ -121,3 +122,159 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
 {
     return new KoOptimizedCompositeOpAlphaDarkenCreamyU64<Vc::CurrentImplementation::current()>(param);
 }
+
+#ifdef HAVE_OPENEXR
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpOverF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpCopyF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenHardF16<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenCreamyF16<Vc::CurrentImplementation::current()>(param);
+}
+
+#endif
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpMultiply32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpScreen32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpOverlay32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpSoftLight32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpColorDodge32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpColorBurn32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdd32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdd32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAdd32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpLinearDodge32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpSubtract32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpDarken32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpDarken32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpDarken32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLighten32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLighten32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpLighten32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColor32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColor32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpColor32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpHue32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpHue32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpHue32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSaturation32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSaturation32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpSaturation32<Vc::CurrentImplementation::current()>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLuminize32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLuminize32>::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return new KoOptimizedCompositeOpLuminize32<Vc::CurrentImplementation::current()>(param);
+}
@@ -51,6 +51,63 @@ class KoOptimizedCompositeOpCopyU64;
 template<Vc::Implementation _impl>
 class KoOptimizedCompositeOpCopy32;
 
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpOverF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpCopyF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenHardF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAlphaDarkenCreamyF16;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpMultiply32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpScreen32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpOverlay32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSoftLight32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColorDodge32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColorBurn32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAdd32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLinearDodge32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSubtract32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpDarken32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLighten32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColor32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpHue32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSaturation32;
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLuminize32;
+
 template<template<Vc::Implementation I> class CompositeOp>
 struct KoOptimizedCompositeOpFactoryPerArch
 {
@@ -11,6 +11,8 @@
 #include "KoAlphaDarkenParamsWrapper.h"
 #include "KoCompositeOpOver.h"
 #include "KoCompositeOpCopy2.h"
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpRegistry.h"
 
 template<>
 template<>
@@ -109,3 +111,158 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+#ifdef HAVE_OPENEXR
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpOver<KoRgbF16Traits>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpCopy2<KoRgbF16Traits>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperHard>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
+}
+
+#endif
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfMultiply<quint8> >(param, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfScreen<quint8> >(param, COMPOSITE_SCREEN, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfOverlay<quint8> >(param, COMPOSITE_OVERLAY, KoCompositeOp::categoryMix());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfSoftLight<quint8> >(param, COMPOSITE_SOFT_LIGHT_PHOTOSHOP, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfColorDodge<quint8> >(param, COMPOSITE_DODGE, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfColorBurn<quint8> >(param, COMPOSITE_BURN, KoCompositeOp::categoryDark());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdd32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdd32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfAddition<quint8> >(param, COMPOSITE_ADD, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfAddition<quint8> >(param, COMPOSITE_LINEAR_DODGE, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfSubtract<quint8> >(param, COMPOSITE_SUBTRACT, KoCompositeOp::categoryArithmetic());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpDarken32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpDarken32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfDarkenOnly<quint8> >(param, COMPOSITE_DARKEN, KoCompositeOp::categoryDark());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLighten32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLighten32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericSC<KoBgrU8Traits, &cfLightenOnly<quint8> >(param, COMPOSITE_LIGHTEN, KoCompositeOp::categoryLight());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColor32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColor32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfColor<HSYType, float> >(param, COMPOSITE_COLOR, KoCompositeOp::categoryHSY());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpHue32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpHue32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfHue<HSYType, float> >(param, COMPOSITE_HUE, KoCompositeOp::categoryHSY());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSaturation32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSaturation32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfSaturation<HSYType, float> >(param, COMPOSITE_SATURATION, KoCompositeOp::categoryHSY());
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLuminize32>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLuminize32>::create<Vc::ScalarImpl>(ParamType param)
+{
+    return new KoCompositeOpGenericHSL<KoBgrU8Traits, &cfLightness<HSYType, float> >(param, COMPOSITE_LUMINIZE, KoCompositeOp::categoryHSY());
+}
@@ -0,0 +1,662 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERIC32_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERIC32_H
+
+#include "KoCompositeOpBase.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoColorSpaceTraits.h"
+#include "KoStreamedMath.h"
+#include "KoOptimizedCompositeOpOver32.h"
+
+#include <cmath>
+#include <algorithm>
+
+
+/**
+ * Overloads of the math functions for plain floats and float vectors,
+ * so that every blending function is written only once and can be used
+ * both in the vector and in the per-pixel code.
+ *
+ * Everything is templated by \p _impl, otherwise the linker may merge
+ * the functions compiled for different architectures.
+ */
+template<Vc::Implementation _impl>
+struct KoBlendMath
+{
+    static ALWAYS_INLINE float min(float a, float b) {
+        return std::min(a, b);
+    }
+
+    static ALWAYS_INLINE float max(float a, float b) {
+        return std::max(a, b);
+    }
+
+    static ALWAYS_INLINE float sqrt(float a) {
+        return std::sqrt(a);
+    }
+
+    static ALWAYS_INLINE float select(bool mask, float a, float b) {
+        return mask ? a : b;
+    }
+
+    static ALWAYS_INLINE Vc::float_v min(Vc::float_v::AsArg a, Vc::float_v::AsArg b) {
+        return Vc::min(a, b);
+    }
+
+    static ALWAYS_INLINE Vc::float_v max(Vc::float_v::AsArg a, Vc::float_v::AsArg b) {
+        return Vc::max(a, b);
+    }
+
+    static ALWAYS_INLINE Vc::float_v sqrt(Vc::float_v::AsArg a) {
+        return Vc::sqrt(a);
+    }
+
+    static ALWAYS_INLINE Vc::float_v select(const Vc::float_m &mask, Vc::float_v::AsArg a, Vc::float_v::AsArg b) {
+        return Vc::iif(mask, a, b);
+    }
+};
+
+/**
+ * Base class for the separable blending functions. \p Func should
+ * define a static function blend<_impl>(src, dst) that takes
+ * and returns the channel values normalized to [0...1]
+ */
+template<class Func>
+struct KoSeparableBlendFunc
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE void apply(const T &sr, const T &sg, const T &sb, T &dr, T &dg, T &db) {
+        dr = Func::template blend<_impl>(sr, dr);
+        dg = Func::template blend<_impl>(sg, dg);
+        db = Func::template blend<_impl>(sb, db);
+    }
+};
+
+/**
+ * The vector versions of the blending functions from KoCompositeOpFunctions.h
+ */
+
+struct KoBlendFuncMultiply : public KoSeparableBlendFunc<KoBlendFuncMultiply>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return src * dst;
+    }
+};
+
+struct KoBlendFuncScreen : public KoSeparableBlendFunc<KoBlendFuncScreen>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return src + dst - src * dst;
+    }
+};
+
+struct KoBlendFuncHardLight : public KoSeparableBlendFunc<KoBlendFuncHardLight>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        typedef KoBlendMath<_impl> M;
+
+        const T src2 = src + src;
+        const T screenSrc = src2 - T(1.0f);
+
+        return M::select(src > T(0.5f),
+                         screenSrc + dst - screenSrc * dst,
+                         src2 * dst);
+    }
+};
+
+struct KoBlendFuncOverlay : public KoSeparableBlendFunc<KoBlendFuncOverlay>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return KoBlendFuncHardLight::blend<_impl>(dst, src);
+    }
+};
+
+struct KoBlendFuncSoftLight : public KoSeparableBlendFunc<KoBlendFuncSoftLight>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        typedef KoBlendMath<_impl> M;
+
+        const T src2 = src + src;
+
+        return M::select(src > T(0.5f),
+                         dst + (src2 - T(1.0f)) * (M::sqrt(dst) - dst),
+                         dst - (T(1.0f) - src2) * dst * (T(1.0f) - dst));
+    }
+};
+
+struct KoBlendFuncColorDodge : public KoSeparableBlendFunc<KoBlendFuncColorDodge>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        typedef KoBlendMath<_impl> M;
+
+        /**
+         * When src is unit the division gives inf or NaN, these
+         * values are replaced by the special case value right away
+         */
+        return M::select(src >= T(1.0f),
+                         M::select(dst == T(0.0f), T(0.0f), T(1.0f)),
+                         M::min(dst / (T(1.0f) - src), T(1.0f)));
+    }
+};
+
+struct KoBlendFuncColorBurn : public KoSeparableBlendFunc<KoBlendFuncColorBurn>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        typedef KoBlendMath<_impl> M;
+
+        // \see KoBlendFuncColorDodge
+        return M::select(src == T(0.0f),
+                         M::select(dst >= T(1.0f), T(1.0f), T(0.0f)),
+                         T(1.0f) - M::min((T(1.0f) - dst) / src, T(1.0f)));
+    }
+};
+
+struct KoBlendFuncAddition : public KoSeparableBlendFunc<KoBlendFuncAddition>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return KoBlendMath<_impl>::min(src + dst, T(1.0f));
+    }
+};
+
+struct KoBlendFuncSubtract : public KoSeparableBlendFunc<KoBlendFuncSubtract>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return KoBlendMath<_impl>::max(dst - src, T(0.0f));
+    }
+};
+
+struct KoBlendFuncDarkenOnly : public KoSeparableBlendFunc<KoBlendFuncDarkenOnly>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return KoBlendMath<_impl>::min(src, dst);
+    }
+};
+
+struct KoBlendFuncLightenOnly : public KoSeparableBlendFunc<KoBlendFuncLightenOnly>
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE T blend(const T &src, const T &dst) {
+        return KoBlendMath<_impl>::max(src, dst);
+    }
+};
+
+/**
+ * The vector versions of the HSY helpers from KoColorSpaceMaths.h
+ *
+ * setSaturation() doesn't sort the channels, the same result
+ * is achieved by scaling all the channels relative to the minimum
+ * one, which is branchless.
+ */
+template<Vc::Implementation _impl>
+struct KoHSYBlendMath
+{
+    typedef KoBlendMath<_impl> M;
+
+    template<typename T>
+    static ALWAYS_INLINE T getLightness(const T &r, const T &g, const T &b) {
+        return T(0.299f) * r + T(0.587f) * g + T(0.114f) * b;
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE T getSaturation(const T &r, const T &g, const T &b) {
+        return M::max(M::max(r, g), b) - M::min(M::min(r, g), b);
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE void addLightness(T &r, T &g, T &b, const T &light) {
+        r += light;
+        g += light;
+        b += light;
+
+        const T l = getLightness(r, g, b);
+        const T n = M::min(M::min(r, g), b);
+        const T x = M::max(M::max(r, g), b);
+
+        {
+            const auto clipMin = n < T(0.0f);
+            const T iln = T(1.0f) / (l - n);
+
+            r = M::select(clipMin, l + ((r - l) * l) * iln, r);
+            g = M::select(clipMin, l + ((g - l) * l) * iln, g);
+            b = M::select(clipMin, l + ((b - l) * l) * iln, b);
+        }
+
+        {
+            const auto clipMax = (x > T(1.0f)) && ((x - l) > T(std::numeric_limits<float>::epsilon()));
+            const T il = T(1.0f) - l;
+            const T ixl = T(1.0f) / (x - l);
+
+            r = M::select(clipMax, l + ((r - l) * il) * ixl, r);
+            g = M::select(clipMax, l + ((g - l) * il) * ixl, g);
+            b = M::select(clipMax, l + ((b - l) * il) * ixl, b);
+        }
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE void setLightness(T &r, T &g, T &b, const T &light) {
+        addLightness(r, g, b, light - getLightness(r, g, b));
+    }
+
+    template<typename T>
+    static ALWAYS_INLINE void setSaturation(T &r, T &g, T &b, const T &sat) {
+        const T n = M::min(M::min(r, g), b);
+        const T x = M::max(M::max(r, g), b);
+        const auto isChromatic = (x - n) > T(0.0f);
+        const T scale = sat / (x - n);
+
+        r = M::select(isChromatic, (r - n) * scale, T(0.0f));
+        g = M::select(isChromatic, (g - n) * scale, T(0.0f));
+        b = M::select(isChromatic, (b - n) * scale, T(0.0f));
+    }
+};
+
+struct KoBlendFuncColor
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE void apply(const T &sr, const T &sg, const T &sb, T &dr, T &dg, T &db) {
+        typedef KoHSYBlendMath<_impl> H;
+
+        const T lum = H::getLightness(dr, dg, db);
+        dr = sr;
+        dg = sg;
+        db = sb;
+        H::setLightness(dr, dg, db, lum);
+    }
+};
+
+struct KoBlendFuncLightness
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE void apply(const T &sr, const T &sg, const T &sb, T &dr, T &dg, T &db) {
+        typedef KoHSYBlendMath<_impl> H;
+        H::setLightness(dr, dg, db, H::getLightness(sr, sg, sb));
+    }
+};
+
+struct KoBlendFuncSaturation
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE void apply(const T &sr, const T &sg, const T &sb, T &dr, T &dg, T &db) {
+        typedef KoHSYBlendMath<_impl> H;
+
+        const T sat = H::getSaturation(sr, sg, sb);
+        const T light = H::getLightness(dr, dg, db);
+        H::setSaturation(dr, dg, db, sat);
+        H::setLightness(dr, dg, db, light);
+    }
+};
+
+struct KoBlendFuncHue
+{
+    template<Vc::Implementation _impl, typename T>
+    static ALWAYS_INLINE void apply(const T &sr, const T &sg, const T &sb, T &dr, T &dg, T &db) {
+        typedef KoHSYBlendMath<_impl> H;
+
+        const T sat = H::getSaturation(dr, dg, db);
+        const T lum = H::getLightness(dr, dg, db);
+        dr = sr;
+        dg = sg;
+        db = sb;
+        H::setSaturation(dr, dg, db, sat);
+        H::setLightness(dr, dg, db, lum);
+    }
+};
+
+
+/**
+ * A compositor implementing the same math as KoCompositeOpGenericSC
+ * and KoCompositeOpGenericHSL, but in floating point:
+ *
+ *     newAlpha = sa + da - sa * da
+ *     dst = ((1 - sa) * da * dst + sa * (1 - da) * src + sa * da * f(src, dst)) / newAlpha
+ *
+ * The pixels are expected to be in BGRA layout, that is, KoBgrU8Traits.
+ */
+template<class BlendFunc, bool alphaLocked, bool allChannelsFlag>
+struct GenericCompositor32 {
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : channelFlags(params.channelFlags)
+        {
+        }
+        const QBitArray &channelFlags;
+    };
+
+    // \see docs in AlphaDarkenCompositor32
+    template<bool haveMask, bool src_aligned, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        Q_UNUSED(oparams);
+
+        const Vc::float_v uint8Max(255.0f);
+        const Vc::float_v uint8MaxRec1(1.0f / 255.0f);
+        const Vc::float_v zeroValue(Vc::Zero);
+        const Vc::float_v oneValue(Vc::One);
+
+        Vc::float_v src_alpha = KoStreamedMath<_impl>::template fetch_alpha_32<src_aligned>(src);
+        src_alpha *= Vc::float_v(opacity) * uint8MaxRec1;
+
+        if (haveMask) {
+            Vc::float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        // The source cannot change the colors in the destination,
+        // since its fully transparent
+        if ((src_alpha == zeroValue).isFull()) {
+            return;
+        }
+
+        Vc::float_v dst_alpha = KoStreamedMath<_impl>::template fetch_alpha_32<true>(dst);
+        dst_alpha *= uint8MaxRec1;
+
+        Vc::float_v src_c1;
+        Vc::float_v src_c2;
+        Vc::float_v src_c3;
+
+        Vc::float_v dst_c1;
+        Vc::float_v dst_c2;
+        Vc::float_v dst_c3;
+
+        KoStreamedMath<_impl>::template fetch_colors_32<src_aligned>(src, src_c1, src_c2, src_c3);
+        KoStreamedMath<_impl>::template fetch_colors_32<true>(dst, dst_c1, dst_c2, dst_c3);
+
+        src_c1 *= uint8MaxRec1;
+        src_c2 *= uint8MaxRec1;
+        src_c3 *= uint8MaxRec1;
+
+        dst_c1 *= uint8MaxRec1;
+        dst_c2 *= uint8MaxRec1;
+        dst_c3 *= uint8MaxRec1;
+
+        // c1 is red and c3 is blue in BGRA pixels
+        Vc::float_v res_c1 = dst_c1;
+        Vc::float_v res_c2 = dst_c2;
+        Vc::float_v res_c3 = dst_c3;
+        BlendFunc::template apply<_impl>(src_c1, src_c2, src_c3, res_c1, res_c2, res_c3);
+
+        res_c1 = Vc::min(Vc::max(res_c1, zeroValue), oneValue);
+        res_c2 = Vc::min(Vc::max(res_c2, zeroValue), oneValue);
+        res_c3 = Vc::min(Vc::max(res_c3, zeroValue), oneValue);
+
+        const Vc::float_v both_alpha = src_alpha * dst_alpha;
+        const Vc::float_v src_weight = src_alpha - both_alpha;
+        const Vc::float_v dst_weight = dst_alpha - both_alpha;
+        const Vc::float_v new_alpha = src_alpha + dst_weight;
+
+        /**
+         * The value of new_alpha can have *some* zero values, which
+         * would give NaN in the division. The colors of such pixels are
+         * left untouched, the same way the generic composite op does.
+         */
+        const Vc::float_m empty_pixels_mask = new_alpha == zeroValue;
+        const Vc::float_v new_alpha_scale = OptiDiv<_impl>::divVector(uint8Max, new_alpha);
+
+        Vc::float_v new_c1 = (dst_weight * dst_c1 + src_weight * src_c1 + both_alpha * res_c1) * new_alpha_scale;
+        Vc::float_v new_c2 = (dst_weight * dst_c2 + src_weight * src_c2 + both_alpha * res_c2) * new_alpha_scale;
+        Vc::float_v new_c3 = (dst_weight * dst_c3 + src_weight * src_c3 + both_alpha * res_c3) * new_alpha_scale;
+
+        new_c1(empty_pixels_mask) = dst_c1 * uint8Max;
+        new_c2(empty_pixels_mask) = dst_c2 * uint8Max;
+        new_c3(empty_pixels_mask) = dst_c3 * uint8Max;
+
+        KoStreamedMath<_impl>::write_channels_32(dst, new_alpha * uint8Max, new_c1, new_c2, new_c3);
+    }
+
+    template <bool haveMask, Vc::Implementation _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        const qint32 red_pos = KoBgrU8Traits::red_pos;
+        const qint32 green_pos = KoBgrU8Traits::green_pos;
+        const qint32 blue_pos = KoBgrU8Traits::blue_pos;
+        const qint32 alpha_pos = KoBgrU8Traits::alpha_pos;
+
+        const float uint8Rec1 = 1.0f / 255.0f;
+        const float uint8Max = 255.0f;
+
+        float srcAlpha = float(src[alpha_pos]) * opacity * uint8Rec1;
+
+        if (haveMask) {
+            srcAlpha *= float(*mask) * uint8Rec1;
+        }
+
+        const float dstAlpha = float(dst[alpha_pos]) * uint8Rec1;
+
+        if (!allChannelsFlag && dstAlpha == 0.0f) {
+            // the same way as KoCompositeOpBase does
+            quint32 *d = reinterpret_cast<quint32*>(dst);
+            *d = 0;
+        }
+
+        if (srcAlpha == 0.0f || (alphaLocked && dstAlpha == 0.0f)) {
+            return;
+        }
+
+        const qint32 positions[3] = {red_pos, green_pos, blue_pos};
+        float s[3];
+        float d[3];
+        float r[3];
+
+        for (int i = 0; i < 3; i++) {
+            s[i] = float(src[positions[i]]) * uint8Rec1;
+            d[i] = float(dst[positions[i]]) * uint8Rec1;
+            r[i] = d[i];
+        }
+
+        BlendFunc::template apply<_impl>(s[0], s[1], s[2], r[0], r[1], r[2]);
+
+        const QBitArray &channelFlags = oparams.channelFlags;
+
+        if (alphaLocked) {
+            for (int i = 0; i < 3; i++) {
+                if (allChannelsFlag || channelFlags.at(positions[i])) {
+                    const float result = qBound(0.0f, r[i], 1.0f);
+                    dst[positions[i]] = KoStreamedMath<_impl>::round_float_to_u8((d[i] + (result - d[i]) * srcAlpha) * uint8Max);
+                }
+            }
+        } else {
+            const float bothAlpha = srcAlpha * dstAlpha;
+            const float srcWeight = srcAlpha - bothAlpha;
+            const float dstWeight = dstAlpha - bothAlpha;
+            const float newAlpha = srcAlpha + dstWeight;
+
+            const float newAlphaScale = OptiDiv<_impl>::divScalar(uint8Max, newAlpha);
+
+            for (int i = 0; i < 3; i++) {
+                if (allChannelsFlag || channelFlags.at(positions[i])) {
+                    const float result = qBound(0.0f, r[i], 1.0f);
+                    dst[positions[i]] = KoStreamedMath<_impl>::round_float_to_u8(
+                        (dstWeight * d[i] + srcWeight * s[i] + bothAlpha * result) * newAlphaScale);
+                }
+            }
+
+            dst[alpha_pos] = KoStreamedMath<_impl>::round_float_to_u8(newAlpha * uint8Max);
+        }
+    }
+};
+
+/**
+ * An optimized version of the generic separable and HSY composite
+ * ops for the use in BGRA 8-bit colorspaces. Only the case of all
+ * channels enabled is vectorized.
+ */
+template<Vc::Implementation _impl, class BlendFunc>
+class KoOptimizedCompositeOpGeneric32 : public KoCompositeOp
+{
+public:
+    KoOptimizedCompositeOpGeneric32(const KoColorSpace* cs, const QString &id, const QString &category)
+        : KoCompositeOp(cs, id, category) {}
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite32<haveMask, false, GenericCompositor32<BlendFunc, false, true> >(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite32_novector<haveMask, false, GenericCompositor32<BlendFunc, true, true> >(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite32_novector<haveMask, false, GenericCompositor32<BlendFunc, false, false> >(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite32_novector<haveMask, false, GenericCompositor32<BlendFunc, true, false> >(params);
+            }
+        }
+    }
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpMultiply32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncMultiply>
+{
+public:
+    KoOptimizedCompositeOpMultiply32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncMultiply>(cs, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpScreen32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncScreen>
+{
+public:
+    KoOptimizedCompositeOpScreen32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncScreen>(cs, COMPOSITE_SCREEN, KoCompositeOp::categoryLight()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpOverlay32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncOverlay>
+{
+public:
+    KoOptimizedCompositeOpOverlay32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncOverlay>(cs, COMPOSITE_OVERLAY, KoCompositeOp::categoryMix()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSoftLight32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSoftLight>
+{
+public:
+    KoOptimizedCompositeOpSoftLight32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSoftLight>(cs, COMPOSITE_SOFT_LIGHT_PHOTOSHOP, KoCompositeOp::categoryLight()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColorDodge32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColorDodge>
+{
+public:
+    KoOptimizedCompositeOpColorDodge32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColorDodge>(cs, COMPOSITE_DODGE, KoCompositeOp::categoryLight()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColorBurn32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColorBurn>
+{
+public:
+    KoOptimizedCompositeOpColorBurn32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColorBurn>(cs, COMPOSITE_BURN, KoCompositeOp::categoryDark()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpAdd32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncAddition>
+{
+public:
+    KoOptimizedCompositeOpAdd32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncAddition>(cs, COMPOSITE_ADD, KoCompositeOp::categoryArithmetic()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLinearDodge32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncAddition>
+{
+public:
+    KoOptimizedCompositeOpLinearDodge32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncAddition>(cs, COMPOSITE_LINEAR_DODGE, KoCompositeOp::categoryLight()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSubtract32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSubtract>
+{
+public:
+    KoOptimizedCompositeOpSubtract32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSubtract>(cs, COMPOSITE_SUBTRACT, KoCompositeOp::categoryArithmetic()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpDarken32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncDarkenOnly>
+{
+public:
+    KoOptimizedCompositeOpDarken32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncDarkenOnly>(cs, COMPOSITE_DARKEN, KoCompositeOp::categoryDark()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLighten32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncLightenOnly>
+{
+public:
+    KoOptimizedCompositeOpLighten32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncLightenOnly>(cs, COMPOSITE_LIGHTEN, KoCompositeOp::categoryLight()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpColor32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColor>
+{
+public:
+    KoOptimizedCompositeOpColor32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncColor>(cs, COMPOSITE_COLOR, KoCompositeOp::categoryHSY()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpHue32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncHue>
+{
+public:
+    KoOptimizedCompositeOpHue32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncHue>(cs, COMPOSITE_HUE, KoCompositeOp::categoryHSY()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpSaturation32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSaturation>
+{
+public:
+    KoOptimizedCompositeOpSaturation32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncSaturation>(cs, COMPOSITE_SATURATION, KoCompositeOp::categoryHSY()) {}
+};
+
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpLuminize32 : public KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncLightness>
+{
+public:
+    KoOptimizedCompositeOpLuminize32(const KoColorSpace* cs)
+        : KoOptimizedCompositeOpGeneric32<_impl, KoBlendFuncLightness>(cs, COMPOSITE_LUMINIZE, KoCompositeOp::categoryHSY()) {}
+};
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERIC32_H
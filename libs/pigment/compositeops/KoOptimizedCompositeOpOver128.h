@@ -316,4 +316,57 @@ public:
     }
 };
 
+#ifdef HAVE_OPENEXR
+
+/**
+ * An optimized version of a composite op for the use in half-float
+ * RGBA colorspaces with alpha channel placed at the last position
+ * of the pixel: C1_C2_C3_A.
+ */
+template<Vc::Implementation _impl>
+class KoOptimizedCompositeOpOverF16 : public KoCompositeOp
+{
+public:
+    KoOptimizedCompositeOpOverF16(const KoColorSpace* cs)
+        : KoCompositeOp(cs, COMPOSITE_OVER, KoCompositeOp::categoryMix()) {}
+
+    using KoCompositeOp::composite;
+
+    virtual void composite(const KoCompositeOp::ParameterInfo& params) const
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite64<haveMask, false, OverCompositor128<half, false, true> >(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, OverCompositor128<half, true, true> >(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, OverCompositor128<half, false, false> >(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, OverCompositor128<half, true, false> >(params);
+            }
+        }
+    }
+};
+
+#endif /* HAVE_OPENEXR */
+
 #endif // KOOPTIMIZEDCOMPOSITEOPOVER128_H_
@@ -0,0 +1,167 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDHALFCONVERSION_H
+#define KOOPTIMIZEDHALFCONVERSION_H
+
+#include "KoVcMultiArchBuildSupport.h"
+
+#ifdef HAVE_VC
+
+#include <QtGlobal>
+#include <KoAlwaysInline.h>
+
+/**
+ * Converts half-float values into floats and back with vector
+ * instructions.
+ *
+ * The per-arch builds don't enable F16C instructions and Vc has
+ * no half-float vector type, so the values are converted with
+ * integer operations on their bits. Both conversions are exact
+ * and round to the nearest even value, that is, the results are
+ * the same as the ones of the scalar `half` class (except for the
+ * payload of NaN values).
+ *
+ * The half values are passed around as their 16-bit patterns
+ * stored in the lanes of an integer vector.
+ */
+template<Vc::Implementation _impl>
+struct KoOptimizedHalfConversion
+{
+    using int_v = Vc::SimdArray<int, Vc::float_v::size()>;
+    using uint_v = Vc::SimdArray<unsigned int, Vc::float_v::size()>;
+
+    ALWAYS_INLINE
+    static Vc::float_v bitsToFloat(const int_v &bits)
+    {
+        return Vc::reinterpret_components_cast<Vc::float_v>(bits);
+    }
+
+    ALWAYS_INLINE
+    static int_v floatToBits(Vc::float_v::AsArg value)
+    {
+        return Vc::reinterpret_components_cast<int_v>(value);
+    }
+
+    /**
+     * Converts the 16-bit patterns of half values in \p h into floats
+     */
+    ALWAYS_INLINE
+    static Vc::float_v toFloat(const int_v &h)
+    {
+        const float minNormal = 6.103515625e-05f; // 2^-14
+
+        /**
+         * Move the exponent and the mantissa into their float
+         * positions and rebias the exponent. Infinities and NaNs
+         * get the maximum exponent of the float.
+         */
+        const int_v expMantissa = h & int_v(0x7fff);
+        int_v bits = (expMantissa << 13) + int_v((127 - 15) << 23);
+        bits = Vc::iif(expMantissa >= int_v(0x7c00), bits + int_v((128 - 16) << 23), bits);
+
+        Vc::float_v value = bitsToFloat(bits);
+
+        /**
+         * Denormals got the exponent of 2^-15 and an implicit one
+         * in the mantissa, renormalize them. Both operations are
+         * exact.
+         */
+        const Vc::float_m isDenormal = value < Vc::float_v(minNormal);
+        value(isDenormal) = value * Vc::float_v(2.0f) - Vc::float_v(minNormal);
+
+        const Vc::float_m isNegative = Vc::simd_cast<Vc::float_v>(h) >= Vc::float_v(32768.0f);
+        value(isNegative) = -value;
+
+        return value;
+    }
+
+    /**
+     * Converts floats into the 16-bit patterns of half values
+     */
+    ALWAYS_INLINE
+    static int_v fromFloat(Vc::float_v::AsArg value)
+    {
+        int_v bits = floatToBits(value);
+        const int_v sign = (bits >> 16) & int_v(0x8000);
+        bits &= int_v(0x7fffffff);
+
+        /**
+         * Normal values: rebias the exponent and round the mantissa
+         * to the nearest even value. The rounding may overflow into
+         * the exponent, which gives the correct result, including
+         * the overflow to infinity.
+         */
+        const int_v normal =
+            (bits + int_v(-(112 << 23) + 0xfff) + ((bits >> 13) & int_v(1))) >> 13;
+
+        /**
+         * Values below the minimal normal half: let the float
+         * adder round the mantissa by adding 0.5, which has the
+         * unit of the last place equal to the one of half denormals
+         */
+        const int_v denormal = floatToBits(Vc::abs(value) + Vc::float_v(0.5f)) - int_v(126 << 23);
+
+        /**
+         * Values too big for a half become infinities, NaNs stay NaNs
+         */
+        const int_v special =
+            Vc::iif(bits > int_v(0x7f800000), int_v(0x7e00), int_v(0x7c00));
+
+        int_v result = Vc::iif(bits < int_v(113 << 23), denormal, normal);
+        result = Vc::iif(bits >= int_v((127 + 16) << 23), special, result);
+
+        return result | sign;
+    }
+
+    /**
+     * Reads float_v::size() pixels of four half channels from \p src
+     * and splits them into separate vectors
+     */
+    ALWAYS_INLINE
+    static void readPixels(const quint8 *src, Vc::float_v &c1, Vc::float_v &c2, Vc::float_v &c3, Vc::float_v &c4)
+    {
+        struct PackedPixel {
+            float c1c2;
+            float c3c4;
+        };
+
+        Vc::InterleavedMemoryWrapper<PackedPixel, Vc::float_v> dataWrapper((PackedPixel*)(const_cast<quint8*>(src)));
+        Vc::float_v v1, v2;
+        Vc::tie(v1, v2) = dataWrapper[size_t(0)];
+
+        const int_v pixelsC1C2 = floatToBits(v1);
+        const int_v pixelsC3C4 = floatToBits(v2);
+        const int_v mask(0xffff);
+
+        c1 = toFloat(pixelsC1C2 & mask);
+        c2 = toFloat((pixelsC1C2 >> 16) & mask);
+        c3 = toFloat(pixelsC3C4 & mask);
+        c4 = toFloat((pixelsC3C4 >> 16) & mask);
+    }
+
+    /**
+     * Writes float_v::size() pixels of four half channels into \p dst,
+     * \p flags tell if \p dst is aligned to the vector size
+     */
+    template<typename Flags>
+    ALWAYS_INLINE
+    static void writePixels(quint8 *dst,
+                            Vc::float_v::AsArg c1, Vc::float_v::AsArg c2, Vc::float_v::AsArg c3, Vc::float_v::AsArg c4,
+                            Flags flags)
+    {
+        const uint_v c1c2 = (uint_v(fromFloat(c2)) << 16) | uint_v(fromFloat(c1));
+        const uint_v c3c4 = (uint_v(fromFloat(c4)) << 16) | uint_v(fromFloat(c3));
+
+        std::pair<uint_v, uint_v> out = Vc::interleave(c1c2, c3c4);
+        out.first.store(reinterpret_cast<Vc::uint32_t*>(dst), flags);
+        out.second.store(reinterpret_cast<Vc::uint32_t*>(dst) + out.first.size(), flags);
+    }
+};
+
+#endif /* HAVE_VC */
+
+#endif // KOOPTIMIZEDHALFCONVERSION_H
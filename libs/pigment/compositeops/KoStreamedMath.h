@@ -29,6 +29,7 @@
 #include <KoAlwaysInline.h>
 #include <KoCompositeOp.h>
 #include <KoColorSpaceMaths.h>
+#include "KoOptimizedHalfConversion.h"
 
 #define BLOCKDEBUG 0
 
@@ -696,6 +697,65 @@ struct PixelWrapper<float, _impl>
     const Vc::float_v::IndexType indexes;
 };
 
+#ifdef HAVE_OPENEXR
+
+/**
+ * Half-float pixels are converted into normalized floats on read
+ * and back on write, so the compositors work in the same way as
+ * for the 32-bit float pixels
+ *
+ * \see KoOptimizedHalfConversion
+ */
+template<Vc::Implementation _impl>
+struct PixelWrapper<half, _impl>
+{
+    using Conversion = KoOptimizedHalfConversion<_impl>;
+
+    ALWAYS_INLINE
+    static half lerpMixedUintFloat(half a, half b, float alpha) {
+        return Arithmetic::lerp(float(a), float(b), alpha);
+    }
+
+    ALWAYS_INLINE
+    static half roundFloatToUint(float x) {
+        return x;
+    }
+
+    ALWAYS_INLINE
+    static void normalizeAlpha(float &alpha) {
+        Q_UNUSED(alpha);
+    }
+
+    ALWAYS_INLINE
+    static void denormalizeAlpha(float &alpha) {
+        Q_UNUSED(alpha);
+    }
+
+    ALWAYS_INLINE
+    void read(quint8 *dataDst, Vc::float_v &dst_c1, Vc::float_v &dst_c2, Vc::float_v &dst_c3, Vc::float_v &dst_alpha)
+    {
+        Conversion::readPixels(dataDst, dst_c1, dst_c2, dst_c3, dst_alpha);
+    }
+
+    ALWAYS_INLINE
+    void write(quint8 *dataDst, Vc::float_v::AsArg c1, Vc::float_v::AsArg c2, Vc::float_v::AsArg c3, Vc::float_v &alpha)
+    {
+        Conversion::writePixels(dataDst, c1, c2, c3, alpha, Vc::Aligned);
+    }
+
+    ALWAYS_INLINE
+    void clearPixels(quint8 *dataDst) {
+        memset(dataDst, 0, Vc::float_v::size() * sizeof(half) * 4);
+    }
+
+    ALWAYS_INLINE
+    void copyPixels(const quint8 *dataSrc, quint8 *dataDst) {
+        memcpy(dataDst, dataSrc, Vc::float_v::size() * sizeof(half) * 4);
+    }
+};
+
+#endif /* HAVE_OPENEXR */
+
 namespace KoStreamedMathFunctions {
 
 template<int pixelSize>
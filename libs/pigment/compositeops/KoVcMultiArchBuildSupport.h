@@ -51,10 +51,71 @@ namespace Vc {
 
 
 #include <QDebug>
+#include <QList>
+#include <QPair>
 #include <ksharedconfig.h>
 #include <kconfig.h>
 #include <kconfiggroup.h>
 
+/**
+ * Parses the name of a vector implementation as it is passed in
+ * KRITA_VC_IMPLEMENTATION: Scalar, SSE2, SSSE3, SSE4_1, AVX or AVX2.
+ * Returns false if the name is unknown.
+ *
+ * There are no AVX-512 and NEON implementations: Vc has no backends
+ * for them.
+ */
+inline bool vcImplementationFromName(const QByteArray &name, Vc::Implementation *impl)
+{
+    const QList<QPair<QByteArray, Vc::Implementation>> names = {
+        {"Scalar", Vc::ScalarImpl},
+#ifdef HAVE_VC
+        {"SSE2", Vc::SSE2Impl},
+        {"SSSE3", Vc::SSSE3Impl},
+        {"SSE4_1", Vc::SSE41Impl},
+        {"AVX", Vc::AVXImpl},
+        {"AVX2", Vc::AVX2Impl},
+#endif
+    };
+
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        if (it->first == name) {
+            *impl = it->second;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Creates the version of the class compiled for \p impl. The caller
+ * must make sure the implementation is supported by the CPU.
+ */
+template<class FactoryType>
+typename FactoryType::ReturnType
+createOptimizedClassForImplementation(Vc::Implementation impl, typename FactoryType::ParamType param)
+{
+#ifdef HAVE_VC
+    switch (impl) {
+    case Vc::AVX2Impl:
+        return FactoryType::template create<Vc::AVX2Impl>(param);
+    case Vc::AVXImpl:
+        return FactoryType::template create<Vc::AVXImpl>(param);
+    case Vc::SSE41Impl:
+        return FactoryType::template create<Vc::SSE41Impl>(param);
+    case Vc::SSSE3Impl:
+        return FactoryType::template create<Vc::SSSE3Impl>(param);
+    case Vc::SSE2Impl:
+        return FactoryType::template create<Vc::SSE2Impl>(param);
+    default:
+        break;
+    }
+#endif
+    (void)impl;
+    return FactoryType::template create<Vc::ScalarImpl>(param);
+}
+
 template<class FactoryType>
 typename FactoryType::ReturnType
 createOptimizedClass(typename FactoryType::ParamType param)
@@ -62,15 +123,46 @@ createOptimizedClass(typename FactoryType::ParamType param)
     static bool isConfigInitialized = false;
     static bool useVectorization = true;
     static bool disableAVXOptimizations = false;
+    static bool hasForcedImplementation = false;
+    static Vc::Implementation forcedImplementation = Vc::ScalarImpl;
 
     if (!isConfigInitialized) {
         KConfigGroup cfg = KSharedConfig::openConfig()->group("");
         // use the old key name for compatibility
         useVectorization = !cfg.readEntry("amdDisableVectorWorkaround", false);
         disableAVXOptimizations = cfg.readEntry("disableAVXOptimizations", false);
+
+        /**
+         * KRITA_VC_IMPLEMENTATION selects one of the compiled
+         * implementations instead of the best one. It is used by
+         * the unit tests to check every implementation on the same
+         * machine, e.g. under an emulator.
+         */
+        const QByteArray forcedName = qgetenv("KRITA_VC_IMPLEMENTATION");
+        if (!forcedName.isEmpty()) {
+            hasForcedImplementation = vcImplementationFromName(forcedName, &forcedImplementation);
+
+            if (!hasForcedImplementation) {
+                qWarning() << "WARNING: unknown vector implementation in KRITA_VC_IMPLEMENTATION:" << forcedName;
+            }
+        }
+
         isConfigInitialized = true;
     }
 
+    if (hasForcedImplementation) {
+#ifdef HAVE_VC
+        if (forcedImplementation == Vc::ScalarImpl ||
+            Vc::isImplementationSupported(forcedImplementation)) {
+
+            return createOptimizedClassForImplementation<FactoryType>(forcedImplementation, param);
+        }
+        qWarning() << "WARNING: the vector implementation forced by KRITA_VC_IMPLEMENTATION is not supported by the CPU!";
+#else
+        return createOptimizedClassForImplementation<FactoryType>(forcedImplementation, param);
+#endif
+    }
+
     if (!useVectorization) {
         qWarning() << "WARNING: vector instructions disabled by the \'amdDisableVectorWorkaround\' option!";
         return FactoryType::template create<Vc::ScalarImpl>(param);
@@ -87,6 +179,10 @@ createOptimizedClass(typename FactoryType::ParamType param)
      * We use SSE2, SSSE3, SSE4.1, AVX and AVX2.
      * The rest are integer and string instructions mostly.
      *
+     * Vc has no AVX-512 and NEON backends, the CPUs with AVX-512
+     * support AVX2 and get the AVX2 version, ARM builds are done
+     * without Vc and use the scalar version.
+     *
      * TODO: Add FMA3/4 when it is adopted by Vc
      */
     if (!disableAVXOptimizations && Vc::isImplementationSupported(Vc::AVX2Impl)) {
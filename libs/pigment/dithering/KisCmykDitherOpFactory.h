@@ -18,10 +18,13 @@ template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class Kis
 {
     using srcChannelsType = typename srcCSTraits::channels_type;
     using dstChannelsType = typename dstCSTraits::channels_type;
+    using BaseClass = KisDitherOpImpl<srcCSTraits, dstCSTraits, dType>;
 
 public:
+    // the color channels are normalized with unitValueCMYK and truncated
     KisCmykDitherOpImpl(const KoID &srcId, const KoID &dstId)
-        : KisDitherOpImpl<srcCSTraits, dstCSTraits, dType>(srcId, dstId)
+        : BaseClass(srcId, dstId,
+                    BaseClass::createOptimizedDither(colorUnitValue<srcChannelsType>(), colorUnitValue<dstChannelsType>(), true))
     {
     }
 
@@ -131,6 +134,11 @@ private:
     template<DitherType t = dType, typename std::enable_if<t != DITHER_NONE, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int x, int y, int columns, int rows) const
     {
+        if (this->m_optimizedDither) {
+            this->m_optimizedDither->dither(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
@@ -170,6 +178,16 @@ private:
 
     // CMYK-specific normalization bits
 
+    template<typename A, typename std::enable_if<std::numeric_limits<A>::is_integer, void>::type * = nullptr> static inline float colorUnitValue()
+    {
+        return static_cast<float>(KoColorSpaceMathsTraits<A>::unitValue);
+    };
+
+    template<typename A, typename std::enable_if<!std::numeric_limits<A>::is_integer, void>::type * = nullptr> static inline float colorUnitValue()
+    {
+        return static_cast<float>(KoCmykColorSpaceMathsTraits<A>::unitValueCMYK);
+    };
+
     template<typename A, typename U = srcCSTraits, typename std::enable_if<std::numeric_limits<A>::is_integer, void>::type * = nullptr> inline float normalize(A value) const
     {
         return static_cast<float>(value) / KoColorSpaceMathsTraits<A>::unitValue;
@@ -0,0 +1,301 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHER_H
+#define KISOPTIMIZEDDITHER_H
+
+#include "KisOptimizedDitherBase.h"
+
+#include <limits>
+#include <type_traits>
+
+#include "KoVcMultiArchBuildSupport.h"
+#include "KisDitherMaths.h"
+#include "kis_assert.h"
+
+
+/**
+ * Per-channel constants of the conversion, every value of the pixel
+ * is computed as:
+ *
+ *     c = src / srcDivisor
+ *     c = c + (factor - c) * scale
+ *     dst = c * dstMultiplier                     // float destinations
+ *     dst = clamp(c * dstMultiplier) + rounding   // integer destinations
+ */
+struct KisOptimizedDitherChannel {
+    float srcDivisor;
+    float dstMultiplier;
+    float rounding;
+};
+
+template<DitherType type>
+inline float ditherFactor(int x, int y)
+{
+    return type == DITHER_BAYER ?
+        KisDitherMaths::dither_factor_bayer_8(x, y) :
+        KisDitherMaths::dither_factor_blue_noise_64(x, y);
+}
+
+/**
+ * Dithers the beginning of the row with vector instructions and
+ * returns the number of processed pixels. The generic version is
+ * used for the scalar implementation and when Vc is not available,
+ * it processes nothing.
+ */
+template<Vc::Implementation _impl,
+         typename EnableDummyType = void>
+struct KisOptimizedDitherKernel
+{
+    static const int laneCount = 1;
+
+    template<typename src_type, typename dst_type, DitherType type>
+    static int ditherRow(const src_type *, dst_type *, int, int, int, int,
+                         float, const float *, const float *, const float *)
+    {
+        return 0;
+    }
+};
+
+#ifdef HAVE_VC
+
+template<Vc::Implementation _impl>
+struct KisOptimizedDitherKernel<
+        _impl,
+        typename std::enable_if<_impl != Vc::ScalarImpl>::type>
+{
+    static const int laneCount = static_cast<int>(Vc::float_v::size());
+
+    /**
+     * \p srcDivisors, \p dstMultipliers and \p roundings contain the
+     * per-channel constants repeated for laneCount pixels
+     */
+    template<typename src_type, typename dst_type, DitherType type>
+    static int ditherRow(const src_type *src, dst_type *dst,
+                         int x, int y, int columns, int channelCount,
+                         float scale,
+                         const float *srcDivisors,
+                         const float *dstMultipliers,
+                         const float *roundings)
+    {
+        const bool isIntegerDst = std::numeric_limits<dst_type>::is_integer;
+        const Vc::float_v dstMax(isIntegerDst ? float(std::numeric_limits<dst_type>::max()) : 0.0f);
+        const Vc::float_v vectorScale(scale);
+
+        alignas(64) float factors[laneCount * KisOptimizedDitherBase::maxChannelCount];
+        alignas(64) float result[laneCount];
+
+        int b = 0;
+
+        for (; b + laneCount <= columns; b += laneCount) {
+            for (int i = 0; i < laneCount; i++) {
+                const float f = ditherFactor<type>(x + b + i, y);
+
+                for (int ch = 0; ch < channelCount; ch++) {
+                    factors[i * channelCount + ch] = f;
+                }
+            }
+
+            for (int v = 0; v < channelCount; v++) {
+                const int offset = v * laneCount;
+
+                Vc::float_v c;
+                c.load(src + offset, Vc::Unaligned);
+                c /= Vc::float_v(srcDivisors + offset, Vc::Unaligned);
+
+                const Vc::float_v f(factors + offset, Vc::Aligned);
+                c += (f - c) * vectorScale;
+                c *= Vc::float_v(dstMultipliers + offset, Vc::Unaligned);
+
+                if (isIntegerDst) {
+                    c = Vc::min(Vc::max(c, Vc::float_v::Zero()), dstMax);
+                    c += Vc::float_v(roundings + offset, Vc::Unaligned);
+
+                    c.store(result, Vc::Aligned);
+                    for (int i = 0; i < laneCount; i++) {
+                        dst[offset + i] = dst_type(int(result[i]));
+                    }
+                } else {
+                    c.store(reinterpret_cast<float*>(dst + offset), Vc::Unaligned);
+                }
+            }
+
+            src += laneCount * channelCount;
+            dst += laneCount * channelCount;
+        }
+
+        return b;
+    }
+};
+
+#endif /* HAVE_VC */
+
+
+template<Vc::Implementation _impl>
+class KisOptimizedDither : public KisOptimizedDitherBase
+{
+    using Kernel = KisOptimizedDitherKernel<_impl>;
+
+public:
+    KisOptimizedDither(const Parameters &params)
+        : m_params(params)
+    {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(params.channelCount <= maxChannelCount);
+
+        const float srcAlphaUnitValue = unitValue(params.srcValueType);
+        const float dstAlphaUnitValue = unitValue(params.dstValueType);
+        const bool isIntegerDst = params.dstValueType != KoChannelInfo::FLOAT32;
+
+        m_scale = isIntegerDst ? 1.0f / float(1 << (8 * channelSize(params.dstValueType))) : 0.0f;
+
+        for (int i = 0; i < params.channelCount; i++) {
+            const bool isAlpha = i == params.alphaPos;
+
+            m_channels[i].srcDivisor = isAlpha ? srcAlphaUnitValue : params.srcColorUnitValue;
+            m_channels[i].dstMultiplier = isAlpha ? dstAlphaUnitValue : params.dstColorUnitValue;
+            m_channels[i].rounding =
+                !isIntegerDst || (!isAlpha && params.truncateColorChannels) ? 0.0f : 0.5f;
+        }
+
+        /**
+         * The kernel processes laneCount pixels at once, which is
+         * exactly channelCount vectors, so the constants of every
+         * vector are the same for all the groups of pixels
+         */
+        const int numValues = Kernel::laneCount * params.channelCount;
+        for (int i = 0; i < numValues; i++) {
+            const KisOptimizedDitherChannel &channel = m_channels[i % params.channelCount];
+
+            m_srcDivisors[i] = channel.srcDivisor;
+            m_dstMultipliers[i] = channel.dstMultiplier;
+            m_roundings[i] = channel.rounding;
+        }
+    }
+
+    void dither(const quint8 *srcRowStart, int srcRowStride,
+                quint8 *dstRowStart, int dstRowStride,
+                int x, int y, int columns, int rows) const override
+    {
+        switch (m_params.srcValueType) {
+        case KoChannelInfo::UINT8:
+            ditherImpl<quint8>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        case KoChannelInfo::UINT16:
+            ditherImpl<quint16>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        case KoChannelInfo::FLOAT32:
+            ditherImpl<float>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        default:
+            KIS_SAFE_ASSERT_RECOVER_RETURN(0 && "unsupported source depth");
+        }
+    }
+
+private:
+    static float unitValue(KoChannelInfo::enumChannelValueType valueType)
+    {
+        return valueType == KoChannelInfo::UINT8 ? 255.0f :
+               valueType == KoChannelInfo::UINT16 ? 65535.0f :
+               1.0f;
+    }
+
+    static int channelSize(KoChannelInfo::enumChannelValueType valueType)
+    {
+        return valueType == KoChannelInfo::UINT8 ? int(sizeof(quint8)) :
+               valueType == KoChannelInfo::UINT16 ? int(sizeof(quint16)) :
+               int(sizeof(float));
+    }
+
+    template<typename src_type>
+    void ditherImpl(const quint8 *srcRowStart, int srcRowStride,
+                    quint8 *dstRowStart, int dstRowStride,
+                    int x, int y, int columns, int rows) const
+    {
+        switch (m_params.dstValueType) {
+        case KoChannelInfo::UINT8:
+            ditherRows<src_type, quint8>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        case KoChannelInfo::UINT16:
+            ditherRows<src_type, quint16>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        case KoChannelInfo::FLOAT32:
+            ditherRows<src_type, float>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+            break;
+        default:
+            KIS_SAFE_ASSERT_RECOVER_RETURN(0 && "unsupported destination depth");
+        }
+    }
+
+    template<typename src_type, typename dst_type>
+    void ditherRows(const quint8 *srcRowStart, int srcRowStride,
+                    quint8 *dstRowStart, int dstRowStride,
+                    int x, int y, int columns, int rows) const
+    {
+        if (m_params.type == DITHER_BAYER) {
+            ditherRows<src_type, dst_type, DITHER_BAYER>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+        } else {
+            ditherRows<src_type, dst_type, DITHER_BLUE_NOISE>(srcRowStart, srcRowStride, dstRowStart, dstRowStride, x, y, columns, rows);
+        }
+    }
+
+    template<typename src_type, typename dst_type, DitherType type>
+    void ditherRows(const quint8 *srcRowStart, int srcRowStride,
+                    quint8 *dstRowStart, int dstRowStride,
+                    int x, int y, int columns, int rows) const
+    {
+        const int channelCount = m_params.channelCount;
+        const bool isIntegerDst = std::numeric_limits<dst_type>::is_integer;
+        const float dstMax = isIntegerDst ? float(std::numeric_limits<dst_type>::max()) : 0.0f;
+
+        for (int row = 0; row < rows; row++) {
+            const src_type *src = reinterpret_cast<const src_type*>(srcRowStart);
+            dst_type *dst = reinterpret_cast<dst_type*>(dstRowStart);
+
+            const int numProcessed =
+                Kernel::template ditherRow<src_type, dst_type, type>(src, dst, x, y + row, columns, channelCount,
+                                                                     m_scale, m_srcDivisors, m_dstMultipliers, m_roundings);
+
+            src += numProcessed * channelCount;
+            dst += numProcessed * channelCount;
+
+            for (int b = numProcessed; b < columns; b++) {
+                const float f = ditherFactor<type>(x + b, y + row);
+
+                for (int ch = 0; ch < channelCount; ch++) {
+                    const KisOptimizedDitherChannel &channel = m_channels[ch];
+
+                    float c = float(src[ch]) / channel.srcDivisor;
+                    c = KisDitherMaths::apply_dither(c, f, m_scale);
+                    c *= channel.dstMultiplier;
+
+                    if (isIntegerDst) {
+                        c = qBound(0.0f, c, dstMax) + channel.rounding;
+                        dst[ch] = dst_type(int(c));
+                    } else {
+                        dst[ch] = dst_type(c);
+                    }
+                }
+
+                src += channelCount;
+                dst += channelCount;
+            }
+
+            srcRowStart += srcRowStride;
+            dstRowStart += dstRowStride;
+        }
+    }
+
+private:
+    const Parameters m_params;
+    float m_scale;
+    KisOptimizedDitherChannel m_channels[maxChannelCount];
+
+    float m_srcDivisors[Kernel::laneCount * maxChannelCount];
+    float m_dstMultipliers[Kernel::laneCount * maxChannelCount];
+    float m_roundings[Kernel::laneCount * maxChannelCount];
+};
+
+#endif // KISOPTIMIZEDDITHER_H
@@ -0,0 +1,67 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERBASE_H
+#define KISOPTIMIZEDDITHERBASE_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+#include "KoChannelInfo.h"
+#include "KisDitherOp.h"
+
+/**
+ * @brief Applies ordered (Bayer or blue noise) dithering to the rows
+ * of pixels while converting them between two channel depths
+ *
+ * The math is the same as in KisDitherOpImpl, but the channels are
+ * processed as a flat stream of values with vector instructions: the
+ * dither factor of every pixel is replicated into all its channels
+ * and the per-channel normalization is kept in vectors that repeat
+ * with the period of the pixel.
+ *
+ * The actual implementation is placed in class `KisOptimizedDither`.
+ * To create it, call the factory. It will return a version optimized
+ * for your CPU architecture or null if the parameters are not
+ * supported.
+ *
+ * \see KisOptimizedDitherFactory
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherBase
+{
+public:
+    static const int maxChannelCount = 5;
+
+    struct Parameters {
+        KoChannelInfo::enumChannelValueType srcValueType;
+        KoChannelInfo::enumChannelValueType dstValueType;
+        DitherType type;
+        int channelCount;
+        int alphaPos;
+
+        /**
+         * The values of the color channels that are normalized into
+         * 1.0, e.g. 255 for 8-bit channels or 100 for floating point
+         * CMYK. The alpha channel always uses the standard unit value.
+         */
+        float srcColorUnitValue;
+        float dstColorUnitValue;
+
+        /**
+         * If true, the integer color channels are truncated instead
+         * of being rounded when stored into the destination
+         */
+        bool truncateColorChannels;
+    };
+
+public:
+    virtual ~KisOptimizedDitherBase();
+
+    virtual void dither(const quint8 *srcRowStart, int srcRowStride,
+                        quint8 *dstRowStart, int dstRowStride,
+                        int x, int y, int columns, int rows) const = 0;
+};
+
+#endif // KISOPTIMIZEDDITHERBASE_H
@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherFactory.h"
+
+#include "KisOptimizedDitherFactoryImpl.h"
+
+namespace {
+bool isValueTypeSupported(KoChannelInfo::enumChannelValueType valueType)
+{
+    return valueType == KoChannelInfo::UINT8 ||
+        valueType == KoChannelInfo::UINT16 ||
+        valueType == KoChannelInfo::FLOAT32;
+}
+}
+
+KisOptimizedDitherBase *KisOptimizedDitherFactory::create(const KisOptimizedDitherBase::Parameters &params)
+{
+    if (!isValueTypeSupported(params.srcValueType) ||
+        !isValueTypeSupported(params.dstValueType) ||
+        (params.type != DITHER_BAYER && params.type != DITHER_BLUE_NOISE) ||
+        params.channelCount < 1 ||
+        params.channelCount > KisOptimizedDitherBase::maxChannelCount) {
+
+        return 0;
+    }
+
+    return createOptimizedClass<KisOptimizedDitherFactoryImpl>(params);
+}
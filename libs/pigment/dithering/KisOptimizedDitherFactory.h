@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERFACTORY_H
+#define KISOPTIMIZEDDITHERFACTORY_H
+
+#include "KisOptimizedDitherBase.h"
+
+/**
+ * \see KisOptimizedDitherBase
+ */
+class KRITAPIGMENT_EXPORT KisOptimizedDitherFactory
+{
+public:
+    /**
+     * Creates a dither op for \p params. Returns null if the depths,
+     * the dithering type or the number of channels are not supported,
+     * in which case the caller should fall back to the generic code.
+     */
+    static KisOptimizedDitherBase* create(const KisOptimizedDitherBase::Parameters &params);
+};
+
+#endif // KISOPTIMIZEDDITHERFACTORY_H
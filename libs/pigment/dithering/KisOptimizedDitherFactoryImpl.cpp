@@ -0,0 +1,17 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisOptimizedDitherFactoryImpl.h"
+
+#include "KisOptimizedDither.h"
+
+template<Vc::Implementation _impl>
+KisOptimizedDitherBase *KisOptimizedDitherFactoryImpl::create(ParamType params)
+{
+    return new KisOptimizedDither<_impl>(params);
+}
+
+template KisOptimizedDitherBase *KisOptimizedDitherFactoryImpl::create<Vc::CurrentImplementation::current()>(ParamType);
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISOPTIMIZEDDITHERFACTORYIMPL_H
+#define KISOPTIMIZEDDITHERFACTORYIMPL_H
+
+#include "KisOptimizedDitherBase.h"
+#include <KoVcMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KisOptimizedDitherFactoryImpl
+{
+public:
+    typedef KisOptimizedDitherBase::Parameters ParamType;
+    typedef KisOptimizedDitherBase* ReturnType;
+
+    template<Vc::Implementation _impl>
+    static KisOptimizedDitherBase* create(ParamType);
+};
+
+#endif // KISOPTIMIZEDDITHERFACTORYIMPL_H
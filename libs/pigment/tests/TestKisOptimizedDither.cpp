@@ -0,0 +1,154 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKisOptimizedDither.h"
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include "KoColorSpaceTraits.h"
+#include "KoColorModelStandardIds.h"
+#include "dithering/KisCmykDitherOpFactory.h"
+
+namespace {
+
+template<typename channels_type>
+channels_type randomChannel(QRandomGenerator &rnd) {
+    return channels_type(rnd.bounded(int(KoColorSpaceMathsTraits<channels_type>::unitValue) + 1));
+}
+
+template<>
+float randomChannel<float>(QRandomGenerator &rnd) {
+    return float(rnd.generateDouble());
+}
+
+template<typename channels_type>
+bool compareChannels(channels_type expected, channels_type actual)
+{
+    // the vector code may fuse multiplication and addition
+    return qAbs(int(expected) - int(actual)) <= 1;
+}
+
+template<>
+bool compareChannels<float>(float expected, float actual)
+{
+    return qAbs(expected - actual) <= 1e-6f * qMax(1.0f, qAbs(expected));
+}
+
+/**
+ * The rows are dithered with the optimized implementation, the
+ * per-pixel version of the op is still the generic one, so it is
+ * used as a reference. The width is not a multiple of the vector
+ * size and the offset is not aligned to the dithering pattern to
+ * cover the scalar tail of the rows.
+ */
+template<class srcTraits, class dstTraits, DitherType type, template<typename, typename, DitherType> class Op>
+void testDitherImpl()
+{
+    typedef typename srcTraits::channels_type src_type;
+    typedef typename dstTraits::channels_type dst_type;
+
+    const int width = 77;
+    const int height = 5;
+    const int x0 = 13;
+    const int y0 = 61;
+    const int numValues = width * height * srcTraits::channels_nb;
+
+    QRandomGenerator rnd(1234);
+
+    QVector<src_type> src(numValues);
+    for (int i = 0; i < numValues; i++) {
+        src[i] = randomChannel<src_type>(rnd);
+    }
+
+    QVector<dst_type> expected(numValues);
+    QVector<dst_type> actual(numValues);
+
+    Op<srcTraits, dstTraits, type> op(KoID(), KoID());
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int offset = (y * width + x) * srcTraits::channels_nb;
+            op.dither(reinterpret_cast<const quint8*>(src.constData() + offset),
+                      reinterpret_cast<quint8*>(expected.data() + offset),
+                      x0 + x, y0 + y);
+        }
+    }
+
+    op.dither(reinterpret_cast<const quint8*>(src.constData()), width * srcTraits::pixelSize,
+              reinterpret_cast<quint8*>(actual.data()), width * dstTraits::pixelSize,
+              x0, y0, width, height);
+
+    for (int i = 0; i < numValues; i++) {
+        QVERIFY2(compareChannels(expected[i], actual[i]),
+                 QString("value %1: %2 != %3").arg(i).arg(double(actual[i])).arg(double(expected[i])).toLatin1());
+    }
+}
+
+template<class U8Traits, class U16Traits, class F32Traits, template<typename, typename, DitherType> class Op>
+void testAllDepths()
+{
+    testDitherImpl<U8Traits, U8Traits, DITHER_BAYER, Op>();
+    testDitherImpl<U8Traits, U16Traits, DITHER_BAYER, Op>();
+    testDitherImpl<U8Traits, F32Traits, DITHER_BAYER, Op>();
+    testDitherImpl<U16Traits, U8Traits, DITHER_BAYER, Op>();
+    testDitherImpl<U16Traits, U16Traits, DITHER_BLUE_NOISE, Op>();
+    testDitherImpl<U16Traits, F32Traits, DITHER_BLUE_NOISE, Op>();
+    testDitherImpl<F32Traits, U8Traits, DITHER_BLUE_NOISE, Op>();
+    testDitherImpl<F32Traits, U16Traits, DITHER_BLUE_NOISE, Op>();
+    testDitherImpl<F32Traits, F32Traits, DITHER_BAYER, Op>();
+}
+
+}
+
+void TestKisOptimizedDither::testRgb()
+{
+    testAllDepths<KoBgrU8Traits, KoBgrU16Traits, KoRgbF32Traits, KisDitherOpImpl>();
+}
+
+void TestKisOptimizedDither::testGray()
+{
+    testAllDepths<KoGrayU8Traits, KoGrayU16Traits, KoGrayF32Traits, KisDitherOpImpl>();
+}
+
+void TestKisOptimizedDither::testCmyk()
+{
+    testAllDepths<KoCmykU8Traits, KoCmykU16Traits, KoCmykF32Traits, KisCmykDitherOpImpl>();
+}
+
+void TestKisOptimizedDither::testUnsupportedParameters()
+{
+    KisOptimizedDitherBase::Parameters params;
+    params.srcValueType = KoChannelInfo::UINT8;
+    params.dstValueType = KoChannelInfo::UINT16;
+    params.type = DITHER_BAYER;
+    params.channelCount = 4;
+    params.alphaPos = 3;
+    params.srcColorUnitValue = 255.0f;
+    params.dstColorUnitValue = 65535.0f;
+    params.truncateColorChannels = false;
+
+    QScopedPointer<KisOptimizedDitherBase> dither(KisOptimizedDitherFactory::create(params));
+    QVERIFY(dither);
+
+    params.type = DITHER_NONE;
+    dither.reset(KisOptimizedDitherFactory::create(params));
+    QVERIFY(!dither);
+
+    params.type = DITHER_BAYER;
+    params.dstValueType = KoChannelInfo::FLOAT16;
+    dither.reset(KisOptimizedDitherFactory::create(params));
+    QVERIFY(!dither);
+
+    params.dstValueType = KoChannelInfo::UINT16;
+    params.channelCount = KisOptimizedDitherBase::maxChannelCount + 1;
+    dither.reset(KisOptimizedDitherFactory::create(params));
+    QVERIFY(!dither);
+}
+
+QTEST_GUILESS_MAIN(TestKisOptimizedDither)
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKISOPTIMIZEDDITHER_H
+#define TESTKISOPTIMIZEDDITHER_H
+
+#include <QObject>
+
+class TestKisOptimizedDither : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRgb();
+    void testGray();
+    void testCmyk();
+    void testUnsupportedParameters();
+};
+
+#endif // TESTKISOPTIMIZEDDITHER_H
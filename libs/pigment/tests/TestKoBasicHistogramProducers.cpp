@@ -0,0 +1,55 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "TestKoBasicHistogramProducers.h"
+
+#include <simpletest.h>
+
+#include "KoBasicHistogramProducers.h"
+#include "KoColorSpaceRegistry.h"
+
+void TestKoBasicHistogramProducers::testU8SkipPixels()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KoBasicU8HistogramProducer producer(KoID("RGB8HISTO", "RGB8 Histogram"), cs);
+
+    // gray pixels, so that the bins of the color channels are the same
+    const quint8 pixels[] = {
+        10, 10, 10, 255, // selected
+        20, 20, 20, 255, // unselected
+        30, 30, 30, 0,   // transparent
+        40, 40, 40, 255  // partially selected
+    };
+    const quint8 selection[] = {255, 0, 255, 128};
+
+    producer.addRegionToBin(pixels, selection, 4, cs);
+    QCOMPARE(producer.count(), 2);
+    QCOMPARE(producer.getBinAt(0, 10), 1);
+    QCOMPARE(producer.getBinAt(0, 20), 0);
+    QCOMPARE(producer.getBinAt(0, 30), 0);
+    QCOMPARE(producer.getBinAt(0, 40), 1);
+
+    // without a selection mask all the pixels are selected
+    producer.clear();
+    producer.addRegionToBin(pixels, 0, 4, cs);
+    QCOMPARE(producer.count(), 3);
+    QCOMPARE(producer.getBinAt(0, 20), 1);
+
+    producer.clear();
+    producer.setSkipUnselected(false);
+    producer.addRegionToBin(pixels, selection, 4, cs);
+    QCOMPARE(producer.count(), 3);
+    QCOMPARE(producer.getBinAt(0, 20), 1);
+    QCOMPARE(producer.getBinAt(0, 30), 0);
+
+    producer.clear();
+    producer.setSkipTransparent(false);
+    producer.addRegionToBin(pixels, selection, 4, cs);
+    QCOMPARE(producer.count(), 4);
+    QCOMPARE(producer.getBinAt(0, 30), 1);
+}
+
+QTEST_GUILESS_MAIN(TestKoBasicHistogramProducers)
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef _TEST_KO_BASIC_HISTOGRAM_PRODUCERS_H_
+#define _TEST_KO_BASIC_HISTOGRAM_PRODUCERS_H_
+
+#include <QObject>
+
+class TestKoBasicHistogramProducers : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testU8SkipPixels();
+};
+
+#endif
@@ -0,0 +1,420 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "TestKoOptimizedCompositeOps.h"
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "KoColorSpaceTraits.h"
+#include "KoOptimizedCompositeOpFactory.h"
+#include "KoCompositeOpAlphaDarken.h"
+#include "KoAlphaDarkenParamsWrapper.h"
+#include "KoCompositeOpOver.h"
+#include "KoCompositeOpCopy2.h"
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpFunctions.h"
+#include "KoOptimizedHalfConversion.h"
+
+/**
+ * Compares the optimized composite ops against their scalar versions.
+ *
+ * The ops are created for the implementation selected for this CPU.
+ * CMake runs the test once more for every compiled implementation
+ * with KRITA_VC_IMPLEMENTATION set. The runs for the implementations
+ * not supported by the CPU are skipped, so to check all of them on a
+ * single machine run the tests under an emulator like Intel SDE.
+ *
+ * There are no AVX-512 and NEON implementations to test: Vc has no
+ * backends for them, AVX-512 CPUs use the AVX2 version and ARM builds
+ * use the scalar one.
+ */
+
+namespace {
+
+const int numRows = 7;
+const int numColumns = 67;
+
+template<typename channels_type>
+channels_type randomChannel(QRandomGenerator &rnd) {
+    return channels_type(rnd.bounded(int(KoColorSpaceMathsTraits<channels_type>::unitValue) + 1));
+}
+
+template<>
+float randomChannel<float>(QRandomGenerator &rnd) {
+    return float(rnd.generateDouble());
+}
+
+#ifdef HAVE_OPENEXR
+template<>
+half randomChannel<half>(QRandomGenerator &rnd) {
+    return half(float(rnd.generateDouble()));
+}
+#endif
+
+/**
+ * The vector versions compute in floating point and the reference
+ * ones in integers, so the results may differ by a few units in the
+ * last place.
+ *
+ * When the resulting alpha is low, the rounding error of the color
+ * channels is amplified by unpremultiplication. It is invisible
+ * though, so the color channels are compared premultiplied:
+ * \p weight is the normalized alpha of the pixel for them and 1.0
+ * for the alpha channel.
+ */
+template<typename channels_type>
+int toleranceLsb()
+{
+    return 1;
+}
+
+template<>
+int toleranceLsb<quint16>()
+{
+    return 4;
+}
+
+template<typename channels_type>
+bool compareChannels(channels_type expected, channels_type actual, qreal weight)
+{
+    return qAbs(int(expected) - int(actual)) * weight <= toleranceLsb<channels_type>();
+}
+
+template<>
+bool compareChannels<float>(float expected, float actual, qreal weight)
+{
+    Q_UNUSED(weight);
+    return qAbs(expected - actual) <= 1e-4f;
+}
+
+#ifdef HAVE_OPENEXR
+template<>
+bool compareChannels<half>(half expected, half actual, qreal weight)
+{
+    Q_UNUSED(weight);
+
+    /**
+     * The reference ops round every intermediate result to half, the
+     * optimized ones only the final one. The conversions themselves
+     * are checked for bit equality in testHalfConversion().
+     */
+    return qAbs(float(expected) - float(actual)) <= 4.0f / 1024.0f;
+}
+#endif
+
+template<class Traits>
+QVector<quint8> generatePixels(QRandomGenerator &rnd)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QVector<quint8> pixels(numRows * numColumns * Traits::pixelSize);
+    channels_type *ptr = reinterpret_cast<channels_type*>(pixels.data());
+
+    for (int i = 0; i < numRows * numColumns * int(Traits::channels_nb); i++) {
+        ptr[i] = randomChannel<channels_type>(rnd);
+    }
+
+    // cover the fast paths for fully transparent and opaque pixels
+    for (int i = 0; i < numRows * numColumns; i += 5) {
+        ptr[i * Traits::channels_nb + Traits::alpha_pos] = KoColorSpaceMathsTraits<channels_type>::zeroValue;
+    }
+    for (int i = 2; i < numRows * numColumns; i += 5) {
+        ptr[i * Traits::channels_nb + Traits::alpha_pos] = KoColorSpaceMathsTraits<channels_type>::unitValue;
+    }
+
+    return pixels;
+}
+
+template<class Traits>
+void compareOps(const KoCompositeOp *optimizedOp, const KoCompositeOp *referenceOp)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QVERIFY(optimizedOp);
+    QVERIFY(referenceOp);
+
+    QRandomGenerator rnd(4321);
+
+    const QVector<quint8> src = generatePixels<Traits>(rnd);
+    const QVector<quint8> dst = generatePixels<Traits>(rnd);
+
+    QVector<quint8> mask(numRows * numColumns);
+    for (int i = 0; i < mask.size(); i++) {
+        mask[i] = quint8(rnd.bounded(256));
+    }
+
+    struct Params {
+        float opacity;
+        float flow;
+        float averageOpacity;
+        bool useMask;
+    };
+
+    const Params testParams[] = {
+        {1.0f, 1.0f, 1.0f, false},
+        {0.5f, 1.0f, 0.5f, false},
+        {1.0f, 1.0f, 1.0f, true},
+        {0.7f, 0.3f, 0.9f, true},
+    };
+
+    for (const Params &p : testParams) {
+        QVector<quint8> expected = dst;
+        QVector<quint8> actual = dst;
+
+        KoCompositeOp::ParameterInfo params;
+        params.srcRowStart = src.constData();
+        params.srcRowStride = numColumns * Traits::pixelSize;
+        params.dstRowStride = numColumns * Traits::pixelSize;
+        params.maskRowStart = p.useMask ? mask.constData() : 0;
+        params.maskRowStride = p.useMask ? numColumns : 0;
+        params.rows = numRows;
+        params.cols = numColumns;
+        params.flow = p.flow;
+        params.setOpacityAndAverage(p.opacity, p.averageOpacity);
+
+        params.dstRowStart = expected.data();
+        referenceOp->composite(params);
+
+        params.dstRowStart = actual.data();
+        optimizedOp->composite(params);
+
+        const channels_type *e = reinterpret_cast<const channels_type*>(expected.constData());
+        const channels_type *a = reinterpret_cast<const channels_type*>(actual.constData());
+
+        for (int i = 0; i < numRows * numColumns * int(Traits::channels_nb); i++) {
+            const int alphaIndex = i - i % int(Traits::channels_nb) + Traits::alpha_pos;
+
+            const qreal weight = i == alphaIndex ? 1.0 :
+                qreal(qMax(e[alphaIndex], a[alphaIndex])) / qreal(KoColorSpaceMathsTraits<channels_type>::unitValue);
+
+            QVERIFY2(compareChannels(e[i], a[i], weight),
+                     QString("%1 (opacity %2, flow %3, mask %4), value %5: %6 != %7")
+                     .arg(optimizedOp->id()).arg(p.opacity).arg(p.flow).arg(p.useMask)
+                     .arg(i).arg(double(a[i])).arg(double(e[i])).toLatin1());
+        }
+    }
+}
+
+template<class Traits, class Op>
+void compareWithReference(KoCompositeOp *optimizedOp, const KoColorSpace *cs)
+{
+    QScopedPointer<KoCompositeOp> op(optimizedOp);
+    QScopedPointer<KoCompositeOp> referenceOp(new Op(cs));
+
+    compareOps<Traits>(op.data(), referenceOp.data());
+}
+
+template<class Traits, typename Traits::channels_type compositeFunc(typename Traits::channels_type, typename Traits::channels_type)>
+void compareBlendOpWithReference(const KoColorSpace *cs, const QString &id)
+{
+    QScopedPointer<KoCompositeOp> op(KoOptimizedCompositeOpFactory::createBlendOp32(cs, id));
+    QScopedPointer<KoCompositeOp> referenceOp(
+        new KoCompositeOpGenericSC<Traits, compositeFunc>(cs, id, KoCompositeOp::categoryArithmetic()));
+
+    compareOps<Traits>(op.data(), referenceOp.data());
+}
+
+}
+
+void TestKoOptimizedCompositeOps::initTestCase()
+{
+    const QByteArray forcedName = qgetenv("KRITA_VC_IMPLEMENTATION");
+    if (forcedName.isEmpty()) return;
+
+    Vc::Implementation impl = Vc::ScalarImpl;
+    QVERIFY2(vcImplementationFromName(forcedName, &impl), forcedName.constData());
+
+#ifdef HAVE_VC
+    if (impl != Vc::ScalarImpl && !Vc::isImplementationSupported(impl)) {
+        QSKIP("The vector implementation is not supported by the CPU");
+    }
+#endif
+
+    qDebug() << "Testing vector implementation" << forcedName;
+}
+
+void TestKoOptimizedCompositeOps::testOps32()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    QVERIFY(cs);
+
+    compareWithReference<KoBgrU8Traits, KoCompositeOpOver<KoBgrU8Traits>>(KoOptimizedCompositeOpFactory::createOverOp32(cs), cs);
+    compareWithReference<KoBgrU8Traits, KoCompositeOpCopy2<KoBgrU8Traits>>(KoOptimizedCompositeOpFactory::createCopyOp32(cs), cs);
+    compareWithReference<KoBgrU8Traits, KoCompositeOpAlphaDarken<KoBgrU8Traits, KoAlphaDarkenParamsWrapperHard>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpHard32(cs), cs);
+    compareWithReference<KoBgrU8Traits, KoCompositeOpAlphaDarken<KoBgrU8Traits, KoAlphaDarkenParamsWrapperCreamy>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamy32(cs), cs);
+
+    compareBlendOpWithReference<KoBgrU8Traits, &cfMultiply<quint8>>(cs, COMPOSITE_MULT);
+    compareBlendOpWithReference<KoBgrU8Traits, &cfScreen<quint8>>(cs, COMPOSITE_SCREEN);
+    compareBlendOpWithReference<KoBgrU8Traits, &cfDarkenOnly<quint8>>(cs, COMPOSITE_DARKEN);
+}
+
+void TestKoOptimizedCompositeOps::testOps128()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+    QVERIFY(cs);
+
+    compareWithReference<KoRgbF32Traits, KoCompositeOpOver<KoRgbF32Traits>>(KoOptimizedCompositeOpFactory::createOverOp128(cs), cs);
+    compareWithReference<KoRgbF32Traits, KoCompositeOpCopy2<KoRgbF32Traits>>(KoOptimizedCompositeOpFactory::createCopyOp128(cs), cs);
+    compareWithReference<KoRgbF32Traits, KoCompositeOpAlphaDarken<KoRgbF32Traits, KoAlphaDarkenParamsWrapperHard>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpHard128(cs), cs);
+    compareWithReference<KoRgbF32Traits, KoCompositeOpAlphaDarken<KoRgbF32Traits, KoAlphaDarkenParamsWrapperCreamy>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamy128(cs), cs);
+}
+
+void TestKoOptimizedCompositeOps::testOpsU64()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+    QVERIFY(cs);
+
+    compareWithReference<KoBgrU16Traits, KoCompositeOpOver<KoBgrU16Traits>>(KoOptimizedCompositeOpFactory::createOverOpU64(cs), cs);
+    compareWithReference<KoBgrU16Traits, KoCompositeOpCopy2<KoBgrU16Traits>>(KoOptimizedCompositeOpFactory::createCopyOpU64(cs), cs);
+    compareWithReference<KoBgrU16Traits, KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperHard>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardU64(cs), cs);
+    compareWithReference<KoBgrU16Traits, KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyU64(cs), cs);
+}
+
+void TestKoOptimizedCompositeOps::testOpsF16()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float16BitsColorDepthID.id(), 0);
+    QVERIFY(cs);
+
+    compareWithReference<KoRgbF16Traits, KoCompositeOpOver<KoRgbF16Traits>>(KoOptimizedCompositeOpFactory::createOverOpF16(cs), cs);
+    compareWithReference<KoRgbF16Traits, KoCompositeOpCopy2<KoRgbF16Traits>>(KoOptimizedCompositeOpFactory::createCopyOpF16(cs), cs);
+    compareWithReference<KoRgbF16Traits, KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperHard>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(cs), cs);
+    compareWithReference<KoRgbF16Traits, KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>>(
+        KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs), cs);
+#else
+    QSKIP("Krita is built without OpenEXR, half-float colorspaces are not available");
+#endif
+}
+
+#if defined HAVE_VC && defined HAVE_OPENEXR
+
+namespace {
+
+quint32 floatBits(float value)
+{
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float floatFromBits(quint32 bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+}
+
+#endif
+
+void TestKoOptimizedCompositeOps::testHalfConversion()
+{
+#if defined HAVE_VC && defined HAVE_OPENEXR
+    using Conversion = KoOptimizedHalfConversion<Vc::CurrentImplementation::current()>;
+    using int_v = Conversion::int_v;
+
+    const int vectorSize = int(Vc::float_v::size());
+
+    // every half value converts into exactly the same float
+    for (int i = 0; i < 0x10000; i += vectorSize) {
+        int_v bits;
+        for (int j = 0; j < vectorSize; j++) {
+            bits[j] = i + j;
+        }
+
+        const Vc::float_v values = Conversion::toFloat(bits);
+
+        for (int j = 0; j < vectorSize; j++) {
+            half reference;
+            reference.setBits(quint16(i + j));
+
+            if (reference.isNan()) {
+                QVERIFY(std::isnan(float(values[j])));
+            } else {
+                QCOMPARE(floatBits(values[j]), floatBits(float(reference)));
+            }
+        }
+    }
+
+    /**
+     * Floats are rounded the same way as the scalar `half` does it:
+     * check every half value, the ties between the neighbouring
+     * values and the floats right next to the ties, the overflow
+     * boundary and random bit patterns.
+     */
+    QVector<float> floats;
+
+    for (int i = 0; i < 0x7c00; i++) {
+        half lo, hi;
+        lo.setBits(quint16(i));
+        hi.setBits(quint16(i + 1));
+
+        const float tie = 0.5f * (float(lo) + float(hi));
+
+        floats << float(lo) << tie
+               << std::nextafter(tie, 0.0f)
+               << std::nextafter(tie, std::numeric_limits<float>::infinity());
+    }
+
+    floats << 65504.0f << 65519.0f << 65520.0f << 1e10f
+           << std::numeric_limits<float>::infinity()
+           << std::numeric_limits<float>::quiet_NaN()
+           << std::numeric_limits<float>::denorm_min();
+
+    QRandomGenerator rnd(42);
+    for (int i = 0; i < 100000; i++) {
+        floats << floatFromBits(rnd.generate());
+    }
+
+    const int numPositive = floats.size();
+    for (int i = 0; i < numPositive; i++) {
+        floats << -floats[i];
+    }
+
+    while (floats.size() % vectorSize) {
+        floats << 0.0f;
+    }
+
+    for (int i = 0; i < floats.size(); i += vectorSize) {
+        const Vc::float_v values(floats.constData() + i, Vc::Unaligned);
+        const int_v bits = Conversion::fromFloat(values);
+
+        for (int j = 0; j < vectorSize; j++) {
+            const half reference(floats[i + j]);
+            const quint16 result = quint16(bits[j]);
+
+            if (reference.isNan()) {
+                QVERIFY((result & 0x7c00) == 0x7c00 && (result & 0x03ff));
+            } else {
+                QCOMPARE(result, reference.bits());
+            }
+        }
+    }
+#else
+    QSKIP("Krita is built without Vc or OpenEXR");
+#endif
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedCompositeOps)
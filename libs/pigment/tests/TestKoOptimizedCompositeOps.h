@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDCOMPOSITEOPS_H
+#define TESTKOOPTIMIZEDCOMPOSITEOPS_H
+
+#include <QObject>
+
+class TestKoOptimizedCompositeOps : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testOps32();
+    void testOps128();
+    void testOpsU64();
+    void testOpsF16();
+    void testHalfConversion();
+};
+
+#endif // TESTKOOPTIMIZEDCOMPOSITEOPS_H
@@ -0,0 +1,290 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "TestKoOptimizedPixelOps.h"
+
+#include <simpletest.h>
+
+#include <QBitArray>
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include "KoBgrColorSpaceTraits.h"
+#include "KoColorModelStandardIds.h"
+#include "KoMixColorsOpImpl.h"
+#include "KoConvolutionOpImpl.h"
+#include "KoNormalisedChannelsOp.h"
+#include "KoOptimizedPixelOpsFactory.h"
+
+namespace {
+
+template<typename channels_type>
+channels_type randomChannel(QRandomGenerator &rnd) {
+    return channels_type(rnd.bounded(int(KoColorSpaceMathsTraits<channels_type>::unitValue) + 1));
+}
+
+template<>
+float randomChannel<float>(QRandomGenerator &rnd) {
+    return float(rnd.generateDouble());
+}
+
+template<class Traits>
+QVector<quint8> generatePixels(int numPixels, QRandomGenerator &rnd)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QVector<quint8> pixels(numPixels * Traits::pixelSize);
+    channels_type *ptr = reinterpret_cast<channels_type*>(pixels.data());
+
+    for (int i = 0; i < numPixels * int(Traits::channels_nb); i++) {
+        ptr[i] = randomChannel<channels_type>(rnd);
+    }
+
+    // every 7th pixel is fully transparent
+    for (int i = 0; i < numPixels; i += 7) {
+        ptr[i * Traits::channels_nb + Traits::alpha_pos] = KoColorSpaceMathsTraits<channels_type>::zeroValue;
+    }
+
+    return pixels;
+}
+
+template<typename channels_type>
+void comparePixels(const quint8 *expected, const quint8 *actual)
+{
+    const channels_type *e = reinterpret_cast<const channels_type*>(expected);
+    const channels_type *a = reinterpret_cast<const channels_type*>(actual);
+
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(a[i], e[i]);
+    }
+}
+
+template<>
+void comparePixels<float>(const quint8 *expected, const quint8 *actual)
+{
+    const float *e = reinterpret_cast<const float*>(expected);
+    const float *a = reinterpret_cast<const float*>(actual);
+
+    for (int i = 0; i < 4; i++) {
+        QVERIFY2(qAbs(a[i] - e[i]) <= 1e-5f * qMax(1.0f, qAbs(e[i])),
+                 QString("channel %1: %2 != %3").arg(i).arg(a[i]).arg(e[i]).toLatin1());
+    }
+}
+
+template<class Traits>
+void testMixColorsImpl(const KoID &depthId)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QScopedPointer<KoMixColorsOp> genericOp(new KoMixColorsOpImpl<Traits>());
+    QScopedPointer<KoMixColorsOp> optimizedOp(KoOptimizedPixelOpsFactory::createMixColorsOp(depthId, 4, 3));
+    QVERIFY(optimizedOp);
+
+    QRandomGenerator rnd(42);
+
+    const int numPixels = 4099;
+    const QVector<quint8> pixels = generatePixels<Traits>(numPixels, rnd);
+
+    QVector<const quint8*> pointers(numPixels);
+    for (int i = 0; i < numPixels; i++) {
+        pointers[i] = pixels.data() + i * Traits::pixelSize;
+    }
+
+    QVector<qint16> weights(numPixels);
+    int weightSum = 0;
+    for (int i = 0; i < numPixels; i++) {
+        weights[i] = qint16(rnd.bounded(256));
+        weightSum += weights[i];
+    }
+
+    QVector<qint16> heavyWeights(numPixels);
+    for (int i = 0; i < numPixels; i++) {
+        heavyWeights[i] = qint16(rnd.bounded(32768));
+    }
+
+    quint8 expected[Traits::pixelSize];
+    quint8 actual[Traits::pixelSize];
+
+    genericOp->mixColors(pixels.constData(), weights.constData(), numPixels, expected, weightSum);
+    optimizedOp->mixColors(pixels.constData(), weights.constData(), numPixels, actual, weightSum);
+    comparePixels<channels_type>(expected, actual);
+
+    genericOp->mixColors(pointers.constData(), weights.constData(), numPixels, expected, weightSum);
+    optimizedOp->mixColors(pointers.constData(), weights.constData(), numPixels, actual, weightSum);
+    comparePixels<channels_type>(expected, actual);
+
+    genericOp->mixColors(pixels.constData(), numPixels, expected);
+    optimizedOp->mixColors(pixels.constData(), numPixels, actual);
+    comparePixels<channels_type>(expected, actual);
+
+    genericOp->mixColors(pixels.constData(), heavyWeights.constData(), 64, expected, 64 * 32767);
+    optimizedOp->mixColors(pixels.constData(), heavyWeights.constData(), 64, actual, 64 * 32767);
+    comparePixels<channels_type>(expected, actual);
+
+    QScopedPointer<KoMixColorsOp::Mixer> genericMixer(genericOp->createMixer());
+    QScopedPointer<KoMixColorsOp::Mixer> optimizedMixer(optimizedOp->createMixer());
+
+    for (int offset = 0; offset + 1000 <= numPixels; offset += 1000) {
+        const quint8 *data = pixels.constData() + offset * Traits::pixelSize;
+
+        genericMixer->accumulate(data, heavyWeights.constData() + offset, 1000 * 16384, 1000);
+        optimizedMixer->accumulate(data, heavyWeights.constData() + offset, 1000 * 16384, 1000);
+
+        genericMixer->accumulateAverage(data, 1000);
+        optimizedMixer->accumulateAverage(data, 1000);
+
+        QCOMPARE(optimizedMixer->currentWeightsSum(), genericMixer->currentWeightsSum());
+
+        genericMixer->computeMixedColor(expected);
+        optimizedMixer->computeMixedColor(actual);
+        comparePixels<channels_type>(expected, actual);
+    }
+
+    const qreal weight = 0.3;
+    QVector<quint8> expectedArray(16 * Traits::pixelSize);
+    QVector<quint8> actualArray(16 * Traits::pixelSize);
+
+    genericOp->mixTwoColorArrays(pixels.constData(), pixels.constData() + 16 * Traits::pixelSize, 16, weight, expectedArray.data());
+    optimizedOp->mixTwoColorArrays(pixels.constData(), pixels.constData() + 16 * Traits::pixelSize, 16, weight, actualArray.data());
+
+    for (int i = 0; i < 16; i++) {
+        comparePixels<channels_type>(expectedArray.constData() + i * Traits::pixelSize,
+                                     actualArray.constData() + i * Traits::pixelSize);
+    }
+}
+
+template<class Traits>
+void testConvolutionImpl(const KoID &depthId)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    QScopedPointer<KoConvolutionOp> genericOp(new KoConvolutionOpImpl<Traits>());
+    QScopedPointer<KoConvolutionOp> optimizedOp(KoOptimizedPixelOpsFactory::createConvolutionOp(depthId, 4, 3));
+    QVERIFY(optimizedOp);
+
+    QRandomGenerator rnd(17);
+
+    const int kernelSize = 49;
+    const QVector<quint8> pixels = generatePixels<Traits>(kernelSize, rnd);
+
+    QVector<const quint8*> pointers(kernelSize);
+    QVector<qreal> kernel(kernelSize);
+    qreal kernelSum = 0;
+
+    for (int i = 0; i < kernelSize; i++) {
+        pointers[i] = pixels.data() + i * Traits::pixelSize;
+        kernel[i] = rnd.bounded(7) - 1;
+        kernelSum += kernel[i];
+    }
+
+    QBitArray colorChannelsOnly(4, true);
+    colorChannelsOnly.clearBit(Traits::alpha_pos);
+
+    const QVector<QBitArray> channelFlags = {QBitArray(), colorChannelsOnly};
+    const QVector<qreal> factors = {kernelSum, kernelSum * 3.0, 1.0};
+
+    quint8 expected[Traits::pixelSize];
+    quint8 actual[Traits::pixelSize];
+
+    Q_FOREACH (const QBitArray &flags, channelFlags) {
+        Q_FOREACH (qreal factor, factors) {
+            memset(expected, 0, sizeof(expected));
+            memset(actual, 0, sizeof(actual));
+
+            genericOp->convolveColors(pointers.constData(), kernel.constData(), expected, factor, 0, kernelSize, flags);
+            optimizedOp->convolveColors(pointers.constData(), kernel.constData(), actual, factor, 0, kernelSize, flags);
+            comparePixels<channels_type>(expected, actual);
+
+            // the first pixel is fully transparent, skipping it covers the case A)
+            genericOp->convolveColors(pointers.constData() + 1, kernel.constData() + 1, expected, factor, 0, 6, flags);
+            optimizedOp->convolveColors(pointers.constData() + 1, kernel.constData() + 1, actual, factor, 0, 6, flags);
+            comparePixels<channels_type>(expected, actual);
+        }
+    }
+}
+
+template<class Traits>
+void testNormalisedChannelsImpl(const KoID &depthId)
+{
+    QRandomGenerator rnd(19);
+
+    QScopedPointer<KoNormalisedChannelsOp> op(KoOptimizedPixelOpsFactory::createNormalisedChannelsOp(depthId));
+    QVERIFY(op);
+
+    // an odd number of pixels covers the scalar tail of the vector loop
+    const int numPixels = 37;
+    const QVector<quint8> pixels = generatePixels<Traits>(numPixels, rnd);
+
+    QVector<float> actual(numPixels * Traits::channels_nb);
+    op->normalise(pixels.constData(), actual.data(), numPixels * Traits::channels_nb);
+
+    QVector<float> expected(Traits::channels_nb);
+    for (int i = 0; i < numPixels; i++) {
+        Traits::normalisedChannelsValue(pixels.constData() + i * Traits::pixelSize, expected);
+
+        for (int ch = 0; ch < int(Traits::channels_nb); ch++) {
+            QCOMPARE(actual[i * Traits::channels_nb + ch], expected[ch]);
+        }
+    }
+}
+
+}
+
+void TestKoOptimizedPixelOps::testMixColorsU8()
+{
+    testMixColorsImpl<KoBgrU8Traits>(Integer8BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testMixColorsU16()
+{
+    testMixColorsImpl<KoBgrU16Traits>(Integer16BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testMixColorsF32()
+{
+    testMixColorsImpl<KoBgrF32Traits>(Float32BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testConvolutionU8()
+{
+    testConvolutionImpl<KoBgrU8Traits>(Integer8BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testConvolutionU16()
+{
+    testConvolutionImpl<KoBgrU16Traits>(Integer16BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testConvolutionF32()
+{
+    testConvolutionImpl<KoBgrF32Traits>(Float32BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testNormalisedChannelsU8()
+{
+    testNormalisedChannelsImpl<KoBgrU8Traits>(Integer8BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testNormalisedChannelsU16()
+{
+    testNormalisedChannelsImpl<KoBgrU16Traits>(Integer16BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testNormalisedChannelsF32()
+{
+    testNormalisedChannelsImpl<KoBgrF32Traits>(Float32BitsColorDepthID);
+}
+
+void TestKoOptimizedPixelOps::testUnsupportedLayouts()
+{
+    QVERIFY(!KoOptimizedPixelOpsFactory::createMixColorsOp(Integer8BitsColorDepthID, 5, 4));
+    QVERIFY(!KoOptimizedPixelOpsFactory::createMixColorsOp(Integer16BitsColorDepthID, 2, 1));
+    QVERIFY(!KoOptimizedPixelOpsFactory::createConvolutionOp(Float16BitsColorDepthID, 4, 3));
+    QVERIFY(!KoOptimizedPixelOpsFactory::createConvolutionOp(Float64BitsColorDepthID, 4, 3));
+    QVERIFY(!KoOptimizedPixelOpsFactory::createNormalisedChannelsOp(Float16BitsColorDepthID));
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedPixelOps)
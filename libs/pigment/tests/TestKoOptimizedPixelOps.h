@@ -0,0 +1,28 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef TESTKOOPTIMIZEDPIXELOPS_H
+#define TESTKOOPTIMIZEDPIXELOPS_H
+
+#include <QObject>
+
+class TestKoOptimizedPixelOps : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMixColorsU8();
+    void testMixColorsU16();
+    void testMixColorsF32();
+    void testConvolutionU8();
+    void testConvolutionU16();
+    void testConvolutionF32();
+    void testNormalisedChannelsU8();
+    void testNormalisedChannelsU16();
+    void testNormalisedChannelsF32();
+    void testUnsupportedLayouts();
+};
+
+#endif // TESTKOOPTIMIZEDPIXELOPS_H
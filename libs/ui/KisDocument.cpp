@@ -2033,6 +2033,8 @@ void KisDocument::slotConfigChanged()
         d->undoStack->setUndoLimit(cfg.undoStackLimit());
     }
 
+    d->undoStack->setUndoMemoryLimit(qint64(cfg.undoStackMemoryLimit()) * 1024 * 1024);
+
     d->autoSaveDelay = cfg.autoSaveInterval();
     setNormalAutoSaveInterval();
 }
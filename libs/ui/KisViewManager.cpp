@@ -403,6 +403,7 @@ void KisViewManager::setCurrentView(KisView *view)
         KisDocument* doc = d->currentImageView->document();
         if (doc) {
             doc->image()->compositeProgressProxy()->removeProxy(d->persistentImageProgressUpdater);
+            doc->image()->setBackgroundMemoryPriority(true);
             doc->disconnect(this);
         }
         d->currentImageView->canvasController()->proxyObject->disconnect(&d->statusBar);
@@ -420,6 +421,9 @@ void KisViewManager::setCurrentView(KisView *view)
         // Wait for the async image to have loaded
         KisDocument* doc = imageView->document();
 
+        // the swapper evicts the tiles of the other documents first
+        doc->image()->setBackgroundMemoryPriority(false);
+
         if (KisConfig(true).readEntry<bool>("EnablePositionLabel", false)) {
             connect(d->currentImageView->canvasController()->proxyObject,
                     SIGNAL(documentMousePositionChanged(QPointF)),
@@ -156,6 +156,16 @@ void KisConfig::setUndoStackLimit(int limit) const
     m_cfg.writeEntry("undoStackLimit", limit);
 }
 
+int KisConfig::undoStackMemoryLimit(bool defaultValue) const
+{
+    return (defaultValue ? 0 : m_cfg.readEntry("undoStackMemoryLimit", 0));
+}
+
+void KisConfig::setUndoStackMemoryLimit(int limit) const
+{
+    m_cfg.writeEntry("undoStackMemoryLimit", limit);
+}
+
 bool KisConfig::useCumulativeUndoRedo(bool defaultValue) const
 {
     return (defaultValue ? false : m_cfg.readEntry("useCumulativeUndoRedo",false));
@@ -58,6 +58,13 @@ public:
     int undoStackLimit(bool defaultValue = false) const;
     void setUndoStackLimit(int limit) const;
 
+    /**
+     * @return the maximum amount of memory the undo history of
+     * a document may occupy, in MiB. Zero means no limit.
+     */
+    int undoStackMemoryLimit(bool defaultValue = false) const;
+    void setUndoStackMemoryLimit(int limit) const;
+
     bool useCumulativeUndoRedo(bool defaultValue = false) const;
     void setCumulativeUndoRedo(bool value);
 
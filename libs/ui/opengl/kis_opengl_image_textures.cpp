@@ -32,6 +32,7 @@
 #include <QVector3D>
 #include "kis_painting_tweaks.h"
 #include "KisOpenGLBufferCreationGuard.h"
+#include "KisUpdatePipelineTracer.h"
 
 #ifdef HAVE_OPENEXR
 #include <half.h>
@@ -314,6 +315,15 @@ KisOpenGLUpdateInfoSP KisOpenGLImageTextures::updateCacheNoConversion(const QRec
 KisOpenGLUpdateInfoSP KisOpenGLImageTextures::updateCacheImpl(const QRect& rect, KisImageSP srcImage, bool convertColorSpace)
 {
     if (!m_initialized) return new KisOpenGLUpdateInfo();
+
+    KisUpdatePipelineTraceScope traceScope("canvas");
+
+    if (traceScope.isActive()) {
+        traceScope.setName("Convert Canvas Tiles");
+        traceScope.addArg("rect", rect);
+        traceScope.addArg("convertColorSpace", convertColorSpace);
+    }
+
     return m_updateInfoBuilder.buildUpdateInfo(rect, srcImage, convertColorSpace);
 }
 
@@ -327,6 +337,14 @@ void KisOpenGLImageTextures::recalculateCache(KisUpdateInfoSP info, bool blockMi
     KisOpenGLUpdateInfoSP glInfo = dynamic_cast<KisOpenGLUpdateInfo*>(info.data());
     if(!glInfo) return;
 
+    KisUpdatePipelineTraceScope traceScope("canvas");
+
+    if (traceScope.isActive()) {
+        traceScope.setName("Upload Canvas Textures");
+        traceScope.addArg("rect", glInfo->dirtyImageRect());
+        traceScope.addArg("numTiles", glInfo->tileList.size());
+    }
+
     QScopedPointer<KisOpenGLSync> sync;
     int numProcessedTiles = 0;
 
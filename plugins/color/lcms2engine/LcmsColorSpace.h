@@ -159,6 +159,12 @@ class LcmsColorSpace : public KoColorSpaceAbstract<_CSTraits>, public KoLcmsInfo
 
     typedef KisLocklessStack<KisLcmsLastTransformationSP> KisLcmsTransformationStack;
 
+    /**
+     * The number of pixels converted to/from QColor with a single
+     * lcms call, the buffer is allocated on the stack
+     */
+    static const int qcolorChunkSize = 256;
+
     struct Private {
         KoLcmsDefaultTransformations *defaultTransformations;
 
@@ -250,20 +256,22 @@ public:
 
     void fromQColor(const QColor &color, quint8 *dst, const KoColorProfile *koprofile = 0) const override
     {
-        std::array<quint8, 3> qcolordata;
+        fromQColors(&color, dst, 1, koprofile);
+    }
 
-        qcolordata[2] = static_cast<quint8>(color.red());
-        qcolordata[1] = static_cast<quint8>(color.green());
-        qcolordata[0] = static_cast<quint8>(color.blue());
+    void fromQColors(const QColor *colors, quint8 *dst, qint32 nPixels, const KoColorProfile *koprofile = 0) const override
+    {
+        std::array<quint8, 3 * qcolorChunkSize> qcolordata;
 
         LcmsColorProfileContainer *profile = asLcmsProfile(koprofile);
+        KisLcmsLastTransformationSP last;
+        cmsHTRANSFORM transform = 0;
+
         if (profile == 0) {
             // Default sRGB
             KIS_ASSERT(d->defaultTransformations && d->defaultTransformations->fromRGB);
-
-            cmsDoTransform(d->defaultTransformations->fromRGB, qcolordata.data(), dst, 1);
+            transform = d->defaultTransformations->fromRGB;
         } else {
-            KisLcmsLastTransformationSP last;
             while (d->fromRGBCachedTransformations.pop(last) && last->transform && last->profile != profile->lcmsProfile()) {
                 last.reset();
             }
@@ -276,24 +284,56 @@ public:
             }
 
             KIS_ASSERT(last->transform);
-            cmsDoTransform(last->transform, qcolordata.data(), dst, 1);
-            d->fromRGBCachedTransformations.push(last);
+            transform = last->transform;
+        }
+
+        /**
+         * The colors are converted in chunks, so that lcms is called
+         * once per chunk instead of once per pixel
+         */
+        while (nPixels > 0) {
+            const int chunkSize = qMin(nPixels, qint32(qcolorChunkSize));
+
+            for (int i = 0; i < chunkSize; i++) {
+                qcolordata[3 * i + 2] = static_cast<quint8>(colors[i].red());
+                qcolordata[3 * i + 1] = static_cast<quint8>(colors[i].green());
+                qcolordata[3 * i + 0] = static_cast<quint8>(colors[i].blue());
+            }
+
+            cmsDoTransform(transform, qcolordata.data(), dst, chunkSize);
+
+            for (int i = 0; i < chunkSize; i++) {
+                _CSTraits::setOpacity(dst, static_cast<quint8>(colors[i].alpha()), 1);
+                dst += _CSTraits::pixelSize;
+            }
+
+            colors += chunkSize;
+            nPixels -= chunkSize;
         }
 
-        this->setOpacity(dst, static_cast<quint8>(color.alpha()), 1);
+        if (last) {
+            d->fromRGBCachedTransformations.push(last);
+        }
     }
 
     void toQColor(const quint8 *src, QColor *c, const KoColorProfile *koprofile = 0) const override
     {
-        std::array<quint8, 3> qcolordata;
+        toQColors(src, c, 1, koprofile);
+    }
+
+    void toQColors(const quint8 *src, QColor *colors, qint32 nPixels, const KoColorProfile *koprofile = 0) const override
+    {
+        std::array<quint8, 3 * qcolorChunkSize> qcolordata;
 
         LcmsColorProfileContainer *profile = asLcmsProfile(koprofile);
+        KisLcmsLastTransformationSP last;
+        cmsHTRANSFORM transform = 0;
+
         if (profile == 0) {
             // Default sRGB transform
             Q_ASSERT(d->defaultTransformations && d->defaultTransformations->toRGB);
-            cmsDoTransform(d->defaultTransformations->toRGB, src, qcolordata.data(), 1);
+            transform = d->defaultTransformations->toRGB;
         } else {
-            KisLcmsLastTransformationSP last;
             while (d->toRGBCachedTransformations.pop(last) && last->transform && last->profile != profile->lcmsProfile()) {
                 last.reset();
             }
@@ -306,11 +346,27 @@ public:
             }
 
             KIS_ASSERT(last->transform);
-            cmsDoTransform(last->transform, src, qcolordata.data(), 1);
+            transform = last->transform;
+        }
+
+        while (nPixels > 0) {
+            const int chunkSize = qMin(nPixels, qint32(qcolorChunkSize));
+
+            cmsDoTransform(transform, src, qcolordata.data(), chunkSize);
+
+            for (int i = 0; i < chunkSize; i++) {
+                colors[i].setRgb(qcolordata[3 * i + 2], qcolordata[3 * i + 1], qcolordata[3 * i + 0]);
+                colors[i].setAlpha(_CSTraits::opacityU8(src));
+                src += _CSTraits::pixelSize;
+            }
+
+            colors += chunkSize;
+            nPixels -= chunkSize;
+        }
+
+        if (last) {
             d->toRGBCachedTransformations.push(last);
         }
-        c->setRgb(qcolordata[2], qcolordata[1], qcolordata[0]);
-        c->setAlpha(this->opacityU8(src));
     }
 
     KoColorTransformation *createBrightnessContrastAdjustment(const quint16 *transferValues) const override
@@ -0,0 +1,176 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef LCMSOPTIMIZEDRGBSHAPERTRANSFORMATION_H
+#define LCMSOPTIMIZEDRGBSHAPERTRANSFORMATION_H
+
+#include <QScopedPointer>
+
+#include <KoConfig.h>
+
+#include "KoColorSpace.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformationFactory.h"
+#include "KoOptimizedRgbShaperFactory.h"
+#include "kis_assert.h"
+
+
+/**
+ * A conversion between two RGB profiles with the same primaries
+ * that bypasses lcms and uses KoOptimizedRgbShaper instead
+ */
+class LcmsOptimizedRgbShaperTransformation : public KoColorConversionTransformation
+{
+public:
+    LcmsOptimizedRgbShaperTransformation(const KoColorSpace* srcCs,
+                                         KoOptimizedRgbShaperBase::TransferFunction srcTransfer,
+                                         const KoColorSpace* dstCs,
+                                         KoOptimizedRgbShaperBase::TransferFunction dstTransfer,
+                                         Intent renderingIntent,
+                                         ConversionFlags conversionFlags)
+        : KoColorConversionTransformation(srcCs,
+                                          dstCs,
+                                          renderingIntent,
+                                          conversionFlags),
+          m_shaper(KoOptimizedRgbShaperFactory::create(srcCs->colorDepthId(), srcTransfer,
+                                                       dstCs->colorDepthId(), dstTransfer))
+    {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(m_shaper);
+    }
+
+    static bool canConvert(const KoColorSpace* srcCs, const KoColorSpace* dstCs) {
+        return KoOptimizedRgbShaperFactory::isDepthSupported(srcCs->colorDepthId()) &&
+            KoOptimizedRgbShaperFactory::isDepthSupported(dstCs->colorDepthId());
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+        KIS_ASSERT(src != dst);
+        KIS_SAFE_ASSERT_RECOVER_RETURN(m_shaper);
+
+        m_shaper->transform(src, dst, nPixels);
+    }
+
+private:
+    QScopedPointer<KoOptimizedRgbShaperBase> m_shaper;
+};
+
+class LcmsOptimizedRgbShaperTransformationFactory : public KoColorConversionTransformationFactory
+{
+public:
+    LcmsOptimizedRgbShaperTransformationFactory(const KoID &srcDepthId,
+                                                const QString &srcProfile,
+                                                KoOptimizedRgbShaperBase::TransferFunction srcTransfer,
+                                                const KoID &dstDepthId,
+                                                const QString &dstProfile,
+                                                KoOptimizedRgbShaperBase::TransferFunction dstTransfer)
+        : KoColorConversionTransformationFactory(RGBAColorModelID.id(),
+                                                 srcDepthId.id(),
+                                                 srcProfile,
+                                                 RGBAColorModelID.id(),
+                                                 dstDepthId.id(),
+                                                 dstProfile),
+          m_srcTransfer(srcTransfer),
+          m_dstTransfer(dstTransfer)
+    {
+    }
+
+    bool conserveColorInformation() const override {
+        return true;
+    }
+
+    bool conserveDynamicRange() const override {
+        return
+            dstColorDepthId() == Float32BitsColorDepthID.id() ||
+            (dstColorDepthId() == Float16BitsColorDepthID.id() &&
+             srcColorDepthId() != Float32BitsColorDepthID.id()) ||
+            (srcColorDepthId() != Float16BitsColorDepthID.id() &&
+             srcColorDepthId() != Float32BitsColorDepthID.id());
+    }
+
+    KoColorConversionTransformation* createColorTransformation(const KoColorSpace* srcColorSpace,
+                                                               const KoColorSpace* dstColorSpace,
+                                                               KoColorConversionTransformation::Intent renderingIntent,
+                                                               KoColorConversionTransformation::ConversionFlags conversionFlags) const override
+    {
+        return new LcmsOptimizedRgbShaperTransformation(srcColorSpace, m_srcTransfer,
+                                                        dstColorSpace, m_dstTransfer,
+                                                        renderingIntent,
+                                                        conversionFlags);
+    }
+
+private:
+    KoOptimizedRgbShaperBase::TransferFunction m_srcTransfer;
+    KoOptimizedRgbShaperBase::TransferFunction m_dstTransfer;
+};
+
+/**
+ * Adds the outgoing conversions from \p srcDepthId to all the profiles
+ * that share the primaries with the source one and differ only in the
+ * transfer curve or depth. The conversion system picks direct links
+ * before routing the conversion through the ICC engine, so these
+ * conversions are preferred over lcms.
+ *
+ * The profiles are the ones shipped with Krita that come in both
+ * linear and sRGB-curve variants. KoColorConversionSystem connects
+ * only the links whose profiles are registered, the links to the
+ * missing profiles are kept pending until they are added.
+ */
+inline void addOptimizedRgbShaperConversions(QList<KoColorConversionTransformationFactory*> &list,
+                                             const KoID &srcDepthId)
+{
+    if (!KoOptimizedRgbShaperFactory::isDepthSupported(srcDepthId)) return;
+
+    static const char * const profileFamilies[] = {
+        "sRGB-elle-V2",
+        "sRGB-elle-V4",
+        "Rec2020-elle-V2",
+        "Rec2020-elle-V4",
+        "ACEScg-elle-V2",
+        "ACEScg-elle-V4",
+        "ClayRGB-elle-V2",
+        "ClayRGB-elle-V4"
+    };
+
+    struct Variant {
+        const char *suffix;
+        KoOptimizedRgbShaperBase::TransferFunction transfer;
+    };
+
+    static const Variant variants[] = {
+        {"-g10.icc", KoOptimizedRgbShaperBase::LinearTransfer},
+        {"-srgbtrc.icc", KoOptimizedRgbShaperBase::SRGBTransfer}
+    };
+
+    /**
+     * Only the depths that have RGB color spaces registered by the
+     * engine, the links to other depths would never be connected
+     */
+    QList<KoID> depths = {Integer8BitsColorDepthID,
+                          Integer16BitsColorDepthID,
+                          Float32BitsColorDepthID};
+
+#ifdef HAVE_OPENEXR
+    if (KoOptimizedRgbShaperFactory::isDepthSupported(Float16BitsColorDepthID)) {
+        depths << Float16BitsColorDepthID;
+    }
+#endif
+
+    for (const char *family : profileFamilies) {
+        for (const Variant &src : variants) {
+            for (const Variant &dst : variants) {
+                for (const KoID &dstDepthId : depths) {
+                    if (src.transfer == dst.transfer && dstDepthId == srcDepthId) continue;
+
+                    list << new LcmsOptimizedRgbShaperTransformationFactory(
+                                srcDepthId, QString(family) + src.suffix, src.transfer,
+                                dstDepthId, QString(family) + dst.suffix, dst.transfer);
+                }
+            }
+        }
+    }
+}
+
+#endif // LCMSOPTIMIZEDRGBSHAPERTRANSFORMATION_H
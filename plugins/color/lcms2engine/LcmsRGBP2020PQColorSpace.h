@@ -20,6 +20,7 @@
 #include "KoColorConversionTransformationFactory.h"
 
 #include <LcmsRGBP2020PQColorSpaceTransformation.h>
+#include <LcmsOptimizedRgbShaperTransformation.h>
 
 template <class T>
 struct ColorSpaceFromFactory {
@@ -123,6 +124,9 @@ class LcmsRGBP2020PQColorSpaceFactoryWrapper : public BaseColorSpaceFactory
         // internally, we can convert to RGB U8 if needed
         addInternalConversion<RelatedColorSpaceType>(list, static_cast<KoBgrU8Traits*>(0));
 
+        // conversions between linear and sRGB-curve profiles bypass lcms
+        addOptimizedRgbShaperConversions(list, this->colorDepthId());
+
         return list;
     }
 };
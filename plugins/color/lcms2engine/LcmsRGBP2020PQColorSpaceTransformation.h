@@ -13,6 +13,7 @@
 #include "KoColorModelStandardIdsUtils.h"
 #include "KoColorConversionTransformationFactory.h"
 #include "KoColorTransferFunctions.h"
+#include "LcmsOptimizedRgbShaperTransformation.h"
 
 #include <colorspaces/rgb_u8/RgbU8ColorSpace.h>
 #include <colorspaces/rgb_u16/RgbU16ColorSpace.h>
@@ -150,6 +151,13 @@ public:
                                                                KoColorConversionTransformation::Intent renderingIntent,
                                                                KoColorConversionTransformation::ConversionFlags conversionFlags) const override
     {
+        if (LcmsOptimizedRgbShaperTransformation::canConvert(srcColorSpace, dstColorSpace)) {
+            return new LcmsOptimizedRgbShaperTransformation(srcColorSpace, KoOptimizedRgbShaperBase::PQTransfer,
+                                                            dstColorSpace, KoOptimizedRgbShaperBase::LinearTransfer,
+                                                            renderingIntent,
+                                                            conversionFlags);
+        }
+
         return new ApplyRgbShaper<
                 typename ParentColorSpace::ColorSpaceTraits,
                 DstColorSpaceTraits,
@@ -187,6 +195,13 @@ public:
                                                                KoColorConversionTransformation::Intent renderingIntent,
                                                                KoColorConversionTransformation::ConversionFlags conversionFlags) const override
     {
+        if (LcmsOptimizedRgbShaperTransformation::canConvert(srcColorSpace, dstColorSpace)) {
+            return new LcmsOptimizedRgbShaperTransformation(srcColorSpace, KoOptimizedRgbShaperBase::LinearTransfer,
+                                                            dstColorSpace, KoOptimizedRgbShaperBase::PQTransfer,
+                                                            renderingIntent,
+                                                            conversionFlags);
+        }
+
         return new ApplyRgbShaper<
                 DstColorSpaceTraits,
                 typename ParentColorSpace::ColorSpaceTraits,
@@ -228,6 +243,13 @@ public:
                                                                KoColorConversionTransformation::Intent renderingIntent,
                                                                KoColorConversionTransformation::ConversionFlags conversionFlags) const override
     {
+        if (LcmsOptimizedRgbShaperTransformation::canConvert(srcColorSpace, dstColorSpace)) {
+            return new LcmsOptimizedRgbShaperTransformation(srcColorSpace, KoOptimizedRgbShaperBase::PQTransfer,
+                                                            dstColorSpace, KoOptimizedRgbShaperBase::PQTransfer,
+                                                            renderingIntent,
+                                                            conversionFlags);
+        }
+
         return new ApplyRgbShaper<
                 typename ParentColorSpace::ColorSpaceTraits,
                 DstColorSpaceTraits,
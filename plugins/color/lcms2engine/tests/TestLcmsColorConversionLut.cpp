@@ -0,0 +1,330 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsColorConversionLut.h"
+
+#include <simpletest.h>
+#include "sdk/tests/testpigment.h"
+
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+#include <utility>
+
+#include "kis_debug.h"
+
+#include "KoColorSpaceRegistry.h"
+#include "KoColorSpaceEngine.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformation.h"
+#include "KoColorConversionLut.h"
+#include "KoChannelInfo.h"
+
+namespace {
+
+KoColorConversionTransformation* createLcmsTransform(const KoColorSpace *srcCS, const KoColorSpace *dstCS)
+{
+    KoColorSpaceEngine *engine = KoColorSpaceEngineRegistry::instance()->get("icc");
+    if (!engine) return 0;
+
+    return engine->createColorTransformation(srcCS, dstCS,
+                                             KoColorConversionTransformation::internalRenderingIntent(),
+                                             KoColorConversionTransformation::internalConversionFlags());
+}
+
+/**
+ * An affine conversion of 16-bit RGB. Tetrahedral interpolation
+ * reproduces affine functions exactly, so the baked table
+ * should differ from it only by the rounding.
+ */
+class AffineRgb16Transformation : public KoColorConversionTransformation
+{
+public:
+    AffineRgb16Transformation(const KoColorSpace *cs)
+        : KoColorConversionTransformation(cs, cs,
+                                          KoColorConversionTransformation::internalRenderingIntent(),
+                                          KoColorConversionTransformation::internalConversionFlags())
+    {
+    }
+
+    static quint16 channel(const quint16 *src, int ch) {
+        const float value = 0.1f * 65535.0f +
+            0.5f * src[ch] +
+            0.25f * src[(ch + 1) % 3] +
+            0.125f * src[(ch + 2) % 3];
+
+        return quint16(value + 0.5f);
+    }
+
+    void transform(const quint8 *src8, quint8 *dst8, qint32 nPixels) const override {
+        const quint16 *src = reinterpret_cast<const quint16*>(src8);
+        quint16 *dst = reinterpret_cast<quint16*>(dst8);
+
+        for (qint32 i = 0; i < nPixels; i++) {
+            for (int ch = 0; ch < 3; ch++) {
+                dst[ch] = channel(src, ch);
+            }
+            dst[3] = src[3];
+
+            src += 4;
+            dst += 4;
+        }
+    }
+};
+
+/**
+ * Compares the conversion of \p numPixels pixels of \p src by the
+ * lookup table and by \p reference, returns the maximum and the
+ * mean absolute difference of the normalized channels
+ */
+std::pair<float, float> compareTransforms(const KoColorConversionTransformation *reference,
+                                          const QSharedPointer<KoColorConversionLut> &lut,
+                                          const QByteArray &src, int numPixels)
+{
+    const KoColorSpace *srcCS = reference->srcColorSpace();
+    const KoColorSpace *dstCS = reference->dstColorSpace();
+
+    KoColorConversionLutTransformation lutTransform(srcCS, dstCS,
+                                                    reference->renderingIntent(),
+                                                    reference->conversionFlags(),
+                                                    lut);
+
+    QByteArray baked(numPixels * dstCS->pixelSize(), 0);
+    QByteArray expected(numPixels * dstCS->pixelSize(), 0);
+
+    lutTransform.transform(reinterpret_cast<const quint8*>(src.constData()),
+                           reinterpret_cast<quint8*>(baked.data()),
+                           numPixels);
+
+    reference->transform(reinterpret_cast<const quint8*>(src.constData()),
+                         reinterpret_cast<quint8*>(expected.data()),
+                         numPixels);
+
+    QVector<float> bakedChannels(dstCS->channelCount());
+    QVector<float> expectedChannels(dstCS->channelCount());
+
+    float maxError = 0.0f;
+    double totalError = 0.0;
+
+    for (int i = 0; i < numPixels; i++) {
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(baked.constData()) + i * dstCS->pixelSize(), bakedChannels);
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(expected.constData()) + i * dstCS->pixelSize(), expectedChannels);
+
+        for (int ch = 0; ch < bakedChannels.size(); ch++) {
+            const float error = qAbs(bakedChannels[ch] - expectedChannels[ch]);
+            maxError = qMax(maxError, error);
+            totalError += error;
+        }
+    }
+
+    return std::make_pair(maxError, float(totalError / (numPixels * dstCS->channelCount())));
+}
+
+QByteArray randomPixels(const KoColorSpace *cs, int numPixels)
+{
+    QByteArray pixels(numPixels * cs->pixelSize(), 0);
+    QVector<float> channels(cs->channelCount());
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < numPixels; i++) {
+        for (int ch = 0; ch < channels.size(); ch++) {
+            channels[ch] = float(random.generateDouble());
+        }
+        cs->fromNormalisedChannelsValue(reinterpret_cast<quint8*>(pixels.data()) + i * cs->pixelSize(), channels);
+    }
+
+    return pixels;
+}
+
+/**
+ * The pixels lying exactly at the nodes of a grid of \p gridSize,
+ * the color space should have 8- or 16-bit integer channels
+ */
+QByteArray gridPixels(const KoColorSpace *cs, int gridSize, int *numPixels)
+{
+    const int numColorChannels = cs->colorChannelCount();
+
+    int numNodes = 1;
+    for (int i = 0; i < numColorChannels; i++) {
+        numNodes *= gridSize;
+    }
+
+    QByteArray pixels(numNodes * cs->pixelSize(), 0);
+
+    for (int node = 0; node < numNodes; node++) {
+        quint8 *pixel = reinterpret_cast<quint8*>(pixels.data()) + node * cs->pixelSize();
+        int index = node;
+
+        // the raw values are written directly to avoid the rounding
+        Q_FOREACH (const KoChannelInfo *channel, cs->channels()) {
+            const bool isUint8 = channel->channelValueType() == KoChannelInfo::UINT8;
+            const int unitValue = isUint8 ? 0xff : 0xffff;
+
+            int value = unitValue;
+
+            if (channel->channelType() != KoChannelInfo::ALPHA) {
+                value = (index % gridSize) * unitValue / (gridSize - 1);
+                index /= gridSize;
+            }
+
+            if (isUint8) {
+                pixel[channel->pos()] = quint8(value);
+            } else {
+                *reinterpret_cast<quint16*>(pixel + channel->pos()) = quint16(value);
+            }
+        }
+    }
+
+    *numPixels = numNodes;
+    return pixels;
+}
+
+}
+
+void TestLcmsColorConversionLut::testAffineConversionIsExact()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+
+    AffineRgb16Transformation transform(cs);
+
+    QSharedPointer<KoColorConversionLut> lut = KoColorConversionLut::bake(&transform, 17);
+    QVERIFY(lut);
+
+    const int numPixels = 10000;
+    const std::pair<float, float> error = compareTransforms(&transform, lut, randomPixels(cs, numPixels), numPixels);
+
+    // one step of the 16-bit channel for rounding of the table and the result
+    QVERIFY2(error.first <= 1.0f / 65535.0f, qPrintable(QString("max error %1").arg(error.first)));
+}
+
+void TestLcmsColorConversionLut::testNodesMatchLcms_data()
+{
+    QTest::addColumn<QString>("srcModel");
+    QTest::addColumn<QString>("srcDepth");
+    QTest::addColumn<QString>("dstModel");
+    QTest::addColumn<QString>("dstDepth");
+
+    QTest::addRow("rgb8 -> cmyk8") << RGBAColorModelID.id() << Integer8BitsColorDepthID.id() << CMYKAColorModelID.id() << Integer8BitsColorDepthID.id();
+    QTest::addRow("rgb16 -> cmyk16") << RGBAColorModelID.id() << Integer16BitsColorDepthID.id() << CMYKAColorModelID.id() << Integer16BitsColorDepthID.id();
+    QTest::addRow("rgb8 -> lab16") << RGBAColorModelID.id() << Integer8BitsColorDepthID.id() << LABAColorModelID.id() << Integer16BitsColorDepthID.id();
+    QTest::addRow("cmyk8 -> rgb8") << CMYKAColorModelID.id() << Integer8BitsColorDepthID.id() << RGBAColorModelID.id() << Integer8BitsColorDepthID.id();
+}
+
+void TestLcmsColorConversionLut::testNodesMatchLcms()
+{
+    QFETCH(QString, srcModel);
+    QFETCH(QString, srcDepth);
+    QFETCH(QString, dstModel);
+    QFETCH(QString, dstDepth);
+
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->colorSpace(srcModel, srcDepth, QString());
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->colorSpace(dstModel, dstDepth, QString());
+
+    if (!srcCS || !dstCS) {
+        QSKIP("The color spaces are not available");
+    }
+
+    QVERIFY(KoColorConversionLut::isSupported(srcCS, dstCS));
+
+    QScopedPointer<KoColorConversionTransformation> lcmsTransform(createLcmsTransform(srcCS, dstCS));
+    QVERIFY(lcmsTransform);
+
+    /**
+     * 255 and 65535 are divisible by 17, so all the nodes of the
+     * grid are representable in the source color space
+     */
+    const int gridSize = 18;
+
+    QSharedPointer<KoColorConversionLut> lut = KoColorConversionLut::bake(lcmsTransform.data(), gridSize);
+    QVERIFY(lut);
+    QCOMPARE(lut->numInputs(), srcModel == CMYKAColorModelID.id() ? 4 : 3);
+    QCOMPARE(lut->gridSize(), gridSize);
+
+    // at the nodes the table returns the values of lcms as they are
+    int numPixels = 0;
+    const QByteArray nodes = gridPixels(srcCS, gridSize, &numPixels);
+    const std::pair<float, float> nodeError = compareTransforms(lcmsTransform.data(), lut, nodes, numPixels);
+
+    const float oneStep = dstDepth == Integer8BitsColorDepthID.id() ? 1.0f / 255.0f : 1.0f / 65535.0f;
+    QVERIFY2(nodeError.first <= oneStep, qPrintable(QString("max error at nodes %1").arg(nodeError.first)));
+
+    /**
+     * Between the nodes the result depends on the curvature of the
+     * transform. lcms precalculates the conversion into its own table
+     * of a similar size, so the difference should stay within a few
+     * steps of an 8-bit channel.
+     */
+    QSharedPointer<KoColorConversionLut> fineLut = KoColorConversionLut::bake(lcmsTransform.data(), 33);
+    QVERIFY(fineLut);
+
+    const int numRandomPixels = 1000;
+    const std::pair<float, float> error =
+        compareTransforms(lcmsTransform.data(), fineLut, randomPixels(srcCS, numRandomPixels), numRandomPixels);
+
+    QVERIFY2(error.first <= 3.0f / 255.0f, qPrintable(QString("max error %1").arg(error.first)));
+    QVERIFY2(error.second <= 0.5f / 255.0f, qPrintable(QString("mean error %1").arg(error.second)));
+}
+
+void TestLcmsColorConversionLut::testUnsupportedSources()
+{
+    const KoColorSpace *cmykCS = KoColorSpaceRegistry::instance()->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), QString());
+    const KoColorSpace *floatCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), QString());
+    const KoColorSpace *linearCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Integer16BitsColorDepthID.id(), "sRGB-elle-V2-g10.icc");
+
+    if (!cmykCS || !floatCS) {
+        QSKIP("The color spaces are not available");
+    }
+
+    // float data may be linear or HDR, it cannot be sampled on a uniform grid
+    QVERIFY(!KoColorConversionLut::isSupported(floatCS, cmykCS));
+
+    // float destinations keep the raw values of the table
+    QVERIFY(KoColorConversionLut::isSupported(cmykCS, floatCS));
+
+    if (linearCS) {
+        QVERIFY(!KoColorConversionLut::isSupported(linearCS, cmykCS));
+    }
+}
+
+void TestLcmsColorConversionLut::testSaveLoad()
+{
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->colorSpace(CMYKAColorModelID.id(), Integer8BitsColorDepthID.id(), QString());
+
+    if (!dstCS) {
+        QSKIP("The color spaces are not available");
+    }
+
+    QScopedPointer<KoColorConversionTransformation> lcmsTransform(createLcmsTransform(srcCS, dstCS));
+    QVERIFY(lcmsTransform);
+
+    QSharedPointer<KoColorConversionLut> lut = KoColorConversionLut::bake(lcmsTransform.data(), 17);
+    QVERIFY(lut);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("test.lut");
+
+    QVERIFY(lut->save(fileName));
+
+    // the dimensions of the file don't match the requested ones
+    QVERIFY(!KoColorConversionLut::load(fileName, lcmsTransform.data(), 33));
+
+    QSharedPointer<KoColorConversionLut> loadedLut = KoColorConversionLut::load(fileName, lcmsTransform.data(), 17);
+    QVERIFY(loadedLut);
+    QCOMPARE(loadedLut->gridSize(), 17);
+
+    const float input[] = {0.1f, 0.5f, 0.9f};
+    QVector<float> output(lut->numOutputs());
+    QVector<float> loadedOutput(loadedLut->numOutputs());
+
+    lut->evaluate(input, output.data());
+    loadedLut->evaluate(input, loadedOutput.data());
+
+    QCOMPARE(loadedOutput, output);
+}
+
+KISTEST_MAIN(TestLcmsColorConversionLut)
@@ -0,0 +1,22 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSCOLORCONVERSIONLUT_H
+#define TESTLCMSCOLORCONVERSIONLUT_H
+#include <QObject>
+
+class TestLcmsColorConversionLut : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+    void testAffineConversionIsExact();
+    void testNodesMatchLcms_data();
+    void testNodesMatchLcms();
+    void testUnsupportedSources();
+    void testSaveLoad();
+};
+
+#endif // TESTLCMSCOLORCONVERSIONLUT_H
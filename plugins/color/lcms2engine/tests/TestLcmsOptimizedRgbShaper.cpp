@@ -0,0 +1,140 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestLcmsOptimizedRgbShaper.h"
+
+#include <simpletest.h>
+#include "sdk/tests/testpigment.h"
+
+#include <QRandomGenerator>
+
+#include "kis_debug.h"
+
+#include "KoColorSpaceRegistry.h"
+#include "KoColorSpaceEngine.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformation.h"
+#include "KoOptimizedRgbShaperFactory.h"
+#include "LcmsOptimizedRgbShaperTransformation.h"
+
+void TestLcmsOptimizedRgbShaper::testCompareWithLcms_data()
+{
+    QTest::addColumn<QString>("srcDepth");
+    QTest::addColumn<QString>("srcProfile");
+    QTest::addColumn<QString>("dstDepth");
+    QTest::addColumn<QString>("dstProfile");
+
+    QStringList depths = {Integer8BitsColorDepthID.id(),
+                          Integer16BitsColorDepthID.id(),
+                          Float32BitsColorDepthID.id()};
+
+    if (KoOptimizedRgbShaperFactory::isDepthSupported(Float16BitsColorDepthID)) {
+        depths << Float16BitsColorDepthID.id();
+    }
+
+    const QStringList profiles = {"sRGB-elle-V2-srgbtrc.icc",
+                                  "sRGB-elle-V2-g10.icc"};
+
+    Q_FOREACH (const QString &srcDepth, depths) {
+        Q_FOREACH (const QString &srcProfile, profiles) {
+            Q_FOREACH (const QString &dstDepth, depths) {
+                Q_FOREACH (const QString &dstProfile, profiles) {
+                    if (srcDepth == dstDepth && srcProfile == dstProfile) continue;
+
+                    QTest::addRow("%s %s -> %s %s",
+                                  qPrintable(srcDepth), qPrintable(srcProfile),
+                                  qPrintable(dstDepth), qPrintable(dstProfile))
+                            << srcDepth << srcProfile << dstDepth << dstProfile;
+                }
+            }
+        }
+    }
+}
+
+void TestLcmsOptimizedRgbShaper::testCompareWithLcms()
+{
+    QFETCH(QString, srcDepth);
+    QFETCH(QString, srcProfile);
+    QFETCH(QString, dstDepth);
+    QFETCH(QString, dstProfile);
+
+    const KoColorSpace *srcCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), srcDepth, srcProfile);
+    const KoColorSpace *dstCS = KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), dstDepth, dstProfile);
+
+    if (!srcCS || !dstCS) {
+        QSKIP("The profiles are not available");
+    }
+
+    // more than one conversion block and a tail
+    const int numPixels = 1000;
+
+    QVector<float> refChannels(4);
+    QByteArray src(numPixels * srcCS->pixelSize(), 0);
+
+    QRandomGenerator random(42);
+    for (int i = 0; i < numPixels; i++) {
+        for (int ch = 0; ch < 4; ch++) {
+            refChannels[ch] = float(random.generateDouble());
+        }
+        srcCS->fromNormalisedChannelsValue(reinterpret_cast<quint8*>(src.data()) + i * srcCS->pixelSize(), refChannels);
+    }
+
+    QByteArray optimized(numPixels * dstCS->pixelSize(), 0);
+    QByteArray reference(numPixels * dstCS->pixelSize(), 0);
+
+    QScopedPointer<KoColorConversionTransformation> optimizedTransform(
+        srcCS->createColorConverter(dstCS,
+                                    KoColorConversionTransformation::internalRenderingIntent(),
+                                    KoColorConversionTransformation::internalConversionFlags()));
+
+    // the conversion system should pick the direct link instead of lcms
+    QVERIFY(dynamic_cast<LcmsOptimizedRgbShaperTransformation*>(optimizedTransform.data()));
+
+    optimizedTransform->transform(reinterpret_cast<const quint8*>(src.constData()),
+                                  reinterpret_cast<quint8*>(optimized.data()),
+                                  numPixels);
+
+    KoColorSpaceEngine *engine = KoColorSpaceEngineRegistry::instance()->get("icc");
+    QVERIFY(engine);
+
+    QScopedPointer<KoColorConversionTransformation> lcmsTransform(
+        engine->createColorTransformation(srcCS, dstCS,
+                                          KoColorConversionTransformation::internalRenderingIntent(),
+                                          KoColorConversionTransformation::internalConversionFlags()));
+
+    lcmsTransform->transform(reinterpret_cast<const quint8*>(src.constData()),
+                             reinterpret_cast<quint8*>(reference.data()),
+                             numPixels);
+
+    /**
+     * The V2 profiles keep the sRGB curve as a table, so the result
+     * differs from the analytical curve a bit. For integer and half
+     * destinations the rounding may differ by one unit of the last
+     * place.
+     */
+    const float tolerance =
+        dstDepth == Integer8BitsColorDepthID.id() ? 1.0f / 255.0f + 1e-6f :
+        dstDepth == Float16BitsColorDepthID.id() ? 0.001f : 0.0005f;
+
+    QVector<float> optimizedChannels(4);
+    QVector<float> referenceChannels(4);
+
+    for (int i = 0; i < numPixels; i++) {
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(optimized.constData()) + i * dstCS->pixelSize(), optimizedChannels);
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(reference.constData()) + i * dstCS->pixelSize(), referenceChannels);
+
+        for (int ch = 0; ch < 4; ch++) {
+            if (qAbs(optimizedChannels[ch] - referenceChannels[ch]) > tolerance) {
+                qDebug() << "pixel" << i << "channel" << ch
+                         << "optimized" << optimizedChannels[ch]
+                         << "lcms" << referenceChannels[ch];
+                QFAIL("The optimized conversion differs from lcms");
+            }
+        }
+    }
+}
+
+KISTEST_MAIN(TestLcmsOptimizedRgbShaper)
@@ -0,0 +1,19 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTLCMSOPTIMIZEDRGBSHAPER_H
+#define TESTLCMSOPTIMIZEDRGBSHAPER_H
+#include <QObject>
+
+class TestLcmsOptimizedRgbShaper : public QObject
+{
+  Q_OBJECT
+private Q_SLOTS:
+    void testCompareWithLcms_data();
+    void testCompareWithLcms();
+};
+
+#endif // TESTLCMSOPTIMIZEDRGBSHAPER_H